@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""Generate the native NCS VM action table (ncs_vm_actions_k2.h) from k2_nwscript.nss
+
+Each routine declared in nwscript.nss becomes one constexpr NcsVmActionInfo,
+indexed by its ACTION routine number (declaration order), with the argument
+types, the return type and the stack footprint precomputed.
+
+Usage (from the repository root):
+    python scripts/generate_ncs_action_table.py [nwscript.nss] [output.h]
+"""
+
+import re
+import sys
+
+DEFAULT_INPUT = 'include/k2_nwscript.nss'
+DEFAULT_OUTPUT = 'src/BioWare.NET/Resource/Formats/NCS/ncs_vm_actions_k2.h'
+
+# Must match NCS_VM_ACTION_MAX_ARGUMENTS / NCS_VM_ACTION_MAX_CELLS in ncs_vm.h
+MAX_ARGUMENTS = 16
+MAX_CELLS = 16
+
+# nwscript type -> (NcsVmScriptType, stack cells, NcsVmType of each cell)
+SCRIPT_TYPES: dict[str, tuple[str, int, str]] = {
+    'void': ('NCS_VM_SCRIPT_VOID', 0, ''),
+    'int': ('NCS_VM_SCRIPT_INT', 1, 'NCS_VM_TYPE_INT'),
+    'float': ('NCS_VM_SCRIPT_FLOAT', 1, 'NCS_VM_TYPE_FLOAT'),
+    'string': ('NCS_VM_SCRIPT_STRING', 1, 'NCS_VM_TYPE_STRING'),
+    'object': ('NCS_VM_SCRIPT_OBJECT', 1, 'NCS_VM_TYPE_OBJECT'),
+    'vector': ('NCS_VM_SCRIPT_VECTOR', 3, 'NCS_VM_TYPE_FLOAT'),
+    'effect': ('NCS_VM_SCRIPT_EFFECT', 1, 'NCS_VM_TYPE_EFFECT'),
+    'event': ('NCS_VM_SCRIPT_EVENT', 1, 'NCS_VM_TYPE_EVENT'),
+    'location': ('NCS_VM_SCRIPT_LOCATION', 1, 'NCS_VM_TYPE_LOCATION'),
+    'talent': ('NCS_VM_SCRIPT_TALENT', 1, 'NCS_VM_TYPE_TALENT'),
+    # Taken from the state stored by STORE_STATE, not from the stack
+    'action': ('NCS_VM_SCRIPT_ACTION', 0, ''),
+}
+
+FUNCTION_PATTERN = re.compile(
+    r'\b(' + '|'.join(SCRIPT_TYPES) + r')\s+(\w+)\s*\(([^;]*?)\)\s*;')
+
+
+def strip_comments(source: str) -> str:
+    """Remove // and /* */ comments"""
+    source = re.sub(r'/\*.*?\*/', '', source, flags=re.S)
+    return re.sub(r'//[^\n]*', '', source)
+
+
+def split_parameters(parameters: str) -> list[str]:
+    """Split a parameter list on commas outside vector defaults ([x, y, z])"""
+    result: list[str] = []
+    depth = 0
+    current = ''
+    for ch in parameters:
+        if ch == '[':
+            depth += 1
+        elif ch == ']':
+            depth -= 1
+        if ch == ',' and depth == 0:
+            result.append(current.strip())
+            current = ''
+        else:
+            current += ch
+    if current.strip():
+        result.append(current.strip())
+    return result
+
+
+def parse_functions(source: str) -> list[tuple[str, str, list[str]]]:
+    """Return (return type, name, parameter types) per routine, in routine number order"""
+    functions: list[tuple[str, str, list[str]]] = []
+    for return_type, name, parameters in FUNCTION_PATTERN.findall(strip_comments(source)):
+        types = [parameter.split()[0] for parameter in split_parameters(parameters)]
+        for parameter_type in types:
+            if parameter_type not in SCRIPT_TYPES or parameter_type == 'void':
+                raise ValueError(f'{name}: unsupported parameter type {parameter_type}')
+        functions.append((return_type, name, types))
+    return functions
+
+
+def convert_function(routine: int, return_type: str, name: str, types: list[str]) -> str:
+    """Convert one routine to an NcsVmActionInfo initializer"""
+    cells: list[str] = []
+    for parameter_type in types:
+        _, count, cell_type = SCRIPT_TYPES[parameter_type]
+        cells.extend([cell_type] * count)
+    if len(types) > MAX_ARGUMENTS or len(cells) > MAX_CELLS:
+        raise ValueError(f'{name}: {len(types)} arguments / {len(cells)} cells exceed the table limits')
+
+    argument_types = ', '.join(SCRIPT_TYPES[t][0] for t in types) or '0'
+    cell_types = ', '.join(cells) or '0'
+    return (f'    /* {routine:3d} */ {{ "{name}", {SCRIPT_TYPES[return_type][0]}, '
+            f'{len(types)}, {len(cells)}, {SCRIPT_TYPES[return_type][1]},\n'
+            f'              {{ {argument_types} }},\n'
+            f'              {{ {cell_types} }} }},')
+
+
+def main() -> int:
+    input_path = sys.argv[1] if len(sys.argv) > 1 else DEFAULT_INPUT
+    output_path = sys.argv[2] if len(sys.argv) > 2 else DEFAULT_OUTPUT
+
+    with open(input_path, encoding='latin-1') as f:
+        functions = parse_functions(f.read())
+
+    output = f"""// ============================================================================
+// NCS VIRTUAL MACHINE - KOTOR 2 ACTION TABLE
+// ============================================================================
+// GENERATED by scripts/generate_ncs_action_table.py from {input_path}.
+// Do not edit; rerun the script after changing the nwscript definitions.
+// ============================================================================
+
+#ifndef NCS_VM_ACTIONS_K2_H
+#define NCS_VM_ACTIONS_K2_H
+
+#include "ncs_vm.h"
+
+#define NCS_VM_K2_ACTION_COUNT {len(functions)}
+
+static constexpr NcsVmActionInfo NCS_VM_K2_ACTIONS[NCS_VM_K2_ACTION_COUNT] = {{
+"""
+    for routine, (return_type, name, types) in enumerate(functions):
+        output += convert_function(routine, return_type, name, types) + '\n'
+    output += """};
+
+#endif // NCS_VM_ACTIONS_K2_H
+"""
+
+    with open(output_path, 'w', encoding='utf-8', newline='\n') as f:
+        f.write(output)
+    print(f'Generated {output_path} ({len(functions)} actions)')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
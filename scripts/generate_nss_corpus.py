@@ -0,0 +1,322 @@
+#!/usr/bin/env python3
+"""Generate a synthetic NSS corpus for compiler scale and throughput testing
+
+Writes valid, type-checked NSS programs whose size and shape are set on the
+command line: lines per script (a comma list gives graded sizes, assigned
+round-robin), function count, control-flow nesting depth, switch fan-out,
+include fan-in, string constant pool and engine call density. Engine calls
+are drawn from the routines declared in k2_nwscript.nss whose parameters
+can be written as literals (int, float, string, object, vector).
+
+Output is deterministic for a given seed: script N depends only on the
+seed, N and the shape options, so a larger corpus extends a smaller one.
+Scripts go to <out>/dNNNN/ in groups of --per-directory; shared include
+files go to <out>/include/ (pass it to the compiler with -i).
+
+Usage (from the repository root):
+    python scripts/generate_nss_corpus.py OUT [--files N] [--lines 10,1000,100000] ...
+"""
+
+import argparse
+import os
+import random
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+from generate_ncs_action_table import parse_functions  # noqa: E402
+
+DEFAULT_NWSCRIPT = 'include/k2_nwscript.nss'
+
+# Parameter types an engine call can be given as an expression
+LITERAL_TYPES = ('int', 'float', 'string', 'object', 'vector')
+
+# Engine routines that take or store script state, or end the script
+EXCLUDED_ROUTINES = {'AssignCommand', 'DelayCommand', 'ActionDoCommand', 'ExecuteScript', 'DestroyObject'}
+
+
+class Shape:
+    """Size and shape options shared by every generated file"""
+
+    def __init__(self, args: argparse.Namespace, actions: list[tuple[str, str, list[str]]]):
+        self.functions = args.functions
+        self.depth = args.depth
+        self.switch_fanout = args.switch_fanout
+        self.includes = args.includes
+        self.include_functions = args.include_functions
+        self.engine_density = args.engine_density
+        self.strings = [f'str_{i:05d}_' + 'x' * (i % 17) for i in range(args.strings)]
+        self.actions = actions
+
+
+class Writer:
+    """Emits the statements of one file, tracking locals and the line budget"""
+
+    def __init__(self, rng: random.Random, shape: Shape, callable_functions: list[tuple[str, int]]):
+        self.rng = rng
+        self.shape = shape
+        self.callable = callable_functions   # (name, int parameter count), all return int
+        self.lines: list[str] = []
+        self.serial = 0
+
+    def name(self, prefix: str) -> str:
+        self.serial += 1
+        return f'{prefix}{self.serial}'
+
+    def emit(self, indent: int, text: str) -> None:
+        self.lines.append('    ' * indent + text)
+
+    # ------------------------------------------------------------------
+    # Expressions
+    # ------------------------------------------------------------------
+
+    def int_expression(self, scope: dict[str, list[str]], depth: int = 0) -> str:
+        rng = self.rng
+        choice = rng.random()
+        ints = scope['int']
+        if depth > 2 or choice < 0.3:
+            return str(rng.randint(0, 1000)) if not ints or rng.random() < 0.4 else rng.choice(ints)
+        if choice < 0.7:
+            op = rng.choice(('+', '-', '*', '&', '|', '^'))
+            return f'({self.int_expression(scope, depth + 1)} {op} {self.int_expression(scope, depth + 1)})'
+        if choice < 0.85 and self.callable:
+            function, parameters = rng.choice(self.callable)
+            arguments = ', '.join(self.int_expression(scope, depth + 1) for _ in range(parameters))
+            return f'{function}({arguments})'
+        if scope['string']:
+            return f'GetStringLength({rng.choice(scope["string"])})'
+        return str(rng.randint(0, 1000))
+
+    def float_expression(self, scope: dict[str, list[str]]) -> str:
+        rng = self.rng
+        if scope['float'] and rng.random() < 0.5:
+            return f'({rng.choice(scope["float"])} * {rng.randint(1, 9)}.5)'
+        return f'{rng.randint(0, 999)}.{rng.randint(0, 99)}'
+
+    def string_expression(self, scope: dict[str, list[str]]) -> str:
+        rng = self.rng
+        choice = rng.random()
+        if scope['string'] and choice < 0.4:
+            return rng.choice(scope['string'])
+        if self.shape.strings and choice < 0.8:
+            return '"' + rng.choice(self.shape.strings) + '"'
+        return f'IntToString({self.int_expression(scope)})'
+
+    def expression(self, script_type: str, scope: dict[str, list[str]]) -> str:
+        if script_type == 'int':
+            return self.int_expression(scope)
+        if script_type == 'float':
+            return self.float_expression(scope)
+        if script_type == 'string':
+            return self.string_expression(scope)
+        if script_type == 'object':
+            return self.rng.choice(('OBJECT_SELF', 'OBJECT_INVALID'))
+        if script_type == 'vector':
+            return f'Vector({self.float_expression(scope)}, {self.float_expression(scope)}, 0.0)'
+        raise ValueError(script_type)
+
+    # ------------------------------------------------------------------
+    # Statements
+    # ------------------------------------------------------------------
+
+    def declare(self, indent: int, scope: dict[str, list[str]], script_type: str, value: str) -> None:
+        prefix = {'int': 'n', 'float': 'f', 'string': 's', 'object': 'o', 'vector': 'v',
+                  'location': 'l', 'effect': 'e', 'event': 'ev', 'talent': 't'}[script_type]
+        variable = self.name(prefix)
+        self.emit(indent, f'{script_type} {variable} = {value};')
+        scope.setdefault(script_type, []).append(variable)
+
+    def engine_call(self, indent: int, scope: dict[str, list[str]]) -> None:
+        return_type, routine, parameters = self.rng.choice(self.shape.actions)
+        call = f'{routine}({", ".join(self.expression(t, scope) for t in parameters)})'
+        if return_type == 'void':
+            self.emit(indent, call + ';')
+        else:
+            self.declare(indent, scope, return_type, call)
+
+    def simple_statement(self, indent: int, scope: dict[str, list[str]]) -> None:
+        rng = self.rng
+        if self.shape.actions and rng.random() < self.shape.engine_density:
+            self.engine_call(indent, scope)
+            return
+        choice = rng.random()
+        if choice < 0.35 or not scope['int']:
+            self.declare(indent, scope, 'int', self.int_expression(scope))
+        elif choice < 0.6:
+            self.emit(indent, f'{rng.choice(scope["int"])} = {self.int_expression(scope)};')
+        elif choice < 0.75:
+            self.declare(indent, scope, 'string', self.string_expression(scope) + ' + ' +
+                         self.string_expression(scope))
+        elif choice < 0.85:
+            self.declare(indent, scope, 'float', self.float_expression(scope))
+        else:
+            self.emit(indent, f'{rng.choice(scope["int"])} += {rng.randint(1, 9)};')
+
+    def block(self, indent: int, scope: dict[str, list[str]], depth: int, budget: int) -> None:
+        """Emit statements until budget lines have been written"""
+        stop = len(self.lines) + budget
+        inner = {key: list(value) for key, value in scope.items()}
+        while len(self.lines) < stop:
+            remaining = stop - len(self.lines)
+            if depth < self.shape.depth and remaining > 6 and self.rng.random() < 0.25:
+                self.compound(indent, inner, depth, min(remaining - 2, max(4, remaining // 3)))
+            else:
+                self.simple_statement(indent, inner)
+
+    def compound(self, indent: int, scope: dict[str, list[str]], depth: int, budget: int) -> None:
+        rng = self.rng
+        if not scope['int']:
+            self.declare(indent, scope, 'int', str(rng.randint(0, 9)))
+        kind = rng.random()
+        subject = rng.choice(scope['int'])
+        if kind < 0.35:
+            self.emit(indent, f'if ({subject} > {rng.randint(0, 500)}) {{')
+            self.block(indent + 1, scope, depth + 1, budget // 2)
+            self.emit(indent, '} else {')
+            self.block(indent + 1, scope, depth + 1, budget // 2)
+            self.emit(indent, '}')
+        elif kind < 0.55:
+            counter = self.name('i')
+            self.emit(indent, f'int {counter};')
+            self.emit(indent, f'for ({counter} = 0; {counter} < {rng.randint(2, 8)}; {counter}++) {{')
+            self.block(indent + 1, scope, depth + 1, budget)
+            self.emit(indent, '}')
+        elif kind < 0.7:
+            counter = self.name('w')
+            self.emit(indent, f'int {counter} = {rng.randint(2, 8)};')
+            self.emit(indent, f'while ({counter} > 0) {{')
+            self.block(indent + 1, scope, depth + 1, budget)
+            self.emit(indent + 1, f'{counter}--;')
+            self.emit(indent, '}')
+        else:
+            # Each case costs at least three lines
+            fanout = max(1, min(self.shape.switch_fanout, budget // 3))
+            self.emit(indent, f'switch ({subject} % {fanout + 1}) {{')
+            for case in range(fanout):
+                self.emit(indent + 1, f'case {case}: {{')
+                self.block(indent + 2, scope, depth + 1, max(1, budget // (fanout + 1)))
+                self.emit(indent + 2, 'break;')
+                self.emit(indent + 1, '}')
+            self.emit(indent + 1, 'default:')
+            self.emit(indent + 2, 'break;')
+            self.emit(indent, '}')
+
+    def function(self, name: str, parameters: int, budget: int) -> None:
+        scope: dict[str, list[str]] = {'int': [f'nArg{i}' for i in range(parameters)], 'float': [], 'string': []}
+        signature = ', '.join(f'int nArg{i}' for i in range(parameters))
+        self.emit(0, f'int {name}({signature})')
+        self.emit(0, '{')
+        # Callees are restricted to functions defined earlier, so there is no recursion
+        self.block(1, scope, 0, max(1, budget - 4))
+        self.emit(1, f'return {self.int_expression(scope)};')
+        self.emit(0, '}')
+        self.emit(0, '')
+
+
+def include_name(index: int) -> str:
+    return f'inc_syn_{index:03d}'
+
+
+def write_include(path: str, index: int, shape: Shape, seed: int) -> list[tuple[str, int]]:
+    """Write one shared include; return its functions"""
+    rng = random.Random(f'{seed}/include/{index}')
+    writer = Writer(rng, shape, [])
+    functions: list[tuple[str, int]] = []
+    writer.emit(0, f'// {include_name(index)}: generated by scripts/generate_nss_corpus.py')
+    writer.emit(0, '')
+    for k in range(shape.include_functions):
+        name = f'Syn{index:03d}_F{k}'
+        parameters = rng.randint(0, 3)
+        writer.function(name, parameters, rng.randint(8, 40))
+        writer.callable.append((name, parameters))
+        functions.append((name, parameters))
+    with open(path, 'w', encoding='latin-1', newline='\n') as f:
+        f.write('\n'.join(writer.lines) + '\n')
+    return functions
+
+
+def write_script(path: str, index: int, lines: int, shape: Shape, seed: int,
+                 includes: list[list[tuple[str, int]]]) -> int:
+    """Write one script of about the given line count; return the lines written"""
+    rng = random.Random(f'{seed}/script/{index}')
+    chosen = sorted(rng.sample(range(len(includes)), min(shape.includes, len(includes))))
+    callable_functions = [function for i in chosen for function in includes[i]]
+    writer = Writer(rng, shape, callable_functions)
+    writer.emit(0, f'// Synthetic script {index}: generated by scripts/generate_nss_corpus.py')
+    for i in chosen:
+        writer.emit(0, f'#include "{include_name(i)}"')
+    writer.emit(0, '')
+
+    # Lines are split evenly between the helper functions and main; small
+    # scripts get fewer helpers so they stay near their line count
+    helpers = min(shape.functions, lines // 25)
+    share = max(1, lines // (helpers + 1))
+    for k in range(helpers):
+        name = f'Local_F{k}'
+        parameters = rng.randint(0, 3)
+        writer.function(name, parameters, share)
+        writer.callable.append((name, parameters))
+
+    writer.emit(0, 'void main()')
+    writer.emit(0, '{')
+    scope: dict[str, list[str]] = {'int': [], 'float': [], 'string': []}
+    writer.block(1, scope, 0, max(1, lines - len(writer.lines) - 1))
+    writer.emit(0, '}')
+    with open(path, 'w', encoding='latin-1', newline='\n') as f:
+        f.write('\n'.join(writer.lines) + '\n')
+    return len(writer.lines)
+
+
+def load_actions(path: str) -> list[tuple[str, str, list[str]]]:
+    """Engine routines whose parameters can all be written as literals"""
+    with open(path, encoding='latin-1') as f:
+        functions = parse_functions(f.read())
+    return [(return_type, name, types) for return_type, name, types in functions
+            if name not in EXCLUDED_ROUTINES and return_type != 'action'
+            and all(t in LITERAL_TYPES for t in types)]
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('out', help='output directory')
+    parser.add_argument('--files', type=int, default=100, help='scripts to write (up to 100k)')
+    parser.add_argument('--lines', default='10,100,1000,10000',
+                        help='lines per script; a comma list is assigned round-robin (graded sizes)')
+    parser.add_argument('--functions', type=int, default=4, help='helper functions per script')
+    parser.add_argument('--depth', type=int, default=3, help='maximum control-flow nesting depth')
+    parser.add_argument('--switch-fanout', type=int, default=8, help='cases per switch')
+    parser.add_argument('--includes', type=int, default=2, help='shared includes per script (fan-in)')
+    parser.add_argument('--include-pool', type=int, default=8, help='shared include files to generate')
+    parser.add_argument('--include-functions', type=int, default=6, help='functions per include file')
+    parser.add_argument('--strings', type=int, default=64, help='distinct string constants')
+    parser.add_argument('--engine-density', type=float, default=0.2,
+                        help='fraction of simple statements that are engine calls')
+    parser.add_argument('--per-directory', type=int, default=1000, help='scripts per output subdirectory')
+    parser.add_argument('--nwscript', default=DEFAULT_NWSCRIPT, help='nwscript.nss to draw engine calls from')
+    parser.add_argument('--seed', type=int, default=1, help='random seed')
+    args = parser.parse_args()
+
+    sizes = [int(size) for size in args.lines.split(',') if size.strip()]
+    if not sizes or min(sizes) < 1 or args.files < 0 or args.per_directory < 1:
+        parser.error('--lines needs positive sizes, --files and --per-directory must be positive')
+
+    shape = Shape(args, load_actions(args.nwscript) if args.engine_density > 0 else [])
+    include_directory = os.path.join(args.out, 'include')
+    os.makedirs(include_directory, exist_ok=True)
+    includes = [write_include(os.path.join(include_directory, include_name(i) + '.nss'), i, shape, args.seed)
+                for i in range(args.include_pool)]
+
+    total = 0
+    for index in range(args.files):
+        directory = os.path.join(args.out, f'd{index // args.per_directory:04d}')
+        if index % args.per_directory == 0:
+            os.makedirs(directory, exist_ok=True)
+        path = os.path.join(directory, f'syn_{index:06d}.nss')
+        total += write_script(path, index, sizes[index % len(sizes)], shape, args.seed, includes)
+
+    print(f'Generated {args.files} scripts ({total} lines) and {args.include_pool} includes in {args.out}')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,405 @@
+// ============================================================================
+// NCS BYTECODE - DECODE / ENCODE
+// ============================================================================
+
+#include "ncs_bytecode.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+// OPCODE TABLES
+// ============================================================================
+
+static const char* const g_ncsOpcodeNames[NCS_OP_COUNT] = {
+    "RESERVED", "CPDOWNSP", "RSADD", "CPTOPSP", "CONST", "ACTION",
+    "LOGAND", "LOGOR", "INCOR", "EXCOR", "BOOLAND", "EQUAL", "NEQUAL",
+    "GEQ", "GT", "LT", "LEQ", "SHLEFT", "SHRIGHT", "USHRIGHT",
+    "ADD", "SUB", "MUL", "DIV", "MOD", "NEG", "COMP", "MOVSP",
+    NULL,                                                   // 0x1C is unused
+    "JMP", "JSR", "JZ", "RETN", "DESTRUCT", "NOT", "DECxSP", "INCxSP",
+    "JNZ", "CPDOWNBP", "CPTOPBP", "DECxBP", "INCxBP", "SAVEBP",
+    "RESTOREBP", "STORE_STATE", "NOP"
+};
+
+const char* ncs_opcode_name(uint8_t opcode)
+{
+    if (opcode >= NCS_OP_COUNT || g_ncsOpcodeNames[opcode] == NULL) {
+        return "UNKNOWN";
+    }
+    return g_ncsOpcodeNames[opcode];
+}
+
+/**
+ * @brief Type suffix used by NCSInstructionType for a qualifier byte
+ */
+static const char* ncs_qualifier_suffix(uint8_t qualifier)
+{
+    switch (qualifier) {
+        case NCS_Q_INT:               return "I";
+        case NCS_Q_FLOAT:             return "F";
+        case NCS_Q_STRING:            return "S";
+        case NCS_Q_OBJECT:            return "O";
+        case NCS_Q_EFFECT:            return "EFF";
+        case NCS_Q_EVENT:             return "EVT";
+        case NCS_Q_LOCATION:          return "LOC";
+        case NCS_Q_TALENT:            return "TAL";
+        case NCS_Q_INT_INT:           return "II";
+        case NCS_Q_FLOAT_FLOAT:       return "FF";
+        case NCS_Q_OBJECT_OBJECT:     return "OO";
+        case NCS_Q_STRING_STRING:     return "SS";
+        case NCS_Q_STRUCT_STRUCT:     return "TT";
+        case NCS_Q_INT_FLOAT:         return "IF";
+        case NCS_Q_FLOAT_INT:         return "FI";
+        case NCS_Q_EFFECT_EFFECT:     return "EFFEFF";
+        case NCS_Q_EVENT_EVENT:       return "EVTEVT";
+        case NCS_Q_LOCATION_LOCATION: return "LOCLOC";
+        case NCS_Q_TALENT_TALENT:     return "TALTAL";
+        case NCS_Q_VECTOR_VECTOR:     return "VV";
+        case NCS_Q_VECTOR_FLOAT:      return "VF";
+        case NCS_Q_FLOAT_VECTOR:      return "FV";
+        default:                      return "";
+    }
+}
+
+/**
+ * @brief True for opcodes whose mnemonic carries the qualifier suffix
+ */
+static bool ncs_opcode_is_typed(uint8_t opcode)
+{
+    switch (opcode) {
+        case NCS_OP_RSADD: case NCS_OP_CONST:
+        case NCS_OP_LOGAND: case NCS_OP_LOGOR: case NCS_OP_INCOR: case NCS_OP_EXCOR:
+        case NCS_OP_BOOLAND: case NCS_OP_EQUAL: case NCS_OP_NEQUAL:
+        case NCS_OP_GEQ: case NCS_OP_GT: case NCS_OP_LT: case NCS_OP_LEQ:
+        case NCS_OP_SHLEFT: case NCS_OP_SHRIGHT: case NCS_OP_USHRIGHT:
+        case NCS_OP_ADD: case NCS_OP_SUB: case NCS_OP_MUL: case NCS_OP_DIV: case NCS_OP_MOD:
+        case NCS_OP_NEG: case NCS_OP_COMP: case NCS_OP_NOT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+int ncs_format_mnemonic(uint8_t opcode, uint8_t qualifier, char* buffer, size_t bufferSize)
+{
+    switch (opcode) {
+        // The type letter sits in the middle of these mnemonics (DECISP, INCIBP)
+        case NCS_OP_DECSP: return snprintf(buffer, bufferSize, "DEC%sSP", ncs_qualifier_suffix(qualifier));
+        case NCS_OP_INCSP: return snprintf(buffer, bufferSize, "INC%sSP", ncs_qualifier_suffix(qualifier));
+        case NCS_OP_DECBP: return snprintf(buffer, bufferSize, "DEC%sBP", ncs_qualifier_suffix(qualifier));
+        case NCS_OP_INCBP: return snprintf(buffer, bufferSize, "INC%sBP", ncs_qualifier_suffix(qualifier));
+        default: break;
+    }
+    if (ncs_opcode_is_typed(opcode)) {
+        return snprintf(buffer, bufferSize, "%s%s", ncs_opcode_name(opcode), ncs_qualifier_suffix(qualifier));
+    }
+    return snprintf(buffer, bufferSize, "%s", ncs_opcode_name(opcode));
+}
+
+const char* ncs_result_string(int result)
+{
+    switch (result) {
+        case NCS_OK:               return "ok";
+        case NCS_ERROR_TRUNCATED:  return "truncated stream";
+        case NCS_ERROR_BAD_HEADER: return "invalid NCS V1.0B header";
+        case NCS_ERROR_BAD_SIZE:   return "size field exceeds stream length";
+        case NCS_ERROR_BAD_OPCODE: return "unknown opcode";
+        case NCS_ERROR_BAD_JUMP:   return "jump target is not an instruction boundary";
+        case NCS_ERROR_OVERFLOW:   return "encoded program exceeds output buffer";
+        default:                   return "unknown error";
+    }
+}
+
+// ============================================================================
+// OPERAND SIZES
+// ============================================================================
+
+int ncs_operand_size(uint8_t opcode, uint8_t qualifier, const uint8_t* operands, size_t available)
+{
+    int size;
+
+    switch (opcode) {
+        case NCS_OP_CPDOWNSP: case NCS_OP_CPTOPSP:
+        case NCS_OP_CPDOWNBP: case NCS_OP_CPTOPBP:
+        case NCS_OP_DESTRUCT:
+            size = 6;
+            break;
+        case NCS_OP_CONST:
+            if (qualifier == NCS_Q_STRING) {
+                if (available < 2) {
+                    return -1;
+                }
+                size = 2 + ncs_read_be16(operands);
+            }
+            else {
+                size = 4;                                   // CONSTI/CONSTF/CONSTO
+            }
+            break;
+        case NCS_OP_ACTION:
+            size = 3;
+            break;
+        case NCS_OP_MOVSP:
+        case NCS_OP_JMP: case NCS_OP_JSR: case NCS_OP_JZ: case NCS_OP_JNZ:
+        case NCS_OP_DECSP: case NCS_OP_INCSP: case NCS_OP_DECBP: case NCS_OP_INCBP:
+            size = 4;
+            break;
+        case NCS_OP_STORE_STATE:
+            size = 8;
+            break;
+        case NCS_OP_EQUAL: case NCS_OP_NEQUAL:
+            size = (qualifier == NCS_Q_STRUCT_STRUCT) ? 2 : 0;
+            break;
+        default:
+            if (opcode >= NCS_OP_COUNT || g_ncsOpcodeNames[opcode] == NULL) {
+                return -1;
+            }
+            size = 0;
+            break;
+    }
+
+    return ((size_t)size <= available) ? size : -1;
+}
+
+uint32_t ncs_instruction_size(const NcsInstruction* instruction)
+{
+    switch (instruction->opcode) {
+        case NCS_OP_CONST:
+            return (instruction->qualifier == NCS_Q_STRING) ? 4 + (uint32_t)instruction->text.size() : 6;
+        case NCS_OP_EQUAL: case NCS_OP_NEQUAL:
+            return (instruction->qualifier == NCS_Q_STRUCT_STRUCT) ? 4 : 2;
+        default: {
+            // Fixed-size operands do not depend on the operand bytes themselves
+            static const uint8_t zero[2] = { 0, 0 };
+            int operands = ncs_operand_size(instruction->opcode, instruction->qualifier, zero, 16);
+            return 2 + (uint32_t)(operands < 0 ? 0 : operands);
+        }
+    }
+}
+
+// ============================================================================
+// DECODE
+// ============================================================================
+
+int ncs_decode_program(const uint8_t* data, size_t size, NcsProgram* program)
+{
+    program->instructions.clear();
+    program->declaredSize = 0;
+
+    if (size < NCS_HEADER_SIZE) {
+        return NCS_ERROR_TRUNCATED;
+    }
+    if (memcmp(data, "NCS V1.0", 8) != 0 || data[8] != NCS_HEADER_MAGIC_BYTE) {
+        return NCS_ERROR_BAD_HEADER;
+    }
+
+    uint32_t declaredSize = ncs_read_be32(data + NCS_HEADER_SIZE_OFFSET);
+    if (declaredSize > size) {
+        return NCS_ERROR_BAD_SIZE;
+    }
+    if (declaredSize < NCS_HEADER_SIZE) {
+        declaredSize = NCS_HEADER_SIZE;
+    }
+    program->declaredSize = declaredSize;
+
+    // First pass: split the stream into instructions, remembering raw jump offsets
+    std::vector<uint32_t> jumpOffsets;
+    uint32_t position = NCS_HEADER_SIZE;
+    while (position < declaredSize) {
+        if (declaredSize - position < 2) {
+            return NCS_ERROR_TRUNCATED;
+        }
+
+        NcsInstruction instruction;
+        instruction.offset = position;
+        instruction.opcode = data[position];
+        instruction.qualifier = data[position + 1];
+        instruction.arg0 = 0;
+        instruction.arg1 = 0;
+        instruction.arg2 = 0;
+        instruction.jumpTarget = -1;
+
+        const uint8_t* operands = data + position + 2;
+        int operandSize = ncs_operand_size(instruction.opcode, instruction.qualifier,
+                                           operands, declaredSize - position - 2);
+        if (operandSize < 0) {
+            return (instruction.opcode >= NCS_OP_COUNT || g_ncsOpcodeNames[instruction.opcode] == NULL)
+                ? NCS_ERROR_BAD_OPCODE : NCS_ERROR_TRUNCATED;
+        }
+
+        switch (instruction.opcode) {
+            case NCS_OP_CPDOWNSP: case NCS_OP_CPTOPSP:
+            case NCS_OP_CPDOWNBP: case NCS_OP_CPTOPBP:
+                instruction.arg0 = (int32_t)ncs_read_be32(operands);
+                instruction.arg1 = ncs_read_be16(operands + 4);
+                break;
+            case NCS_OP_CONST:
+                if (instruction.qualifier == NCS_Q_STRING) {
+                    instruction.text.assign((const char*)operands + 2, ncs_read_be16(operands));
+                }
+                else {
+                    instruction.arg0 = (int32_t)ncs_read_be32(operands);
+                }
+                break;
+            case NCS_OP_ACTION:
+                instruction.arg0 = ncs_read_be16(operands);
+                instruction.arg1 = operands[2];
+                break;
+            case NCS_OP_MOVSP:
+            case NCS_OP_DECSP: case NCS_OP_INCSP: case NCS_OP_DECBP: case NCS_OP_INCBP:
+                instruction.arg0 = (int32_t)ncs_read_be32(operands);
+                break;
+            case NCS_OP_JMP: case NCS_OP_JSR: case NCS_OP_JZ: case NCS_OP_JNZ:
+                jumpOffsets.push_back(position + ncs_read_be32(operands));
+                instruction.jumpTarget = (int32_t)(jumpOffsets.size() - 1);
+                break;
+            case NCS_OP_DESTRUCT:
+                instruction.arg0 = ncs_read_be16(operands);
+                instruction.arg1 = (int16_t)ncs_read_be16(operands + 2);
+                instruction.arg2 = ncs_read_be16(operands + 4);
+                break;
+            case NCS_OP_STORE_STATE:
+                instruction.arg0 = (int32_t)ncs_read_be32(operands);
+                instruction.arg1 = (int32_t)ncs_read_be32(operands + 4);
+                break;
+            case NCS_OP_EQUAL: case NCS_OP_NEQUAL:
+                if (instruction.qualifier == NCS_Q_STRUCT_STRUCT) {
+                    instruction.arg0 = ncs_read_be16(operands);
+                }
+                break;
+            default:
+                break;
+        }
+
+        program->instructions.push_back(instruction);
+        position += 2 + (uint32_t)operandSize;
+    }
+
+    // Second pass: map absolute jump offsets to instruction indices
+    std::vector<NcsInstruction>& instructions = program->instructions;
+    for (size_t i = 0; i < instructions.size(); i++) {
+        NcsInstruction& instruction = instructions[i];
+        if (instruction.jumpTarget < 0) {
+            continue;
+        }
+        uint32_t target = jumpOffsets[instruction.jumpTarget];
+
+        // Binary search over the (sorted) instruction offsets
+        size_t low = 0;
+        size_t high = instructions.size();
+        while (low < high) {
+            size_t mid = (low + high) / 2;
+            if (instructions[mid].offset < target) {
+                low = mid + 1;
+            }
+            else {
+                high = mid;
+            }
+        }
+        if (low >= instructions.size() || instructions[low].offset != target) {
+            return NCS_ERROR_BAD_JUMP;
+        }
+        instruction.jumpTarget = (int32_t)low;
+    }
+
+    return NCS_OK;
+}
+
+// ============================================================================
+// ENCODE
+// ============================================================================
+
+uint32_t ncs_layout_program(NcsProgram* program)
+{
+    uint32_t position = NCS_HEADER_SIZE;
+    for (size_t i = 0; i < program->instructions.size(); i++) {
+        program->instructions[i].offset = position;
+        position += ncs_instruction_size(&program->instructions[i]);
+    }
+    return position;
+}
+
+uint32_t ncs_program_size(const NcsProgram* program)
+{
+    uint32_t size = NCS_HEADER_SIZE;
+    for (size_t i = 0; i < program->instructions.size(); i++) {
+        size += ncs_instruction_size(&program->instructions[i]);
+    }
+    return size;
+}
+
+int ncs_encode_program(const NcsProgram* program, std::vector<uint8_t>* output)
+{
+    const std::vector<NcsInstruction>& instructions = program->instructions;
+
+    // Offsets are recomputed locally so callers may pass a freshly edited list
+    std::vector<uint32_t> offsets(instructions.size());
+    uint32_t totalSize = NCS_HEADER_SIZE;
+    for (size_t i = 0; i < instructions.size(); i++) {
+        offsets[i] = totalSize;
+        totalSize += ncs_instruction_size(&instructions[i]);
+    }
+
+    output->assign(totalSize, 0);
+    uint8_t* out = output->data();
+    memcpy(out, "NCS V1.0", 8);
+    out[8] = NCS_HEADER_MAGIC_BYTE;
+    ncs_write_be32(out + NCS_HEADER_SIZE_OFFSET, totalSize);
+
+    for (size_t i = 0; i < instructions.size(); i++) {
+        const NcsInstruction& instruction = instructions[i];
+        uint8_t* p = out + offsets[i];
+        p[0] = instruction.opcode;
+        p[1] = instruction.qualifier;
+        uint8_t* operands = p + 2;
+
+        switch (instruction.opcode) {
+            case NCS_OP_CPDOWNSP: case NCS_OP_CPTOPSP:
+            case NCS_OP_CPDOWNBP: case NCS_OP_CPTOPBP:
+                ncs_write_be32(operands, (uint32_t)instruction.arg0);
+                ncs_write_be16(operands + 4, (uint16_t)instruction.arg1);
+                break;
+            case NCS_OP_CONST:
+                if (instruction.qualifier == NCS_Q_STRING) {
+                    ncs_write_be16(operands, (uint16_t)instruction.text.size());
+                    memcpy(operands + 2, instruction.text.data(), instruction.text.size());
+                }
+                else {
+                    ncs_write_be32(operands, (uint32_t)instruction.arg0);
+                }
+                break;
+            case NCS_OP_ACTION:
+                ncs_write_be16(operands, (uint16_t)instruction.arg0);
+                operands[2] = (uint8_t)instruction.arg1;
+                break;
+            case NCS_OP_MOVSP:
+            case NCS_OP_DECSP: case NCS_OP_INCSP: case NCS_OP_DECBP: case NCS_OP_INCBP:
+                ncs_write_be32(operands, (uint32_t)instruction.arg0);
+                break;
+            case NCS_OP_JMP: case NCS_OP_JSR: case NCS_OP_JZ: case NCS_OP_JNZ:
+                if (instruction.jumpTarget < 0 || (size_t)instruction.jumpTarget >= instructions.size()) {
+                    return NCS_ERROR_BAD_JUMP;
+                }
+                ncs_write_be32(operands, offsets[instruction.jumpTarget] - offsets[i]);
+                break;
+            case NCS_OP_DESTRUCT:
+                ncs_write_be16(operands, (uint16_t)instruction.arg0);
+                ncs_write_be16(operands + 2, (uint16_t)(int16_t)instruction.arg1);
+                ncs_write_be16(operands + 4, (uint16_t)instruction.arg2);
+                break;
+            case NCS_OP_STORE_STATE:
+                ncs_write_be32(operands, (uint32_t)instruction.arg0);
+                ncs_write_be32(operands + 4, (uint32_t)instruction.arg1);
+                break;
+            case NCS_OP_EQUAL: case NCS_OP_NEQUAL:
+                if (instruction.qualifier == NCS_Q_STRUCT_STRUCT) {
+                    ncs_write_be16(operands, (uint16_t)instruction.arg0);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    return NCS_OK;
+}
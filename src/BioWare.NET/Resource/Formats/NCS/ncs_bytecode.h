@@ -0,0 +1,278 @@
+// ============================================================================
+// NCS BYTECODE - SHARED NATIVE DEFINITIONS
+// ============================================================================
+// Opcode and qualifier tables, big-endian helpers and a decoded instruction
+// list used by the native nwnnsscomp passes and tools. The opcode values
+// mirror NCSByteCode.cs and NCSInstructionQualifier.cs; operand layouts
+// mirror NCSBinaryReader.ReadInstruction().
+// ============================================================================
+
+#ifndef NCS_BYTECODE_H
+#define NCS_BYTECODE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// OPCODES AND QUALIFIERS
+// ============================================================================
+
+enum NcsOpcode
+{
+    NCS_OP_RESERVED     = 0x00,
+    NCS_OP_CPDOWNSP     = 0x01,
+    NCS_OP_RSADD        = 0x02,
+    NCS_OP_CPTOPSP      = 0x03,
+    NCS_OP_CONST        = 0x04,
+    NCS_OP_ACTION       = 0x05,
+    NCS_OP_LOGAND       = 0x06,
+    NCS_OP_LOGOR        = 0x07,
+    NCS_OP_INCOR        = 0x08,
+    NCS_OP_EXCOR        = 0x09,
+    NCS_OP_BOOLAND      = 0x0A,
+    NCS_OP_EQUAL        = 0x0B,
+    NCS_OP_NEQUAL       = 0x0C,
+    NCS_OP_GEQ          = 0x0D,
+    NCS_OP_GT           = 0x0E,
+    NCS_OP_LT           = 0x0F,
+    NCS_OP_LEQ          = 0x10,
+    NCS_OP_SHLEFT       = 0x11,
+    NCS_OP_SHRIGHT      = 0x12,
+    NCS_OP_USHRIGHT     = 0x13,
+    NCS_OP_ADD          = 0x14,
+    NCS_OP_SUB          = 0x15,
+    NCS_OP_MUL          = 0x16,
+    NCS_OP_DIV          = 0x17,
+    NCS_OP_MOD          = 0x18,
+    NCS_OP_NEG          = 0x19,
+    NCS_OP_COMP         = 0x1A,
+    NCS_OP_MOVSP        = 0x1B,
+    NCS_OP_JMP          = 0x1D,
+    NCS_OP_JSR          = 0x1E,
+    NCS_OP_JZ           = 0x1F,
+    NCS_OP_RETN         = 0x20,
+    NCS_OP_DESTRUCT     = 0x21,
+    NCS_OP_NOT          = 0x22,
+    NCS_OP_DECSP        = 0x23,
+    NCS_OP_INCSP        = 0x24,
+    NCS_OP_JNZ          = 0x25,
+    NCS_OP_CPDOWNBP     = 0x26,
+    NCS_OP_CPTOPBP      = 0x27,
+    NCS_OP_DECBP        = 0x28,
+    NCS_OP_INCBP        = 0x29,
+    NCS_OP_SAVEBP       = 0x2A,
+    NCS_OP_RESTOREBP    = 0x2B,
+    NCS_OP_STORE_STATE  = 0x2C,
+    NCS_OP_NOP          = 0x2D,
+    NCS_OP_COUNT        = 0x2E         // One past the highest defined opcode
+};
+
+enum NcsQualifier
+{
+    NCS_Q_NONE              = 0x00,
+    NCS_Q_STACK             = 0x01,    // CPDOWNSP/CPTOPSP/MOVSP/DESTRUCT
+    NCS_Q_INT               = 0x03,
+    NCS_Q_FLOAT             = 0x04,
+    NCS_Q_STRING            = 0x05,
+    NCS_Q_OBJECT            = 0x06,
+    NCS_Q_EFFECT            = 0x10,
+    NCS_Q_EVENT             = 0x11,
+    NCS_Q_LOCATION          = 0x12,
+    NCS_Q_TALENT            = 0x13,
+    NCS_Q_INT_INT           = 0x20,
+    NCS_Q_FLOAT_FLOAT       = 0x21,
+    NCS_Q_OBJECT_OBJECT     = 0x22,
+    NCS_Q_STRING_STRING     = 0x23,
+    NCS_Q_STRUCT_STRUCT     = 0x24,
+    NCS_Q_INT_FLOAT         = 0x25,
+    NCS_Q_FLOAT_INT         = 0x26,
+    NCS_Q_EFFECT_EFFECT     = 0x30,
+    NCS_Q_EVENT_EVENT       = 0x31,
+    NCS_Q_LOCATION_LOCATION = 0x32,
+    NCS_Q_TALENT_TALENT     = 0x33,
+    NCS_Q_VECTOR_VECTOR     = 0x3A,
+    NCS_Q_VECTOR_FLOAT      = 0x3B,
+    NCS_Q_FLOAT_VECTOR      = 0x3C
+};
+
+#define NCS_HEADER_SIZE         13      // "NCS " + "V1.0" + 'B' + uint32 size
+#define NCS_HEADER_MAGIC_BYTE   0x42    // Program-size marker at offset 8
+#define NCS_HEADER_SIZE_OFFSET  9       // Big-endian total size field
+#define NCS_STACK_ELEMENT_SIZE  4       // Every stack cell is 4 bytes wide
+#define NCS_JUMP_SIZE           6       // JMP/JSR/JZ/JNZ encoded length
+#define NCS_STORE_STATE_SIZE    10      // STORE_STATE encoded length
+
+enum NcsResult
+{
+    NCS_OK = 0,
+    NCS_ERROR_TRUNCATED,               // Stream ends inside a header or instruction
+    NCS_ERROR_BAD_HEADER,              // Missing "NCS V1.0" signature or magic byte
+    NCS_ERROR_BAD_SIZE,                // Size field larger than the stream
+    NCS_ERROR_BAD_OPCODE,              // Opcode outside the NCSByteCode set
+    NCS_ERROR_BAD_JUMP,                // Jump target is not an instruction boundary
+    NCS_ERROR_OVERFLOW                 // Encoded program does not fit the output buffer
+};
+
+// ============================================================================
+// DECODED INSTRUCTION LIST
+// ============================================================================
+
+/**
+ * @brief One decoded NCS instruction
+ *
+ * Operand meaning depends on the opcode:
+ * - CPDOWNSP/CPTOPSP/CPDOWNBP/CPTOPBP: arg0 = stack offset, arg1 = byte count
+ * - CONSTI/CONSTO: arg0 = value, CONSTF: arg0 = IEEE-754 bits, CONSTS: text
+ * - ACTION: arg0 = routine number, arg1 = argument count
+ * - MOVSP/DECxSP/INCxSP/DECxBP/INCxBP: arg0 = stack offset
+ * - JMP/JSR/JZ/JNZ: jumpTarget = index of the target instruction
+ * - DESTRUCT: arg0 = size, arg1 = offset to keep, arg2 = size to keep
+ * - STORE_STATE: arg0 = BP bytes to save, arg1 = SP bytes to save
+ * - EQUALTT/NEQUALTT: arg0 = struct byte size
+ */
+typedef struct NcsInstruction
+{
+    uint32_t offset;                   // Byte offset in the source stream
+    uint8_t opcode;                    // NcsOpcode
+    uint8_t qualifier;                 // NcsQualifier
+    int32_t arg0;
+    int32_t arg1;
+    int32_t arg2;
+    int32_t jumpTarget;                // Instruction index, -1 when not a jump
+    std::string text;                  // CONSTS payload
+} NcsInstruction;
+
+/**
+ * @brief Decoded NCS program
+ *
+ * Instructions are kept in stream order; jumps refer to instructions by
+ * index so passes can insert and delete without tracking byte offsets.
+ */
+typedef struct NcsProgram
+{
+    std::vector<NcsInstruction> instructions;
+    uint32_t declaredSize;             // Size field read from the header
+} NcsProgram;
+
+// ============================================================================
+// BIG-ENDIAN HELPERS
+// ============================================================================
+
+inline uint32_t ncs_read_be32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+inline uint16_t ncs_read_be16(const uint8_t* p)
+{
+    return (uint16_t)(((uint32_t)p[0] << 8) | (uint32_t)p[1]);
+}
+
+inline void ncs_write_be32(uint8_t* p, uint32_t value)
+{
+    p[0] = (uint8_t)(value >> 24);
+    p[1] = (uint8_t)(value >> 16);
+    p[2] = (uint8_t)(value >> 8);
+    p[3] = (uint8_t)value;
+}
+
+inline void ncs_write_be16(uint8_t* p, uint16_t value)
+{
+    p[0] = (uint8_t)(value >> 8);
+    p[1] = (uint8_t)value;
+}
+
+// ============================================================================
+// INSTRUCTION QUERIES
+// ============================================================================
+
+inline bool ncs_is_jump(uint8_t opcode)
+{
+    return opcode == NCS_OP_JMP || opcode == NCS_OP_JSR || opcode == NCS_OP_JZ || opcode == NCS_OP_JNZ;
+}
+
+/**
+ * @brief True when control never falls through to the next instruction
+ */
+inline bool ncs_is_terminator(uint8_t opcode)
+{
+    return opcode == NCS_OP_JMP || opcode == NCS_OP_RETN;
+}
+
+/**
+ * @brief Operand byte count for an encoded instruction
+ *
+ * @param opcode Instruction opcode
+ * @param qualifier Instruction qualifier
+ * @param operands Pointer to the first operand byte (needed for CONSTS)
+ * @param available Bytes readable at operands
+ * @return Operand size in bytes, or -1 if the opcode is unknown or truncated
+ */
+int ncs_operand_size(uint8_t opcode, uint8_t qualifier, const uint8_t* operands, size_t available);
+
+/**
+ * @brief Encoded size of a decoded instruction (opcode + qualifier + operands)
+ */
+uint32_t ncs_instruction_size(const NcsInstruction* instruction);
+
+/**
+ * @brief Format the NCSInstructionType-style mnemonic (e.g. "ADDII", "DECISP")
+ *
+ * @return Number of characters written, excluding the terminator
+ */
+int ncs_format_mnemonic(uint8_t opcode, uint8_t qualifier, char* buffer, size_t bufferSize);
+
+/**
+ * @brief Base opcode name without the qualifier suffix (e.g. "ADD", "CONST")
+ */
+const char* ncs_opcode_name(uint8_t opcode);
+
+/**
+ * @brief Human-readable description of an NcsResult
+ */
+const char* ncs_result_string(int result);
+
+// ============================================================================
+// DECODE / ENCODE
+// ============================================================================
+
+/**
+ * @brief Decode an "NCS V1.0B" stream into an instruction list
+ *
+ * Validates the header and size field, decodes every instruction up to the
+ * declared size and resolves relative jump offsets to instruction indices.
+ *
+ * @param data Complete NCS file contents
+ * @param size Byte count of data
+ * @param program Receives the decoded instructions
+ * @return NCS_OK or an NcsResult error code
+ */
+int ncs_decode_program(const uint8_t* data, size_t size, NcsProgram* program);
+
+/**
+ * @brief Encode an instruction list back to an "NCS V1.0B" stream
+ *
+ * Recomputes every instruction offset, re-derives relative jump operands
+ * from jumpTarget and writes the header with the new total size.
+ *
+ * @param program Program to encode
+ * @param output Receives the encoded bytes (replaced, not appended)
+ * @return NCS_OK or an NcsResult error code
+ */
+int ncs_encode_program(const NcsProgram* program, std::vector<uint8_t>* output);
+
+/**
+ * @brief Recompute instruction offsets from the current list order
+ *
+ * @return Total encoded size including the header
+ */
+uint32_t ncs_layout_program(NcsProgram* program);
+
+/**
+ * @brief Encoded size of a program including the header, without modifying it
+ */
+uint32_t ncs_program_size(const NcsProgram* program);
+
+#endif // NCS_BYTECODE_H
@@ -0,0 +1,702 @@
+// ============================================================================
+// NCS CONTROL-FLOW RECOVERY
+// ============================================================================
+// Every per-function pass works on local indices (positions in the
+// function's reverse postorder), so dominator intersection compares plain
+// integers and the scratch arrays are reused from one function to the next
+// without being cleared: a stamp array records which blocks belong to the
+// function being analysed.
+// ============================================================================
+
+#include "ncs_cfg.h"
+
+#include <algorithm>
+
+typedef struct NcsCfgScratch
+{
+    std::vector<uint32_t> stamp;       // Function number + 1 of the last function that visited each block
+    std::vector<int32_t> local;        // Local index of each block in the current function
+    std::vector<uint32_t> predStart;   // CSR predecessor lists by local index
+    std::vector<uint32_t> preds;
+    std::vector<int32_t> idom;         // Local immediate dominators
+    std::vector<int32_t> ipdom;        // Local immediate post-dominators (count = virtual exit)
+    std::vector<uint32_t> order;       // DFS work
+    std::vector<uint32_t> cursor;
+} NcsCfgScratch;
+
+// ============================================================================
+// BLOCKS
+// ============================================================================
+
+static void ncs_cfg_split_blocks(const NcsProgram* program, NcsCfg* cfg)
+{
+    const std::vector<NcsInstruction>& instructions = program->instructions;
+    const size_t count = instructions.size();
+
+    std::vector<uint8_t> leader(count + 1, 0);
+    if (count > 0) {
+        leader[0] = 1;
+    }
+    for (size_t i = 0; i < count; i++) {
+        const NcsInstruction& instruction = instructions[i];
+        if (instruction.opcode == NCS_OP_JSR) {
+            if (instruction.jumpTarget >= 0) {
+                leader[instruction.jumpTarget] = 1;
+            }
+            continue;
+        }
+        if (instruction.jumpTarget >= 0) {
+            leader[instruction.jumpTarget] = 1;
+        }
+        if (ncs_is_jump(instruction.opcode) || instruction.opcode == NCS_OP_RETN) {
+            leader[i + 1] = 1;
+        }
+        else if (instruction.opcode == NCS_OP_STORE_STATE && i + 2 <= count) {
+            leader[i + 2] = 1;
+        }
+    }
+
+    size_t blockCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        blockCount += leader[i];
+    }
+    cfg->blocks.reserve(blockCount);
+    cfg->blockOf.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        if (leader[i]) {
+            NcsCfgBlock block;
+            block.first = (uint32_t)i;
+            block.last = (uint32_t)i;
+            block.kind = NCS_CFG_FALLTHROUGH;
+            block.successors[0] = NCS_CFG_NONE;
+            block.successors[1] = NCS_CFG_NONE;
+            block.function = NCS_CFG_NONE;
+            block.idom = NCS_CFG_NONE;
+            block.ipdom = NCS_CFG_NONE;
+            block.loop = NCS_CFG_NONE;
+            block.domPre = 0;
+            block.domPost = 0;
+            cfg->blocks.push_back(block);
+        }
+        cfg->blockOf[i] = (uint32_t)cfg->blocks.size() - 1;
+        cfg->blocks.back().last = (uint32_t)i + 1;
+    }
+
+    for (size_t b = 0; b < cfg->blocks.size(); b++) {
+        NcsCfgBlock& block = cfg->blocks[b];
+        const NcsInstruction& last = instructions[block.last - 1];
+        int32_t next = block.last < count ? (int32_t)cfg->blockOf[block.last] : NCS_CFG_NONE;
+        int32_t target = last.jumpTarget >= 0 ? (int32_t)cfg->blockOf[last.jumpTarget] : NCS_CFG_NONE;
+        switch (last.opcode) {
+            case NCS_OP_JMP:
+                block.kind = NCS_CFG_JUMP;
+                block.successors[0] = target;
+                break;
+            case NCS_OP_JZ: case NCS_OP_JNZ:
+                block.kind = NCS_CFG_CONDITIONAL;
+                block.successors[0] = next;
+                block.successors[1] = target;
+                break;
+            case NCS_OP_RETN:
+                block.kind = NCS_CFG_RETURN;
+                break;
+            default:
+                block.kind = next >= 0 ? NCS_CFG_FALLTHROUGH : NCS_CFG_EXIT;
+                block.successors[0] = next;
+                break;
+        }
+    }
+}
+
+static void ncs_cfg_find_functions(const NcsProgram* program, NcsCfg* cfg)
+{
+    const std::vector<NcsInstruction>& instructions = program->instructions;
+    std::vector<uint8_t> entry(instructions.size(), 0);
+    if (!instructions.empty()) {
+        entry[0] = 1;
+    }
+    for (size_t i = 0; i < instructions.size(); i++) {
+        if (instructions[i].opcode == NCS_OP_JSR && instructions[i].jumpTarget >= 0) {
+            entry[instructions[i].jumpTarget] |= 1;
+        }
+        else if (instructions[i].opcode == NCS_OP_STORE_STATE && i + 2 < instructions.size()) {
+            entry[i + 2] |= 2;
+        }
+    }
+    for (size_t i = 0; i < instructions.size(); i++) {
+        if (entry[i]) {
+            NcsCfgFunction function;
+            function.entry = cfg->blockOf[i];
+            function.deferred = entry[i] == 2;
+            cfg->functions.push_back(function);
+        }
+    }
+}
+
+// ============================================================================
+// DOMINATORS
+// ============================================================================
+
+/**
+ * @brief Reverse postorder of the blocks reachable from a function entry
+ */
+static void ncs_cfg_order_function(NcsCfg* cfg, uint32_t functionIndex, NcsCfgScratch* scratch)
+{
+    NcsCfgFunction& function = cfg->functions[functionIndex];
+    const uint32_t mark = functionIndex + 1;
+    std::vector<uint32_t>& stack = scratch->order;
+    std::vector<uint32_t>& cursor = scratch->cursor;
+    std::vector<uint32_t> postorder;
+
+    stack.clear();
+    cursor.clear();
+    stack.push_back(function.entry);
+    cursor.push_back(0);
+    scratch->stamp[function.entry] = mark;
+    while (!stack.empty()) {
+        const NcsCfgBlock& block = cfg->blocks[stack.back()];
+        uint32_t& next = cursor.back();
+        if (next < 2) {
+            int32_t successor = block.successors[next++];
+            if (successor >= 0 && scratch->stamp[successor] != mark) {
+                scratch->stamp[successor] = mark;
+                stack.push_back((uint32_t)successor);
+                cursor.push_back(0);
+            }
+            continue;
+        }
+        postorder.push_back(stack.back());
+        stack.pop_back();
+        cursor.pop_back();
+    }
+
+    function.blocks.assign(postorder.rbegin(), postorder.rend());
+    for (size_t i = 0; i < function.blocks.size(); i++) {
+        scratch->local[function.blocks[i]] = (int32_t)i;
+        if (cfg->blocks[function.blocks[i]].function == NCS_CFG_NONE) {
+            cfg->blocks[function.blocks[i]].function = (int32_t)functionIndex;
+        }
+    }
+}
+
+static int32_t ncs_cfg_intersect(const std::vector<int32_t>& idom, int32_t a, int32_t b)
+{
+    while (a != b) {
+        while (a > b) {
+            a = idom[a];
+        }
+        while (b > a) {
+            b = idom[b];
+        }
+    }
+    return a;
+}
+
+/**
+ * @brief Cooper-Harvey-Kennedy over the function's reverse postorder
+ */
+static void ncs_cfg_dominators(NcsCfg* cfg, uint32_t functionIndex, NcsCfgScratch* scratch)
+{
+    const NcsCfgFunction& function = cfg->functions[functionIndex];
+    const uint32_t mark = functionIndex + 1;
+    const size_t count = function.blocks.size();
+
+    // Predecessor lists by local index
+    std::vector<uint32_t>& start = scratch->predStart;
+    std::vector<uint32_t>& preds = scratch->preds;
+    start.assign(count + 1, 0);
+    for (size_t i = 0; i < count; i++) {
+        const NcsCfgBlock& block = cfg->blocks[function.blocks[i]];
+        for (int s = 0; s < 2; s++) {
+            if (block.successors[s] >= 0 && scratch->stamp[block.successors[s]] == mark) {
+                start[scratch->local[block.successors[s]] + 1]++;
+            }
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        start[i + 1] += start[i];
+    }
+    preds.resize(start[count]);
+    std::vector<uint32_t> fill(start.begin(), start.end() - 1);
+    for (size_t i = 0; i < count; i++) {
+        const NcsCfgBlock& block = cfg->blocks[function.blocks[i]];
+        for (int s = 0; s < 2; s++) {
+            if (block.successors[s] >= 0 && scratch->stamp[block.successors[s]] == mark) {
+                preds[fill[scratch->local[block.successors[s]]]++] = (uint32_t)i;
+            }
+        }
+    }
+
+    std::vector<int32_t>& idom = scratch->idom;
+    idom.assign(count, NCS_CFG_NONE);
+    idom[0] = 0;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 1; i < count; i++) {
+            int32_t newIdom = NCS_CFG_NONE;
+            for (uint32_t p = start[i]; p < start[i + 1]; p++) {
+                int32_t pred = (int32_t)preds[p];
+                if (idom[pred] == NCS_CFG_NONE) {
+                    continue;
+                }
+                newIdom = newIdom == NCS_CFG_NONE ? pred : ncs_cfg_intersect(idom, pred, newIdom);
+            }
+            if (newIdom != idom[i]) {
+                idom[i] = newIdom;
+                changed = true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Post-dominators: the same algorithm on the reversed graph from a virtual exit
+ *
+ * Blocks that cannot reach a RETN (endless loops) have no post-dominator.
+ */
+static void ncs_cfg_post_dominators(NcsCfg* cfg, uint32_t functionIndex, NcsCfgScratch* scratch)
+{
+    const NcsCfgFunction& function = cfg->functions[functionIndex];
+    const uint32_t mark = functionIndex + 1;
+    const size_t count = function.blocks.size();
+    const std::vector<uint32_t>& start = scratch->predStart;
+    const std::vector<uint32_t>& preds = scratch->preds;
+
+    // Reverse-graph DFS from the exit; the exit's successors are the returning blocks
+    std::vector<uint32_t> exits;
+    for (size_t i = 0; i < count; i++) {
+        uint8_t kind = cfg->blocks[function.blocks[i]].kind;
+        if (kind == NCS_CFG_RETURN || kind == NCS_CFG_EXIT) {
+            exits.push_back((uint32_t)i);
+        }
+    }
+    std::vector<int32_t> number(count + 1, NCS_CFG_NONE);   // Reverse-graph RPO number per local index
+    std::vector<uint32_t> postorder;
+    std::vector<uint32_t>& stack = scratch->order;
+    std::vector<uint32_t>& cursor = scratch->cursor;
+    std::vector<uint8_t> seen(count + 1, 0);
+    stack.assign(1, (uint32_t)count);
+    cursor.assign(1, 0);
+    seen[count] = 1;
+    while (!stack.empty()) {
+        uint32_t node = stack.back();
+        uint32_t& next = cursor.back();
+        uint32_t degree = node == count ? (uint32_t)exits.size() : start[node + 1] - start[node];
+        if (next < degree) {
+            uint32_t successor = node == count ? exits[next] : preds[start[node] + next];
+            next++;
+            if (!seen[successor]) {
+                seen[successor] = 1;
+                stack.push_back(successor);
+                cursor.push_back(0);
+            }
+            continue;
+        }
+        postorder.push_back(node);
+        stack.pop_back();
+        cursor.pop_back();
+    }
+    const size_t reached = postorder.size();
+    std::vector<uint32_t> rpo(postorder.rbegin(), postorder.rend());
+    for (size_t i = 0; i < reached; i++) {
+        number[rpo[i]] = (int32_t)i;
+    }
+
+    // Iterate in reverse-graph RPO; a node's reverse predecessors are its CFG successors
+    std::vector<int32_t> ipdom(reached, NCS_CFG_NONE);
+    ipdom[0] = 0;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 1; i < reached; i++) {
+            const NcsCfgBlock& block = cfg->blocks[function.blocks[rpo[i]]];
+            int32_t newIdom = NCS_CFG_NONE;
+            int32_t candidates[3];
+            int candidateCount = 0;
+            if (block.kind == NCS_CFG_RETURN || block.kind == NCS_CFG_EXIT) {
+                candidates[candidateCount++] = 0;
+            }
+            for (int s = 0; s < 2; s++) {
+                if (block.successors[s] >= 0 && scratch->stamp[block.successors[s]] == mark) {
+                    int32_t n = number[scratch->local[block.successors[s]]];
+                    if (n >= 0) {
+                        candidates[candidateCount++] = n;
+                    }
+                }
+            }
+            for (int c = 0; c < candidateCount; c++) {
+                if (ipdom[candidates[c]] == NCS_CFG_NONE) {
+                    continue;
+                }
+                newIdom = newIdom == NCS_CFG_NONE ? candidates[c] : ncs_cfg_intersect(ipdom, candidates[c], newIdom);
+            }
+            if (newIdom != ipdom[i]) {
+                ipdom[i] = newIdom;
+                changed = true;
+            }
+        }
+    }
+
+    std::vector<int32_t>& result = scratch->ipdom;
+    result.assign(count, NCS_CFG_NONE);
+    for (size_t i = 1; i < reached; i++) {
+        int32_t parent = ipdom[i];
+        result[rpo[i]] = (parent <= 0) ? NCS_CFG_NONE : (int32_t)rpo[parent];
+    }
+}
+
+/**
+ * @brief Store dominator results and number the dominator tree for constant-time queries
+ */
+static void ncs_cfg_store_dominators(NcsCfg* cfg, uint32_t functionIndex, NcsCfgScratch* scratch)
+{
+    const NcsCfgFunction& function = cfg->functions[functionIndex];
+    const size_t count = function.blocks.size();
+    const std::vector<int32_t>& idom = scratch->idom;
+
+    std::vector<uint32_t> childStart(count + 1, 0);
+    for (size_t i = 1; i < count; i++) {
+        childStart[idom[i] + 1]++;
+    }
+    for (size_t i = 0; i < count; i++) {
+        childStart[i + 1] += childStart[i];
+    }
+    std::vector<uint32_t> children(count > 0 ? count - 1 : 0);
+    std::vector<uint32_t> fill(childStart.begin(), childStart.end() - 1);
+    for (size_t i = 1; i < count; i++) {
+        children[fill[idom[i]]++] = (uint32_t)i;
+    }
+
+    std::vector<uint32_t> pre(count, 0);
+    std::vector<uint32_t> post(count, 0);
+    std::vector<uint32_t>& stack = scratch->order;
+    std::vector<uint32_t>& cursor = scratch->cursor;
+    uint32_t preCounter = 0;
+    uint32_t postCounter = 0;
+    stack.assign(1, 0);
+    cursor.assign(1, childStart[0]);
+    pre[0] = preCounter++;
+    while (!stack.empty()) {
+        uint32_t node = stack.back();
+        uint32_t& next = cursor.back();
+        if (next < childStart[node + 1]) {
+            uint32_t child = children[next++];
+            pre[child] = preCounter++;
+            stack.push_back(child);
+            cursor.push_back(childStart[child]);
+            continue;
+        }
+        post[node] = postCounter++;
+        stack.pop_back();
+        cursor.pop_back();
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        NcsCfgBlock& block = cfg->blocks[function.blocks[i]];
+        if (block.function != (int32_t)functionIndex) {
+            continue;
+        }
+        block.idom = i == 0 ? NCS_CFG_NONE : (int32_t)function.blocks[idom[i]];
+        block.ipdom = scratch->ipdom[i] >= 0 ? (int32_t)function.blocks[scratch->ipdom[i]] : NCS_CFG_NONE;
+        block.domPre = pre[i];
+        block.domPost = post[i];
+    }
+}
+
+bool ncs_cfg_dominates(const NcsCfg* cfg, uint32_t a, uint32_t b)
+{
+    const NcsCfgBlock& blockA = cfg->blocks[a];
+    const NcsCfgBlock& blockB = cfg->blocks[b];
+    if (blockA.function == NCS_CFG_NONE || blockA.function != blockB.function) {
+        return false;
+    }
+    return blockA.domPre <= blockB.domPre && blockB.domPost <= blockA.domPost;
+}
+
+// ============================================================================
+// LOOPS AND REGIONS
+// ============================================================================
+
+static void ncs_cfg_find_loops(NcsCfg* cfg, uint32_t functionIndex, NcsCfgScratch* scratch)
+{
+    const NcsCfgFunction& function = cfg->functions[functionIndex];
+    const size_t firstLoop = cfg->loops.size();
+
+    // Back edges, grouped by header; headers come out in reverse postorder
+    std::vector<std::pair<uint32_t, uint32_t> > backEdges;     // (header local, latch local)
+    for (size_t i = 0; i < function.blocks.size(); i++) {
+        const NcsCfgBlock& block = cfg->blocks[function.blocks[i]];
+        if (block.function != (int32_t)functionIndex) {
+            continue;
+        }
+        for (int s = 0; s < 2; s++) {
+            int32_t successor = block.successors[s];
+            if (successor >= 0 && ncs_cfg_dominates(cfg, (uint32_t)successor, function.blocks[i])) {
+                backEdges.push_back(std::make_pair((uint32_t)scratch->local[successor], (uint32_t)i));
+            }
+        }
+    }
+    if (backEdges.empty()) {
+        return;
+    }
+    std::sort(backEdges.begin(), backEdges.end());
+
+    // Natural loop bodies: walk predecessors back from the latches to the header
+    std::vector<uint32_t> inLoop(function.blocks.size(), 0);
+    std::vector<uint32_t> work;
+    for (size_t e = 0; e < backEdges.size();) {
+        uint32_t header = backEdges[e].first;
+        NcsCfgLoop loop;
+        loop.header = function.blocks[header];
+        loop.function = (int32_t)functionIndex;
+        loop.parent = NCS_CFG_NONE;
+        loop.depth = 1;
+        loop.follow = NCS_CFG_NONE;
+        uint32_t loopMark = (uint32_t)cfg->loops.size() + 1;
+        inLoop[header] = loopMark;
+        loop.blocks.push_back(loop.header);
+        work.clear();
+        for (; e < backEdges.size() && backEdges[e].first == header; e++) {
+            uint32_t latch = backEdges[e].second;
+            loop.latches.push_back(function.blocks[latch]);
+            if (inLoop[latch] != loopMark) {
+                inLoop[latch] = loopMark;
+                loop.blocks.push_back(function.blocks[latch]);
+                work.push_back(latch);
+            }
+        }
+        while (!work.empty()) {
+            uint32_t node = work.back();
+            work.pop_back();
+            for (uint32_t p = scratch->predStart[node]; p < scratch->predStart[node + 1]; p++) {
+                uint32_t pred = scratch->preds[p];
+                if (inLoop[pred] != loopMark) {
+                    inLoop[pred] = loopMark;
+                    loop.blocks.push_back(function.blocks[pred]);
+                    work.push_back(pred);
+                }
+            }
+        }
+        std::sort(loop.blocks.begin(), loop.blocks.end());
+        cfg->loops.push_back(loop);
+    }
+
+    // Nesting: visit loops from the largest body down, so each block ends up
+    // in its innermost loop and a loop's parent is whatever held its header
+    std::vector<uint32_t> bySize;
+    for (size_t l = firstLoop; l < cfg->loops.size(); l++) {
+        bySize.push_back((uint32_t)l);
+    }
+    std::stable_sort(bySize.begin(), bySize.end(), [cfg](uint32_t a, uint32_t b) {
+        return cfg->loops[a].blocks.size() > cfg->loops[b].blocks.size();
+    });
+    for (size_t k = 0; k < bySize.size(); k++) {
+        NcsCfgLoop& loop = cfg->loops[bySize[k]];
+        loop.parent = cfg->blocks[loop.header].loop;
+        loop.depth = loop.parent == NCS_CFG_NONE ? 1 : cfg->loops[loop.parent].depth + 1;
+        for (size_t b = 0; b < loop.blocks.size(); b++) {
+            if (cfg->blocks[loop.blocks[b]].function == (int32_t)functionIndex) {
+                cfg->blocks[loop.blocks[b]].loop = (int32_t)bySize[k];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Whether a block lies in a loop body (bodies are sorted)
+ */
+static bool ncs_cfg_in_loop(const NcsCfgLoop* loop, int32_t block)
+{
+    return block >= 0 && std::binary_search(loop->blocks.begin(), loop->blocks.end(), (uint32_t)block);
+}
+
+/**
+ * @brief Successor of a conditional block that leaves the loop, or NCS_CFG_NONE
+ */
+static int32_t ncs_cfg_loop_exit(const NcsCfgLoop* loop, const NcsCfgBlock* block)
+{
+    if (block->kind != NCS_CFG_CONDITIONAL) {
+        return NCS_CFG_NONE;
+    }
+    bool in0 = ncs_cfg_in_loop(loop, block->successors[0]);
+    bool in1 = ncs_cfg_in_loop(loop, block->successors[1]);
+    if (in0 == in1) {
+        return NCS_CFG_NONE;
+    }
+    return in0 ? block->successors[1] : block->successors[0];
+}
+
+static void ncs_cfg_loop_region(NcsCfg* cfg, uint32_t loopIndex, std::vector<uint8_t>* loopCondition)
+{
+    NcsCfgLoop& loop = cfg->loops[loopIndex];
+    const NcsCfgBlock& header = cfg->blocks[loop.header];
+
+    NcsCfgRegion region;
+    region.kind = NCS_CFG_REGION_ENDLESS;
+    region.structured = true;
+    region.inverted = false;
+    region.head = loop.header;
+    region.thenBlock = NCS_CFG_NONE;
+    region.elseBlock = NCS_CFG_NONE;
+    region.follow = NCS_CFG_NONE;
+    region.loop = (int32_t)loopIndex;
+
+    int32_t exit = ncs_cfg_loop_exit(&loop, &header);
+    if (exit != NCS_CFG_NONE && loop.blocks.size() > 1) {
+        region.kind = NCS_CFG_REGION_WHILE;
+        region.follow = exit;
+        region.thenBlock = header.successors[0] == exit ? header.successors[1] : header.successors[0];
+        (*loopCondition)[loop.header] = 1;
+    }
+    else {
+        for (size_t l = 0; l < loop.latches.size(); l++) {
+            exit = ncs_cfg_loop_exit(&loop, &cfg->blocks[loop.latches[l]]);
+            if (exit != NCS_CFG_NONE) {
+                region.kind = NCS_CFG_REGION_DO_WHILE;
+                region.follow = exit;
+                region.thenBlock = (int32_t)loop.header;
+                (*loopCondition)[loop.latches[l]] = 1;
+                break;
+            }
+        }
+    }
+    if (region.kind == NCS_CFG_REGION_ENDLESS) {
+        region.thenBlock = (int32_t)loop.header;
+    }
+
+    // Every other exit edge must land on the follow, or it becomes a goto
+    for (size_t b = 0; b < loop.blocks.size(); b++) {
+        const NcsCfgBlock& block = cfg->blocks[loop.blocks[b]];
+        for (int s = 0; s < 2; s++) {
+            int32_t successor = block.successors[s];
+            if (successor < 0 || ncs_cfg_in_loop(&loop, successor)) {
+                continue;
+            }
+            if (region.follow == NCS_CFG_NONE) {
+                region.follow = successor;
+            }
+            else if (successor != region.follow) {
+                region.structured = false;
+            }
+        }
+    }
+    loop.follow = region.follow;
+    cfg->regions.push_back(region);
+}
+
+static void ncs_cfg_conditional_region(NcsCfg* cfg, const NcsProgram* program, uint32_t blockIndex)
+{
+    const NcsCfgBlock& block = cfg->blocks[blockIndex];
+    const int32_t fall = block.successors[0];
+    const int32_t target = block.successors[1];
+    const bool jumpsOnZero = program->instructions[block.last - 1].opcode == NCS_OP_JZ;
+
+    NcsCfgRegion region;
+    region.head = blockIndex;
+    region.follow = block.ipdom;
+    region.loop = NCS_CFG_NONE;
+    region.elseBlock = NCS_CFG_NONE;
+
+    // The arm that runs when the condition is true comes first in source:
+    // the fall-through of JZ, the target of JNZ
+    int32_t whenTrue = jumpsOnZero ? fall : target;
+    int32_t whenFalse = jumpsOnZero ? target : fall;
+    if (whenFalse == region.follow) {
+        region.kind = NCS_CFG_REGION_IF_THEN;
+        region.thenBlock = whenTrue;
+        region.inverted = false;
+    }
+    else if (whenTrue == region.follow) {
+        region.kind = NCS_CFG_REGION_IF_THEN;
+        region.thenBlock = whenFalse;
+        region.inverted = true;
+    }
+    else {
+        region.kind = NCS_CFG_REGION_IF_THEN_ELSE;
+        region.thenBlock = whenTrue;
+        region.elseBlock = whenFalse;
+        region.inverted = false;
+    }
+
+    // Single entry, single exit: the merge point is only reachable through the head
+    region.structured = region.follow == NCS_CFG_NONE || ncs_cfg_dominates(cfg, blockIndex, (uint32_t)region.follow);
+    cfg->regions.push_back(region);
+}
+
+// ============================================================================
+// BUILD
+// ============================================================================
+
+void ncs_cfg_build(const NcsProgram* program, NcsCfg* cfg)
+{
+    cfg->blocks.clear();
+    cfg->blockOf.clear();
+    cfg->functions.clear();
+    cfg->loops.clear();
+    cfg->regions.clear();
+    if (program->instructions.empty()) {
+        return;
+    }
+
+    ncs_cfg_split_blocks(program, cfg);
+    ncs_cfg_find_functions(program, cfg);
+
+    NcsCfgScratch scratch;
+    scratch.stamp.assign(cfg->blocks.size(), 0);
+    scratch.local.assign(cfg->blocks.size(), NCS_CFG_NONE);
+    for (uint32_t f = 0; f < cfg->functions.size(); f++) {
+        ncs_cfg_order_function(cfg, f, &scratch);
+        ncs_cfg_dominators(cfg, f, &scratch);
+        ncs_cfg_post_dominators(cfg, f, &scratch);
+        ncs_cfg_store_dominators(cfg, f, &scratch);
+        ncs_cfg_find_loops(cfg, f, &scratch);
+    }
+
+    std::vector<uint8_t> loopCondition(cfg->blocks.size(), 0);
+    for (uint32_t l = 0; l < cfg->loops.size(); l++) {
+        ncs_cfg_loop_region(cfg, l, &loopCondition);
+    }
+    for (uint32_t b = 0; b < cfg->blocks.size(); b++) {
+        if (cfg->blocks[b].kind == NCS_CFG_CONDITIONAL && cfg->blocks[b].function != NCS_CFG_NONE &&
+            !loopCondition[b]) {
+            ncs_cfg_conditional_region(cfg, program, b);
+        }
+    }
+    std::stable_sort(cfg->regions.begin(), cfg->regions.end(), [](const NcsCfgRegion& a, const NcsCfgRegion& b) {
+        return a.head < b.head;
+    });
+}
+
+// ============================================================================
+// DEBUG OUTPUT
+// ============================================================================
+
+void ncs_cfg_print(const NcsCfg* cfg, FILE* stream)
+{
+    static const char* const blockKinds[] = { "fall", "jump", "cond", "return", "exit" };
+    static const char* const regionKinds[] = { "if", "if-else", "while", "do-while", "endless" };
+
+    for (size_t f = 0; f < cfg->functions.size(); f++) {
+        const NcsCfgFunction& function = cfg->functions[f];
+        fprintf(stream, "function %zu entry B%u%s (%zu blocks)\n", f, function.entry,
+                function.deferred ? " deferred" : "", function.blocks.size());
+        for (size_t i = 0; i < function.blocks.size(); i++) {
+            const NcsCfgBlock& block = cfg->blocks[function.blocks[i]];
+            fprintf(stream, "  B%u [%u,%u) %s succ %d %d idom %d ipdom %d loop %d\n", function.blocks[i],
+                    block.first, block.last, blockKinds[block.kind], block.successors[0], block.successors[1],
+                    block.idom, block.ipdom, block.loop);
+        }
+    }
+    for (size_t l = 0; l < cfg->loops.size(); l++) {
+        const NcsCfgLoop& loop = cfg->loops[l];
+        fprintf(stream, "loop %zu header B%u depth %u parent %d follow %d (%zu blocks, %zu latches)\n", l,
+                loop.header, loop.depth, loop.parent, loop.follow, loop.blocks.size(), loop.latches.size());
+    }
+    for (size_t r = 0; r < cfg->regions.size(); r++) {
+        const NcsCfgRegion& region = cfg->regions[r];
+        fprintf(stream, "region %s head B%u then %d else %d follow %d%s%s\n", regionKinds[region.kind], region.head,
+                region.thenBlock, region.elseBlock, region.follow, region.inverted ? " inverted" : "",
+                region.structured ? "" : " unstructured");
+    }
+}
@@ -0,0 +1,123 @@
+// ============================================================================
+// NCS CONTROL-FLOW RECOVERY
+// ============================================================================
+// Basic blocks, dominators, loops and structured regions of a decoded
+// program, as needed to decompile NCS back to NSS.
+//
+// Blocks split at jump targets and after JMP/JZ/JNZ/RETN. JSR is a call,
+// not a transfer: it stays inside its block, and its target starts a new
+// function. Functions are entered at the program start, at every JSR
+// target and at every STORE_STATE deferred block (STORE_STATE + 2), and
+// each function gets its own reverse postorder, dominator and
+// post-dominator trees (Cooper-Harvey-Kennedy: a few passes over the
+// reverse postorder, near-linear on the reducible graphs compilers emit).
+//
+// Loops are natural loops of back edges (an edge to a dominator), merged by
+// header and nested by containment. Regions describe how each
+// conditional block should be written: an if/else whose arms meet at the
+// block's immediate post-dominator, or the condition of a while or
+// do-while loop. A region is flagged unstructured when the decompiler will
+// need a goto or break to express it.
+// ============================================================================
+
+#ifndef NCS_CFG_H
+#define NCS_CFG_H
+
+#include <stdio.h>
+
+#include "ncs_bytecode.h"
+
+#define NCS_CFG_NONE  (-1)             // No block, loop or dominator
+
+enum NcsCfgBlockKind
+{
+    NCS_CFG_FALLTHROUGH = 0,           // Continues into the next block
+    NCS_CFG_JUMP,                      // Ends in JMP
+    NCS_CFG_CONDITIONAL,               // Ends in JZ/JNZ: successors[0] falls through, successors[1] is the target
+    NCS_CFG_RETURN,                    // Ends in RETN
+    NCS_CFG_EXIT                       // Runs off the end of the program
+};
+
+enum NcsCfgRegionKind
+{
+    NCS_CFG_REGION_IF_THEN = 0,
+    NCS_CFG_REGION_IF_THEN_ELSE,
+    NCS_CFG_REGION_WHILE,              // Loop tested at the header
+    NCS_CFG_REGION_DO_WHILE,           // Loop tested at a latch
+    NCS_CFG_REGION_ENDLESS             // Loop left only by jumps out of the body (or never)
+};
+
+typedef struct NcsCfgBlock
+{
+    uint32_t first;                    // First instruction index
+    uint32_t last;                     // One past the last instruction index
+    uint8_t kind;                      // NcsCfgBlockKind
+    int32_t successors[2];             // Block indices, NCS_CFG_NONE when absent
+    int32_t function;                  // Function that reaches the block first, NCS_CFG_NONE if unreachable
+    int32_t idom;                      // Immediate dominator, NCS_CFG_NONE for entries and unreachable blocks
+    int32_t ipdom;                     // Immediate post-dominator, NCS_CFG_NONE if it is the function exit
+    int32_t loop;                      // Innermost loop containing the block, NCS_CFG_NONE
+    uint32_t domPre;                   // Dominator-tree preorder number (within the function)
+    uint32_t domPost;                  // Dominator-tree postorder number (within the function)
+} NcsCfgBlock;
+
+typedef struct NcsCfgFunction
+{
+    uint32_t entry;                    // Entry block
+    bool deferred;                     // Entered as a STORE_STATE deferred block
+    std::vector<uint32_t> blocks;      // Reachable blocks in reverse postorder (blocks[0] == entry)
+} NcsCfgFunction;
+
+typedef struct NcsCfgLoop
+{
+    uint32_t header;                   // Header block (dominates the body)
+    int32_t function;
+    int32_t parent;                    // Enclosing loop, NCS_CFG_NONE
+    uint32_t depth;                    // 1 for outermost loops
+    int32_t follow;                    // Block control reaches on leaving the loop, NCS_CFG_NONE
+    std::vector<uint32_t> latches;     // Sources of the back edges
+    std::vector<uint32_t> blocks;      // Body blocks, ascending (header included)
+} NcsCfgLoop;
+
+typedef struct NcsCfgRegion
+{
+    uint8_t kind;                      // NcsCfgRegionKind
+    bool structured;                   // Expressible without goto/break
+    bool inverted;                     // Then arm runs when the condition is zero
+    uint32_t head;                     // Conditional block (loop header for loops)
+    int32_t thenBlock;                 // Then arm or loop body entry, NCS_CFG_NONE
+    int32_t elseBlock;                 // Else arm, NCS_CFG_NONE
+    int32_t follow;                    // Block after the region, NCS_CFG_NONE if every path returns
+    int32_t loop;                      // Loop index for loop regions, NCS_CFG_NONE
+} NcsCfgRegion;
+
+typedef struct NcsCfg
+{
+    std::vector<NcsCfgBlock> blocks;   // In instruction order
+    std::vector<uint32_t> blockOf;     // Block index per instruction
+    std::vector<NcsCfgFunction> functions; // Ordered by entry instruction
+    std::vector<NcsCfgLoop> loops;
+    std::vector<NcsCfgRegion> regions; // Ordered by head block
+} NcsCfg;
+
+/**
+ * @brief Recover blocks, dominators, loops and regions
+ *
+ * Runs in time close to linear in the instruction count.
+ *
+ * @param program Decoded program (jumpTarget resolved)
+ * @param cfg Receives the graph (replaced)
+ */
+void ncs_cfg_build(const NcsProgram* program, NcsCfg* cfg);
+
+/**
+ * @brief Whether block a dominates block b (both in a's function; constant time)
+ */
+bool ncs_cfg_dominates(const NcsCfg* cfg, uint32_t a, uint32_t b);
+
+/**
+ * @brief Print functions, blocks, loops and regions for debugging
+ */
+void ncs_cfg_print(const NcsCfg* cfg, FILE* stream);
+
+#endif // NCS_CFG_H
@@ -0,0 +1,1216 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - THREADED INTERPRETER
+// ============================================================================
+
+#include "ncs_vm.h"
+#include "ncs_vm_native.h"
+#include "ncs_vm_profiler.h"
+#include "ncs_vm_trace.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+
+#ifndef NCS_VM_THREADED_DISPATCH
+#if defined(__GNUC__) || defined(__clang__)
+#define NCS_VM_THREADED_DISPATCH 1     // Labels-as-values: one indirect jump per instruction
+#else
+#define NCS_VM_THREADED_DISPATCH 0     // Portable switch dispatch
+#endif
+#endif
+
+// ============================================================================
+// LIFECYCLE AND REGISTRATION
+// ============================================================================
+
+void ncs_vm_init(NcsVm* vm, uint32_t stackCells)
+{
+    vm->stack.assign(stackCells != 0 ? stackCells : NCS_VM_DEFAULT_STACK_CELLS, NcsVmValue());
+    vm->actions.clear();
+    vm->defaultAction.handler = NULL;
+    vm->defaultAction.userData = NULL;
+    vm->objectSelf = NCS_VM_OBJECT_SELF;
+    vm->commands = NULL;
+    vm->profiler = NULL;
+    vm->recorder = NULL;
+    vm->budgetInstructions = 0;
+    vm->budgetMicroseconds = 0;
+    ncs_vm_reset(vm);
+}
+
+void ncs_vm_reset(NcsVm* vm)
+{
+    vm->sp = 0;
+    vm->bp = 0;
+    vm->returns.clear();
+    vm->strings.assign(1, std::string());
+    vm->stringProgram = 0;
+    vm->stringBase = 0;
+    vm->storedState.resumeIndex = 0;
+    vm->storedState.globals.reset();
+    vm->storedState.locals.values.clear();
+    vm->storedState.locals.strings.clear();
+    vm->globalsSegment.reset();
+    vm->globalsBase = 0;
+    vm->globalsDirty = 1;
+    vm->hasStoredState = 0;
+    vm->sliceInstructions = 0;
+    vm->sliceDeadline = 0;
+    vm->suspendedProgram = NULL;
+    vm->resumeIndex = 0;
+    vm->suspendedChecked = 0;
+    vm->errorOffset = 0;
+}
+
+void ncs_vm_set_budget(NcsVm* vm, uint64_t instructions, uint64_t microseconds)
+{
+    vm->budgetInstructions = instructions;
+    vm->budgetMicroseconds = microseconds;
+}
+
+void ncs_vm_register_action(NcsVm* vm, uint16_t routine, NcsVmActionHandler handler, void* userData)
+{
+    if (vm->actions.size() <= routine) {
+        NcsVmAction none = { NULL, NULL };
+        vm->actions.resize((size_t)routine + 1, none);
+    }
+    vm->actions[routine].handler = handler;
+    vm->actions[routine].userData = userData;
+}
+
+void ncs_vm_set_default_action(NcsVm* vm, NcsVmActionHandler handler, void* userData)
+{
+    vm->defaultAction.handler = handler;
+    vm->defaultAction.userData = userData;
+}
+
+const char* ncs_vm_result_string(int result)
+{
+    switch (result) {
+        case NCS_VM_OK:                    return "ok";
+        case NCS_VM_ERROR_BAD_PROGRAM:     return "invalid NCS V1.0B header or size";
+        case NCS_VM_ERROR_BAD_OPCODE:      return "unknown opcode or qualifier";
+        case NCS_VM_ERROR_BAD_JUMP:        return "control transfer outside the code";
+        case NCS_VM_ERROR_STACK_OVERFLOW:  return "stack overflow";
+        case NCS_VM_ERROR_STACK_UNDERFLOW: return "stack access out of bounds";
+        case NCS_VM_ERROR_BAD_OFFSET:      return "stack offset is not cell aligned";
+        case NCS_VM_ERROR_DIVIDE_BY_ZERO:  return "integer division by zero";
+        case NCS_VM_ERROR_TYPE_MISMATCH:   return "value has the wrong type";
+        case NCS_VM_ERROR_UNKNOWN_ACTION:  return "no handler for ACTION routine";
+        case NCS_VM_ERROR_ACTION_FAILED:   return "ACTION handler failed";
+        case NCS_VM_ERROR_NO_STORED_STATE: return "no STORE_STATE pending for action argument";
+        case NCS_VM_ERROR_END_OF_CODE:     return "execution ran past the last instruction";
+        case NCS_VM_ERROR_UNBALANCED:      return "stack depth differs where control flow merges";
+        case NCS_VM_ERROR_UNSUPPORTED:     return "control flow the verifier cannot prove (recursion or shared code)";
+        case NCS_VM_ERROR_ACTION_SIGNATURE: return "ACTION handler stack effect differs from its signature";
+        case NCS_VM_ERROR_NOT_SUSPENDED:   return "no suspended run to resume";
+        case NCS_VM_ERROR_TRACE_MISMATCH:  return "replay diverged from the recorded trace";
+        case NCS_VM_SUSPENDED:             return "suspended: slice budget used up";
+        default:                           return "unknown error";
+    }
+}
+
+const char* ncs_vm_op_name(int op)
+{
+    static const char* const names[NCS_VM_OP_COUNT] = {
+        "CPDOWNSP", "RSADD", "CPTOPSP", "CONST", "CONSTS", "CONSTO", "ACTION",
+        "LOGANDII", "LOGORII", "INCORII", "EXCORII", "BOOLANDII",
+        "EQUAL", "EQUALFF", "EQUALSS", "EQUALTT",
+        "NEQUAL", "NEQUALFF", "NEQUALSS", "NEQUALTT",
+        "GEQII", "GEQFF", "GTII", "GTFF", "LTII", "LTFF", "LEQII", "LEQFF",
+        "SHLEFTII", "SHRIGHTII", "USHRIGHTII",
+        "ADDII", "ADDIF", "ADDFI", "ADDFF", "ADDSS", "ADDVV",
+        "SUBII", "SUBIF", "SUBFI", "SUBFF", "SUBVV",
+        "MULII", "MULIF", "MULFI", "MULFF", "MULVF", "MULFV",
+        "DIVII", "DIVIF", "DIVFI", "DIVFF", "DIVVF",
+        "MODII", "NEGI", "NEGF", "COMPI", "MOVSP",
+        "JMP", "JSR", "JZ", "JNZ", "RETN", "DESTRUCT", "NOTI",
+        "DECSP", "INCSP", "CPDOWNBP", "CPTOPBP", "DECBP", "INCBP",
+        "SAVEBP", "RESTOREBP", "STORE_STATE", "NOP",
+        "CPDOWNSP_MOVSP", "CONST_CPDOWNSP_MOVSP", "CPTOPSP_CONST_ADDII_CPDOWNSP_MOVSP",
+        "CPTOPSP_JZ", "CPTOPSP_JNZ", "COMPAREII_JZ", "CPTOPSP_CONST_COMPAREII_JZ",
+        "END"
+    };
+    return (op >= 0 && op < NCS_VM_OP_COUNT) ? names[op] : "???";
+}
+
+// ============================================================================
+// VALUE HELPERS
+// ============================================================================
+
+uint32_t ncs_vm_new_string(NcsVm* vm, const std::string& text)
+{
+    vm->strings.push_back(text);
+    return (uint32_t)vm->strings.size() - 1;
+}
+
+const std::string& ncs_vm_string(const NcsVm* vm, uint32_t handle)
+{
+    return handle < vm->strings.size() ? vm->strings[handle] : vm->strings[0];
+}
+
+bool ncs_vm_values_equal(const NcsVm* vm, const NcsVmValue* a, const NcsVmValue* b)
+{
+    if (a->type == NCS_VM_TYPE_STRING && b->type == NCS_VM_TYPE_STRING) {
+        return ncs_vm_string(vm, a->value.handle) == ncs_vm_string(vm, b->value.handle);
+    }
+    if (a->type == NCS_VM_TYPE_FLOAT && b->type == NCS_VM_TYPE_FLOAT) {
+        return a->value.f == b->value.f;
+    }
+    return a->value.i == b->value.i;
+}
+
+/**
+ * @brief Evaluate the int comparison a fused COMPAREII operation carries
+ *
+ * @param op NCS_VM_OP_EQUAL, NEQUAL, GEQII, GTII, LTII or LEQII
+ */
+static inline bool ncs_vm_compare_ii(uint8_t op, int32_t l, int32_t r)
+{
+    switch (op) {
+        case NCS_VM_OP_EQUAL:  return l == r;
+        case NCS_VM_OP_NEQUAL: return l != r;
+        case NCS_VM_OP_GEQII:  return l >= r;
+        case NCS_VM_OP_GTII:   return l > r;
+        case NCS_VM_OP_LTII:   return l < r;
+        default:               return l <= r;
+    }
+}
+
+void ncs_vm_copy_cells(const NcsVm* vm, const NcsVmValue* cells, size_t count, NcsVmCells* copy)
+{
+    copy->values.assign(cells, cells + count);
+    copy->strings.clear();
+    for (size_t k = 0; k < count; k++) {
+        if (cells[k].type == NCS_VM_TYPE_STRING) {
+            copy->strings.push_back(ncs_vm_string(vm, cells[k].value.handle));
+            copy->values[k].value.handle = (uint32_t)(copy->strings.size() - 1);
+        }
+    }
+}
+
+/**
+ * @brief Write copied cells to the stack, interning their strings into the pool
+ */
+static void ncs_vm_restore_cells(NcsVm* vm, const NcsVmCells* copy, NcsVmValue* stack)
+{
+    std::copy(copy->values.begin(), copy->values.end(), stack);
+    for (size_t k = 0; k < copy->values.size(); k++) {
+        if (stack[k].type == NCS_VM_TYPE_STRING) {
+            uint32_t index = stack[k].value.handle;
+            stack[k].value.handle = ncs_vm_new_string(vm, index < copy->strings.size() ? copy->strings[index]
+                                                                                        : std::string());
+        }
+    }
+}
+
+/**
+ * @brief Capture the BP and SP regions named by a STORE_STATE
+ *
+ * The globals are shared with the last captured segment when nothing
+ * below BP was written since (vm->globalsDirty) and the segment covers
+ * the same cells, so a capture costs O(1) for the globals instead of an
+ * allocation and a copy per deferred action; the local slice is always
+ * copied.
+ */
+int ncs_vm_store_state(NcsVm* vm, uint32_t resumeIndex, uint32_t globalCells, uint32_t localCells)
+{
+    if (globalCells > vm->bp || localCells > vm->sp) {
+        return NCS_VM_ERROR_STACK_UNDERFLOW;
+    }
+
+    const NcsVmValue* stack = vm->stack.data();
+    const NcsVmValue* globals = stack + vm->bp - globalCells;
+    if (globalCells == 0) {
+        vm->storedState.globals.reset();
+    }
+    else {
+        uint32_t base = vm->bp - globalCells;
+        if (vm->globalsDirty || !vm->globalsSegment || vm->globalsBase != base ||
+            vm->globalsSegment->values.size() != globalCells) {
+            NcsVmCells* segment = new NcsVmCells();
+            ncs_vm_copy_cells(vm, globals, globalCells, segment);
+            vm->globalsSegment.reset(segment);
+            vm->globalsBase = base;
+            vm->globalsDirty = 0;
+        }
+        vm->storedState.globals = vm->globalsSegment;
+    }
+    vm->storedState.resumeIndex = resumeIndex;
+    ncs_vm_copy_cells(vm, stack + vm->sp - localCells, localCells, &vm->storedState.locals);
+    vm->hasStoredState = 1;
+    return NCS_VM_OK;
+}
+
+// ============================================================================
+// SLICE BUDGETS
+// ============================================================================
+
+static uint64_t ncs_vm_clock_ns()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void ncs_vm_begin_slice(NcsVm* vm)
+{
+    vm->sliceInstructions = 0;
+    vm->sliceDeadline = vm->budgetMicroseconds != 0 ? ncs_vm_clock_ns() + vm->budgetMicroseconds * 1000 : 0;
+}
+
+/**
+ * @brief Instructions the dispatch loop may run before consulting the budget again
+ *
+ * @return 0 when the slice is used up
+ */
+static int64_t ncs_vm_next_fuel(const NcsVm* vm)
+{
+    const int64_t unlimited = INT64_MAX / 2;
+    if (vm->budgetInstructions != 0 && vm->sliceInstructions >= vm->budgetInstructions) {
+        return 0;
+    }
+    if (vm->sliceDeadline != 0 && vm->sliceInstructions != 0 && ncs_vm_clock_ns() >= vm->sliceDeadline) {
+        return 0;
+    }
+    int64_t fuel = vm->sliceDeadline != 0 ? NCS_VM_CLOCK_INTERVAL : unlimited;
+    if (vm->budgetInstructions != 0 && vm->budgetInstructions - vm->sliceInstructions < (uint64_t)fuel) {
+        fuel = (int64_t)(vm->budgetInstructions - vm->sliceInstructions);
+    }
+    return fuel;
+}
+
+// ============================================================================
+// DISPATCH LOOP
+// ============================================================================
+
+/**
+ * @brief Reclaim the string pool for a new run and make the program's CONSTS literals addressable
+ *
+ * Everything a previous run interned is dropped; only "" and the
+ * program's literals stay, and the literals are kept across runs of the
+ * same program (keyed by its load id, not its address), so CONSTS pushes
+ * stringBase + literal index without touching the pool. String cells the
+ * host left in [0, liveCells) are re-interned.
+ */
+static void ncs_vm_bind_strings(NcsVm* vm, const NcsVmProgram* program, uint32_t liveCells)
+{
+    bool bound = vm->stringProgram == program->id;
+    uint32_t keep = bound ? vm->stringBase + (uint32_t)program->strings.size() : 1;
+    uint32_t literalsEnd = (bound ? vm->stringBase : 1) + (uint32_t)program->strings.size();
+
+    std::vector<std::string> live;
+    NcsVmValue* stack = vm->stack.data();
+    for (uint32_t i = 0; i < liveCells; i++) {
+        if (stack[i].type == NCS_VM_TYPE_STRING && stack[i].value.handle >= keep) {
+            live.push_back(ncs_vm_string(vm, stack[i].value.handle));
+            stack[i].value.handle = literalsEnd + (uint32_t)live.size() - 1;
+        }
+    }
+
+    vm->strings.resize(keep);
+    if (!bound) {
+        vm->stringBase = 1;
+        vm->strings.insert(vm->strings.end(), program->strings.begin(), program->strings.end());
+        vm->stringProgram = program->id;
+    }
+    vm->strings.insert(vm->strings.end(), live.begin(), live.end());
+}
+
+/**
+ * @brief Execute from instruction startIndex until the outermost RETN or the end of the slice
+ *
+ * SP and BP live in locals for the duration of the loop and are written
+ * back before ACTION handlers run and when the loop exits. The slice
+ * budget is charged per straight-line block when control transfers (the
+ * block's length is the distance from segment), so straight-line code
+ * pays nothing; a run suspends at the transfer's target. The profiled
+ * instantiation also charges each block to the innermost profiler frame
+ * and tracks JSR/RETN frames. Opcodes,
+ * operand alignment and jump targets were validated by ncs_vm_load, so
+ * only stack bounds are checked here, and only when checked is true.
+ * The unchecked instantiation is used for programs proven safe by
+ * ncs_vm_verify; it still checks ACTION handlers against their verified
+ * stack effect, since handlers are host code.
+ */
+template <bool checked, bool profiled>
+static int ncs_vm_execute(NcsVm* vm, const NcsVmProgram* program, uint32_t startIndex)
+{
+    NcsVmProfiler* const profiler = vm->profiler;
+    NcsVmValue* stack = vm->stack.data();
+    const uint32_t capacity = (uint32_t)vm->stack.size();
+    const NcsVmInstruction* const code = program->code.data();
+    const NcsVmInstruction* ip = code + startIndex;
+    const uint32_t stringBase = vm->stringBase;
+    uint32_t sp = vm->sp;
+    uint32_t bp = vm->bp;
+    int result = NCS_VM_OK;
+    const NcsVmInstruction* segment = ip; // First instruction of the current straight-line block
+    int64_t chunk = ncs_vm_next_fuel(vm);
+    int64_t fuel = chunk;
+
+#define VM_FAIL(error_) do { result = (error_); goto vm_exit; } while (0)
+    // Fail on step k_ of a superinstruction so errorOffset names the original instruction
+#define VM_FAIL_AT(k_, error_) do { ip += (k_); VM_FAIL(error_); } while (0)
+    // Bounds checks; compiled out of the unchecked instantiation
+#define VM_CHECK(k_, failed_, error_) do { if (checked && (failed_)) VM_FAIL_AT(k_, error_); } while (0)
+#define VM_NEED_CELLS(n_) VM_CHECK(0, sp < (uint32_t)(n_), NCS_VM_ERROR_STACK_UNDERFLOW)
+#define VM_ROOM_CELLS(n_) VM_CHECK(0, capacity - sp < (uint32_t)(n_), NCS_VM_ERROR_STACK_OVERFLOW)
+
+    // Resolve a cell offset relative to base_ into an index covering cells_ cells
+#define VM_CELL_INDEX(index_, base_, offset_, cells_)                                    \
+    do {                                                                                 \
+        int64_t cell_ = (int64_t)(base_) + (offset_);                                    \
+        VM_CHECK(0, cell_ < 0 || cell_ + (cells_) > (int64_t)sp, NCS_VM_ERROR_STACK_UNDERFLOW); \
+        (index_) = (uint32_t)cell_;                                                      \
+    } while (0)
+
+    // Binary operators on the two top cells; l and r are the operands
+#define VM_BINARY(ltype_, lfield_, rtype_, rfield_, outType_, outField_, expr_)         \
+    do {                                                                                 \
+        VM_NEED_CELLS(2);                                                                \
+        ltype_ l = stack[sp - 2].value.lfield_;                                          \
+        rtype_ r = stack[sp - 1].value.rfield_;                                          \
+        sp--;                                                                            \
+        stack[sp - 1].type = (outType_);                                                 \
+        stack[sp - 1].value.outField_ = (expr_);                                         \
+    } while (0)
+#define VM_BINARY_II(expr_) VM_BINARY(int32_t, i, int32_t, i, NCS_VM_TYPE_INT, i, expr_)
+#define VM_BINARY_FF(expr_) VM_BINARY(float, f, float, f, NCS_VM_TYPE_FLOAT, f, expr_)
+#define VM_BINARY_IF(expr_) VM_BINARY(int32_t, i, float, f, NCS_VM_TYPE_FLOAT, f, expr_)
+#define VM_BINARY_FI(expr_) VM_BINARY(float, f, int32_t, i, NCS_VM_TYPE_FLOAT, f, expr_)
+#define VM_COMPARE_II(expr_) VM_BINARY(int32_t, i, int32_t, i, NCS_VM_TYPE_INT, i, (expr_) ? 1 : 0)
+#define VM_COMPARE_FF(expr_) VM_BINARY(float, f, float, f, NCS_VM_TYPE_INT, i, (expr_) ? 1 : 0)
+
+    // Vector (3 cells) with vector or float operands
+#define VM_VECTOR_VV(op_)                                                                \
+    do {                                                                                 \
+        VM_NEED_CELLS(6);                                                                \
+        for (int k_ = 0; k_ < 3; k_++) {                                                 \
+            stack[sp - 6 + k_].value.f = stack[sp - 6 + k_].value.f op_ stack[sp - 3 + k_].value.f; \
+        }                                                                                \
+        sp -= 3;                                                                         \
+    } while (0)
+#define VM_VECTOR_VF(op_)                                                                \
+    do {                                                                                 \
+        VM_NEED_CELLS(4);                                                                \
+        float scalar_ = stack[sp - 1].value.f;                                           \
+        for (int k_ = 0; k_ < 3; k_++) {                                                 \
+            stack[sp - 4 + k_].value.f = stack[sp - 4 + k_].value.f op_ scalar_;         \
+        }                                                                                \
+        sp -= 1;                                                                         \
+    } while (0)
+
+    // Equality over count_ cells per operand; expect_ is true for EQUAL
+#define VM_EQUALITY(count_, expect_, compare_)                                           \
+    do {                                                                                 \
+        uint32_t cells_ = (count_);                                                      \
+        VM_NEED_CELLS(2 * cells_);                                                       \
+        bool equal_ = true;                                                              \
+        for (uint32_t k_ = 0; k_ < cells_ && equal_; k_++) {                             \
+            const NcsVmValue* a_ = &stack[sp - 2 * cells_ + k_];                         \
+            const NcsVmValue* b_ = &stack[sp - cells_ + k_];                             \
+            equal_ = (compare_);                                                         \
+        }                                                                                \
+        sp -= 2 * cells_;                                                                \
+        stack[sp].type = NCS_VM_TYPE_INT;                                                \
+        stack[sp].value.i = (equal_ == (expect_)) ? 1 : 0;                               \
+        sp++;                                                                            \
+    } while (0)
+
+#if NCS_VM_THREADED_DISPATCH
+    static void* const dispatchTable[NCS_VM_OP_COUNT] = {
+        &&op_cpdownsp, &&op_rsadd, &&op_cptopsp, &&op_const, &&op_consts, &&op_consto, &&op_action,
+        &&op_logandii, &&op_logorii, &&op_incorii, &&op_excorii, &&op_boolandii,
+        &&op_equal, &&op_equalff, &&op_equalss, &&op_equaltt,
+        &&op_nequal, &&op_nequalff, &&op_nequalss, &&op_nequaltt,
+        &&op_geqii, &&op_geqff, &&op_gtii, &&op_gtff, &&op_ltii, &&op_ltff, &&op_leqii, &&op_leqff,
+        &&op_shleftii, &&op_shrightii, &&op_ushrightii,
+        &&op_addii, &&op_addif, &&op_addfi, &&op_addff, &&op_addss, &&op_addvv,
+        &&op_subii, &&op_subif, &&op_subfi, &&op_subff, &&op_subvv,
+        &&op_mulii, &&op_mulif, &&op_mulfi, &&op_mulff, &&op_mulvf, &&op_mulfv,
+        &&op_divii, &&op_divif, &&op_divfi, &&op_divff, &&op_divvf,
+        &&op_modii, &&op_negi, &&op_negf, &&op_compi, &&op_movsp,
+        &&op_jmp, &&op_jsr, &&op_jz, &&op_jnz, &&op_retn, &&op_destruct, &&op_noti,
+        &&op_decsp, &&op_incsp, &&op_cpdownbp, &&op_cptopbp, &&op_decbp, &&op_incbp,
+        &&op_savebp, &&op_restorebp, &&op_store_state, &&op_nop,
+        &&op_cpdownsp_movsp, &&op_const_cpdownsp_movsp, &&op_cptopsp_const_addii_cpdownsp_movsp,
+        &&op_cptopsp_jz, &&op_cptopsp_jnz, &&op_compareii_jz, &&op_cptopsp_const_compareii_jz,
+        &&op_end
+    };
+#define VM_OP(name_, value_) op_##name_:
+#define VM_DISPATCH() goto *dispatchTable[ip->op]
+#else
+#define VM_OP(name_, value_) case value_:
+#define VM_DISPATCH() goto vm_dispatch
+#endif
+#define VM_NEXT() do { ip++; VM_DISPATCH(); } while (0)
+    // Charge the block that ends at step k_ of the current operation
+#define VM_CHARGE(k_)                                                                    \
+    do {                                                                                 \
+        int64_t block_ = (ip + (k_)) - segment + 1;                                      \
+        fuel -= block_;                                                                  \
+        if (profiled) ncs_vm_profile_charge(profiler, block_);                           \
+    } while (0)
+    // Start a new block at index_ (after VM_CHARGE)
+#define VM_TRANSFER(index_)                                                              \
+    do {                                                                                 \
+        ip = segment = code + (index_);                                                  \
+        if (fuel <= 0) goto vm_refuel;                                                   \
+        VM_DISPATCH();                                                                   \
+    } while (0)
+#define VM_JUMP_AT(k_, index_) do { VM_CHARGE(k_); VM_TRANSFER(index_); } while (0)
+#define VM_JUMP(index_) VM_JUMP_AT(0, index_)
+#define VM_SKIP(covered_) do { ip += (covered_); VM_DISPATCH(); } while (0)
+
+    // A write to (or a pop down to) a cell below BP may change the globals
+    // a STORE_STATE would capture, so the shared segment must not be reused
+#define VM_WRITE_BELOW_BP(cell_) do { if ((int64_t)(cell_) < (int64_t)bp) vm->globalsDirty = 1; } while (0)
+
+#if NCS_VM_THREADED_DISPATCH
+    VM_DISPATCH();
+    {
+#else
+vm_dispatch:
+    switch (ip->op) {
+#endif
+
+    VM_OP(cpdownsp, NCS_VM_OP_CPDOWNSP) {
+        uint32_t target;
+        VM_NEED_CELLS(ip->count);
+        VM_CELL_INDEX(target, sp, ip->a, ip->count);
+        VM_WRITE_BELOW_BP(target);
+        memmove(&stack[target], &stack[sp - ip->count], ip->count * sizeof(NcsVmValue));
+        VM_NEXT();
+    }
+
+    VM_OP(rsadd, NCS_VM_OP_RSADD) {
+        VM_ROOM_CELLS(1);
+        stack[sp].type = ip->type;
+        stack[sp].value.handle = (ip->type == NCS_VM_TYPE_OBJECT) ? NCS_VM_OBJECT_INVALID : 0;
+        sp++;
+        VM_NEXT();
+    }
+
+    VM_OP(cptopsp, NCS_VM_OP_CPTOPSP) {
+        uint32_t source;
+        VM_CELL_INDEX(source, sp, ip->a, ip->count);
+        VM_ROOM_CELLS(ip->count);
+        memcpy(&stack[sp], &stack[source], ip->count * sizeof(NcsVmValue));
+        sp += ip->count;
+        VM_NEXT();
+    }
+
+    VM_OP(const, NCS_VM_OP_CONST) {
+        // Int or float: a holds the host-order bit pattern either way
+        VM_ROOM_CELLS(1);
+        stack[sp].type = ip->type;
+        stack[sp].value.i = ip->a;
+        sp++;
+        VM_NEXT();
+    }
+
+    VM_OP(consts, NCS_VM_OP_CONSTS) {
+        VM_ROOM_CELLS(1);
+        stack[sp].type = NCS_VM_TYPE_STRING;
+        stack[sp].value.handle = stringBase + (uint32_t)ip->a;
+        sp++;
+        VM_NEXT();
+    }
+
+    VM_OP(consto, NCS_VM_OP_CONSTO) {
+        // The compiler emits OBJECT_SELF as 0 and OBJECT_INVALID as 1
+        VM_ROOM_CELLS(1);
+        stack[sp].type = NCS_VM_TYPE_OBJECT;
+        stack[sp].value.handle = ip->a == 0 ? vm->objectSelf : ip->a == 1 ? NCS_VM_OBJECT_INVALID : (uint32_t)ip->a;
+        sp++;
+        VM_NEXT();
+    }
+
+    VM_OP(action, NCS_VM_OP_ACTION) {
+        uint16_t routine = (uint16_t)ip->a;
+        const NcsVmAction* action = (routine < vm->actions.size() && vm->actions[routine].handler != NULL)
+            ? &vm->actions[routine] : &vm->defaultAction;
+        if (action->handler == NULL) {
+            VM_FAIL(NCS_VM_ERROR_UNKNOWN_ACTION);
+        }
+        vm->sp = sp;
+        vm->bp = bp;
+        vm->errorOffset = ip->offset;
+        int hadState = vm->hasStoredState;
+        int actionResult = action->handler(vm, routine, (uint8_t)ip->count, action->userData);
+        if (actionResult != NCS_VM_OK) {
+            sp = vm->sp;
+            VM_FAIL(actionResult);
+        }
+        if (!checked && vm->sp != sp + (uint32_t)ip->b) {
+            VM_FAIL(NCS_VM_ERROR_ACTION_SIGNATURE);
+        }
+        if (vm->recorder != NULL) {
+            ncs_vm_trace_action(vm->recorder, vm, routine, sp, hadState && !vm->hasStoredState);
+        }
+        sp = vm->sp;
+        VM_WRITE_BELOW_BP(sp);
+        VM_NEXT();
+    }
+
+    VM_OP(logandii, NCS_VM_OP_LOGANDII)     { VM_COMPARE_II(l && r); VM_NEXT(); }
+    VM_OP(logorii, NCS_VM_OP_LOGORII)       { VM_COMPARE_II(l || r); VM_NEXT(); }
+    VM_OP(incorii, NCS_VM_OP_INCORII)       { VM_BINARY_II(l | r); VM_NEXT(); }
+    VM_OP(excorii, NCS_VM_OP_EXCORII)       { VM_BINARY_II(l ^ r); VM_NEXT(); }
+    VM_OP(boolandii, NCS_VM_OP_BOOLANDII)   { VM_BINARY_II(l & r); VM_NEXT(); }
+
+    VM_OP(equal, NCS_VM_OP_EQUAL)       { VM_EQUALITY(1, true, a_->value.i == b_->value.i); VM_NEXT(); }
+    VM_OP(equalff, NCS_VM_OP_EQUALFF)   { VM_EQUALITY(1, true, a_->value.f == b_->value.f); VM_NEXT(); }
+    VM_OP(equalss, NCS_VM_OP_EQUALSS)   { VM_EQUALITY(1, true, ncs_vm_values_equal(vm, a_, b_)); VM_NEXT(); }
+    VM_OP(equaltt, NCS_VM_OP_EQUALTT)   { VM_EQUALITY(ip->count, true, ncs_vm_values_equal(vm, a_, b_)); VM_NEXT(); }
+    VM_OP(nequal, NCS_VM_OP_NEQUAL)     { VM_EQUALITY(1, false, a_->value.i == b_->value.i); VM_NEXT(); }
+    VM_OP(nequalff, NCS_VM_OP_NEQUALFF) { VM_EQUALITY(1, false, a_->value.f == b_->value.f); VM_NEXT(); }
+    VM_OP(nequalss, NCS_VM_OP_NEQUALSS) { VM_EQUALITY(1, false, ncs_vm_values_equal(vm, a_, b_)); VM_NEXT(); }
+    VM_OP(nequaltt, NCS_VM_OP_NEQUALTT) { VM_EQUALITY(ip->count, false, ncs_vm_values_equal(vm, a_, b_)); VM_NEXT(); }
+
+    VM_OP(geqii, NCS_VM_OP_GEQII) { VM_COMPARE_II(l >= r); VM_NEXT(); }
+    VM_OP(geqff, NCS_VM_OP_GEQFF) { VM_COMPARE_FF(l >= r); VM_NEXT(); }
+    VM_OP(gtii, NCS_VM_OP_GTII)   { VM_COMPARE_II(l > r); VM_NEXT(); }
+    VM_OP(gtff, NCS_VM_OP_GTFF)   { VM_COMPARE_FF(l > r); VM_NEXT(); }
+    VM_OP(ltii, NCS_VM_OP_LTII)   { VM_COMPARE_II(l < r); VM_NEXT(); }
+    VM_OP(ltff, NCS_VM_OP_LTFF)   { VM_COMPARE_FF(l < r); VM_NEXT(); }
+    VM_OP(leqii, NCS_VM_OP_LEQII) { VM_COMPARE_II(l <= r); VM_NEXT(); }
+    VM_OP(leqff, NCS_VM_OP_LEQFF) { VM_COMPARE_FF(l <= r); VM_NEXT(); }
+
+    VM_OP(shleftii, NCS_VM_OP_SHLEFTII)     { VM_BINARY_II((int32_t)((uint32_t)l << (r & 31))); VM_NEXT(); }
+    VM_OP(shrightii, NCS_VM_OP_SHRIGHTII)   { VM_BINARY_II(l >> (r & 31)); VM_NEXT(); }
+    VM_OP(ushrightii, NCS_VM_OP_USHRIGHTII) { VM_BINARY_II((int32_t)((uint32_t)l >> (r & 31))); VM_NEXT(); }
+
+    VM_OP(addii, NCS_VM_OP_ADDII) { VM_BINARY_II((int32_t)((uint32_t)l + (uint32_t)r)); VM_NEXT(); }
+    VM_OP(addif, NCS_VM_OP_ADDIF) { VM_BINARY_IF((float)l + r); VM_NEXT(); }
+    VM_OP(addfi, NCS_VM_OP_ADDFI) { VM_BINARY_FI(l + (float)r); VM_NEXT(); }
+    VM_OP(addff, NCS_VM_OP_ADDFF) { VM_BINARY_FF(l + r); VM_NEXT(); }
+    VM_OP(addvv, NCS_VM_OP_ADDVV) { VM_VECTOR_VV(+); VM_NEXT(); }
+    VM_OP(addss, NCS_VM_OP_ADDSS) {
+        VM_NEED_CELLS(2);
+        std::string joined = ncs_vm_string(vm, stack[sp - 2].value.handle) +
+                             ncs_vm_string(vm, stack[sp - 1].value.handle);
+        sp--;
+        stack[sp - 1].type = NCS_VM_TYPE_STRING;
+        stack[sp - 1].value.handle = ncs_vm_new_string(vm, joined);
+        VM_NEXT();
+    }
+
+    VM_OP(subii, NCS_VM_OP_SUBII) { VM_BINARY_II((int32_t)((uint32_t)l - (uint32_t)r)); VM_NEXT(); }
+    VM_OP(subif, NCS_VM_OP_SUBIF) { VM_BINARY_IF((float)l - r); VM_NEXT(); }
+    VM_OP(subfi, NCS_VM_OP_SUBFI) { VM_BINARY_FI(l - (float)r); VM_NEXT(); }
+    VM_OP(subff, NCS_VM_OP_SUBFF) { VM_BINARY_FF(l - r); VM_NEXT(); }
+    VM_OP(subvv, NCS_VM_OP_SUBVV) { VM_VECTOR_VV(-); VM_NEXT(); }
+
+    VM_OP(mulii, NCS_VM_OP_MULII) { VM_BINARY_II((int32_t)((uint32_t)l * (uint32_t)r)); VM_NEXT(); }
+    VM_OP(mulif, NCS_VM_OP_MULIF) { VM_BINARY_IF((float)l * r); VM_NEXT(); }
+    VM_OP(mulfi, NCS_VM_OP_MULFI) { VM_BINARY_FI(l * (float)r); VM_NEXT(); }
+    VM_OP(mulff, NCS_VM_OP_MULFF) { VM_BINARY_FF(l * r); VM_NEXT(); }
+    VM_OP(mulvf, NCS_VM_OP_MULVF) { VM_VECTOR_VF(*); VM_NEXT(); }
+    VM_OP(mulfv, NCS_VM_OP_MULFV) {
+        // Scalar sits below the vector: scale in place, then drop the scalar slot
+        VM_NEED_CELLS(4);
+        float scalar = stack[sp - 4].value.f;
+        for (int k = 0; k < 3; k++) {
+            stack[sp - 4 + k] = stack[sp - 3 + k];
+            stack[sp - 4 + k].value.f *= scalar;
+        }
+        sp--;
+        VM_NEXT();
+    }
+
+    VM_OP(divii, NCS_VM_OP_DIVII) {
+        VM_NEED_CELLS(2);
+        if (stack[sp - 1].value.i == 0) VM_FAIL(NCS_VM_ERROR_DIVIDE_BY_ZERO);
+        VM_BINARY_II(r == -1 ? (int32_t)(0u - (uint32_t)l) : l / r);
+        VM_NEXT();
+    }
+    VM_OP(divif, NCS_VM_OP_DIVIF) { VM_BINARY_IF((float)l / r); VM_NEXT(); }
+    VM_OP(divfi, NCS_VM_OP_DIVFI) { VM_BINARY_FI(l / (float)r); VM_NEXT(); }
+    VM_OP(divff, NCS_VM_OP_DIVFF) { VM_BINARY_FF(l / r); VM_NEXT(); }
+    VM_OP(divvf, NCS_VM_OP_DIVVF) { VM_VECTOR_VF(/); VM_NEXT(); }
+
+    VM_OP(modii, NCS_VM_OP_MODII) {
+        VM_NEED_CELLS(2);
+        if (stack[sp - 1].value.i == 0) VM_FAIL(NCS_VM_ERROR_DIVIDE_BY_ZERO);
+        VM_BINARY_II(r == -1 ? 0 : l % r);
+        VM_NEXT();
+    }
+
+    VM_OP(negi, NCS_VM_OP_NEGI) {
+        VM_NEED_CELLS(1);
+        stack[sp - 1].value.i = (int32_t)(0u - (uint32_t)stack[sp - 1].value.i);
+        VM_NEXT();
+    }
+
+    VM_OP(negf, NCS_VM_OP_NEGF) {
+        VM_NEED_CELLS(1);
+        stack[sp - 1].value.f = -stack[sp - 1].value.f;
+        VM_NEXT();
+    }
+
+    VM_OP(compi, NCS_VM_OP_COMPI) {
+        VM_NEED_CELLS(1);
+        stack[sp - 1].value.i = ~stack[sp - 1].value.i;
+        VM_NEXT();
+    }
+
+    VM_OP(movsp, NCS_VM_OP_MOVSP) {
+        // Loader guarantees a <= 0
+        VM_NEED_CELLS(-ip->a);
+        sp += ip->a;
+        VM_WRITE_BELOW_BP(sp);
+        VM_NEXT();
+    }
+
+    VM_OP(jmp, NCS_VM_OP_JMP) {
+        VM_JUMP(ip->a);
+    }
+
+    VM_OP(jsr, NCS_VM_OP_JSR) {
+        vm->returns.push_back((uint32_t)(ip - code) + 1);
+        VM_CHARGE(0);
+        if (profiled) ncs_vm_profile_call(profiler, program, (uint32_t)ip->a);
+        VM_TRANSFER(ip->a);
+    }
+
+    VM_OP(jz, NCS_VM_OP_JZ) {
+        VM_NEED_CELLS(1);
+        if (stack[--sp].value.i == 0) {
+            VM_JUMP(ip->a);
+        }
+        VM_NEXT();
+    }
+
+    VM_OP(jnz, NCS_VM_OP_JNZ) {
+        VM_NEED_CELLS(1);
+        if (stack[--sp].value.i != 0) {
+            VM_JUMP(ip->a);
+        }
+        VM_NEXT();
+    }
+
+    VM_OP(retn, NCS_VM_OP_RETN) {
+        if (vm->returns.empty()) {
+            goto vm_exit;
+        }
+        uint32_t returnIndex = vm->returns.back();
+        vm->returns.pop_back();
+        VM_CHARGE(0);
+        if (profiled) ncs_vm_profile_return(profiler);
+        VM_TRANSFER(returnIndex);
+    }
+
+    VM_OP(destruct, NCS_VM_OP_DESTRUCT) {
+        // Loader guarantees the kept range lies inside the removed region
+        VM_NEED_CELLS(ip->count);
+        uint32_t base = sp - ip->count;
+        VM_WRITE_BELOW_BP(base);
+        memmove(&stack[base], &stack[base + ip->a], ip->b * sizeof(NcsVmValue));
+        sp = base + ip->b;
+        VM_NEXT();
+    }
+
+    VM_OP(noti, NCS_VM_OP_NOTI) {
+        VM_NEED_CELLS(1);
+        stack[sp - 1].value.i = (stack[sp - 1].value.i == 0) ? 1 : 0;
+        VM_NEXT();
+    }
+
+    VM_OP(decsp, NCS_VM_OP_DECSP)
+    VM_OP(incsp, NCS_VM_OP_INCSP)
+    VM_OP(decbp, NCS_VM_OP_DECBP)
+    VM_OP(incbp, NCS_VM_OP_INCBP) {
+        uint32_t index;
+        bool relativeToBp = (ip->op == NCS_VM_OP_DECBP || ip->op == NCS_VM_OP_INCBP);
+        VM_CELL_INDEX(index, relativeToBp ? bp : sp, ip->a, 1);
+        VM_WRITE_BELOW_BP(index);
+        int step = (ip->op == NCS_VM_OP_INCSP || ip->op == NCS_VM_OP_INCBP) ? 1 : -1;
+        if (stack[index].type == NCS_VM_TYPE_FLOAT) {
+            stack[index].value.f += (float)step;
+        }
+        else {
+            stack[index].value.i = (int32_t)((uint32_t)stack[index].value.i + (uint32_t)step);
+        }
+        VM_NEXT();
+    }
+
+    VM_OP(cpdownbp, NCS_VM_OP_CPDOWNBP) {
+        uint32_t target;
+        VM_NEED_CELLS(ip->count);
+        VM_CELL_INDEX(target, bp, ip->a, ip->count);
+        vm->globalsDirty = 1;
+        memmove(&stack[target], &stack[sp - ip->count], ip->count * sizeof(NcsVmValue));
+        VM_NEXT();
+    }
+
+    VM_OP(cptopbp, NCS_VM_OP_CPTOPBP) {
+        uint32_t source;
+        VM_CELL_INDEX(source, bp, ip->a, ip->count);
+        VM_ROOM_CELLS(ip->count);
+        memcpy(&stack[sp], &stack[source], ip->count * sizeof(NcsVmValue));
+        sp += ip->count;
+        VM_NEXT();
+    }
+
+    VM_OP(savebp, NCS_VM_OP_SAVEBP) {
+        // Same layout as Stack.SaveBp(): BP points at the saved-BP cell
+        VM_ROOM_CELLS(1);
+        stack[sp].type = NCS_VM_TYPE_INT;
+        stack[sp].value.i = (int32_t)bp;
+        bp = sp++;
+        VM_NEXT();
+    }
+
+    VM_OP(restorebp, NCS_VM_OP_RESTOREBP) {
+        VM_NEED_CELLS(1);
+        sp--;
+        if (stack[sp].type != NCS_VM_TYPE_INT || (uint32_t)stack[sp].value.i > sp) VM_FAIL(NCS_VM_ERROR_TYPE_MISMATCH);
+        bp = (uint32_t)stack[sp].value.i;
+        vm->globalsDirty = 1;          // Cells that were below the old BP are now above the new one
+        VM_NEXT();
+    }
+
+    VM_OP(store_state, NCS_VM_OP_STORE_STATE) {
+        vm->sp = sp;
+        vm->bp = bp;
+        int stored = ncs_vm_store_state(vm, (uint32_t)(ip - code) + 2, (uint32_t)ip->a, (uint32_t)ip->b);
+        if (stored != NCS_VM_OK) {
+            VM_FAIL(stored);
+        }
+        VM_NEXT();
+    }
+
+    VM_OP(nop, NCS_VM_OP_NOP) {
+        VM_NEXT();
+    }
+
+    // Superinstructions: operands of covered steps are read from ip[k], which
+    // ncs_vm_fuse_program left unchanged; each bounds check matches the one
+    // the unfused step would make.
+
+    VM_OP(cpdownsp_movsp, NCS_VM_OP_CPDOWNSP_MOVSP) {
+        uint32_t target;
+        VM_NEED_CELLS(ip->count);
+        VM_CELL_INDEX(target, sp, ip->a, ip->count);
+        VM_WRITE_BELOW_BP(target);
+        memmove(&stack[target], &stack[sp - ip->count], ip->count * sizeof(NcsVmValue));
+        VM_CHECK(1, sp < (uint32_t)-ip->b, NCS_VM_ERROR_STACK_UNDERFLOW);
+        sp += ip->b;
+        VM_WRITE_BELOW_BP(sp);
+        VM_SKIP(2);
+    }
+
+    VM_OP(const_cpdownsp_movsp, NCS_VM_OP_CONST_CPDOWNSP_MOVSP) {
+        // The pushed constant is popped again, so it is written straight to its target
+        VM_ROOM_CELLS(1);
+        int64_t cell = (int64_t)sp + 1 + ip->b;
+        VM_CHECK(1, cell < 0 || cell > (int64_t)sp, NCS_VM_ERROR_STACK_UNDERFLOW);
+        VM_WRITE_BELOW_BP(cell);
+        stack[cell].type = ip->type;
+        stack[cell].value.i = ip->a;
+        VM_SKIP(3);
+    }
+
+    VM_OP(cptopsp_const_addii_cpdownsp_movsp, NCS_VM_OP_CPTOPSP_CONST_ADDII_CPDOWNSP_MOVSP) {
+        uint32_t source;
+        VM_CELL_INDEX(source, sp, ip->a, 1);
+        VM_ROOM_CELLS(1);
+        VM_CHECK(1, capacity - sp < 2, NCS_VM_ERROR_STACK_OVERFLOW);
+        int64_t cell = (int64_t)sp + 1 + ip[3].a;
+        VM_CHECK(3, cell < 0 || cell > (int64_t)sp, NCS_VM_ERROR_STACK_UNDERFLOW);
+        VM_WRITE_BELOW_BP(cell);
+        int32_t sum = (int32_t)((uint32_t)stack[source].value.i + (uint32_t)ip->b);
+        stack[cell].type = NCS_VM_TYPE_INT;
+        stack[cell].value.i = sum;
+        VM_SKIP(5);
+    }
+
+    VM_OP(cptopsp_jz, NCS_VM_OP_CPTOPSP_JZ) {
+        uint32_t source;
+        VM_CELL_INDEX(source, sp, ip->a, 1);
+        VM_ROOM_CELLS(1);
+        if (stack[source].value.i == 0) {
+            VM_JUMP_AT(1, ip->b);
+        }
+        VM_SKIP(2);
+    }
+
+    VM_OP(cptopsp_jnz, NCS_VM_OP_CPTOPSP_JNZ) {
+        uint32_t source;
+        VM_CELL_INDEX(source, sp, ip->a, 1);
+        VM_ROOM_CELLS(1);
+        if (stack[source].value.i != 0) {
+            VM_JUMP_AT(1, ip->b);
+        }
+        VM_SKIP(2);
+    }
+
+    VM_OP(compareii_jz, NCS_VM_OP_COMPAREII_JZ) {
+        VM_NEED_CELLS(2);
+        bool holds = ncs_vm_compare_ii(ip->type, stack[sp - 2].value.i, stack[sp - 1].value.i);
+        sp -= 2;
+        if (!holds) {
+            VM_JUMP_AT(1, ip->a);
+        }
+        VM_SKIP(2);
+    }
+
+    VM_OP(cptopsp_const_compareii_jz, NCS_VM_OP_CPTOPSP_CONST_COMPAREII_JZ) {
+        uint32_t source;
+        VM_CELL_INDEX(source, sp, ip->a, 1);
+        VM_ROOM_CELLS(1);
+        VM_CHECK(1, capacity - sp < 2, NCS_VM_ERROR_STACK_OVERFLOW);
+        if (!ncs_vm_compare_ii(ip->type, stack[source].value.i, ip->b)) {
+            VM_JUMP_AT(3, ip[3].a);
+        }
+        VM_SKIP(4);
+    }
+
+    VM_OP(end, NCS_VM_OP_END) {
+        VM_FAIL(NCS_VM_ERROR_END_OF_CODE);
+    }
+
+#if !NCS_VM_THREADED_DISPATCH
+    default:
+        VM_FAIL(NCS_VM_ERROR_BAD_OPCODE);
+#endif
+    }
+
+vm_refuel:
+    vm->sliceInstructions += chunk - fuel;
+    chunk = fuel = ncs_vm_next_fuel(vm);
+    if (fuel > 0) {
+        VM_DISPATCH();
+    }
+    vm->resumeIndex = (uint32_t)(ip - code);
+    vm->sp = sp;
+    vm->bp = bp;
+    return NCS_VM_SUSPENDED;
+
+vm_exit:
+    VM_CHARGE(0);
+    vm->sliceInstructions += chunk - fuel;
+    vm->sp = sp;
+    vm->bp = bp;
+    if (result != NCS_VM_OK) {
+        vm->errorOffset = ip->offset;
+    }
+    return result;
+
+#undef VM_FAIL
+#undef VM_FAIL_AT
+#undef VM_CHECK
+#undef VM_NEED_CELLS
+#undef VM_ROOM_CELLS
+#undef VM_CELL_INDEX
+#undef VM_BINARY
+#undef VM_BINARY_II
+#undef VM_BINARY_FF
+#undef VM_BINARY_IF
+#undef VM_BINARY_FI
+#undef VM_COMPARE_II
+#undef VM_COMPARE_FF
+#undef VM_VECTOR_VV
+#undef VM_VECTOR_VF
+#undef VM_EQUALITY
+#undef VM_OP
+#undef VM_DISPATCH
+#undef VM_NEXT
+#undef VM_JUMP
+#undef VM_JUMP_AT
+#undef VM_CHARGE
+#undef VM_TRANSFER
+#undef VM_SKIP
+#undef VM_WRITE_BELOW_BP
+}
+
+int ncs_vm_call_action(NcsVm* vm, uint16_t routine, uint8_t argumentCount, int32_t stackDelta)
+{
+    // Same sequence as the interpreter's unchecked ACTION
+    const NcsVmAction* action = (routine < vm->actions.size() && vm->actions[routine].handler != NULL)
+        ? &vm->actions[routine] : &vm->defaultAction;
+    if (action->handler == NULL) {
+        return NCS_VM_ERROR_UNKNOWN_ACTION;
+    }
+    uint32_t sp = vm->sp;
+    int hadState = vm->hasStoredState;
+    int result = action->handler(vm, routine, argumentCount, action->userData);
+    if (result != NCS_VM_OK) {
+        return result;
+    }
+    if (vm->sp != sp + (uint32_t)stackDelta) {
+        vm->sp = sp;
+        return NCS_VM_ERROR_ACTION_SIGNATURE;
+    }
+    if (vm->sp < vm->bp) {
+        vm->globalsDirty = 1;
+    }
+    if (vm->recorder != NULL) {
+        ncs_vm_trace_action(vm->recorder, vm, routine, sp, hadState && !vm->hasStoredState);
+    }
+    return NCS_VM_OK;
+}
+
+/**
+ * @brief Whether a run from entry can use the program's native translation
+ *
+ * Budgets, profiling and tracing are implemented by the dispatch loop, and
+ * native code has no bounds checks, so any of those selects the bytecode.
+ */
+static bool ncs_vm_use_native(const NcsVm* vm, const NcsVmProgram* program, uint32_t entry, bool checked)
+{
+    return program->native != NULL && !checked && vm->profiler == NULL && vm->recorder == NULL &&
+           vm->budgetInstructions == 0 && vm->budgetMicroseconds == 0 &&
+           ncs_vm_native_has_entry(program->native, entry);
+}
+
+/**
+ * @brief Run one slice in the given mode and remember where a suspended run stopped
+ */
+static int ncs_vm_run_slice(NcsVm* vm, const NcsVmProgram* program, uint32_t startIndex, bool checked,
+                            bool resuming)
+{
+    ncs_vm_begin_slice(vm);
+    vm->suspendedProgram = NULL;
+    int result;
+    if (vm->profiler != NULL) {
+        if (!resuming) {
+            ncs_vm_profile_enter(vm->profiler, program, startIndex);
+        }
+        vm->profiler->running = 1;
+        result = checked ? ncs_vm_execute<true, true>(vm, program, startIndex)
+                         : ncs_vm_execute<false, true>(vm, program, startIndex);
+        vm->profiler->running = 0;
+        if (result != NCS_VM_SUSPENDED) {
+            ncs_vm_profile_leave(vm->profiler);
+        }
+    }
+    else {
+        result = checked ? ncs_vm_execute<true, false>(vm, program, startIndex)
+                         : ncs_vm_execute<false, false>(vm, program, startIndex);
+    }
+    if (vm->recorder != NULL) {
+        ncs_vm_trace_slice(vm->recorder, vm->sliceInstructions);
+        if (result != NCS_VM_SUSPENDED) {
+            ncs_vm_trace_finish(vm->recorder, vm, result);
+        }
+    }
+    if (result == NCS_VM_SUSPENDED) {
+        vm->suspendedProgram = program;
+        vm->suspendedChecked = checked ? 1 : 0;
+    }
+    return result;
+}
+
+int ncs_vm_run_program(NcsVm* vm, const NcsVmProgram* program)
+{
+    if (program->code.size() < 2) {
+        return NCS_VM_ERROR_BAD_PROGRAM;
+    }
+    ncs_vm_bind_strings(vm, program, vm->sp);
+    vm->globalsDirty = 1;              // The host may have changed the stack since the last run
+    vm->returns.clear();
+    bool checked = !(program->verified && vm->stack.size() - vm->sp >= program->maxStackCells);
+    if (ncs_vm_use_native(vm, program, 0, checked)) {
+        vm->suspendedProgram = NULL;
+        vm->sliceInstructions = 0;
+        return program->native->entry(vm, 0);
+    }
+    if (vm->recorder != NULL) {
+        ncs_vm_trace_run(vm->recorder, vm, program, 0, NULL);
+    }
+    return ncs_vm_run_slice(vm, program, 0, checked, false);
+}
+
+int ncs_vm_run(NcsVm* vm, const uint8_t* code, uint32_t size)
+{
+    NcsVmProgram program;
+    int result = ncs_vm_load(code, size, &program);
+    if (result != NCS_VM_OK) {
+        vm->errorOffset = program.errorOffset;
+        return result;
+    }
+    return ncs_vm_run_program(vm, &program);
+}
+
+int ncs_vm_run_state(NcsVm* vm, const NcsVmProgram* program, const NcsVmSavedState* state)
+{
+    if (state->resumeIndex >= program->code.size()) {
+        return NCS_VM_ERROR_BAD_PROGRAM;
+    }
+    size_t globalCells = state->globals ? state->globals->values.size() : 0;
+    size_t localCells = state->locals.values.size();
+    if (globalCells + localCells > vm->stack.size()) {
+        return NCS_VM_ERROR_STACK_OVERFLOW;
+    }
+
+    // The stack is replaced, so nothing in the pool survives
+    ncs_vm_bind_strings(vm, program, 0);
+    if (globalCells > 0) {
+        ncs_vm_restore_cells(vm, state->globals.get(), vm->stack.data());
+    }
+    ncs_vm_restore_cells(vm, &state->locals, vm->stack.data() + globalCells);
+    vm->bp = (uint32_t)globalCells;
+    vm->sp = (uint32_t)(globalCells + localCells);
+    // The stack now starts with exactly this segment: nested captures can share it
+    vm->globalsSegment = state->globals;
+    vm->globalsBase = 0;
+    vm->globalsDirty = state->globals ? 0 : 1;
+    vm->returns.clear();
+    bool checked = !(program->verified && vm->stack.size() >= program->maxStackCells);
+    if (ncs_vm_use_native(vm, program, state->resumeIndex, checked)) {
+        vm->suspendedProgram = NULL;
+        vm->sliceInstructions = 0;
+        return program->native->entry(vm, state->resumeIndex);
+    }
+    if (vm->recorder != NULL) {
+        ncs_vm_trace_run(vm->recorder, vm, program, state->resumeIndex, state);
+    }
+    return ncs_vm_run_slice(vm, program, state->resumeIndex, checked, false);
+}
+
+int ncs_vm_resume(NcsVm* vm)
+{
+    if (vm->suspendedProgram == NULL) {
+        return NCS_VM_ERROR_NOT_SUSPENDED;
+    }
+    // The string binding and return stack are still those of the suspended run
+    return ncs_vm_run_slice(vm, vm->suspendedProgram, vm->resumeIndex, vm->suspendedChecked != 0, true);
+}
+
+int ncs_vm_is_suspended(const NcsVm* vm)
+{
+    return vm->suspendedProgram != NULL;
+}
+
+// ============================================================================
+// ACTION HANDLER HELPERS
+// ============================================================================
+
+int ncs_vm_push_handle(NcsVm* vm, uint8_t type, uint32_t handle)
+{
+    if (vm->sp >= vm->stack.size()) {
+        return NCS_VM_ERROR_STACK_OVERFLOW;
+    }
+    vm->stack[vm->sp].type = type;
+    vm->stack[vm->sp].value.handle = handle;
+    vm->sp++;
+    return NCS_VM_OK;
+}
+
+int ncs_vm_push_int(NcsVm* vm, int32_t value)
+{
+    return ncs_vm_push_handle(vm, NCS_VM_TYPE_INT, (uint32_t)value);
+}
+
+int ncs_vm_push_float(NcsVm* vm, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return ncs_vm_push_handle(vm, NCS_VM_TYPE_FLOAT, bits);
+}
+
+int ncs_vm_push_string(NcsVm* vm, const char* text)
+{
+    return ncs_vm_push_handle(vm, NCS_VM_TYPE_STRING, ncs_vm_new_string(vm, text != NULL ? text : ""));
+}
+
+int ncs_vm_push_object(NcsVm* vm, uint32_t object)
+{
+    return ncs_vm_push_handle(vm, NCS_VM_TYPE_OBJECT, object);
+}
+
+int ncs_vm_push_vector(NcsVm* vm, float x, float y, float z)
+{
+    if (vm->stack.size() - vm->sp < 3) {
+        return NCS_VM_ERROR_STACK_OVERFLOW;
+    }
+    ncs_vm_push_float(vm, x);
+    ncs_vm_push_float(vm, y);
+    return ncs_vm_push_float(vm, z);
+}
+
+int ncs_vm_pop_handle(NcsVm* vm, uint8_t type, uint32_t* handle)
+{
+    if (vm->sp == 0) {
+        return NCS_VM_ERROR_STACK_UNDERFLOW;
+    }
+    const NcsVmValue& top = vm->stack[vm->sp - 1];
+    if (top.type != type) {
+        return NCS_VM_ERROR_TYPE_MISMATCH;
+    }
+    *handle = top.value.handle;
+    vm->sp--;
+    return NCS_VM_OK;
+}
+
+int ncs_vm_pop_int(NcsVm* vm, int32_t* value)
+{
+    // Ints and floats satisfy each other, as in Interpreter.ExecuteAction()
+    if (vm->sp > 0 && vm->stack[vm->sp - 1].type == NCS_VM_TYPE_FLOAT) {
+        *value = (int32_t)vm->stack[--vm->sp].value.f;
+        return NCS_VM_OK;
+    }
+    uint32_t bits = 0;
+    int result = ncs_vm_pop_handle(vm, NCS_VM_TYPE_INT, &bits);
+    *value = (int32_t)bits;
+    return result;
+}
+
+int ncs_vm_pop_float(NcsVm* vm, float* value)
+{
+    if (vm->sp > 0 && vm->stack[vm->sp - 1].type == NCS_VM_TYPE_INT) {
+        *value = (float)vm->stack[--vm->sp].value.i;
+        return NCS_VM_OK;
+    }
+    uint32_t bits = 0;
+    int result = ncs_vm_pop_handle(vm, NCS_VM_TYPE_FLOAT, &bits);
+    memcpy(value, &bits, sizeof(float));
+    return result;
+}
+
+int ncs_vm_pop_string(NcsVm* vm, std::string* text)
+{
+    uint32_t handle = 0;
+    int result = ncs_vm_pop_handle(vm, NCS_VM_TYPE_STRING, &handle);
+    if (result == NCS_VM_OK) {
+        *text = ncs_vm_string(vm, handle);
+    }
+    return result;
+}
+
+int ncs_vm_pop_object(NcsVm* vm, uint32_t* object)
+{
+    return ncs_vm_pop_handle(vm, NCS_VM_TYPE_OBJECT, object);
+}
+
+int ncs_vm_pop_vector(NcsVm* vm, float* x, float* y, float* z)
+{
+    // Components were pushed x, y, z so z is on top
+    int result = ncs_vm_pop_float(vm, z);
+    if (result == NCS_VM_OK) {
+        result = ncs_vm_pop_float(vm, y);
+    }
+    if (result == NCS_VM_OK) {
+        result = ncs_vm_pop_float(vm, x);
+    }
+    return result;
+}
+
+int ncs_vm_take_stored_state(NcsVm* vm, NcsVmSavedState* state)
+{
+    if (!vm->hasStoredState) {
+        return NCS_VM_ERROR_NO_STORED_STATE;
+    }
+    state->resumeIndex = vm->storedState.resumeIndex;
+    state->globals.swap(vm->storedState.globals);
+    state->locals.values.swap(vm->storedState.locals.values);
+    state->locals.strings.swap(vm->storedState.locals.strings);
+    vm->storedState.globals.reset();
+    vm->storedState.locals.values.clear();
+    vm->storedState.locals.strings.clear();
+    vm->hasStoredState = 0;
+    return NCS_VM_OK;
+}
@@ -0,0 +1,694 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - NATIVE REFERENCE RUNTIME
+// ============================================================================
+// Executes "NCS V1.0B" bytecode as written by nwnnsscomp_write_bytecode_to_file.
+// Scripts are decoded once by ncs_vm_load into a fixed-width, host-endian
+// instruction array with jumps resolved to instruction indices, and common
+// compiler idioms are fused into superinstructions; the dispatch loop uses
+// computed-goto threading over that array where the compiler supports it
+// (GCC/Clang) and a switch elsewhere. Scripts accepted by ncs_vm_verify run
+// without per-instruction stack bounds checks. Engine routines are supplied
+// by the host as ACTION handlers registered per routine number. A run can be
+// bounded by an instruction or time budget, after which it suspends and is
+// continued by ncs_vm_resume. A program with an attached native translation
+// (see ncs_vm_native.h) runs that instead, falling back to the bytecode
+// whenever a feature needs the interpreter.
+//
+// Stack model (mirrors Compiler/Stack.cs): every cell is 4 bytes of NCS
+// stack space, vectors occupy three float cells, SP/BP-relative operands are
+// byte offsets that must be multiples of NCS_STACK_ELEMENT_SIZE.
+// ============================================================================
+
+#ifndef NCS_VM_H
+#define NCS_VM_H
+
+#include <stdio.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ncs_bytecode.h"
+
+#define NCS_VM_DEFAULT_STACK_CELLS  8192        // 32 KB of NCS stack space
+#define NCS_VM_OBJECT_INVALID       0x7F000000  // OBJECT_INVALID
+#define NCS_VM_OBJECT_SELF          0x00000000  // OBJECT_SELF placeholder pushed by CONSTO 0
+
+#define NCS_VM_LOAD_NO_FUSION       0x00000001  // ncs_vm_load_with_flags: keep one operation per NCS instruction
+
+#define NCS_VM_CLOCK_INTERVAL       4096        // Instructions between clock reads under a time budget
+
+#define NCS_VM_ACTION_MAX_ARGUMENTS 16          // Largest parameter list in nwscript.nss is 15
+#define NCS_VM_ACTION_MAX_CELLS     16
+
+enum NcsVmType
+{
+    NCS_VM_TYPE_INT = 0,
+    NCS_VM_TYPE_FLOAT,
+    NCS_VM_TYPE_STRING,                // value.handle indexes NcsVm::strings
+    NCS_VM_TYPE_OBJECT,
+    NCS_VM_TYPE_EFFECT,                // Engine types: value.handle is owned by the host
+    NCS_VM_TYPE_EVENT,
+    NCS_VM_TYPE_LOCATION,
+    NCS_VM_TYPE_TALENT
+};
+
+/**
+ * @brief nwscript.nss declaration types, as used by NcsVmActionInfo
+ */
+enum NcsVmScriptType
+{
+    NCS_VM_SCRIPT_VOID = 0,
+    NCS_VM_SCRIPT_INT,
+    NCS_VM_SCRIPT_FLOAT,
+    NCS_VM_SCRIPT_STRING,
+    NCS_VM_SCRIPT_OBJECT,
+    NCS_VM_SCRIPT_VECTOR,              // Three float cells
+    NCS_VM_SCRIPT_EFFECT,
+    NCS_VM_SCRIPT_EVENT,
+    NCS_VM_SCRIPT_LOCATION,
+    NCS_VM_SCRIPT_TALENT,
+    NCS_VM_SCRIPT_ACTION               // Taken from the stored state, not the stack
+};
+
+enum NcsVmResult
+{
+    NCS_VM_OK = 0,
+    NCS_VM_ERROR_BAD_PROGRAM,          // Header or size field invalid
+    NCS_VM_ERROR_BAD_OPCODE,           // Unknown opcode or opcode/qualifier pair
+    NCS_VM_ERROR_BAD_JUMP,             // Jump or return outside the code
+    NCS_VM_ERROR_STACK_OVERFLOW,       // Push beyond the stack capacity
+    NCS_VM_ERROR_STACK_UNDERFLOW,      // Pop or access below the stack base
+    NCS_VM_ERROR_BAD_OFFSET,           // Stack offset not a multiple of 4
+    NCS_VM_ERROR_DIVIDE_BY_ZERO,
+    NCS_VM_ERROR_TYPE_MISMATCH,        // Handler popped a value of the wrong type
+    NCS_VM_ERROR_UNKNOWN_ACTION,       // ACTION with no registered handler
+    NCS_VM_ERROR_ACTION_FAILED,        // Handler reported a failure
+    NCS_VM_ERROR_NO_STORED_STATE,      // Handler asked for an action argument with none stored
+    NCS_VM_ERROR_END_OF_CODE,          // Execution ran past the last instruction
+    NCS_VM_ERROR_UNBALANCED,           // Stack depth differs where control flow merges
+    NCS_VM_ERROR_UNSUPPORTED,          // Recursion or shared code the verifier cannot prove
+    NCS_VM_ERROR_ACTION_SIGNATURE,     // Handler stack effect differs from its verified signature
+    NCS_VM_ERROR_NOT_SUSPENDED,        // ncs_vm_resume with no suspended run
+    NCS_VM_ERROR_TRACE_MISMATCH,       // Replay diverged from the recorded trace
+    NCS_VM_SUSPENDED                   // Slice budget used up; not an error, continue with ncs_vm_resume
+};
+
+/**
+ * @brief Loaded operation: an NCS opcode with its qualifier resolved
+ *
+ * Typed opcodes get one operation per supported operand pair so the
+ * dispatch loop never inspects the qualifier.
+ */
+enum NcsVmOp
+{
+    NCS_VM_OP_CPDOWNSP = 0,
+    NCS_VM_OP_RSADD,                   // type = NcsVmType to push
+    NCS_VM_OP_CPTOPSP,
+    NCS_VM_OP_CONST,                   // type = NcsVmType, a = host-endian bits
+    NCS_VM_OP_CONSTS,                  // a = index into NcsVmProgram::strings
+    NCS_VM_OP_CONSTO,                  // a = object id (0 = OBJECT_SELF, 1 = OBJECT_INVALID)
+    NCS_VM_OP_ACTION,
+    NCS_VM_OP_LOGANDII,
+    NCS_VM_OP_LOGORII,
+    NCS_VM_OP_INCORII,
+    NCS_VM_OP_EXCORII,
+    NCS_VM_OP_BOOLANDII,
+    NCS_VM_OP_EQUAL,                   // Scalar equality (int, float bits, object, engine handle)
+    NCS_VM_OP_EQUALFF,
+    NCS_VM_OP_EQUALSS,
+    NCS_VM_OP_EQUALTT,                 // count = cells per operand
+    NCS_VM_OP_NEQUAL,
+    NCS_VM_OP_NEQUALFF,
+    NCS_VM_OP_NEQUALSS,
+    NCS_VM_OP_NEQUALTT,
+    NCS_VM_OP_GEQII, NCS_VM_OP_GEQFF,
+    NCS_VM_OP_GTII,  NCS_VM_OP_GTFF,
+    NCS_VM_OP_LTII,  NCS_VM_OP_LTFF,
+    NCS_VM_OP_LEQII, NCS_VM_OP_LEQFF,
+    NCS_VM_OP_SHLEFTII,
+    NCS_VM_OP_SHRIGHTII,
+    NCS_VM_OP_USHRIGHTII,
+    NCS_VM_OP_ADDII, NCS_VM_OP_ADDIF, NCS_VM_OP_ADDFI, NCS_VM_OP_ADDFF, NCS_VM_OP_ADDSS, NCS_VM_OP_ADDVV,
+    NCS_VM_OP_SUBII, NCS_VM_OP_SUBIF, NCS_VM_OP_SUBFI, NCS_VM_OP_SUBFF, NCS_VM_OP_SUBVV,
+    NCS_VM_OP_MULII, NCS_VM_OP_MULIF, NCS_VM_OP_MULFI, NCS_VM_OP_MULFF, NCS_VM_OP_MULVF, NCS_VM_OP_MULFV,
+    NCS_VM_OP_DIVII, NCS_VM_OP_DIVIF, NCS_VM_OP_DIVFI, NCS_VM_OP_DIVFF, NCS_VM_OP_DIVVF,
+    NCS_VM_OP_MODII,
+    NCS_VM_OP_NEGI, NCS_VM_OP_NEGF,
+    NCS_VM_OP_COMPI,
+    NCS_VM_OP_MOVSP,
+    NCS_VM_OP_JMP,
+    NCS_VM_OP_JSR,
+    NCS_VM_OP_JZ,
+    NCS_VM_OP_JNZ,
+    NCS_VM_OP_RETN,
+    NCS_VM_OP_DESTRUCT,
+    NCS_VM_OP_NOTI,
+    NCS_VM_OP_DECSP,
+    NCS_VM_OP_INCSP,
+    NCS_VM_OP_CPDOWNBP,
+    NCS_VM_OP_CPTOPBP,
+    NCS_VM_OP_DECBP,
+    NCS_VM_OP_INCBP,
+    NCS_VM_OP_SAVEBP,
+    NCS_VM_OP_RESTOREBP,
+    NCS_VM_OP_STORE_STATE,
+    NCS_VM_OP_NOP,
+
+    // Superinstructions (see ncs_vm_fuse_program)
+    NCS_VM_OP_CPDOWNSP_MOVSP,          // Assign and pop: b = MOVSP cells
+    NCS_VM_OP_CONST_CPDOWNSP_MOVSP,    // x = constant: b = CPDOWNSP cell offset
+    NCS_VM_OP_CPTOPSP_CONST_ADDII_CPDOWNSP_MOVSP, // x += constant (also -=): b = addend
+    NCS_VM_OP_CPTOPSP_JZ,              // if (!x): b = target index
+    NCS_VM_OP_CPTOPSP_JNZ,             // if (x): b = target index
+    NCS_VM_OP_COMPAREII_JZ,            // Int comparison and branch: type = comparison NcsVmOp, a = target index
+    NCS_VM_OP_CPTOPSP_CONST_COMPAREII_JZ, // Loop guard (x < constant): type = comparison, b = constant
+
+    NCS_VM_OP_END,                     // Sentinel after the last instruction
+    NCS_VM_OP_COUNT
+};
+
+/**
+ * @brief Fixed-width loaded instruction (16 bytes, host-endian)
+ *
+ * Stack offsets and sizes are stored in cells, already validated as
+ * multiples of NCS_STACK_ELEMENT_SIZE. Operand meaning by operation:
+ * - CPDOWNSP/CPTOPSP/CPDOWNBP/CPTOPBP: a = cell offset, count = cells
+ * - MOVSP/DECxSP/INCxSP/DECxBP/INCxBP: a = cell offset
+ * - JMP/JSR/JZ/JNZ: a = target instruction index
+ * - ACTION: a = routine, count = argument count, b = verified stack delta
+ * - DESTRUCT: count = cells removed, a = first kept cell, b = cells kept
+ * - STORE_STATE: a = global cells, b = local cells
+ *
+ * A superinstruction replaces only the first instruction of its
+ * sequence; the instructions it covers stay in place unchanged. Jumps
+ * into the middle of a sequence therefore still work, and an error
+ * raised by a fused step reports the offset of the instruction that
+ * step came from.
+ */
+typedef struct NcsVmInstruction
+{
+    uint8_t op;                        // NcsVmOp
+    uint8_t type;                      // NcsVmType for RSADD/CONST
+    uint16_t count;
+    int32_t a;
+    int32_t b;
+    uint32_t offset;                   // Byte offset in the original stream
+} NcsVmInstruction;
+
+struct NcsVmNativeScript;
+
+/**
+ * @brief Script decoded by ncs_vm_load; immutable and shareable between machines
+ */
+typedef struct NcsVmProgram
+{
+    std::vector<NcsVmInstruction> code; // Instructions plus a trailing NCS_VM_OP_END
+    std::vector<std::string> strings;   // CONSTS literals
+    uint32_t errorOffset;               // Offset of the instruction that failed to load
+    uint32_t fusedSequences;            // Superinstructions formed by ncs_vm_fuse_program
+    int verified;                       // Accepted by ncs_vm_verify: runs without bounds checks
+    uint32_t maxStackCells;             // Verified stack cells needed above the starting SP
+    uint32_t checksum;                  // FNV-1a of the loaded NCS file
+    uint64_t id;                        // Unique per ncs_vm_load call; keys per-machine caches
+    const struct NcsVmNativeScript* native; // Attached AOT translation (ncs_vm_native_attach), or NULL
+} NcsVmProgram;
+
+/**
+ * @brief Stack effect of one ACTION routine, as declared in nwscript.nss
+ *
+ * Arguments of type action are taken from the stored state and are not
+ * counted. Vectors count three cells.
+ */
+typedef struct NcsVmActionSignature
+{
+    int16_t argumentCells;             // Cells popped; -1 for an unknown routine
+    uint8_t resultCells;               // 0 (void), 1 or 3 (vector)
+    uint8_t resultType;                // NcsVmType of each result cell
+} NcsVmActionSignature;
+
+/**
+ * @brief Declaration of one engine routine, generated from nwscript.nss
+ *
+ * Tables of these are generated at build time by
+ * scripts/generate_ncs_action_table.py (see ncs_vm_actions_k2.h) and are
+ * usable in constant expressions. Arguments are pushed in declaration
+ * order, so the last argument is on top of the stack.
+ */
+typedef struct NcsVmActionInfo
+{
+    const char* name;
+    uint8_t returnType;                // NcsVmScriptType
+    uint8_t argumentCount;             // Declared parameters (the ACTION argument count)
+    uint8_t argumentCells;             // Stack cells the arguments occupy
+    uint8_t resultCells;               // Stack cells the return value occupies
+    uint8_t argumentTypes[NCS_VM_ACTION_MAX_ARGUMENTS]; // NcsVmScriptType per parameter
+    uint8_t cellTypes[NCS_VM_ACTION_MAX_CELLS];         // NcsVmType per argument cell, bottom first
+} NcsVmActionInfo;
+
+/**
+ * @brief Net stack change of a call to the routine
+ */
+static inline constexpr int ncs_vm_action_stack_delta(const NcsVmActionInfo& info)
+{
+    return (int)info.resultCells - (int)info.argumentCells;
+}
+
+/**
+ * @brief Occurrences of each operation sequence, keyed by NcsVmOp values
+ */
+typedef std::map<std::vector<uint8_t>, uint32_t> NcsVmSequenceCounts;
+
+/**
+ * @brief One 4-byte NCS stack cell with its type tag
+ */
+typedef struct NcsVmValue
+{
+    uint8_t type;                      // NcsVmType
+    union
+    {
+        int32_t i;
+        float f;
+        uint32_t handle;               // String index, object id or engine handle
+    } value;
+} NcsVmValue;
+
+/**
+ * @brief Stack cells copied out of a machine
+ *
+ * String cells hold an index into strings instead of a pool handle, so
+ * the copy stays valid after the machine reclaims its string pool and can
+ * be restored on any machine.
+ */
+typedef struct NcsVmCells
+{
+    std::vector<NcsVmValue> values;
+    std::vector<std::string> strings;  // Text of the string cells
+} NcsVmCells;
+
+/**
+ * @brief Immutable run of stack cells shared between continuations
+ */
+typedef std::shared_ptr<const NcsVmCells> NcsVmSegment;
+
+/**
+ * @brief Continuation captured by STORE_STATE for a deferred action
+ *
+ * Only the cells the action references are kept: the globals below BP
+ * and the local frame slice below SP. The globals segment is shared
+ * copy-on-write: consecutive captures reuse the same segment while the
+ * globals are unchanged, so queuing many delayed actions copies only
+ * their local slices. Resuming pushes globals, points BP at the first
+ * local and runs the block that follows the STORE_STATE/JMP pair until
+ * its RETN. A state carries its own string texts and outlives the run
+ * (and the machine) that captured it.
+ */
+typedef struct NcsVmSavedState
+{
+    uint32_t resumeIndex;              // Instruction index of the deferred block
+    NcsVmSegment globals;              // BP-relative cells saved by STORE_STATE (shared; may be null when empty)
+    NcsVmCells locals;                 // SP-relative cells saved by STORE_STATE
+} NcsVmSavedState;
+
+struct NcsVm;
+struct NcsVmCommandBuffer;
+struct NcsVmProfiler;
+struct NcsVmTraceRecorder;
+
+/**
+ * @brief Engine routine implementation
+ *
+ * Pops its arguments with the ncs_vm_pop_* helpers (last argument on top;
+ * arguments of type action are taken with ncs_vm_take_stored_state) and
+ * pushes its return value, if any.
+ *
+ * @param vm Running machine
+ * @param routine ACTION routine number (index into nwscript.nss)
+ * @param argumentCount Argument count encoded in the instruction
+ * @param userData Pointer given at registration
+ * @return NCS_VM_OK or an NcsVmResult error that aborts the run
+ */
+typedef int (*NcsVmActionHandler)(struct NcsVm* vm, uint16_t routine, uint8_t argumentCount, void* userData);
+
+typedef struct NcsVmAction
+{
+    NcsVmActionHandler handler;
+    void* userData;
+} NcsVmAction;
+
+/**
+ * @brief Machine state; reusable across runs
+ */
+typedef struct NcsVm
+{
+    std::vector<NcsVmValue> stack;     // Fixed capacity, cells [0, sp) are live
+    uint32_t sp;                       // Stack pointer in cells
+    uint32_t bp;                       // Base pointer in cells
+    std::vector<uint32_t> returns;     // Return stack (instruction indices), separate from data stack
+    std::vector<std::string> strings;  // String pool; handle 0 is "", reclaimed at the start of each run
+    uint64_t stringProgram;            // id of the program whose literals start at stringBase (0 = none)
+    uint32_t stringBase;               // Pool handle of the first literal of that program
+    std::vector<NcsVmAction> actions;  // Indexed by routine number
+    NcsVmAction defaultAction;         // Used when no routine-specific handler is registered
+    NcsVmSavedState storedState;       // Last STORE_STATE snapshot
+    NcsVmSegment globalsSegment;       // Last captured globals, reused until globalsDirty is set
+    uint32_t globalsBase;              // Stack index globalsSegment was captured from
+    int globalsDirty;                  // A cell below BP may have changed since globalsSegment was captured
+    int hasStoredState;                // storedState is valid and not yet taken
+    uint32_t objectSelf;               // Value pushed for OBJECT_SELF (CONSTO 0)
+    struct NcsVmCommandBuffer* commands; // Deferred engine commands (set by ncs_vm_scheduler_run)
+    struct NcsVmProfiler* profiler;    // Attached profiler, NULL when not profiling
+    struct NcsVmTraceRecorder* recorder; // Attached trace recorder, NULL when not recording
+    uint64_t budgetInstructions;       // Instructions per slice (0 = unlimited)
+    uint64_t budgetMicroseconds;       // Wall-clock time per slice (0 = unlimited)
+    uint64_t sliceInstructions;        // Instructions executed by the last run or resume call
+    uint64_t sliceDeadline;            // steady_clock nanoseconds the current slice ends at (0 = none)
+    const NcsVmProgram* suspendedProgram; // Program of a suspended run, NULL when none
+    uint32_t resumeIndex;              // Instruction index the suspended run continues at
+    int suspendedChecked;              // Suspended run uses the bounds-checked loop
+    uint32_t errorOffset;              // Byte offset of the failing instruction
+} NcsVm;
+
+// ============================================================================
+// LIFECYCLE AND REGISTRATION
+// ============================================================================
+
+/**
+ * @brief Initialize a machine with an empty stack
+ *
+ * @param vm Machine to initialize
+ * @param stackCells Stack capacity in 4-byte cells (0 = NCS_VM_DEFAULT_STACK_CELLS)
+ */
+void ncs_vm_init(NcsVm* vm, uint32_t stackCells);
+
+/**
+ * @brief Clear the stack, return stack, string pool, stored state and any suspended run
+ */
+void ncs_vm_reset(NcsVm* vm);
+
+/**
+ * @brief Limit how long one run or resume call may execute
+ *
+ * Instructions are counted in original NCS instructions (a superinstruction
+ * counts every instruction it covers) and charged at control transfers, so
+ * a slice may overrun by one straight-line block. The clock is read every
+ * NCS_VM_CLOCK_INTERVAL instructions. A run that exhausts either budget
+ * returns NCS_VM_SUSPENDED with its stack, frames and position kept in the
+ * machine; ncs_vm_resume continues it with a fresh slice.
+ *
+ * @param vm Machine
+ * @param instructions Instructions per slice (0 = unlimited)
+ * @param microseconds Wall-clock time per slice (0 = unlimited)
+ */
+void ncs_vm_set_budget(NcsVm* vm, uint64_t instructions, uint64_t microseconds);
+
+/**
+ * @brief Register the handler for one ACTION routine
+ */
+void ncs_vm_register_action(NcsVm* vm, uint16_t routine, NcsVmActionHandler handler, void* userData);
+
+/**
+ * @brief Register the handler used for routines without their own handler
+ */
+void ncs_vm_set_default_action(NcsVm* vm, NcsVmActionHandler handler, void* userData);
+
+/**
+ * @brief Human-readable description of an NcsVmResult
+ */
+const char* ncs_vm_result_string(int result);
+
+/**
+ * @brief Mnemonic of an NcsVmOp (e.g. "ADDII", "CPTOPSP_JZ")
+ */
+const char* ncs_vm_op_name(int op);
+
+// ============================================================================
+// EXECUTION
+// ============================================================================
+
+/**
+ * @brief Validate and decode an "NCS V1.0B" stream once
+ *
+ * Checks the header and size field, resolves every opcode/qualifier pair
+ * to an NcsVmOp, converts big-endian operands to host order, stack
+ * offsets to cells and jumps to instruction indices. Nothing the VM
+ * executes afterwards touches the raw bytes.
+ *
+ * @param data Complete NCS file contents
+ * @param size Byte count of data
+ * @param program Receives the loaded script
+ * @return NCS_VM_OK or an NcsVmResult error (program->errorOffset is set)
+ */
+int ncs_vm_load(const uint8_t* data, size_t size, NcsVmProgram* program);
+
+/**
+ * @brief ncs_vm_load with NCS_VM_LOAD_* flags
+ */
+int ncs_vm_load_with_flags(const uint8_t* data, size_t size, uint32_t flags, NcsVmProgram* program);
+
+/**
+ * @brief Run a loaded script from its first instruction until the outermost RETN
+ *
+ * The stack is not cleared, so a host can push values first; whatever the
+ * script leaves (e.g. the StartingConditional result) stays on the stack.
+ * The string pool is reclaimed first: only strings on the stack survive.
+ * A verified program runs unchecked when program->maxStackCells fit above
+ * the current SP, and with bounds checks otherwise. An attached native
+ * translation is used when no budget, profiler or recorder is set and the
+ * program would run unchecked.
+ *
+ * @param vm Machine
+ * @param program Script from ncs_vm_load
+ * @return NCS_VM_OK, NCS_VM_SUSPENDED under a budget (see ncs_vm_set_budget),
+ *         or an NcsVmResult error (vm->errorOffset is set)
+ */
+int ncs_vm_run_program(NcsVm* vm, const NcsVmProgram* program);
+
+/**
+ * @brief Load and run a script in one call (no program reuse)
+ */
+int ncs_vm_run(NcsVm* vm, const uint8_t* code, uint32_t size);
+
+/**
+ * @brief Run a deferred action captured by STORE_STATE
+ *
+ * @param vm Machine (its stack is replaced by the saved state)
+ * @param program The script the state was captured from
+ * @param state State taken with ncs_vm_take_stored_state
+ * @return NCS_VM_OK, NCS_VM_SUSPENDED or an NcsVmResult error
+ */
+int ncs_vm_run_state(NcsVm* vm, const NcsVmProgram* program, const NcsVmSavedState* state);
+
+/**
+ * @brief Continue a run that returned NCS_VM_SUSPENDED for another slice
+ *
+ * The program passed to the suspended run must still be alive. Starting
+ * another run on the machine abandons the suspended one.
+ *
+ * @param vm Machine holding the suspended run
+ * @return NCS_VM_OK, NCS_VM_SUSPENDED again, NCS_VM_ERROR_NOT_SUSPENDED,
+ *         or an NcsVmResult error
+ */
+int ncs_vm_resume(NcsVm* vm);
+
+/**
+ * @brief Whether the machine holds a run that can be resumed
+ */
+int ncs_vm_is_suspended(const NcsVm* vm);
+
+// ============================================================================
+// ACTION TABLES
+// ============================================================================
+
+/**
+ * @brief The generated KotOR 2 table (NCS_VM_K2_ACTIONS)
+ *
+ * @param count Receives the number of routines
+ */
+const NcsVmActionInfo* ncs_vm_k2_actions(size_t* count);
+
+/**
+ * @brief Look up a routine in a table, or NULL if out of range
+ */
+const NcsVmActionInfo* ncs_vm_find_action(const NcsVmActionInfo* table, size_t count, uint16_t routine);
+
+/**
+ * @brief Derive the ncs_vm_verify signatures from an action table
+ */
+void ncs_vm_action_signatures(const NcsVmActionInfo* table, size_t count,
+                              std::vector<NcsVmActionSignature>* signatures);
+
+/**
+ * @brief Pop all arguments of a routine in one step using its cell layout
+ *
+ * Checks the cell types against info->cellTypes (ints and floats satisfy
+ * each other, as in ncs_vm_pop_int/ncs_vm_pop_float) and copies the cells,
+ * bottom first, so cells[0] starts the first argument.
+ *
+ * @param vm Running machine
+ * @param info Routine being executed
+ * @param cells Receives info->argumentCells values
+ * @return NCS_VM_OK, NCS_VM_ERROR_STACK_UNDERFLOW or NCS_VM_ERROR_TYPE_MISMATCH
+ */
+int ncs_vm_pop_arguments(NcsVm* vm, const NcsVmActionInfo* info, NcsVmValue* cells);
+
+// ============================================================================
+// VERIFICATION
+// ============================================================================
+
+/**
+ * @brief Prove a loaded script stack-safe so it can run unchecked
+ *
+ * Abstract interpretation over the control-flow graph of every
+ * subroutine, tracking the stack depth and a type for each cell
+ * (int/float/string/object/engine type, or unknown). Subroutines are
+ * summarized once per entry BP (net depth change, lowest caller cell
+ * reached, peak depth, result types) and the summary is applied at each
+ * JSR; one that executes SAVEBP, like the globals routine around main, is
+ * summarized per absolute entry depth, which is passed down through every
+ * JSR from the roots. The verifier proves that:
+ * - every CPTOPSP/CPDOWNSP/MOVSP/DESTRUCT and BP-relative access stays
+ *   inside the live stack,
+ * - the depth agrees wherever paths merge, so every JSR is matched by a
+ *   RETN with the same net effect,
+ * - typed operations see operands of their type where the type is known,
+ * - no path runs past the last instruction.
+ * STORE_STATE blocks are checked as separate entry points. Recursion is
+ * reported as NCS_VM_ERROR_UNSUPPORTED; such scripts still run checked.
+ *
+ * On success sets program->verified and program->maxStackCells and
+ * records each ACTION's stack delta, which the VM checks after the
+ * handler returns.
+ *
+ * @param program Script from ncs_vm_load
+ * @param signatures Stack effect per routine number
+ * @param signatureCount Entries in signatures
+ * @return NCS_VM_OK or the NcsVmResult that rejects the script (program->errorOffset is set)
+ */
+int ncs_vm_verify(NcsVmProgram* program, const NcsVmActionSignature* signatures, size_t signatureCount);
+
+// ============================================================================
+// SUPERINSTRUCTIONS
+// ============================================================================
+
+/**
+ * @brief Replace frequent instruction sequences with superinstructions
+ *
+ * Called by ncs_vm_load unless NCS_VM_LOAD_NO_FUSION is given. The
+ * sequences fused are the most frequent ones in compiled scripts:
+ * assignments (CPDOWNSP+MOVSP, CONST+CPDOWNSP+MOVSP), compound assignment
+ * (CPTOPSP+CONSTI+ADDII/SUBII+CPDOWNSP+MOVSP), tests of a local
+ * (CPTOPSP+JZ/JNZ) and int comparisons feeding a branch. Operand
+ * constraints (single cells, int constants) are checked here so the
+ * fused handlers only check stack bounds.
+ *
+ * @return Number of sequences fused
+ */
+uint32_t ncs_vm_fuse_program(NcsVmProgram* program);
+
+/**
+ * @brief Count the operation sequences of a given length in a script
+ *
+ * Load the script with NCS_VM_LOAD_NO_FUSION. Sequences containing a
+ * control transfer before their last operation are skipped because they
+ * cannot be fused. Counts accumulate, so a corpus is measured by calling
+ * this once per script.
+ *
+ * @param program Unfused script
+ * @param length Operations per sequence (n-gram length)
+ * @param counts Receives the counts (not cleared)
+ */
+void ncs_vm_count_sequences(const NcsVmProgram* program, size_t length, NcsVmSequenceCounts* counts);
+
+/**
+ * @brief Print the most frequent sequences, most frequent first
+ *
+ * @param counts Counts from ncs_vm_count_sequences
+ * @param limit Maximum number of lines (0 = all)
+ * @param stream Output stream
+ */
+void ncs_vm_print_sequences(const NcsVmSequenceCounts* counts, size_t limit, FILE* stream);
+
+// ============================================================================
+// ACTION HANDLER HELPERS
+// ============================================================================
+
+int ncs_vm_push_int(NcsVm* vm, int32_t value);
+int ncs_vm_push_float(NcsVm* vm, float value);
+int ncs_vm_push_string(NcsVm* vm, const char* text);
+int ncs_vm_push_object(NcsVm* vm, uint32_t object);
+int ncs_vm_push_vector(NcsVm* vm, float x, float y, float z);
+int ncs_vm_push_handle(NcsVm* vm, uint8_t type, uint32_t handle);
+
+int ncs_vm_pop_int(NcsVm* vm, int32_t* value);
+int ncs_vm_pop_float(NcsVm* vm, float* value);
+int ncs_vm_pop_string(NcsVm* vm, std::string* text);
+int ncs_vm_pop_object(NcsVm* vm, uint32_t* object);
+int ncs_vm_pop_vector(NcsVm* vm, float* x, float* y, float* z);
+int ncs_vm_pop_handle(NcsVm* vm, uint8_t type, uint32_t* handle);
+
+/**
+ * @brief Take the state stored by the last STORE_STATE (action-typed argument)
+ *
+ * @return NCS_VM_OK, or NCS_VM_ERROR_NO_STORED_STATE if none is pending
+ */
+int ncs_vm_take_stored_state(NcsVm* vm, NcsVmSavedState* state);
+
+/**
+ * @brief Text of a string handle (empty for unknown handles)
+ *
+ * Handles are valid until the next ncs_vm_run_program or ncs_vm_run_state
+ * on the machine (except for strings the host left on the stack for that
+ * run); copy the text, or the cells with ncs_vm_copy_cells, to keep it.
+ */
+const std::string& ncs_vm_string(const NcsVm* vm, uint32_t handle);
+
+/**
+ * @brief Copy stack cells out of a machine, taking the text of string cells with them
+ *
+ * @param vm Machine whose pool the string handles refer to
+ * @param cells First cell
+ * @param count Number of cells
+ * @param copy Receives the cells (replaced)
+ */
+void ncs_vm_copy_cells(const NcsVm* vm, const NcsVmValue* cells, size_t count, NcsVmCells* copy);
+
+// ============================================================================
+// NATIVE SCRIPT SUPPORT
+// ============================================================================
+// Operations the interpreter performs out of line, exported for code
+// generated by ncs_vm_native_emit.
+
+/**
+ * @brief Execute one ACTION: call the routine's handler with vm->sp/bp current
+ *
+ * @param vm Machine with SP and BP written back
+ * @param routine Routine number
+ * @param argumentCount Argument count encoded in the instruction
+ * @param stackDelta Verified net stack change the handler must produce
+ * @return NCS_VM_OK, the handler's error, NCS_VM_ERROR_UNKNOWN_ACTION or
+ *         NCS_VM_ERROR_ACTION_SIGNATURE
+ */
+int ncs_vm_call_action(NcsVm* vm, uint16_t routine, uint8_t argumentCount, int32_t stackDelta);
+
+/**
+ * @brief Execute STORE_STATE with vm->sp/bp current
+ *
+ * @param resumeIndex Instruction index of the deferred block
+ * @param globalCells Cells to save below BP
+ * @param localCells Cells to save below SP
+ */
+int ncs_vm_store_state(NcsVm* vm, uint32_t resumeIndex, uint32_t globalCells, uint32_t localCells);
+
+/**
+ * @brief Cell equality used by EQUALxx/NEQUALxx (strings compare by text)
+ */
+bool ncs_vm_values_equal(const NcsVm* vm, const NcsVmValue* a, const NcsVmValue* b);
+
+/**
+ * @brief Add text to the string pool and return its handle
+ */
+uint32_t ncs_vm_new_string(NcsVm* vm, const std::string& text);
+
+#endif // NCS_VM_H
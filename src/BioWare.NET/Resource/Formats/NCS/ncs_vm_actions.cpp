@@ -0,0 +1,74 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - ENGINE ACTION TABLES
+// ============================================================================
+
+#include "ncs_vm.h"
+#include "ncs_vm_actions_k2.h"
+
+#include <string.h>
+
+// The table is a constant expression: layouts are known at compile time
+static_assert(NCS_VM_K2_ACTION_COUNT > 0, "k2_nwscript.nss declared no routines");
+static_assert(ncs_vm_action_stack_delta(NCS_VM_K2_ACTIONS[0]) == 0, "Random(int) pops one int and pushes one int");
+
+const NcsVmActionInfo* ncs_vm_k2_actions(size_t* count)
+{
+    *count = NCS_VM_K2_ACTION_COUNT;
+    return NCS_VM_K2_ACTIONS;
+}
+
+const NcsVmActionInfo* ncs_vm_find_action(const NcsVmActionInfo* table, size_t count, uint16_t routine)
+{
+    return routine < count ? &table[routine] : NULL;
+}
+
+void ncs_vm_action_signatures(const NcsVmActionInfo* table, size_t count,
+                              std::vector<NcsVmActionSignature>* signatures)
+{
+    signatures->resize(count);
+    for (size_t i = 0; i < count; i++) {
+        NcsVmActionSignature& signature = (*signatures)[i];
+        signature.argumentCells = table[i].argumentCells;
+        signature.resultCells = table[i].resultCells;
+        switch (table[i].returnType) {
+            case NCS_VM_SCRIPT_FLOAT:
+            case NCS_VM_SCRIPT_VECTOR:   signature.resultType = NCS_VM_TYPE_FLOAT; break;
+            case NCS_VM_SCRIPT_STRING:   signature.resultType = NCS_VM_TYPE_STRING; break;
+            case NCS_VM_SCRIPT_OBJECT:   signature.resultType = NCS_VM_TYPE_OBJECT; break;
+            case NCS_VM_SCRIPT_EFFECT:   signature.resultType = NCS_VM_TYPE_EFFECT; break;
+            case NCS_VM_SCRIPT_EVENT:    signature.resultType = NCS_VM_TYPE_EVENT; break;
+            case NCS_VM_SCRIPT_LOCATION: signature.resultType = NCS_VM_TYPE_LOCATION; break;
+            case NCS_VM_SCRIPT_TALENT:   signature.resultType = NCS_VM_TYPE_TALENT; break;
+            default:                     signature.resultType = NCS_VM_TYPE_INT; break;
+        }
+    }
+}
+
+int ncs_vm_pop_arguments(NcsVm* vm, const NcsVmActionInfo* info, NcsVmValue* cells)
+{
+    uint32_t count = info->argumentCells;
+    if (vm->sp < count) {
+        return NCS_VM_ERROR_STACK_UNDERFLOW;
+    }
+
+    const NcsVmValue* source = &vm->stack[vm->sp - count];
+    memcpy(cells, source, count * sizeof(NcsVmValue));
+    for (uint32_t k = 0; k < count; k++) {
+        uint8_t expected = info->cellTypes[k];
+        if (cells[k].type == expected) {
+            continue;
+        }
+        if (expected == NCS_VM_TYPE_FLOAT && cells[k].type == NCS_VM_TYPE_INT) {
+            cells[k].value.f = (float)cells[k].value.i;
+        }
+        else if (expected == NCS_VM_TYPE_INT && cells[k].type == NCS_VM_TYPE_FLOAT) {
+            cells[k].value.i = (int32_t)cells[k].value.f;
+        }
+        else {
+            return NCS_VM_ERROR_TYPE_MISMATCH;
+        }
+        cells[k].type = expected;
+    }
+    vm->sp -= count;
+    return NCS_VM_OK;
+}
@@ -0,0 +1,2649 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - KOTOR 2 ACTION TABLE
+// ============================================================================
+// GENERATED by scripts/generate_ncs_action_table.py from include/k2_nwscript.nss.
+// Do not edit; rerun the script after changing the nwscript definitions.
+// ============================================================================
+
+#ifndef NCS_VM_ACTIONS_K2_H
+#define NCS_VM_ACTIONS_K2_H
+
+#include "ncs_vm.h"
+
+#define NCS_VM_K2_ACTION_COUNT 877
+
+static constexpr NcsVmActionInfo NCS_VM_K2_ACTIONS[NCS_VM_K2_ACTION_COUNT] = {
+    /*   0 */ { "Random", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*   1 */ { "PrintString", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /*   2 */ { "PrintFloat", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /*   3 */ { "FloatToString", NCS_VM_SCRIPT_STRING, 3, 3, 1,
+              { NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /*   4 */ { "PrintInteger", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*   5 */ { "PrintObject", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*   6 */ { "AssignCommand", NCS_VM_SCRIPT_VOID, 2, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_ACTION },
+              { NCS_VM_TYPE_OBJECT } },
+    /*   7 */ { "DelayCommand", NCS_VM_SCRIPT_VOID, 2, 1, 0,
+              { NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_ACTION },
+              { NCS_VM_TYPE_FLOAT } },
+    /*   8 */ { "ExecuteScript", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /*   9 */ { "ClearAllActions", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /*  10 */ { "SetFacing", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /*  11 */ { "SwitchPlayerCharacter", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*  12 */ { "SetTime", NCS_VM_SCRIPT_VOID, 4, 4, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /*  13 */ { "SetPartyLeader", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*  14 */ { "SetAreaUnescapable", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*  15 */ { "GetAreaUnescapable", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /*  16 */ { "GetTimeHour", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /*  17 */ { "GetTimeMinute", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /*  18 */ { "GetTimeSecond", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /*  19 */ { "GetTimeMillisecond", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /*  20 */ { "ActionRandomWalk", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /*  21 */ { "ActionMoveToLocation", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_INT } },
+    /*  22 */ { "ActionMoveToObject", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT } },
+    /*  23 */ { "ActionMoveAwayFromObject", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT } },
+    /*  24 */ { "GetArea", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  25 */ { "GetEnteringObject", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /*  26 */ { "GetExitingObject", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /*  27 */ { "GetPosition", NCS_VM_SCRIPT_VECTOR, 1, 1, 3,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  28 */ { "GetFacing", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  29 */ { "GetItemPossessor", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  30 */ { "GetItemPossessedBy", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_STRING } },
+    /*  31 */ { "CreateItemOnObject", NCS_VM_SCRIPT_OBJECT, 4, 4, 1,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /*  32 */ { "ActionEquipItem", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /*  33 */ { "ActionUnequipItem", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /*  34 */ { "ActionPickUpItem", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  35 */ { "ActionPutDownItem", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  36 */ { "GetLastAttacker", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  37 */ { "ActionAttack", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /*  38 */ { "GetNearestCreature", NCS_VM_SCRIPT_OBJECT, 8, 8, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /*  39 */ { "ActionSpeakString", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /*  40 */ { "ActionPlayAnimation", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /*  41 */ { "GetDistanceToObject", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  42 */ { "GetIsObjectValid", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  43 */ { "ActionOpenDoor", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  44 */ { "ActionCloseDoor", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  45 */ { "SetCameraFacing", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /*  46 */ { "PlaySound", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /*  47 */ { "GetSpellTargetObject", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /*  48 */ { "ActionCastSpellAtObject", NCS_VM_SCRIPT_VOID, 7, 7, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /*  49 */ { "GetCurrentHitPoints", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  50 */ { "GetMaxHitPoints", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  51 */ { "EffectAssuredHit", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /*  52 */ { "GetLastItemEquipped", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /*  53 */ { "GetSubScreenID", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /*  54 */ { "CancelCombat", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  55 */ { "GetCurrentForcePoints", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  56 */ { "GetMaxForcePoints", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  57 */ { "PauseGame", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*  58 */ { "SetPlayerRestrictMode", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*  59 */ { "GetStringLength", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /*  60 */ { "GetStringUpperCase", NCS_VM_SCRIPT_STRING, 1, 1, 1,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /*  61 */ { "GetStringLowerCase", NCS_VM_SCRIPT_STRING, 1, 1, 1,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /*  62 */ { "GetStringRight", NCS_VM_SCRIPT_STRING, 2, 2, 1,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /*  63 */ { "GetStringLeft", NCS_VM_SCRIPT_STRING, 2, 2, 1,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /*  64 */ { "InsertString", NCS_VM_SCRIPT_STRING, 3, 3, 1,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /*  65 */ { "GetSubString", NCS_VM_SCRIPT_STRING, 3, 3, 1,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /*  66 */ { "FindSubString", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING } },
+    /*  67 */ { "fabs", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /*  68 */ { "cos", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /*  69 */ { "sin", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /*  70 */ { "tan", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /*  71 */ { "acos", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /*  72 */ { "asin", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /*  73 */ { "atan", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /*  74 */ { "log", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /*  75 */ { "pow", NCS_VM_SCRIPT_FLOAT, 2, 2, 1,
+              { NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /*  76 */ { "sqrt", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /*  77 */ { "abs", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*  78 */ { "EffectHeal", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*  79 */ { "EffectDamage", NCS_VM_SCRIPT_EFFECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /*  80 */ { "EffectAbilityIncrease", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /*  81 */ { "EffectDamageResistance", NCS_VM_SCRIPT_EFFECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /*  82 */ { "EffectResurrection", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*  83 */ { "GetPlayerRestrictMode", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  84 */ { "GetCasterLevel", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  85 */ { "GetFirstEffect", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  86 */ { "GetNextEffect", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /*  87 */ { "RemoveEffect", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_EFFECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_EFFECT } },
+    /*  88 */ { "GetIsEffectValid", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_EFFECT },
+              { NCS_VM_TYPE_EFFECT } },
+    /*  89 */ { "GetEffectDurationType", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_EFFECT },
+              { NCS_VM_TYPE_EFFECT } },
+    /*  90 */ { "GetEffectSubType", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_EFFECT },
+              { NCS_VM_TYPE_EFFECT } },
+    /*  91 */ { "GetEffectCreator", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_EFFECT },
+              { NCS_VM_TYPE_EFFECT } },
+    /*  92 */ { "IntToString", NCS_VM_SCRIPT_STRING, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*  93 */ { "GetFirstObjectInArea", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /*  94 */ { "GetNextObjectInArea", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /*  95 */ { "d2", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*  96 */ { "d3", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*  97 */ { "d4", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*  98 */ { "d6", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /*  99 */ { "d8", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 100 */ { "d10", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 101 */ { "d12", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 102 */ { "d20", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 103 */ { "d100", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 104 */ { "VectorMagnitude", NCS_VM_SCRIPT_FLOAT, 1, 3, 1,
+              { NCS_VM_SCRIPT_VECTOR },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 105 */ { "GetMetaMagicFeat", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 106 */ { "GetObjectType", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 107 */ { "GetRacialType", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 108 */ { "FortitudeSave", NCS_VM_SCRIPT_INT, 4, 4, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 109 */ { "ReflexSave", NCS_VM_SCRIPT_INT, 4, 4, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 110 */ { "WillSave", NCS_VM_SCRIPT_INT, 4, 4, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 111 */ { "GetSpellSaveDC", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 112 */ { "MagicalEffect", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_EFFECT },
+              { NCS_VM_TYPE_EFFECT } },
+    /* 113 */ { "SupernaturalEffect", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_EFFECT },
+              { NCS_VM_TYPE_EFFECT } },
+    /* 114 */ { "ExtraordinaryEffect", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_EFFECT },
+              { NCS_VM_TYPE_EFFECT } },
+    /* 115 */ { "EffectACIncrease", NCS_VM_SCRIPT_EFFECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 116 */ { "GetAC", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 117 */ { "EffectSavingThrowIncrease", NCS_VM_SCRIPT_EFFECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 118 */ { "EffectAttackIncrease", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 119 */ { "EffectDamageReduction", NCS_VM_SCRIPT_EFFECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 120 */ { "EffectDamageIncrease", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 121 */ { "RoundsToSeconds", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 122 */ { "HoursToSeconds", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 123 */ { "TurnsToSeconds", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 124 */ { "SoundObjectSetFixedVariance", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_FLOAT } },
+    /* 125 */ { "GetGoodEvilValue", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 126 */ { "GetPartyMemberCount", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 127 */ { "GetAlignmentGoodEvil", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 128 */ { "GetFirstObjectInShape", NCS_VM_SCRIPT_OBJECT, 6, 8, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_VECTOR },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 129 */ { "GetNextObjectInShape", NCS_VM_SCRIPT_OBJECT, 6, 8, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_VECTOR },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 130 */ { "EffectEntangle", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 131 */ { "SignalEvent", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_EVENT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_EVENT } },
+    /* 132 */ { "EventUserDefined", NCS_VM_SCRIPT_EVENT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 133 */ { "EffectDeath", NCS_VM_SCRIPT_EFFECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 134 */ { "EffectKnockdown", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 135 */ { "ActionGiveItem", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 136 */ { "ActionTakeItem", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 137 */ { "VectorNormalize", NCS_VM_SCRIPT_VECTOR, 1, 3, 3,
+              { NCS_VM_SCRIPT_VECTOR },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 138 */ { "GetItemStackSize", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 139 */ { "GetAbilityScore", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 140 */ { "GetIsDead", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 141 */ { "PrintVector", NCS_VM_SCRIPT_VOID, 2, 4, 0,
+              { NCS_VM_SCRIPT_VECTOR, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_INT } },
+    /* 142 */ { "Vector", NCS_VM_SCRIPT_VECTOR, 3, 3, 3,
+              { NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 143 */ { "SetFacingPoint", NCS_VM_SCRIPT_VOID, 1, 3, 0,
+              { NCS_VM_SCRIPT_VECTOR },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 144 */ { "AngleToVector", NCS_VM_SCRIPT_VECTOR, 1, 1, 3,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 145 */ { "VectorToAngle", NCS_VM_SCRIPT_FLOAT, 1, 3, 1,
+              { NCS_VM_SCRIPT_VECTOR },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 146 */ { "TouchAttackMelee", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 147 */ { "TouchAttackRanged", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 148 */ { "EffectParalyze", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 149 */ { "EffectSpellImmunity", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 150 */ { "SetItemStackSize", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 151 */ { "GetDistanceBetween", NCS_VM_SCRIPT_FLOAT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 152 */ { "SetReturnStrref", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 153 */ { "EffectForceJump", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 154 */ { "EffectSleep", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 155 */ { "GetItemInSlot", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 156 */ { "EffectTemporaryForcePoints", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 157 */ { "EffectConfused", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 158 */ { "EffectFrightened", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 159 */ { "EffectChoke", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 160 */ { "SetGlobalString", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING } },
+    /* 161 */ { "EffectStunned", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 162 */ { "SetCommandable", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 163 */ { "GetCommandable", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 164 */ { "EffectRegenerate", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT } },
+    /* 165 */ { "EffectMovementSpeedIncrease", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 166 */ { "GetHitDice", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 167 */ { "ActionForceFollowObject", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_FLOAT } },
+    /* 168 */ { "GetTag", NCS_VM_SCRIPT_STRING, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 169 */ { "ResistForce", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 170 */ { "GetEffectType", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_EFFECT },
+              { NCS_VM_TYPE_EFFECT } },
+    /* 171 */ { "EffectAreaOfEffect", NCS_VM_SCRIPT_EFFECT, 4, 4, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING } },
+    /* 172 */ { "GetFactionEqual", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 173 */ { "ChangeFaction", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 174 */ { "GetIsListening", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 175 */ { "SetListening", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 176 */ { "SetListenPattern", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /* 177 */ { "TestStringAgainstPattern", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING } },
+    /* 178 */ { "GetMatchedSubstring", NCS_VM_SCRIPT_STRING, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 179 */ { "GetMatchedSubstringsCount", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 180 */ { "EffectVisualEffect", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 181 */ { "GetFactionWeakestMember", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 182 */ { "GetFactionStrongestMember", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 183 */ { "GetFactionMostDamagedMember", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 184 */ { "GetFactionLeastDamagedMember", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 185 */ { "GetFactionGold", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 186 */ { "GetFactionAverageReputation", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 187 */ { "GetFactionAverageGoodEvilAlignment", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 188 */ { "SoundObjectGetFixedVariance", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 189 */ { "GetFactionAverageLevel", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 190 */ { "GetFactionAverageXP", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 191 */ { "GetFactionMostFrequentClass", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 192 */ { "GetFactionWorstAC", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 193 */ { "GetFactionBestAC", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 194 */ { "GetGlobalString", NCS_VM_SCRIPT_STRING, 1, 1, 1,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /* 195 */ { "GetListenPatternNumber", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 196 */ { "ActionJumpToObject", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 197 */ { "GetWaypointByTag", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /* 198 */ { "GetTransitionTarget", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 199 */ { "EffectLinkEffects", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_EFFECT, NCS_VM_SCRIPT_EFFECT },
+              { NCS_VM_TYPE_EFFECT, NCS_VM_TYPE_EFFECT } },
+    /* 200 */ { "GetObjectByTag", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /* 201 */ { "AdjustAlignment", NCS_VM_SCRIPT_VOID, 4, 4, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 202 */ { "ActionWait", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 203 */ { "SetAreaTransitionBMP", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_STRING } },
+    /* 204 */ { "ActionStartConversation", NCS_VM_SCRIPT_VOID, 15, 15, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 205 */ { "ActionPauseConversation", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 206 */ { "ActionResumeConversation", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 207 */ { "EffectBeam", NCS_VM_SCRIPT_EFFECT, 4, 4, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 208 */ { "GetReputation", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 209 */ { "AdjustReputation", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 210 */ { "GetModuleFileName", NCS_VM_SCRIPT_STRING, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 211 */ { "GetGoingToBeAttackedBy", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 212 */ { "EffectForceResistanceIncrease", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 213 */ { "GetLocation", NCS_VM_SCRIPT_LOCATION, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 214 */ { "ActionJumpToLocation", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_LOCATION },
+              { NCS_VM_TYPE_LOCATION } },
+    /* 215 */ { "Location", NCS_VM_SCRIPT_LOCATION, 2, 4, 1,
+              { NCS_VM_SCRIPT_VECTOR, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 216 */ { "ApplyEffectAtLocation", NCS_VM_SCRIPT_VOID, 4, 4, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_EFFECT, NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_EFFECT, NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_FLOAT } },
+    /* 217 */ { "GetIsPC", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 218 */ { "FeetToMeters", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 219 */ { "YardsToMeters", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 220 */ { "ApplyEffectToObject", NCS_VM_SCRIPT_VOID, 4, 4, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_EFFECT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_EFFECT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_FLOAT } },
+    /* 221 */ { "SpeakString", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /* 222 */ { "GetSpellTargetLocation", NCS_VM_SCRIPT_LOCATION, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 223 */ { "GetPositionFromLocation", NCS_VM_SCRIPT_VECTOR, 1, 1, 3,
+              { NCS_VM_SCRIPT_LOCATION },
+              { NCS_VM_TYPE_LOCATION } },
+    /* 224 */ { "EffectBodyFuel", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 225 */ { "GetFacingFromLocation", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_LOCATION },
+              { NCS_VM_TYPE_LOCATION } },
+    /* 226 */ { "GetNearestCreatureToLocation", NCS_VM_SCRIPT_OBJECT, 8, 8, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 227 */ { "GetNearestObject", NCS_VM_SCRIPT_OBJECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 228 */ { "GetNearestObjectToLocation", NCS_VM_SCRIPT_OBJECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_INT } },
+    /* 229 */ { "GetNearestObjectByTag", NCS_VM_SCRIPT_OBJECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 230 */ { "IntToFloat", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 231 */ { "FloatToInt", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 232 */ { "StringToInt", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /* 233 */ { "StringToFloat", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /* 234 */ { "ActionCastSpellAtLocation", NCS_VM_SCRIPT_VOID, 6, 6, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 235 */ { "GetIsEnemy", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 236 */ { "GetIsFriend", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 237 */ { "GetIsNeutral", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 238 */ { "GetPCSpeaker", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 239 */ { "GetStringByStrRef", NCS_VM_SCRIPT_STRING, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 240 */ { "ActionSpeakStringByStrRef", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 241 */ { "DestroyObject", NCS_VM_SCRIPT_VOID, 5, 5, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_INT } },
+    /* 242 */ { "GetModule", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 243 */ { "CreateObject", NCS_VM_SCRIPT_OBJECT, 4, 4, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_STRING, NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_INT } },
+    /* 244 */ { "EventSpellCastAt", NCS_VM_SCRIPT_EVENT, 3, 3, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 245 */ { "GetLastSpellCaster", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 246 */ { "GetLastSpell", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 247 */ { "GetUserDefinedEventNumber", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 248 */ { "GetSpellId", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 249 */ { "RandomName", NCS_VM_SCRIPT_STRING, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 250 */ { "EffectPoison", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 251 */ { "GetLoadFromSaveGame", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 252 */ { "EffectAssuredDeflection", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 253 */ { "GetName", NCS_VM_SCRIPT_STRING, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 254 */ { "GetLastSpeaker", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 255 */ { "BeginConversation", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_OBJECT } },
+    /* 256 */ { "GetLastPerceived", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 257 */ { "GetLastPerceptionHeard", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 258 */ { "GetLastPerceptionInaudible", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 259 */ { "GetLastPerceptionSeen", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 260 */ { "GetLastClosedBy", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 261 */ { "GetLastPerceptionVanished", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 262 */ { "GetFirstInPersistentObject", NCS_VM_SCRIPT_OBJECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 263 */ { "GetNextInPersistentObject", NCS_VM_SCRIPT_OBJECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 264 */ { "GetAreaOfEffectCreator", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 265 */ { "ShowLevelUpGUI", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 266 */ { "SetItemNonEquippable", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 267 */ { "GetButtonMashCheck", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 268 */ { "SetButtonMashCheck", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 269 */ { "EffectForcePushTargeted", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_INT } },
+    /* 270 */ { "EffectHaste", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 271 */ { "GiveItem", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 272 */ { "ObjectToString", NCS_VM_SCRIPT_STRING, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 273 */ { "EffectImmunity", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 274 */ { "GetIsImmune", NCS_VM_SCRIPT_INT, 3, 3, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 275 */ { "EffectDamageImmunityIncrease", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 276 */ { "GetEncounterActive", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 277 */ { "SetEncounterActive", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 278 */ { "GetEncounterSpawnsMax", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 279 */ { "SetEncounterSpawnsMax", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 280 */ { "GetEncounterSpawnsCurrent", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 281 */ { "SetEncounterSpawnsCurrent", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 282 */ { "GetModuleItemAcquired", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 283 */ { "GetModuleItemAcquiredFrom", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 284 */ { "SetCustomToken", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_STRING } },
+    /* 285 */ { "GetHasFeat", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 286 */ { "GetHasSkill", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 287 */ { "ActionUseFeat", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 288 */ { "ActionUseSkill", NCS_VM_SCRIPT_VOID, 4, 4, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 289 */ { "GetObjectSeen", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 290 */ { "GetObjectHeard", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 291 */ { "GetLastPlayerDied", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 292 */ { "GetModuleItemLost", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 293 */ { "GetModuleItemLostBy", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 294 */ { "ActionDoCommand", NCS_VM_SCRIPT_VOID, 1, 0, 0,
+              { NCS_VM_SCRIPT_ACTION },
+              { 0 } },
+    /* 295 */ { "EventConversation", NCS_VM_SCRIPT_EVENT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 296 */ { "SetEncounterDifficulty", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 297 */ { "GetEncounterDifficulty", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 298 */ { "GetDistanceBetweenLocations", NCS_VM_SCRIPT_FLOAT, 2, 2, 1,
+              { NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_LOCATION },
+              { NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_LOCATION } },
+    /* 299 */ { "GetReflexAdjustedDamage", NCS_VM_SCRIPT_INT, 5, 5, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 300 */ { "PlayAnimation", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 301 */ { "TalentSpell", NCS_VM_SCRIPT_TALENT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 302 */ { "TalentFeat", NCS_VM_SCRIPT_TALENT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 303 */ { "TalentSkill", NCS_VM_SCRIPT_TALENT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 304 */ { "GetHasSpellEffect", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 305 */ { "GetEffectSpellId", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_EFFECT },
+              { NCS_VM_TYPE_EFFECT } },
+    /* 306 */ { "GetCreatureHasTalent", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_TALENT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_TALENT, NCS_VM_TYPE_OBJECT } },
+    /* 307 */ { "GetCreatureTalentRandom", NCS_VM_SCRIPT_TALENT, 3, 3, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 308 */ { "GetCreatureTalentBest", NCS_VM_SCRIPT_TALENT, 6, 6, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 309 */ { "ActionUseTalentOnObject", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_TALENT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_TALENT, NCS_VM_TYPE_OBJECT } },
+    /* 310 */ { "ActionUseTalentAtLocation", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_TALENT, NCS_VM_SCRIPT_LOCATION },
+              { NCS_VM_TYPE_TALENT, NCS_VM_TYPE_LOCATION } },
+    /* 311 */ { "GetGoldPieceValue", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 312 */ { "GetIsPlayableRacialType", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 313 */ { "JumpToLocation", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_LOCATION },
+              { NCS_VM_TYPE_LOCATION } },
+    /* 314 */ { "EffectTemporaryHitpoints", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 315 */ { "GetSkillRank", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 316 */ { "GetAttackTarget", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 317 */ { "GetLastAttackType", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 318 */ { "GetLastAttackMode", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 319 */ { "GetDistanceBetween2D", NCS_VM_SCRIPT_FLOAT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 320 */ { "GetIsInCombat", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 321 */ { "GetLastAssociateCommand", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 322 */ { "GiveGoldToCreature", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 323 */ { "SetIsDestroyable", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 324 */ { "SetLocked", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 325 */ { "GetLocked", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 326 */ { "GetClickingObject", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 327 */ { "SetAssociateListenPatterns", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 328 */ { "GetLastWeaponUsed", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 329 */ { "ActionInteractObject", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 330 */ { "GetLastUsedBy", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 331 */ { "GetAbilityModifier", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 332 */ { "GetIdentified", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 333 */ { "SetIdentified", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 334 */ { "GetDistanceBetweenLocations2D", NCS_VM_SCRIPT_FLOAT, 2, 2, 1,
+              { NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_LOCATION },
+              { NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_LOCATION } },
+    /* 335 */ { "GetDistanceToObject2D", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 336 */ { "GetBlockingDoor", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 337 */ { "GetIsDoorActionPossible", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 338 */ { "DoDoorAction", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 339 */ { "GetFirstItemInInventory", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 340 */ { "GetNextItemInInventory", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 341 */ { "GetClassByPosition", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 342 */ { "GetLevelByPosition", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 343 */ { "GetLevelByClass", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 344 */ { "GetDamageDealtByType", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 345 */ { "GetTotalDamageDealt", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 346 */ { "GetLastDamager", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 347 */ { "GetLastDisarmed", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 348 */ { "GetLastDisturbed", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 349 */ { "GetLastLocked", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 350 */ { "GetLastUnlocked", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 351 */ { "EffectSkillIncrease", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 352 */ { "GetInventoryDisturbType", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 353 */ { "GetInventoryDisturbItem", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 354 */ { "ShowUpgradeScreen", NCS_VM_SCRIPT_VOID, 5, 5, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_STRING } },
+    /* 355 */ { "VersusAlignmentEffect", NCS_VM_SCRIPT_EFFECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_EFFECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_EFFECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 356 */ { "VersusRacialTypeEffect", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_EFFECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_EFFECT, NCS_VM_TYPE_INT } },
+    /* 357 */ { "VersusTrapEffect", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_EFFECT },
+              { NCS_VM_TYPE_EFFECT } },
+    /* 358 */ { "GetGender", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 359 */ { "GetIsTalentValid", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_TALENT },
+              { NCS_VM_TYPE_TALENT } },
+    /* 360 */ { "ActionMoveAwayFromLocation", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT } },
+    /* 361 */ { "GetAttemptedAttackTarget", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 362 */ { "GetTypeFromTalent", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_TALENT },
+              { NCS_VM_TYPE_TALENT } },
+    /* 363 */ { "GetIdFromTalent", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_TALENT },
+              { NCS_VM_TYPE_TALENT } },
+    /* 364 */ { "PlayPazaak", NCS_VM_SCRIPT_VOID, 5, 5, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 365 */ { "GetLastPazaakResult", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 366 */ { "DisplayFeedBackText", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 367 */ { "AddJournalQuestEntry", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 368 */ { "RemoveJournalQuestEntry", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /* 369 */ { "GetJournalEntry", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /* 370 */ { "PlayRumblePattern", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 371 */ { "StopRumblePattern", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 372 */ { "EffectDamageForcePoints", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 373 */ { "EffectHealForcePoints", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 374 */ { "SendMessageToPC", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_STRING } },
+    /* 375 */ { "GetAttemptedSpellTarget", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 376 */ { "GetLastOpenedBy", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 377 */ { "GetHasSpell", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 378 */ { "OpenStore", NCS_VM_SCRIPT_VOID, 4, 4, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 379 */ { "ActionSurrenderToEnemies", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 380 */ { "GetFirstFactionMember", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 381 */ { "GetNextFactionMember", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 382 */ { "ActionForceMoveToLocation", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT } },
+    /* 383 */ { "ActionForceMoveToObject", NCS_VM_SCRIPT_VOID, 4, 4, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 384 */ { "GetJournalQuestExperience", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /* 385 */ { "JumpToObject", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 386 */ { "SetMapPinEnabled", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 387 */ { "EffectHitPointChangeWhenDying", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 388 */ { "PopUpGUIPanel", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 389 */ { "AddMultiClass", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 390 */ { "GetIsLinkImmune", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_EFFECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_EFFECT } },
+    /* 391 */ { "EffectDroidStun", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 392 */ { "EffectForcePushed", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 393 */ { "GiveXPToCreature", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 394 */ { "SetXP", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 395 */ { "GetXP", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 396 */ { "IntToHexString", NCS_VM_SCRIPT_STRING, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 397 */ { "GetBaseItemType", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 398 */ { "GetItemHasItemProperty", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 399 */ { "ActionEquipMostDamagingMelee", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 400 */ { "ActionEquipMostDamagingRanged", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 401 */ { "GetItemACValue", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 402 */ { "EffectForceResisted", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 403 */ { "ExploreAreaForPlayer", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 404 */ { "ActionEquipMostEffectiveArmor", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 405 */ { "GetIsDay", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 406 */ { "GetIsNight", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 407 */ { "GetIsDawn", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 408 */ { "GetIsDusk", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 409 */ { "GetIsEncounterCreature", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 410 */ { "GetLastPlayerDying", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 411 */ { "GetStartingLocation", NCS_VM_SCRIPT_LOCATION, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 412 */ { "ChangeToStandardFaction", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 413 */ { "SoundObjectPlay", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 414 */ { "SoundObjectStop", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 415 */ { "SoundObjectSetVolume", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 416 */ { "SoundObjectSetPosition", NCS_VM_SCRIPT_VOID, 2, 4, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_VECTOR },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 417 */ { "SpeakOneLinerConversation", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_OBJECT } },
+    /* 418 */ { "GetGold", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 419 */ { "GetLastRespawnButtonPresser", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 420 */ { "EffectForceFizzle", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 421 */ { "SetLightsaberPowered", NCS_VM_SCRIPT_VOID, 4, 4, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 422 */ { "GetIsWeaponEffective", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 423 */ { "GetLastSpellHarmful", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 424 */ { "EventActivateItem", NCS_VM_SCRIPT_EVENT, 3, 3, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_OBJECT } },
+    /* 425 */ { "MusicBackgroundPlay", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 426 */ { "MusicBackgroundStop", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 427 */ { "MusicBackgroundSetDelay", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 428 */ { "MusicBackgroundChangeDay", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 429 */ { "MusicBackgroundChangeNight", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 430 */ { "MusicBattlePlay", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 431 */ { "MusicBattleStop", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 432 */ { "MusicBattleChange", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 433 */ { "AmbientSoundPlay", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 434 */ { "AmbientSoundStop", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 435 */ { "AmbientSoundChangeDay", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 436 */ { "AmbientSoundChangeNight", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 437 */ { "GetLastKiller", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 438 */ { "GetSpellCastItem", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 439 */ { "GetItemActivated", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 440 */ { "GetItemActivator", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 441 */ { "GetItemActivatedTargetLocation", NCS_VM_SCRIPT_LOCATION, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 442 */ { "GetItemActivatedTarget", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 443 */ { "GetIsOpen", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 444 */ { "TakeGoldFromCreature", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 445 */ { "GetIsInConversation", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 446 */ { "EffectAbilityDecrease", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 447 */ { "EffectAttackDecrease", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 448 */ { "EffectDamageDecrease", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 449 */ { "EffectDamageImmunityDecrease", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 450 */ { "EffectACDecrease", NCS_VM_SCRIPT_EFFECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 451 */ { "EffectMovementSpeedDecrease", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 452 */ { "EffectSavingThrowDecrease", NCS_VM_SCRIPT_EFFECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 453 */ { "EffectSkillDecrease", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 454 */ { "EffectForceResistanceDecrease", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 455 */ { "GetPlotFlag", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 456 */ { "SetPlotFlag", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 457 */ { "EffectInvisibility", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 458 */ { "EffectConcealment", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 459 */ { "EffectForceShield", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 460 */ { "EffectDispelMagicAll", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 461 */ { "SetDialogPlaceableCamera", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 462 */ { "GetSoloMode", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 463 */ { "EffectDisguise", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 464 */ { "GetMaxStealthXP", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 465 */ { "EffectTrueSeeing", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 466 */ { "EffectSeeInvisible", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 467 */ { "EffectTimeStop", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 468 */ { "SetMaxStealthXP", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 469 */ { "EffectBlasterDeflectionIncrease", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 470 */ { "EffectBlasterDeflectionDecrease", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 471 */ { "EffectHorrified", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 472 */ { "EffectSpellLevelAbsorption", NCS_VM_SCRIPT_EFFECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 473 */ { "EffectDispelMagicBest", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 474 */ { "GetCurrentStealthXP", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 475 */ { "GetNumStackedItems", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 476 */ { "SurrenderToEnemies", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 477 */ { "EffectMissChance", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 478 */ { "SetCurrentStealthXP", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 479 */ { "GetCreatureSize", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 480 */ { "AwardStealthXP", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 481 */ { "GetStealthXPEnabled", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 482 */ { "SetStealthXPEnabled", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 483 */ { "ActionUnlockObject", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 484 */ { "ActionLockObject", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 485 */ { "EffectModifyAttacks", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 486 */ { "GetLastTrapDetected", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 487 */ { "EffectDamageShield", NCS_VM_SCRIPT_EFFECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 488 */ { "GetNearestTrapToObject", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 489 */ { "GetAttemptedMovementTarget", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 490 */ { "GetBlockingCreature", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 491 */ { "GetFortitudeSavingThrow", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 492 */ { "GetWillSavingThrow", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 493 */ { "GetReflexSavingThrow", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 494 */ { "GetChallengeRating", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 495 */ { "GetFoundEnemyCreature", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 496 */ { "GetMovementRate", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 497 */ { "GetSubRace", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 498 */ { "GetStealthXPDecrement", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 499 */ { "SetStealthXPDecrement", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 500 */ { "DuplicateHeadAppearance", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 501 */ { "ActionCastFakeSpellAtObject", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 502 */ { "ActionCastFakeSpellAtLocation", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_INT } },
+    /* 503 */ { "CutsceneAttack", NCS_VM_SCRIPT_VOID, 4, 4, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 504 */ { "SetCameraMode", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 505 */ { "SetLockOrientationInDialog", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 506 */ { "SetLockHeadFollowInDialog", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 507 */ { "CutsceneMove", NCS_VM_SCRIPT_VOID, 3, 5, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_VECTOR, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_INT } },
+    /* 508 */ { "EnableVideoEffect", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 509 */ { "StartNewModule", NCS_VM_SCRIPT_VOID, 8, 8, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING } },
+    /* 510 */ { "DisableVideoEffect", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 511 */ { "GetWeaponRanged", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 512 */ { "DoSinglePlayerAutoSave", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 513 */ { "GetGameDifficulty", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 514 */ { "GetUserActionsPending", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 515 */ { "RevealMap", NCS_VM_SCRIPT_VOID, 2, 4, 0,
+              { NCS_VM_SCRIPT_VECTOR, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_INT } },
+    /* 516 */ { "SetTutorialWindowsEnabled", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 517 */ { "ShowTutorialWindow", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 518 */ { "StartCreditSequence", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 519 */ { "IsCreditSequenceInProgress", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 520 */ { "SWMG_SetLateralAccelerationPerSecond", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 521 */ { "SWMG_GetLateralAccelerationPerSecond", NCS_VM_SCRIPT_FLOAT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 522 */ { "GetCurrentAction", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 523 */ { "GetDifficultyModifier", NCS_VM_SCRIPT_FLOAT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 524 */ { "GetAppearanceType", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 525 */ { "FloatingTextStrRefOnCreature", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 526 */ { "FloatingTextStringOnCreature", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 527 */ { "GetTrapDisarmable", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 528 */ { "GetTrapDetectable", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 529 */ { "GetTrapDetectedBy", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 530 */ { "GetTrapFlagged", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 531 */ { "GetTrapBaseType", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 532 */ { "GetTrapOneShot", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 533 */ { "GetTrapCreator", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 534 */ { "GetTrapKeyTag", NCS_VM_SCRIPT_STRING, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 535 */ { "GetTrapDisarmDC", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 536 */ { "GetTrapDetectDC", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 537 */ { "GetLockKeyRequired", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 538 */ { "GetLockKeyTag", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 539 */ { "GetLockLockable", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 540 */ { "GetLockUnlockDC", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 541 */ { "GetLockLockDC", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 542 */ { "GetPCLevellingUp", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 543 */ { "GetHasFeatEffect", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 544 */ { "SetPlaceableIllumination", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 545 */ { "GetPlaceableIllumination", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 546 */ { "GetIsPlaceableObjectActionPossible", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 547 */ { "DoPlaceableObjectAction", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 548 */ { "GetFirstPC", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 549 */ { "GetNextPC", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 550 */ { "SetTrapDetectedBy", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 551 */ { "GetIsTrapped", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 552 */ { "SetEffectIcon", NCS_VM_SCRIPT_EFFECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_EFFECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_EFFECT, NCS_VM_TYPE_INT } },
+    /* 553 */ { "FaceObjectAwayFromObject", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 554 */ { "PopUpDeathGUIPanel", NCS_VM_SCRIPT_VOID, 5, 5, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_STRING } },
+    /* 555 */ { "SetTrapDisabled", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 556 */ { "GetLastHostileActor", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 557 */ { "ExportAllCharacters", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 558 */ { "MusicBackgroundGetDayTrack", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 559 */ { "MusicBackgroundGetNightTrack", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 560 */ { "WriteTimestampedLogEntry", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /* 561 */ { "GetModuleName", NCS_VM_SCRIPT_STRING, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 562 */ { "GetFactionLeader", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 563 */ { "SWMG_SetSpeedBlurEffect", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT } },
+    /* 564 */ { "EndGame", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 565 */ { "GetRunScriptVar", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 566 */ { "GetCreatureMovmentType", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 567 */ { "AmbientSoundSetDayVolume", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 568 */ { "AmbientSoundSetNightVolume", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 569 */ { "MusicBackgroundGetBattleTrack", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 570 */ { "GetHasInventory", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 571 */ { "GetStrRefSoundDuration", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 572 */ { "AddToParty", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 573 */ { "RemoveFromParty", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 574 */ { "AddPartyMember", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 575 */ { "RemovePartyMember", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 576 */ { "IsObjectPartyMember", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 577 */ { "GetPartyMemberByIndex", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 578 */ { "GetGlobalBoolean", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /* 579 */ { "SetGlobalBoolean", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /* 580 */ { "GetGlobalNumber", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /* 581 */ { "SetGlobalNumber", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /* 582 */ { "AurPostString", NCS_VM_SCRIPT_VOID, 4, 4, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT } },
+    /* 583 */ { "SWMG_GetLastEvent", NCS_VM_SCRIPT_STRING, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 584 */ { "SWMG_GetLastEventModelName", NCS_VM_SCRIPT_STRING, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 585 */ { "SWMG_GetObjectByName", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /* 586 */ { "SWMG_PlayAnimation", NCS_VM_SCRIPT_VOID, 5, 5, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 587 */ { "SWMG_GetLastBulletHitDamage", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 588 */ { "SWMG_GetLastBulletHitTarget", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 589 */ { "SWMG_GetLastBulletHitShooter", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 590 */ { "SWMG_AdjustFollowerHitPoints", NCS_VM_SCRIPT_INT, 3, 3, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 591 */ { "SWMG_OnBulletHit", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 592 */ { "SWMG_OnObstacleHit", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 593 */ { "SWMG_GetLastFollowerHit", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 594 */ { "SWMG_GetLastObstacleHit", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 595 */ { "SWMG_GetLastBulletFiredDamage", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 596 */ { "SWMG_GetLastBulletFiredTarget", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 597 */ { "SWMG_GetObjectName", NCS_VM_SCRIPT_STRING, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 598 */ { "SWMG_OnDeath", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 599 */ { "SWMG_IsFollower", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 600 */ { "SWMG_IsPlayer", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 601 */ { "SWMG_IsEnemy", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 602 */ { "SWMG_IsTrigger", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 603 */ { "SWMG_IsObstacle", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 604 */ { "SWMG_SetFollowerHitPoints", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 605 */ { "SWMG_OnDamage", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 606 */ { "SWMG_GetLastHPChange", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 607 */ { "SWMG_RemoveAnimation", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_STRING } },
+    /* 608 */ { "SWMG_GetCameraNearClip", NCS_VM_SCRIPT_FLOAT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 609 */ { "SWMG_GetCameraFarClip", NCS_VM_SCRIPT_FLOAT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 610 */ { "SWMG_SetCameraClip", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 611 */ { "SWMG_GetPlayer", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 612 */ { "SWMG_GetEnemyCount", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 613 */ { "SWMG_GetEnemy", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 614 */ { "SWMG_GetObstacleCount", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 615 */ { "SWMG_GetObstacle", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 616 */ { "SWMG_GetHitPoints", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 617 */ { "SWMG_GetMaxHitPoints", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 618 */ { "SWMG_SetMaxHitPoints", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 619 */ { "SWMG_GetSphereRadius", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 620 */ { "SWMG_SetSphereRadius", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_FLOAT } },
+    /* 621 */ { "SWMG_GetNumLoops", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 622 */ { "SWMG_SetNumLoops", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 623 */ { "SWMG_GetPosition", NCS_VM_SCRIPT_VECTOR, 1, 1, 3,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 624 */ { "SWMG_GetGunBankCount", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 625 */ { "SWMG_GetGunBankBulletModel", NCS_VM_SCRIPT_STRING, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 626 */ { "SWMG_GetGunBankGunModel", NCS_VM_SCRIPT_STRING, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 627 */ { "SWMG_GetGunBankDamage", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 628 */ { "SWMG_GetGunBankTimeBetweenShots", NCS_VM_SCRIPT_FLOAT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 629 */ { "SWMG_GetGunBankLifespan", NCS_VM_SCRIPT_FLOAT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 630 */ { "SWMG_GetGunBankSpeed", NCS_VM_SCRIPT_FLOAT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 631 */ { "SWMG_GetGunBankTarget", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 632 */ { "SWMG_SetGunBankBulletModel", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_STRING } },
+    /* 633 */ { "SWMG_SetGunBankGunModel", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_STRING } },
+    /* 634 */ { "SWMG_SetGunBankDamage", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 635 */ { "SWMG_SetGunBankTimeBetweenShots", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT } },
+    /* 636 */ { "SWMG_SetGunBankLifespan", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT } },
+    /* 637 */ { "SWMG_SetGunBankSpeed", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT } },
+    /* 638 */ { "SWMG_SetGunBankTarget", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 639 */ { "SWMG_GetLastBulletHitPart", NCS_VM_SCRIPT_STRING, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 640 */ { "SWMG_IsGunBankTargetting", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 641 */ { "SWMG_GetPlayerOffset", NCS_VM_SCRIPT_VECTOR, 0, 0, 3,
+              { 0 },
+              { 0 } },
+    /* 642 */ { "SWMG_GetPlayerInvincibility", NCS_VM_SCRIPT_FLOAT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 643 */ { "SWMG_GetPlayerSpeed", NCS_VM_SCRIPT_FLOAT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 644 */ { "SWMG_GetPlayerMinSpeed", NCS_VM_SCRIPT_FLOAT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 645 */ { "SWMG_GetPlayerAccelerationPerSecond", NCS_VM_SCRIPT_FLOAT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 646 */ { "SWMG_GetPlayerTunnelPos", NCS_VM_SCRIPT_VECTOR, 0, 0, 3,
+              { 0 },
+              { 0 } },
+    /* 647 */ { "SWMG_SetPlayerOffset", NCS_VM_SCRIPT_VOID, 1, 3, 0,
+              { NCS_VM_SCRIPT_VECTOR },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 648 */ { "SWMG_SetPlayerInvincibility", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 649 */ { "SWMG_SetPlayerSpeed", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 650 */ { "SWMG_SetPlayerMinSpeed", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 651 */ { "SWMG_SetPlayerAccelerationPerSecond", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 652 */ { "SWMG_SetPlayerTunnelPos", NCS_VM_SCRIPT_VOID, 1, 3, 0,
+              { NCS_VM_SCRIPT_VECTOR },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 653 */ { "SWMG_GetPlayerTunnelNeg", NCS_VM_SCRIPT_VECTOR, 0, 0, 3,
+              { 0 },
+              { 0 } },
+    /* 654 */ { "SWMG_SetPlayerTunnelNeg", NCS_VM_SCRIPT_VOID, 1, 3, 0,
+              { NCS_VM_SCRIPT_VECTOR },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 655 */ { "SWMG_GetPlayerOrigin", NCS_VM_SCRIPT_VECTOR, 0, 0, 3,
+              { 0 },
+              { 0 } },
+    /* 656 */ { "SWMG_SetPlayerOrigin", NCS_VM_SCRIPT_VOID, 1, 3, 0,
+              { NCS_VM_SCRIPT_VECTOR },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 657 */ { "SWMG_GetGunBankHorizontalSpread", NCS_VM_SCRIPT_FLOAT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 658 */ { "SWMG_GetGunBankVerticalSpread", NCS_VM_SCRIPT_FLOAT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 659 */ { "SWMG_GetGunBankSensingRadius", NCS_VM_SCRIPT_FLOAT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 660 */ { "SWMG_GetGunBankInaccuracy", NCS_VM_SCRIPT_FLOAT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 661 */ { "SWMG_SetGunBankHorizontalSpread", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT } },
+    /* 662 */ { "SWMG_SetGunBankVerticalSpread", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT } },
+    /* 663 */ { "SWMG_SetGunBankSensingRadius", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT } },
+    /* 664 */ { "SWMG_SetGunBankInaccuracy", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT } },
+    /* 665 */ { "SWMG_GetIsInvulnerable", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 666 */ { "SWMG_StartInvulnerability", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 667 */ { "SWMG_GetPlayerMaxSpeed", NCS_VM_SCRIPT_FLOAT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 668 */ { "SWMG_SetPlayerMaxSpeed", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 669 */ { "AddJournalWorldEntry", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING } },
+    /* 670 */ { "AddJournalWorldEntryStrref", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 671 */ { "BarkString", NCS_VM_SCRIPT_VOID, 4, 4, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 672 */ { "DeleteJournalWorldAllEntries", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 673 */ { "DeleteJournalWorldEntry", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 674 */ { "DeleteJournalWorldEntryStrref", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 675 */ { "EffectForceDrain", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 676 */ { "EffectPsychicStatic", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 677 */ { "PlayVisualAreaEffect", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_LOCATION },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_LOCATION } },
+    /* 678 */ { "SetJournalQuestEntryPicture", NCS_VM_SCRIPT_VOID, 5, 5, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 679 */ { "GetLocalBoolean", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 680 */ { "SetLocalBoolean", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 681 */ { "GetLocalNumber", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 682 */ { "SetLocalNumber", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 683 */ { "SWMG_GetSoundFrequency", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 684 */ { "SWMG_SetSoundFrequency", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 685 */ { "SWMG_GetSoundFrequencyIsRandom", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 686 */ { "SWMG_SetSoundFrequencyIsRandom", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 687 */ { "SWMG_GetSoundVolume", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 688 */ { "SWMG_SetSoundVolume", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 689 */ { "SoundObjectGetPitchVariance", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 690 */ { "SoundObjectSetPitchVariance", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_FLOAT } },
+    /* 691 */ { "SoundObjectGetVolume", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 692 */ { "GetGlobalLocation", NCS_VM_SCRIPT_LOCATION, 1, 1, 1,
+              { NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_STRING } },
+    /* 693 */ { "SetGlobalLocation", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_LOCATION },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_LOCATION } },
+    /* 694 */ { "AddAvailableNPCByObject", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 695 */ { "RemoveAvailableNPC", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 696 */ { "IsAvailableCreature", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 697 */ { "AddAvailableNPCByTemplate", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_STRING } },
+    /* 698 */ { "SpawnAvailableNPC", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_LOCATION },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_LOCATION } },
+    /* 699 */ { "IsNPCPartyMember", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 700 */ { "ActionBarkString", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 701 */ { "GetIsConversationActive", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 702 */ { "EffectLightsaberThrow", NCS_VM_SCRIPT_EFFECT, 4, 4, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 703 */ { "EffectWhirlWind", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 704 */ { "GetPartyAIStyle", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 705 */ { "GetNPCAIStyle", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 706 */ { "SetPartyAIStyle", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 707 */ { "SetNPCAIStyle", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 708 */ { "SetNPCSelectability", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 709 */ { "GetNPCSelectability", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 710 */ { "ClearAllEffects", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 711 */ { "GetLastConversation", NCS_VM_SCRIPT_STRING, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 712 */ { "ShowPartySelectionGUI", NCS_VM_SCRIPT_VOID, 4, 4, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 713 */ { "GetStandardFaction", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 714 */ { "GivePlotXP", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /* 715 */ { "GetMinOneHP", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 716 */ { "SetMinOneHP", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 717 */ { "SWMG_GetPlayerTunnelInfinite", NCS_VM_SCRIPT_VECTOR, 0, 0, 3,
+              { 0 },
+              { 0 } },
+    /* 718 */ { "SWMG_SetPlayerTunnelInfinite", NCS_VM_SCRIPT_VOID, 1, 3, 0,
+              { NCS_VM_SCRIPT_VECTOR },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 719 */ { "SetGlobalFadeIn", NCS_VM_SCRIPT_VOID, 5, 5, 0,
+              { NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 720 */ { "SetGlobalFadeOut", NCS_VM_SCRIPT_VOID, 5, 5, 0,
+              { NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 721 */ { "GetLastHostileTarget", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 722 */ { "GetLastAttackAction", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 723 */ { "GetLastForcePowerUsed", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 724 */ { "GetLastCombatFeatUsed", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 725 */ { "GetLastAttackResult", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 726 */ { "GetWasForcePowerSuccessful", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 727 */ { "GetFirstAttacker", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 728 */ { "GetNextAttacker", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 729 */ { "SetFormation", NCS_VM_SCRIPT_VOID, 4, 4, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 730 */ { "ActionFollowLeader", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 731 */ { "SetForcePowerUnsuccessful", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 732 */ { "GetIsDebilitated", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 733 */ { "PlayMovie", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /* 734 */ { "SaveNPCState", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 735 */ { "GetCategoryFromTalent", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_TALENT },
+              { NCS_VM_TYPE_TALENT } },
+    /* 736 */ { "SurrenderByFaction", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 737 */ { "ChangeFactionByFaction", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 738 */ { "PlayRoomAnimation", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /* 739 */ { "ShowGalaxyMap", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 740 */ { "SetPlanetSelectable", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 741 */ { "GetPlanetSelectable", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 742 */ { "SetPlanetAvailable", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 743 */ { "GetPlanetAvailable", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 744 */ { "GetSelectedPlanet", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 745 */ { "SoundObjectFadeAndStop", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_FLOAT } },
+    /* 746 */ { "SetAreaFogColor", NCS_VM_SCRIPT_VOID, 4, 4, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 747 */ { "ChangeItemCost", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_FLOAT } },
+    /* 748 */ { "GetIsLiveContentAvailable", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 749 */ { "ResetDialogState", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 750 */ { "SetGoodEvilValue", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 751 */ { "GetIsPoisoned", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 752 */ { "GetSpellTarget", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 753 */ { "SetSoloMode", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 754 */ { "EffectCutSceneHorrified", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 755 */ { "EffectCutSceneParalyze", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 756 */ { "EffectCutSceneStunned", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 757 */ { "CancelPostDialogCharacterSwitch", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 758 */ { "SetMaxHitPoints", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 759 */ { "NoClicksFor", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 760 */ { "HoldWorldFadeInForDialog", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 761 */ { "ShipBuild", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 762 */ { "SurrenderRetainBuffs", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 763 */ { "SuppressStatusSummaryEntry", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 764 */ { "GetCheatCode", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 765 */ { "SetMusicVolume", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 766 */ { "CreateItemOnFloor", NCS_VM_SCRIPT_OBJECT, 3, 3, 1,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_INT } },
+    /* 767 */ { "SetAvailableNPCId", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 768 */ { "GetScriptParameter", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 769 */ { "SetFadeUntilScript", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 770 */ { "EffectForceBody", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 771 */ { "GetItemComponent", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 772 */ { "GetItemComponentPieceValue", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 773 */ { "ShowChemicalUpgradeScreen", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 774 */ { "GetChemicals", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 775 */ { "GetChemicalPieceValue", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 776 */ { "GetSpellForcePointCost", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 777 */ { "EffectFury", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 778 */ { "EffectBlind", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 779 */ { "EffectFPRegenModifier", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 780 */ { "EffectVPRegenModifier", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 781 */ { "EffectCrush", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 782 */ { "SWMG_GetSwoopUpgrade", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 783 */ { "GetFeatAcquired", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 784 */ { "GetSpellAcquired", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 785 */ { "ShowSwoopUpgradeScreen", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 786 */ { "GrantFeat", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 787 */ { "GrantSpell", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 788 */ { "SpawnMine", NCS_VM_SCRIPT_VOID, 5, 5, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_LOCATION, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_LOCATION, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 789 */ { "SWMG_GetTrackPosition", NCS_VM_SCRIPT_VECTOR, 1, 1, 3,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 790 */ { "SWMG_SetFollowerPosition", NCS_VM_SCRIPT_VECTOR, 1, 3, 3,
+              { NCS_VM_SCRIPT_VECTOR },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 791 */ { "SetFakeCombatState", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 792 */ { "SWMG_DestroyMiniGameObject", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 793 */ { "GetOwnerDemolitionsSkill", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 794 */ { "SetOrientOnClick", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 795 */ { "GetInfluence", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 796 */ { "SetInfluence", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 797 */ { "ModifyInfluence", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 798 */ { "GetRacialSubType", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 799 */ { "IncrementGlobalNumber", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /* 800 */ { "DecrementGlobalNumber", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /* 801 */ { "SetBonusForcePoints", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 802 */ { "AddBonusForcePoints", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 803 */ { "GetBonusForcePoints", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 804 */ { "SWMG_SetJumpSpeed", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 805 */ { "IsMoviePlaying", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 806 */ { "QueueMovie", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT } },
+    /* 807 */ { "PlayMovieQueue", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 808 */ { "YavinHackDoorClose", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 809 */ { "EffectDroidConfused", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 810 */ { "IsStealthed", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 811 */ { "IsMeditating", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 812 */ { "IsInTotalDefense", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 813 */ { "SetHealTarget", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 814 */ { "GetHealTarget", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 815 */ { "GetRandomDestination", NCS_VM_SCRIPT_VECTOR, 2, 2, 3,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 816 */ { "IsFormActive", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 817 */ { "GetSpellFormMask", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 818 */ { "GetSpellBaseForcePointCost", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 819 */ { "SetKeepStealthInDialog", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 820 */ { "HasLineOfSight", NCS_VM_SCRIPT_INT, 4, 8, 1,
+              { NCS_VM_SCRIPT_VECTOR, NCS_VM_SCRIPT_VECTOR, NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_OBJECT } },
+    /* 821 */ { "ShowDemoScreen", NCS_VM_SCRIPT_INT, 5, 5, 1,
+              { NCS_VM_SCRIPT_STRING, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 822 */ { "ForceHeartbeat", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 823 */ { "EffectForceSight", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 824 */ { "IsRunning", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 825 */ { "SWMG_PlayerApplyForce", NCS_VM_SCRIPT_VOID, 1, 3, 0,
+              { NCS_VM_SCRIPT_VECTOR },
+              { NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT } },
+    /* 826 */ { "SetForfeitConditions", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 827 */ { "GetLastForfeitViolation", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 828 */ { "ModifyReflexSavingThrowBase", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 829 */ { "ModifyFortitudeSavingThrowBase", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 830 */ { "ModifyWillSavingThrowBase", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 831 */ { "GetScriptStringParameter", NCS_VM_SCRIPT_STRING, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 832 */ { "GetObjectPersonalSpace", NCS_VM_SCRIPT_FLOAT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 833 */ { "AdjustCreatureAttributes", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 834 */ { "SetCreatureAILevel", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 835 */ { "ResetCreatureAILevel", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 836 */ { "AddAvailablePUPByTemplate", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_STRING } },
+    /* 837 */ { "AddAvailablePUPByObject", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 838 */ { "AssignPUP", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 839 */ { "SpawnAvailablePUP", NCS_VM_SCRIPT_OBJECT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_LOCATION },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_LOCATION } },
+    /* 840 */ { "AddPartyPuppet", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 841 */ { "GetPUPOwner", NCS_VM_SCRIPT_OBJECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 842 */ { "GetIsPuppet", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 843 */ { "ActionFollowOwner", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_FLOAT },
+              { NCS_VM_TYPE_FLOAT } },
+    /* 844 */ { "GetIsPartyLeader", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 845 */ { "GetPartyLeader", NCS_VM_SCRIPT_OBJECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 846 */ { "RemoveNPCFromPartyToBase", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 847 */ { "CreatureFlourishWeapon", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 848 */ { "EffectMindTrick", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 849 */ { "EffectFactionModifier", NCS_VM_SCRIPT_EFFECT, 1, 1, 1,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 850 */ { "ChangeObjectAppearance", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 851 */ { "GetIsXBox", NCS_VM_SCRIPT_INT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 852 */ { "EffectDroidScramble", NCS_VM_SCRIPT_EFFECT, 0, 0, 1,
+              { 0 },
+              { 0 } },
+    /* 853 */ { "ActionSwitchWeapons", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 854 */ { "PlayOverlayAnimation", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 855 */ { "UnlockAllSongs", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+    /* 856 */ { "DisableMap", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 857 */ { "DetonateMine", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 858 */ { "DisableHealthRegen", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 859 */ { "SetCurrentForm", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 860 */ { "SetDisableTransit", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 861 */ { "SetInputClass", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 862 */ { "SetForceAlwaysUpdate", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 863 */ { "EnableRain", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_INT } },
+    /* 864 */ { "DisplayMessageBox", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_STRING },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_STRING } },
+    /* 865 */ { "DisplayDatapad", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 866 */ { "RemoveHeartbeat", NCS_VM_SCRIPT_VOID, 1, 1, 0,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 867 */ { "RemoveEffectByID", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 868 */ { "RemoveEffectByExactMatch", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_EFFECT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_EFFECT } },
+    /* 869 */ { "AdjustCreatureSkills", NCS_VM_SCRIPT_VOID, 3, 3, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT } },
+    /* 870 */ { "GetSkillRankBase", NCS_VM_SCRIPT_INT, 2, 2, 1,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 871 */ { "EnableRendering", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_OBJECT, NCS_VM_SCRIPT_INT },
+              { NCS_VM_TYPE_OBJECT, NCS_VM_TYPE_INT } },
+    /* 872 */ { "GetCombatActionsPending", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 873 */ { "SaveNPCByObject", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 874 */ { "SavePUPByObject", NCS_VM_SCRIPT_VOID, 2, 2, 0,
+              { NCS_VM_SCRIPT_INT, NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_INT, NCS_VM_TYPE_OBJECT } },
+    /* 875 */ { "GetIsPlayerMadeCharacter", NCS_VM_SCRIPT_INT, 1, 1, 1,
+              { NCS_VM_SCRIPT_OBJECT },
+              { NCS_VM_TYPE_OBJECT } },
+    /* 876 */ { "RebuildPartyTable", NCS_VM_SCRIPT_VOID, 0, 0, 0,
+              { 0 },
+              { 0 } },
+};
+
+#endif // NCS_VM_ACTIONS_K2_H
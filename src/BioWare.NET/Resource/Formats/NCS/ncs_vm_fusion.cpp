@@ -0,0 +1,184 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - SUPERINSTRUCTION FUSION
+// ============================================================================
+// Runs on loaded programs. A fused sequence keeps its covered instructions
+// in place behind the rewritten first instruction, so instruction indices,
+// jump targets and offsets are the same with or without fusion.
+// ============================================================================
+
+#include "ncs_vm.h"
+
+#include <algorithm>
+#include <utility>
+
+// ============================================================================
+// PATTERN MATCHING
+// ============================================================================
+
+static bool ncs_vm_is_int_comparison(uint8_t op)
+{
+    switch (op) {
+        case NCS_VM_OP_EQUAL: case NCS_VM_OP_NEQUAL:
+        case NCS_VM_OP_GEQII: case NCS_VM_OP_GTII:
+        case NCS_VM_OP_LTII: case NCS_VM_OP_LEQII:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool ncs_vm_is_single_cell(const NcsVmInstruction* in, uint8_t op)
+{
+    return in->op == op && in->count == 1;
+}
+
+static bool ncs_vm_is_int_constant(const NcsVmInstruction* in)
+{
+    return in->op == NCS_VM_OP_CONST && in->type == NCS_VM_TYPE_INT;
+}
+
+static bool ncs_vm_is_pop_one(const NcsVmInstruction* in)
+{
+    return in->op == NCS_VM_OP_MOVSP && in->a == -1;
+}
+
+/**
+ * @brief Fuse the longest sequence starting at in, if any
+ *
+ * @param in First instruction of the candidate sequence
+ * @param available Instructions from in up to (not including) the END sentinel
+ * @return Instructions covered by the superinstruction, or 0
+ */
+static size_t ncs_vm_fuse_at(NcsVmInstruction* in, size_t available)
+{
+    // x += c / x -= c
+    if (available >= 5 && ncs_vm_is_single_cell(&in[0], NCS_VM_OP_CPTOPSP) && ncs_vm_is_int_constant(&in[1]) &&
+        (in[2].op == NCS_VM_OP_ADDII || in[2].op == NCS_VM_OP_SUBII) &&
+        ncs_vm_is_single_cell(&in[3], NCS_VM_OP_CPDOWNSP) && ncs_vm_is_pop_one(&in[4])) {
+        uint32_t constant = (uint32_t)in[1].a;
+        in[0].op = NCS_VM_OP_CPTOPSP_CONST_ADDII_CPDOWNSP_MOVSP;
+        in[0].b = (int32_t)(in[2].op == NCS_VM_OP_ADDII ? constant : 0u - constant);
+        return 5;
+    }
+
+    // while (x < c)
+    if (available >= 4 && ncs_vm_is_single_cell(&in[0], NCS_VM_OP_CPTOPSP) && ncs_vm_is_int_constant(&in[1]) &&
+        ncs_vm_is_int_comparison(in[2].op) && in[3].op == NCS_VM_OP_JZ) {
+        in[0].op = NCS_VM_OP_CPTOPSP_CONST_COMPAREII_JZ;
+        in[0].type = in[2].op;
+        in[0].b = in[1].a;
+        return 4;
+    }
+
+    // x = c
+    if (available >= 3 && in[0].op == NCS_VM_OP_CONST &&
+        ncs_vm_is_single_cell(&in[1], NCS_VM_OP_CPDOWNSP) && ncs_vm_is_pop_one(&in[2])) {
+        in[0].op = NCS_VM_OP_CONST_CPDOWNSP_MOVSP;
+        in[0].b = in[1].a;
+        return 3;
+    }
+
+    if (available >= 2) {
+        if (in[0].op == NCS_VM_OP_CPDOWNSP && in[1].op == NCS_VM_OP_MOVSP) {
+            in[0].op = NCS_VM_OP_CPDOWNSP_MOVSP;
+            in[0].b = in[1].a;
+            return 2;
+        }
+        if (ncs_vm_is_single_cell(&in[0], NCS_VM_OP_CPTOPSP) &&
+            (in[1].op == NCS_VM_OP_JZ || in[1].op == NCS_VM_OP_JNZ)) {
+            in[0].op = (in[1].op == NCS_VM_OP_JZ) ? NCS_VM_OP_CPTOPSP_JZ : NCS_VM_OP_CPTOPSP_JNZ;
+            in[0].b = in[1].a;
+            return 2;
+        }
+        if (ncs_vm_is_int_comparison(in[0].op) && in[1].op == NCS_VM_OP_JZ) {
+            in[0].type = in[0].op;
+            in[0].op = NCS_VM_OP_COMPAREII_JZ;
+            in[0].a = in[1].a;
+            return 2;
+        }
+    }
+    return 0;
+}
+
+uint32_t ncs_vm_fuse_program(NcsVmProgram* program)
+{
+    if (program->code.empty()) {
+        return 0;
+    }
+
+    // The END sentinel is never part of a sequence
+    size_t count = program->code.size() - 1;
+    uint32_t fused = 0;
+    size_t i = 0;
+    while (i < count) {
+        size_t covered = ncs_vm_fuse_at(&program->code[i], count - i);
+        if (covered > 0) {
+            fused++;
+            i += covered;
+        }
+        else {
+            i++;
+        }
+    }
+    return fused;
+}
+
+// ============================================================================
+// SEQUENCE STATISTICS
+// ============================================================================
+
+static bool ncs_vm_transfers_control(uint8_t op)
+{
+    switch (op) {
+        case NCS_VM_OP_JMP: case NCS_VM_OP_JSR: case NCS_VM_OP_JZ: case NCS_VM_OP_JNZ:
+        case NCS_VM_OP_RETN: case NCS_VM_OP_END:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void ncs_vm_count_sequences(const NcsVmProgram* program, size_t length, NcsVmSequenceCounts* counts)
+{
+    if (length == 0 || program->code.size() <= length) {
+        return;
+    }
+
+    size_t count = program->code.size() - 1;
+    std::vector<uint8_t> key(length);
+    for (size_t i = 0; i + length <= count; i++) {
+        size_t k = 0;
+        for (; k < length; k++) {
+            key[k] = program->code[i + k].op;
+            if (k + 1 < length && ncs_vm_transfers_control(key[k])) {
+                break;
+            }
+        }
+        if (k == length) {
+            (*counts)[key]++;
+        }
+    }
+}
+
+static bool ncs_vm_more_frequent(const std::pair<std::vector<uint8_t>, uint32_t>& a,
+                                 const std::pair<std::vector<uint8_t>, uint32_t>& b)
+{
+    return a.second != b.second ? a.second > b.second : a.first < b.first;
+}
+
+void ncs_vm_print_sequences(const NcsVmSequenceCounts* counts, size_t limit, FILE* stream)
+{
+    std::vector<std::pair<std::vector<uint8_t>, uint32_t> > sorted(counts->begin(), counts->end());
+    std::sort(sorted.begin(), sorted.end(), ncs_vm_more_frequent);
+    if (limit == 0 || limit > sorted.size()) {
+        limit = sorted.size();
+    }
+
+    for (size_t i = 0; i < limit; i++) {
+        fprintf(stream, "%8u ", sorted[i].second);
+        for (size_t k = 0; k < sorted[i].first.size(); k++) {
+            fprintf(stream, " %s", ncs_vm_op_name(sorted[i].first[k]));
+        }
+        fprintf(stream, "\n");
+    }
+}
@@ -0,0 +1,350 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - DECODE-ONCE LOADER
+// ============================================================================
+
+#include "ncs_vm.h"
+
+#include <string.h>
+
+#include <atomic>
+
+/**
+ * @brief Map a decode error to the VM error reported to hosts
+ */
+static int ncs_vm_load_error(int decodeResult)
+{
+    switch (decodeResult) {
+        case NCS_ERROR_BAD_OPCODE: return NCS_VM_ERROR_BAD_OPCODE;
+        case NCS_ERROR_BAD_JUMP:   return NCS_VM_ERROR_BAD_JUMP;
+        default:                   return NCS_VM_ERROR_BAD_PROGRAM;
+    }
+}
+
+/**
+ * @brief Convert a byte offset or size to cells
+ *
+ * @return false if value is not a multiple of NCS_STACK_ELEMENT_SIZE
+ */
+static bool ncs_vm_to_cells(int32_t bytes, int32_t* cells)
+{
+    if ((bytes & (NCS_STACK_ELEMENT_SIZE - 1)) != 0) {
+        return false;
+    }
+    *cells = bytes / NCS_STACK_ELEMENT_SIZE;
+    return true;
+}
+
+/**
+ * @brief NcsVmType pushed by RSADDx for a qualifier, or -1
+ */
+static int ncs_vm_type_for_qualifier(uint8_t qualifier)
+{
+    switch (qualifier) {
+        case NCS_Q_INT:      return NCS_VM_TYPE_INT;
+        case NCS_Q_FLOAT:    return NCS_VM_TYPE_FLOAT;
+        case NCS_Q_STRING:   return NCS_VM_TYPE_STRING;
+        case NCS_Q_OBJECT:   return NCS_VM_TYPE_OBJECT;
+        case NCS_Q_EFFECT:   return NCS_VM_TYPE_EFFECT;
+        case NCS_Q_EVENT:    return NCS_VM_TYPE_EVENT;
+        case NCS_Q_LOCATION: return NCS_VM_TYPE_LOCATION;
+        case NCS_Q_TALENT:   return NCS_VM_TYPE_TALENT;
+        default:             return -1;
+    }
+}
+
+/**
+ * @brief Resolve a typed opcode and its qualifier to one NcsVmOp
+ *
+ * @return Operation, or -1 for an unsupported opcode/qualifier pair
+ */
+static int ncs_vm_resolve_typed(uint8_t opcode, uint8_t qualifier)
+{
+#define NCS_VM_PAIR(opcode_, qualifier_) (((uint32_t)(opcode_) << 8) | (qualifier_))
+    switch (NCS_VM_PAIR(opcode, qualifier)) {
+        case NCS_VM_PAIR(NCS_OP_LOGAND, NCS_Q_INT_INT):        return NCS_VM_OP_LOGANDII;
+        case NCS_VM_PAIR(NCS_OP_LOGOR, NCS_Q_INT_INT):         return NCS_VM_OP_LOGORII;
+        case NCS_VM_PAIR(NCS_OP_INCOR, NCS_Q_INT_INT):         return NCS_VM_OP_INCORII;
+        case NCS_VM_PAIR(NCS_OP_EXCOR, NCS_Q_INT_INT):         return NCS_VM_OP_EXCORII;
+        case NCS_VM_PAIR(NCS_OP_BOOLAND, NCS_Q_INT_INT):       return NCS_VM_OP_BOOLANDII;
+
+        case NCS_VM_PAIR(NCS_OP_EQUAL, NCS_Q_INT_INT):
+        case NCS_VM_PAIR(NCS_OP_EQUAL, NCS_Q_OBJECT_OBJECT):
+        case NCS_VM_PAIR(NCS_OP_EQUAL, NCS_Q_EFFECT_EFFECT):
+        case NCS_VM_PAIR(NCS_OP_EQUAL, NCS_Q_EVENT_EVENT):
+        case NCS_VM_PAIR(NCS_OP_EQUAL, NCS_Q_LOCATION_LOCATION):
+        case NCS_VM_PAIR(NCS_OP_EQUAL, NCS_Q_TALENT_TALENT):   return NCS_VM_OP_EQUAL;
+        case NCS_VM_PAIR(NCS_OP_EQUAL, NCS_Q_FLOAT_FLOAT):     return NCS_VM_OP_EQUALFF;
+        case NCS_VM_PAIR(NCS_OP_EQUAL, NCS_Q_STRING_STRING):   return NCS_VM_OP_EQUALSS;
+        case NCS_VM_PAIR(NCS_OP_EQUAL, NCS_Q_STRUCT_STRUCT):   return NCS_VM_OP_EQUALTT;
+        case NCS_VM_PAIR(NCS_OP_NEQUAL, NCS_Q_INT_INT):
+        case NCS_VM_PAIR(NCS_OP_NEQUAL, NCS_Q_OBJECT_OBJECT):
+        case NCS_VM_PAIR(NCS_OP_NEQUAL, NCS_Q_EFFECT_EFFECT):
+        case NCS_VM_PAIR(NCS_OP_NEQUAL, NCS_Q_EVENT_EVENT):
+        case NCS_VM_PAIR(NCS_OP_NEQUAL, NCS_Q_LOCATION_LOCATION):
+        case NCS_VM_PAIR(NCS_OP_NEQUAL, NCS_Q_TALENT_TALENT):  return NCS_VM_OP_NEQUAL;
+        case NCS_VM_PAIR(NCS_OP_NEQUAL, NCS_Q_FLOAT_FLOAT):    return NCS_VM_OP_NEQUALFF;
+        case NCS_VM_PAIR(NCS_OP_NEQUAL, NCS_Q_STRING_STRING):  return NCS_VM_OP_NEQUALSS;
+        case NCS_VM_PAIR(NCS_OP_NEQUAL, NCS_Q_STRUCT_STRUCT):  return NCS_VM_OP_NEQUALTT;
+
+        case NCS_VM_PAIR(NCS_OP_GEQ, NCS_Q_INT_INT):           return NCS_VM_OP_GEQII;
+        case NCS_VM_PAIR(NCS_OP_GEQ, NCS_Q_FLOAT_FLOAT):       return NCS_VM_OP_GEQFF;
+        case NCS_VM_PAIR(NCS_OP_GT, NCS_Q_INT_INT):            return NCS_VM_OP_GTII;
+        case NCS_VM_PAIR(NCS_OP_GT, NCS_Q_FLOAT_FLOAT):        return NCS_VM_OP_GTFF;
+        case NCS_VM_PAIR(NCS_OP_LT, NCS_Q_INT_INT):            return NCS_VM_OP_LTII;
+        case NCS_VM_PAIR(NCS_OP_LT, NCS_Q_FLOAT_FLOAT):        return NCS_VM_OP_LTFF;
+        case NCS_VM_PAIR(NCS_OP_LEQ, NCS_Q_INT_INT):           return NCS_VM_OP_LEQII;
+        case NCS_VM_PAIR(NCS_OP_LEQ, NCS_Q_FLOAT_FLOAT):       return NCS_VM_OP_LEQFF;
+
+        case NCS_VM_PAIR(NCS_OP_SHLEFT, NCS_Q_INT_INT):        return NCS_VM_OP_SHLEFTII;
+        case NCS_VM_PAIR(NCS_OP_SHRIGHT, NCS_Q_INT_INT):       return NCS_VM_OP_SHRIGHTII;
+        case NCS_VM_PAIR(NCS_OP_USHRIGHT, NCS_Q_INT_INT):      return NCS_VM_OP_USHRIGHTII;
+
+        case NCS_VM_PAIR(NCS_OP_ADD, NCS_Q_INT_INT):           return NCS_VM_OP_ADDII;
+        case NCS_VM_PAIR(NCS_OP_ADD, NCS_Q_INT_FLOAT):         return NCS_VM_OP_ADDIF;
+        case NCS_VM_PAIR(NCS_OP_ADD, NCS_Q_FLOAT_INT):         return NCS_VM_OP_ADDFI;
+        case NCS_VM_PAIR(NCS_OP_ADD, NCS_Q_FLOAT_FLOAT):       return NCS_VM_OP_ADDFF;
+        case NCS_VM_PAIR(NCS_OP_ADD, NCS_Q_STRING_STRING):     return NCS_VM_OP_ADDSS;
+        case NCS_VM_PAIR(NCS_OP_ADD, NCS_Q_VECTOR_VECTOR):     return NCS_VM_OP_ADDVV;
+        case NCS_VM_PAIR(NCS_OP_SUB, NCS_Q_INT_INT):           return NCS_VM_OP_SUBII;
+        case NCS_VM_PAIR(NCS_OP_SUB, NCS_Q_INT_FLOAT):         return NCS_VM_OP_SUBIF;
+        case NCS_VM_PAIR(NCS_OP_SUB, NCS_Q_FLOAT_INT):         return NCS_VM_OP_SUBFI;
+        case NCS_VM_PAIR(NCS_OP_SUB, NCS_Q_FLOAT_FLOAT):       return NCS_VM_OP_SUBFF;
+        case NCS_VM_PAIR(NCS_OP_SUB, NCS_Q_VECTOR_VECTOR):     return NCS_VM_OP_SUBVV;
+        case NCS_VM_PAIR(NCS_OP_MUL, NCS_Q_INT_INT):           return NCS_VM_OP_MULII;
+        case NCS_VM_PAIR(NCS_OP_MUL, NCS_Q_INT_FLOAT):         return NCS_VM_OP_MULIF;
+        case NCS_VM_PAIR(NCS_OP_MUL, NCS_Q_FLOAT_INT):         return NCS_VM_OP_MULFI;
+        case NCS_VM_PAIR(NCS_OP_MUL, NCS_Q_FLOAT_FLOAT):       return NCS_VM_OP_MULFF;
+        case NCS_VM_PAIR(NCS_OP_MUL, NCS_Q_VECTOR_FLOAT):      return NCS_VM_OP_MULVF;
+        case NCS_VM_PAIR(NCS_OP_MUL, NCS_Q_FLOAT_VECTOR):      return NCS_VM_OP_MULFV;
+        case NCS_VM_PAIR(NCS_OP_DIV, NCS_Q_INT_INT):           return NCS_VM_OP_DIVII;
+        case NCS_VM_PAIR(NCS_OP_DIV, NCS_Q_INT_FLOAT):         return NCS_VM_OP_DIVIF;
+        case NCS_VM_PAIR(NCS_OP_DIV, NCS_Q_FLOAT_INT):         return NCS_VM_OP_DIVFI;
+        case NCS_VM_PAIR(NCS_OP_DIV, NCS_Q_FLOAT_FLOAT):       return NCS_VM_OP_DIVFF;
+        case NCS_VM_PAIR(NCS_OP_DIV, NCS_Q_VECTOR_FLOAT):      return NCS_VM_OP_DIVVF;
+        case NCS_VM_PAIR(NCS_OP_MOD, NCS_Q_INT_INT):           return NCS_VM_OP_MODII;
+
+        case NCS_VM_PAIR(NCS_OP_NEG, NCS_Q_INT):               return NCS_VM_OP_NEGI;
+        case NCS_VM_PAIR(NCS_OP_NEG, NCS_Q_FLOAT):             return NCS_VM_OP_NEGF;
+        case NCS_VM_PAIR(NCS_OP_COMP, NCS_Q_INT):              return NCS_VM_OP_COMPI;
+        case NCS_VM_PAIR(NCS_OP_NOT, NCS_Q_INT):               return NCS_VM_OP_NOTI;
+        default:                                               return -1;
+    }
+#undef NCS_VM_PAIR
+}
+
+/**
+ * @brief Translate one decoded instruction to its fixed-width form
+ *
+ * @return NCS_VM_OK or the NcsVmResult that rejects the instruction
+ */
+static int ncs_vm_load_instruction(const NcsProgram* decoded, size_t index,
+                                   NcsVmProgram* program, NcsVmInstruction* out)
+{
+    const NcsInstruction& in = decoded->instructions[index];
+    int32_t cells;
+
+    out->op = NCS_VM_OP_NOP;
+    out->type = 0;
+    out->count = 0;
+    out->a = 0;
+    out->b = 0;
+    out->offset = in.offset;
+
+    switch (in.opcode) {
+        case NCS_OP_CPDOWNSP: case NCS_OP_CPTOPSP:
+        case NCS_OP_CPDOWNBP: case NCS_OP_CPTOPBP:
+            out->op = (in.opcode == NCS_OP_CPDOWNSP) ? NCS_VM_OP_CPDOWNSP
+                    : (in.opcode == NCS_OP_CPTOPSP) ? NCS_VM_OP_CPTOPSP
+                    : (in.opcode == NCS_OP_CPDOWNBP) ? NCS_VM_OP_CPDOWNBP : NCS_VM_OP_CPTOPBP;
+            if (!ncs_vm_to_cells(in.arg0, &out->a) || !ncs_vm_to_cells(in.arg1, &cells)) {
+                return NCS_VM_ERROR_BAD_OFFSET;
+            }
+            out->count = (uint16_t)cells;
+            return NCS_VM_OK;
+
+        case NCS_OP_RSADD: {
+            int type = ncs_vm_type_for_qualifier(in.qualifier);
+            if (type < 0) {
+                return NCS_VM_ERROR_BAD_OPCODE;
+            }
+            out->op = NCS_VM_OP_RSADD;
+            out->type = (uint8_t)type;
+            return NCS_VM_OK;
+        }
+
+        case NCS_OP_CONST:
+            switch (in.qualifier) {
+                case NCS_Q_INT:
+                case NCS_Q_FLOAT:
+                    // arg0 already holds the host-order bits (float reinterpreted at push)
+                    out->op = NCS_VM_OP_CONST;
+                    out->type = (in.qualifier == NCS_Q_INT) ? NCS_VM_TYPE_INT : NCS_VM_TYPE_FLOAT;
+                    out->a = in.arg0;
+                    return NCS_VM_OK;
+                case NCS_Q_OBJECT:
+                    out->op = NCS_VM_OP_CONSTO;
+                    out->type = NCS_VM_TYPE_OBJECT;
+                    out->a = in.arg0;
+                    return NCS_VM_OK;
+                case NCS_Q_STRING:
+                    out->op = NCS_VM_OP_CONSTS;
+                    out->type = NCS_VM_TYPE_STRING;
+                    out->a = (int32_t)program->strings.size();
+                    program->strings.push_back(in.text);
+                    return NCS_VM_OK;
+                default:
+                    return NCS_VM_ERROR_BAD_OPCODE;
+            }
+
+        case NCS_OP_ACTION:
+            out->op = NCS_VM_OP_ACTION;
+            out->a = in.arg0;
+            out->count = (uint16_t)in.arg1;
+            return NCS_VM_OK;
+
+        case NCS_OP_EQUAL: case NCS_OP_NEQUAL:
+            if (in.qualifier == NCS_Q_STRUCT_STRUCT) {
+                if (!ncs_vm_to_cells(in.arg0, &cells)) {
+                    return NCS_VM_ERROR_BAD_OFFSET;
+                }
+                out->count = (uint16_t)cells;
+            }
+            // fall through
+        case NCS_OP_LOGAND: case NCS_OP_LOGOR: case NCS_OP_INCOR: case NCS_OP_EXCOR: case NCS_OP_BOOLAND:
+        case NCS_OP_GEQ: case NCS_OP_GT: case NCS_OP_LT: case NCS_OP_LEQ:
+        case NCS_OP_SHLEFT: case NCS_OP_SHRIGHT: case NCS_OP_USHRIGHT:
+        case NCS_OP_ADD: case NCS_OP_SUB: case NCS_OP_MUL: case NCS_OP_DIV: case NCS_OP_MOD:
+        case NCS_OP_NEG: case NCS_OP_COMP: case NCS_OP_NOT: {
+            int op = ncs_vm_resolve_typed(in.opcode, in.qualifier);
+            if (op < 0) {
+                return NCS_VM_ERROR_BAD_OPCODE;
+            }
+            out->op = (uint8_t)op;
+            return NCS_VM_OK;
+        }
+
+        case NCS_OP_MOVSP:
+            out->op = NCS_VM_OP_MOVSP;
+            if (!ncs_vm_to_cells(in.arg0, &out->a)) {
+                return NCS_VM_ERROR_BAD_OFFSET;
+            }
+            return out->a <= 0 ? NCS_VM_OK : NCS_VM_ERROR_BAD_OFFSET;
+
+        case NCS_OP_JMP: case NCS_OP_JSR: case NCS_OP_JZ: case NCS_OP_JNZ:
+            out->op = (in.opcode == NCS_OP_JMP) ? NCS_VM_OP_JMP
+                    : (in.opcode == NCS_OP_JSR) ? NCS_VM_OP_JSR
+                    : (in.opcode == NCS_OP_JZ) ? NCS_VM_OP_JZ : NCS_VM_OP_JNZ;
+            out->a = in.jumpTarget;
+            return NCS_VM_OK;
+
+        case NCS_OP_RETN:
+            out->op = NCS_VM_OP_RETN;
+            return NCS_VM_OK;
+
+        case NCS_OP_DESTRUCT:
+            out->op = NCS_VM_OP_DESTRUCT;
+            if (!ncs_vm_to_cells(in.arg0, &cells) || !ncs_vm_to_cells(in.arg1, &out->a) ||
+                !ncs_vm_to_cells(in.arg2, &out->b) || out->a < 0 || out->a + out->b > cells) {
+                return NCS_VM_ERROR_BAD_OFFSET;
+            }
+            out->count = (uint16_t)cells;
+            return NCS_VM_OK;
+
+        case NCS_OP_DECSP: case NCS_OP_INCSP: case NCS_OP_DECBP: case NCS_OP_INCBP:
+            out->op = (in.opcode == NCS_OP_DECSP) ? NCS_VM_OP_DECSP
+                    : (in.opcode == NCS_OP_INCSP) ? NCS_VM_OP_INCSP
+                    : (in.opcode == NCS_OP_DECBP) ? NCS_VM_OP_DECBP : NCS_VM_OP_INCBP;
+            return ncs_vm_to_cells(in.arg0, &out->a) ? NCS_VM_OK : NCS_VM_ERROR_BAD_OFFSET;
+
+        case NCS_OP_SAVEBP:
+            out->op = NCS_VM_OP_SAVEBP;
+            return NCS_VM_OK;
+
+        case NCS_OP_RESTOREBP:
+            out->op = NCS_VM_OP_RESTOREBP;
+            return NCS_VM_OK;
+
+        case NCS_OP_STORE_STATE:
+            // The deferred block starts after the JMP that skips it
+            if (index + 2 >= decoded->instructions.size() ||
+                decoded->instructions[index + 1].opcode != NCS_OP_JMP) {
+                return NCS_VM_ERROR_BAD_PROGRAM;
+            }
+            out->op = NCS_VM_OP_STORE_STATE;
+            if (!ncs_vm_to_cells(in.arg0, &out->a) || !ncs_vm_to_cells(in.arg1, &out->b) ||
+                out->a < 0 || out->b < 0) {
+                return NCS_VM_ERROR_BAD_OFFSET;
+            }
+            return NCS_VM_OK;
+
+        case NCS_OP_NOP:
+            out->op = NCS_VM_OP_NOP;
+            return NCS_VM_OK;
+
+        default:
+            return NCS_VM_ERROR_BAD_OPCODE;
+    }
+}
+
+/**
+ * @brief FNV-1a over the file; ties a native translation to the exact script it came from
+ */
+static uint32_t ncs_vm_checksum(const uint8_t* data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static std::atomic<uint64_t> g_ncsVmNextProgramId(1);
+
+int ncs_vm_load(const uint8_t* data, size_t size, NcsVmProgram* program)
+{
+    return ncs_vm_load_with_flags(data, size, 0, program);
+}
+
+int ncs_vm_load_with_flags(const uint8_t* data, size_t size, uint32_t flags, NcsVmProgram* program)
+{
+    program->code.clear();
+    program->strings.clear();
+    program->errorOffset = 0;
+    program->fusedSequences = 0;
+    program->verified = 0;
+    program->maxStackCells = 0;
+    program->checksum = ncs_vm_checksum(data, size);
+    program->id = g_ncsVmNextProgramId.fetch_add(1);
+    program->native = NULL;
+
+    NcsProgram decoded;
+    int decodeResult = ncs_decode_program(data, size, &decoded);
+    if (decodeResult != NCS_OK) {
+        return ncs_vm_load_error(decodeResult);
+    }
+    if (decoded.instructions.empty()) {
+        return NCS_VM_ERROR_BAD_PROGRAM;
+    }
+
+    program->code.resize(decoded.instructions.size() + 1);
+    for (size_t i = 0; i < decoded.instructions.size(); i++) {
+        int result = ncs_vm_load_instruction(&decoded, i, program, &program->code[i]);
+        if (result != NCS_VM_OK) {
+            program->errorOffset = decoded.instructions[i].offset;
+            program->code.clear();
+            program->strings.clear();
+            return result;
+        }
+    }
+
+    // Falling off the end lands on the sentinel instead of needing a bounds check
+    NcsVmInstruction& end = program->code.back();
+    memset(&end, 0, sizeof(end));
+    end.op = NCS_VM_OP_END;
+    end.offset = decoded.declaredSize;
+
+    if ((flags & NCS_VM_LOAD_NO_FUSION) == 0) {
+        program->fusedSequences = ncs_vm_fuse_program(program);
+    }
+    return NCS_VM_OK;
+}
@@ -0,0 +1,714 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - AHEAD-OF-TIME NATIVE SCRIPTS
+// ============================================================================
+// Translation runs in two passes. The first walks each function (program
+// start, JSR targets and STORE_STATE blocks) and assigns every instruction
+// its stack depth relative to the function's entry; a JSR applies the
+// callee's net effect, analysed first. The second writes one C++ function
+// per analysed function in which the depth of each instruction is a
+// constant, so cell k below the top is simply f[depth - k].
+// ============================================================================
+
+#include "ncs_vm_native.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include <algorithm>
+#include <mutex>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#define NCS_VM_NATIVE_UNREACHED INT32_MIN     // Depth of an instruction no path reaches
+
+enum NcsVmNativeFunctionKind
+{
+    NCS_VM_NATIVE_START = 0,           // Program start
+    NCS_VM_NATIVE_SUBROUTINE,          // JSR target
+    NCS_VM_NATIVE_BLOCK                // STORE_STATE block, an entry point of its own
+};
+
+typedef struct NcsVmNativeFunction
+{
+    int kind;                          // NcsVmNativeFunctionKind
+    bool analysed;                     // Analysis finished (a JSR to an unfinished function is recursion)
+    bool returns;                      // Some path reaches RETN
+    int32_t exitDepth;                 // Depth at RETN
+    bool savesBp;                      // Contains SAVEBP, so BP can rise above the entry SP
+} NcsVmNativeFunction;
+
+typedef struct NcsVmNativeAnalysis
+{
+    const NcsVmProgram* program;
+    std::vector<int32_t> depth;        // Depth before each instruction, NCS_VM_NATIVE_UNREACHED if unreached
+    std::vector<uint32_t> owner;       // Entry of the function each instruction belongs to
+    std::vector<uint8_t> labelled;     // Target of a JMP/JZ/JNZ
+    std::map<uint32_t, NcsVmNativeFunction> functions;
+    std::vector<uint32_t> blocks;      // STORE_STATE blocks not yet analysed
+} NcsVmNativeAnalysis;
+
+// ============================================================================
+// REGISTRY
+// ============================================================================
+
+static std::mutex& ncs_vm_native_lock()
+{
+    static std::mutex lock;
+    return lock;
+}
+
+static std::map<std::string, const NcsVmNativeScript*>& ncs_vm_native_scripts()
+{
+    static std::map<std::string, const NcsVmNativeScript*> scripts;
+    return scripts;
+}
+
+static std::string ncs_vm_native_key(const char* resref)
+{
+    std::string key(resref != NULL ? resref : "");
+    for (size_t i = 0; i < key.size(); i++) {
+        key[i] = (char)tolower((unsigned char)key[i]);
+    }
+    return key;
+}
+
+void ncs_vm_native_register(const NcsVmNativeScript* script)
+{
+    std::lock_guard<std::mutex> guard(ncs_vm_native_lock());
+    ncs_vm_native_scripts()[ncs_vm_native_key(script->resref)] = script;
+}
+
+int ncs_vm_native_load(const char* path, const char* resref)
+{
+    std::string symbol = NCS_VM_NATIVE_SYMBOL_PREFIX + ncs_vm_native_key(resref);
+#if defined(_WIN32)
+    HMODULE library = LoadLibraryA(path);
+    if (library == NULL) {
+        return 0;
+    }
+    NcsVmNativeAccessor accessor = (NcsVmNativeAccessor)GetProcAddress(library, symbol.c_str());
+#else
+    void* library = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (library == NULL) {
+        return 0;
+    }
+    NcsVmNativeAccessor accessor = (NcsVmNativeAccessor)dlsym(library, symbol.c_str());
+#endif
+    const NcsVmNativeScript* script = accessor != NULL ? accessor() : NULL;
+    if (script == NULL) {
+        return 0;
+    }
+    ncs_vm_native_register(script);
+    return 1;
+}
+
+const NcsVmNativeScript* ncs_vm_native_find(const char* resref)
+{
+    std::lock_guard<std::mutex> guard(ncs_vm_native_lock());
+    std::map<std::string, const NcsVmNativeScript*>& scripts = ncs_vm_native_scripts();
+    std::map<std::string, const NcsVmNativeScript*>::const_iterator found = scripts.find(ncs_vm_native_key(resref));
+    return found != scripts.end() ? found->second : NULL;
+}
+
+int ncs_vm_native_attach(NcsVmProgram* program, const char* resref)
+{
+    const NcsVmNativeScript* script = ncs_vm_native_find(resref);
+    if (script == NULL || script->checksum != program->checksum) {
+        program->native = NULL;
+        return 0;
+    }
+    program->native = script;
+    return 1;
+}
+
+int ncs_vm_native_has_entry(const NcsVmNativeScript* script, uint32_t entryIndex)
+{
+    const uint32_t* end = script->entries + script->entryCount;
+    const uint32_t* found = std::lower_bound(script->entries, end, entryIndex);
+    return found != end && *found == entryIndex;
+}
+
+// ============================================================================
+// DEPTH ANALYSIS
+// ============================================================================
+
+/**
+ * @brief Net stack change of an instruction that is not a control transfer
+ */
+static int32_t ncs_vm_native_delta(const NcsVmInstruction* in)
+{
+    switch (in->op) {
+        case NCS_VM_OP_RSADD:
+        case NCS_VM_OP_CONST:
+        case NCS_VM_OP_CONSTS:
+        case NCS_VM_OP_CONSTO:
+        case NCS_VM_OP_SAVEBP:
+            return 1;
+        case NCS_VM_OP_CPTOPSP:
+        case NCS_VM_OP_CPTOPBP:
+            return in->count;
+        case NCS_VM_OP_ACTION:
+            return in->b;
+        case NCS_VM_OP_EQUALTT:
+        case NCS_VM_OP_NEQUALTT:
+            return 1 - 2 * (int32_t)in->count;
+        case NCS_VM_OP_ADDVV:
+        case NCS_VM_OP_SUBVV:
+            return -3;
+        case NCS_VM_OP_MOVSP:
+            return in->a;
+        case NCS_VM_OP_DESTRUCT:
+            return in->b - (int32_t)in->count;
+        case NCS_VM_OP_CPDOWNSP:
+        case NCS_VM_OP_CPDOWNBP:
+        case NCS_VM_OP_NEGI:
+        case NCS_VM_OP_NEGF:
+        case NCS_VM_OP_COMPI:
+        case NCS_VM_OP_NOTI:
+        case NCS_VM_OP_DECSP:
+        case NCS_VM_OP_INCSP:
+        case NCS_VM_OP_DECBP:
+        case NCS_VM_OP_INCBP:
+        case NCS_VM_OP_STORE_STATE:
+        case NCS_VM_OP_NOP:
+            return 0;
+        default:
+            return -1;                 // Binary operators and RESTOREBP
+    }
+}
+
+static int ncs_vm_native_analyse(NcsVmNativeAnalysis* analysis, uint32_t entry, int kind);
+
+/**
+ * @brief Give a successor its depth; a second path must agree
+ */
+static int ncs_vm_native_reach(NcsVmNativeAnalysis* analysis, uint32_t entry, uint32_t index, int32_t depth,
+                               std::vector<uint32_t>* pending)
+{
+    if (analysis->depth[index] == NCS_VM_NATIVE_UNREACHED) {
+        analysis->depth[index] = depth;
+        analysis->owner[index] = entry;
+        pending->push_back(index);
+        return NCS_VM_OK;
+    }
+    if (analysis->owner[index] != entry) {
+        return NCS_VM_ERROR_UNSUPPORTED;
+    }
+    return analysis->depth[index] == depth ? NCS_VM_OK : NCS_VM_ERROR_UNBALANCED;
+}
+
+/**
+ * @brief Assign depths to every instruction of the function at entry
+ */
+static int ncs_vm_native_analyse(NcsVmNativeAnalysis* analysis, uint32_t entry, int kind)
+{
+    NcsVmNativeFunction function;
+    function.kind = kind;
+    function.analysed = false;
+    function.returns = false;
+    function.exitDepth = 0;
+    function.savesBp = false;
+    analysis->functions[entry] = function;
+
+    const NcsVmInstruction* code = analysis->program->code.data();
+    std::vector<uint32_t> pending;
+    int result = ncs_vm_native_reach(analysis, entry, entry, 0, &pending);
+    while (result == NCS_VM_OK && !pending.empty()) {
+        uint32_t index = pending.back();
+        pending.pop_back();
+        const NcsVmInstruction* in = &code[index];
+        int32_t depth = analysis->depth[index];
+
+        switch (in->op) {
+            case NCS_VM_OP_JMP:
+                analysis->labelled[in->a] = 1;
+                result = ncs_vm_native_reach(analysis, entry, (uint32_t)in->a, depth, &pending);
+                break;
+            case NCS_VM_OP_JZ:
+            case NCS_VM_OP_JNZ:
+                analysis->labelled[in->a] = 1;
+                result = ncs_vm_native_reach(analysis, entry, (uint32_t)in->a, depth - 1, &pending);
+                if (result == NCS_VM_OK) {
+                    result = ncs_vm_native_reach(analysis, entry, index + 1, depth - 1, &pending);
+                }
+                break;
+            case NCS_VM_OP_JSR: {
+                std::map<uint32_t, NcsVmNativeFunction>::iterator callee = analysis->functions.find((uint32_t)in->a);
+                if (callee == analysis->functions.end()) {
+                    result = ncs_vm_native_analyse(analysis, (uint32_t)in->a, NCS_VM_NATIVE_SUBROUTINE);
+                    callee = analysis->functions.find((uint32_t)in->a);
+                }
+                if (result != NCS_VM_OK) {
+                    break;
+                }
+                if (!callee->second.analysed || callee->second.kind != NCS_VM_NATIVE_SUBROUTINE) {
+                    result = NCS_VM_ERROR_UNSUPPORTED;
+                    break;
+                }
+                if (callee->second.returns) {
+                    result = ncs_vm_native_reach(analysis, entry, index + 1, depth + callee->second.exitDepth, &pending);
+                }
+                break;
+            }
+            case NCS_VM_OP_RETN: {
+                NcsVmNativeFunction* self = &analysis->functions[entry];
+                if (self->returns && self->exitDepth != depth) {
+                    result = NCS_VM_ERROR_UNBALANCED;
+                }
+                self->returns = true;
+                self->exitDepth = depth;
+                break;
+            }
+            case NCS_VM_OP_END:
+                result = NCS_VM_ERROR_END_OF_CODE;
+                break;
+            case NCS_VM_OP_STORE_STATE:
+                analysis->blocks.push_back(index + 2);
+                result = ncs_vm_native_reach(analysis, entry, index + 1, depth, &pending);
+                break;
+            default:
+                if (in->op == NCS_VM_OP_SAVEBP) {
+                    analysis->functions[entry].savesBp = true;
+                }
+                if (in->op >= NCS_VM_OP_CPDOWNSP_MOVSP) {
+                    result = NCS_VM_ERROR_UNSUPPORTED;
+                    break;
+                }
+                result = ncs_vm_native_reach(analysis, entry, index + 1, depth + ncs_vm_native_delta(in), &pending);
+                break;
+        }
+    }
+    analysis->functions[entry].analysed = true;
+    return result;
+}
+
+// ============================================================================
+// C++ OUTPUT
+// ============================================================================
+
+static void ncs_vm_native_function_name(const NcsVmNativeAnalysis* analysis, uint32_t entry, char* name, size_t size)
+{
+    const NcsVmNativeFunction& function = analysis->functions.find(entry)->second;
+    uint32_t offset = analysis->program->code[entry].offset;
+    switch (function.kind) {
+        case NCS_VM_NATIVE_START: snprintf(name, size, "ncs_start"); break;
+        case NCS_VM_NATIVE_BLOCK: snprintf(name, size, "ncs_action_%08X", offset); break;
+        default:                  snprintf(name, size, "ncs_sub_%08X", offset); break;
+    }
+}
+
+static const char* ncs_vm_native_type_name(uint8_t type)
+{
+    static const char* const names[] = {
+        "NCS_VM_TYPE_INT", "NCS_VM_TYPE_FLOAT", "NCS_VM_TYPE_STRING", "NCS_VM_TYPE_OBJECT",
+        "NCS_VM_TYPE_EFFECT", "NCS_VM_TYPE_EVENT", "NCS_VM_TYPE_LOCATION", "NCS_VM_TYPE_TALENT"
+    };
+    return type < sizeof(names) / sizeof(names[0]) ? names[type] : "NCS_VM_TYPE_INT";
+}
+
+/**
+ * @brief Operand fields, result type and expression of a two-cell operator
+ */
+typedef struct NcsVmNativeBinary
+{
+    uint8_t op;
+    char left;                         // 'i' or 'f'
+    char right;
+    char resultField;                  // 'i' (int result) or 'f'
+    const char* expression;            // Of l and r
+} NcsVmNativeBinary;
+
+static const NcsVmNativeBinary* ncs_vm_native_binary(uint8_t op)
+{
+    static const NcsVmNativeBinary table[] = {
+        { NCS_VM_OP_LOGANDII,   'i', 'i', 'i', "(l && r) ? 1 : 0" },
+        { NCS_VM_OP_LOGORII,    'i', 'i', 'i', "(l || r) ? 1 : 0" },
+        { NCS_VM_OP_INCORII,    'i', 'i', 'i', "l | r" },
+        { NCS_VM_OP_EXCORII,    'i', 'i', 'i', "l ^ r" },
+        { NCS_VM_OP_BOOLANDII,  'i', 'i', 'i', "l & r" },
+        { NCS_VM_OP_EQUAL,      'i', 'i', 'i', "(l == r) ? 1 : 0" },
+        { NCS_VM_OP_EQUALFF,    'f', 'f', 'i', "(l == r) ? 1 : 0" },
+        { NCS_VM_OP_NEQUAL,     'i', 'i', 'i', "(l == r) ? 0 : 1" },
+        { NCS_VM_OP_NEQUALFF,   'f', 'f', 'i', "(l == r) ? 0 : 1" },
+        { NCS_VM_OP_GEQII,      'i', 'i', 'i', "(l >= r) ? 1 : 0" },
+        { NCS_VM_OP_GEQFF,      'f', 'f', 'i', "(l >= r) ? 1 : 0" },
+        { NCS_VM_OP_GTII,       'i', 'i', 'i', "(l > r) ? 1 : 0" },
+        { NCS_VM_OP_GTFF,       'f', 'f', 'i', "(l > r) ? 1 : 0" },
+        { NCS_VM_OP_LTII,       'i', 'i', 'i', "(l < r) ? 1 : 0" },
+        { NCS_VM_OP_LTFF,       'f', 'f', 'i', "(l < r) ? 1 : 0" },
+        { NCS_VM_OP_LEQII,      'i', 'i', 'i', "(l <= r) ? 1 : 0" },
+        { NCS_VM_OP_LEQFF,      'f', 'f', 'i', "(l <= r) ? 1 : 0" },
+        { NCS_VM_OP_SHLEFTII,   'i', 'i', 'i', "(int32_t)((uint32_t)l << (r & 31))" },
+        { NCS_VM_OP_SHRIGHTII,  'i', 'i', 'i', "l >> (r & 31)" },
+        { NCS_VM_OP_USHRIGHTII, 'i', 'i', 'i', "(int32_t)((uint32_t)l >> (r & 31))" },
+        { NCS_VM_OP_ADDII,      'i', 'i', 'i', "(int32_t)((uint32_t)l + (uint32_t)r)" },
+        { NCS_VM_OP_ADDIF,      'i', 'f', 'f', "(float)l + r" },
+        { NCS_VM_OP_ADDFI,      'f', 'i', 'f', "l + (float)r" },
+        { NCS_VM_OP_ADDFF,      'f', 'f', 'f', "l + r" },
+        { NCS_VM_OP_SUBII,      'i', 'i', 'i', "(int32_t)((uint32_t)l - (uint32_t)r)" },
+        { NCS_VM_OP_SUBIF,      'i', 'f', 'f', "(float)l - r" },
+        { NCS_VM_OP_SUBFI,      'f', 'i', 'f', "l - (float)r" },
+        { NCS_VM_OP_SUBFF,      'f', 'f', 'f', "l - r" },
+        { NCS_VM_OP_MULII,      'i', 'i', 'i', "(int32_t)((uint32_t)l * (uint32_t)r)" },
+        { NCS_VM_OP_MULIF,      'i', 'f', 'f', "(float)l * r" },
+        { NCS_VM_OP_MULFI,      'f', 'i', 'f', "l * (float)r" },
+        { NCS_VM_OP_MULFF,      'f', 'f', 'f', "l * r" },
+        { NCS_VM_OP_DIVII,      'i', 'i', 'i', "r == -1 ? (int32_t)(0u - (uint32_t)l) : l / r" },
+        { NCS_VM_OP_DIVIF,      'i', 'f', 'f', "(float)l / r" },
+        { NCS_VM_OP_DIVFI,      'f', 'i', 'f', "l / (float)r" },
+        { NCS_VM_OP_DIVFF,      'f', 'f', 'f', "l / r" },
+        { NCS_VM_OP_MODII,      'i', 'i', 'i', "r == -1 ? 0 : l % r" }
+    };
+    for (size_t i = 0; i < sizeof(table) / sizeof(table[0]); i++) {
+        if (table[i].op == op) {
+            return &table[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief "c->bp - 3" style operand for a BP-relative cell
+ */
+static std::string ncs_vm_native_bp_cell(int32_t offset)
+{
+    char text[32];
+    if (offset < 0) {
+        snprintf(text, sizeof(text), "c->stack[c->bp - %d]", -offset);
+    }
+    else {
+        snprintf(text, sizeof(text), "c->stack[c->bp + %d]", offset);
+    }
+    return text;
+}
+
+/**
+ * @brief Emit the globalsDirty update for an SP-relative write or pop down to a depth
+ *
+ * BP never rises above a function's entry SP unless the function itself
+ * executes SAVEBP (a callee restores BP before returning), so in other
+ * functions only cells below the entry (arguments, return slots, a
+ * deferred block's saved cells) can be globals and need the check.
+ */
+static void ncs_vm_native_emit_below_bp(const NcsVmNativeAnalysis* analysis, uint32_t index, int32_t depth,
+                                        FILE* stream)
+{
+    if (depth < 0 || analysis->functions.find(analysis->owner[index])->second.savesBp) {
+        fprintf(stream, "    if (&f[%d] < c->stack + c->bp) vm->globalsDirty = 1;\n", depth);
+    }
+}
+
+/**
+ * @brief Write the statements of one instruction at a known depth
+ */
+static void ncs_vm_native_emit_instruction(const NcsVmNativeAnalysis* analysis, uint32_t index, FILE* stream)
+{
+    const NcsVmInstruction* in = &analysis->program->code[index];
+    const int32_t d = analysis->depth[index];
+    const int32_t n = in->count;
+    char callee[32];
+
+    if (analysis->labelled[index]) {
+        fprintf(stream, "L_%u:\n", index);
+    }
+    fprintf(stream, "    // %08X %s (depth %d)\n", in->offset, ncs_vm_op_name(in->op), d);
+
+    const NcsVmNativeBinary* binary = ncs_vm_native_binary(in->op);
+    if (binary != NULL) {
+        if (in->op == NCS_VM_OP_DIVII || in->op == NCS_VM_OP_MODII) {
+            fprintf(stream, "    if (f[%d].value.i == 0) NCS_AOT_FAIL(NCS_VM_ERROR_DIVIDE_BY_ZERO, 0x%08Xu, %d);\n",
+                    d - 1, in->offset, d);
+        }
+        fprintf(stream, "    { %s l = f[%d].value.%c; %s r = f[%d].value.%c;\n",
+                binary->left == 'f' ? "float" : "int32_t", d - 2, binary->left,
+                binary->right == 'f' ? "float" : "int32_t", d - 1, binary->right);
+        fprintf(stream, "      f[%d] = %s(%s); }\n", d - 2, binary->resultField == 'f' ? "ncs_aot_float" : "ncs_aot_int",
+                binary->expression);
+        return;
+    }
+
+    switch (in->op) {
+        case NCS_VM_OP_CPDOWNSP:
+            ncs_vm_native_emit_below_bp(analysis, index, d + in->a, stream);
+            if (n == 1) {
+                fprintf(stream, "    ncs_aot_copy(&f[%d], &f[%d]);\n", d + in->a, d - 1);
+            }
+            else {
+                fprintf(stream, "    memmove(&f[%d], &f[%d], %d * sizeof(NcsVmValue));\n", d + in->a, d - n, n);
+            }
+            break;
+        case NCS_VM_OP_CPTOPSP:
+            if (n == 1) {
+                fprintf(stream, "    ncs_aot_copy(&f[%d], &f[%d]);\n", d, d + in->a);
+            }
+            else {
+                fprintf(stream, "    memcpy(&f[%d], &f[%d], %d * sizeof(NcsVmValue));\n", d, d + in->a, n);
+            }
+            break;
+        case NCS_VM_OP_CPDOWNBP:
+            fprintf(stream, "    vm->globalsDirty = 1;\n");
+            fprintf(stream, "    memmove(&%s, &f[%d], %d * sizeof(NcsVmValue));\n",
+                    ncs_vm_native_bp_cell(in->a).c_str(), d - n, n);
+            break;
+        case NCS_VM_OP_CPTOPBP:
+            fprintf(stream, "    memcpy(&f[%d], &%s, %d * sizeof(NcsVmValue));\n",
+                    d, ncs_vm_native_bp_cell(in->a).c_str(), n);
+            break;
+        case NCS_VM_OP_RSADD:
+            fprintf(stream, "    f[%d] = ncs_aot_cell(%s, %s);\n", d, ncs_vm_native_type_name(in->type),
+                    in->type == NCS_VM_TYPE_OBJECT ? "NCS_VM_OBJECT_INVALID" : "0");
+            break;
+        case NCS_VM_OP_CONST:
+            fprintf(stream, "    f[%d] = ncs_aot_cell(%s, 0x%08Xu);\n", d, ncs_vm_native_type_name(in->type), (uint32_t)in->a);
+            break;
+        case NCS_VM_OP_CONSTS:
+            fprintf(stream, "    f[%d] = ncs_aot_cell(NCS_VM_TYPE_STRING, c->stringBase + %du);\n", d, in->a);
+            break;
+        case NCS_VM_OP_CONSTO:
+            if (in->a == 0) {
+                fprintf(stream, "    f[%d] = ncs_aot_cell(NCS_VM_TYPE_OBJECT, vm->objectSelf);\n", d);
+            }
+            else if (in->a == 1) {
+                fprintf(stream, "    f[%d] = ncs_aot_cell(NCS_VM_TYPE_OBJECT, NCS_VM_OBJECT_INVALID);\n", d);
+            }
+            else {
+                fprintf(stream, "    f[%d] = ncs_aot_cell(NCS_VM_TYPE_OBJECT, %uu);\n", d, (uint32_t)in->a);
+            }
+            break;
+        case NCS_VM_OP_ACTION:
+            fprintf(stream, "    vm->sp = (uint32_t)(&f[%d] - c->stack); vm->bp = c->bp; vm->errorOffset = 0x%08Xu;\n",
+                    d, in->offset);
+            fprintf(stream, "    result = ncs_vm_call_action(vm, %d, %d, %d);\n", in->a, n, in->b);
+            fprintf(stream, "    if (result != NCS_VM_OK) return result;\n");
+            break;
+        case NCS_VM_OP_EQUALSS:
+        case NCS_VM_OP_NEQUALSS:
+        case NCS_VM_OP_EQUALTT:
+        case NCS_VM_OP_NEQUALTT: {
+            int32_t cells = (in->op == NCS_VM_OP_EQUALTT || in->op == NCS_VM_OP_NEQUALTT) ? n : 1;
+            bool expect = (in->op == NCS_VM_OP_EQUALSS || in->op == NCS_VM_OP_EQUALTT);
+            fprintf(stream, "    { bool equal = true;\n");
+            fprintf(stream, "      for (int k = 0; k < %d && equal; k++) equal = ncs_vm_values_equal(vm, &f[%d + k], &f[%d + k]);\n",
+                    cells, d - 2 * cells, d - cells);
+            fprintf(stream, "      f[%d] = ncs_aot_int(equal ? %d : %d); }\n", d - 2 * cells, expect ? 1 : 0, expect ? 0 : 1);
+            break;
+        }
+        case NCS_VM_OP_ADDSS:
+            fprintf(stream, "    { std::string joined = ncs_vm_string(vm, f[%d].value.handle) + ncs_vm_string(vm, f[%d].value.handle);\n",
+                    d - 2, d - 1);
+            fprintf(stream, "      f[%d] = ncs_aot_cell(NCS_VM_TYPE_STRING, ncs_vm_new_string(vm, joined)); }\n", d - 2);
+            break;
+        case NCS_VM_OP_ADDVV:
+        case NCS_VM_OP_SUBVV:
+            for (int k = 0; k < 3; k++) {
+                fprintf(stream, "    f[%d].value.f %c= f[%d].value.f;\n", d - 6 + k,
+                        in->op == NCS_VM_OP_ADDVV ? '+' : '-', d - 3 + k);
+            }
+            break;
+        case NCS_VM_OP_MULVF:
+        case NCS_VM_OP_DIVVF:
+            fprintf(stream, "    { float scalar = f[%d].value.f;\n", d - 1);
+            for (int k = 0; k < 3; k++) {
+                fprintf(stream, "      f[%d].value.f %c= scalar;\n", d - 4 + k, in->op == NCS_VM_OP_MULVF ? '*' : '/');
+            }
+            fprintf(stream, "    }\n");
+            break;
+        case NCS_VM_OP_MULFV:
+            fprintf(stream, "    { float scalar = f[%d].value.f;\n", d - 4);
+            for (int k = 0; k < 3; k++) {
+                fprintf(stream, "      ncs_aot_copy(&f[%d], &f[%d]); f[%d].value.f *= scalar;\n", d - 4 + k, d - 3 + k, d - 4 + k);
+            }
+            fprintf(stream, "    }\n");
+            break;
+        case NCS_VM_OP_NEGI:
+            fprintf(stream, "    f[%d].value.i = (int32_t)(0u - (uint32_t)f[%d].value.i);\n", d - 1, d - 1);
+            break;
+        case NCS_VM_OP_NEGF:
+            fprintf(stream, "    f[%d].value.f = -f[%d].value.f;\n", d - 1, d - 1);
+            break;
+        case NCS_VM_OP_COMPI:
+            fprintf(stream, "    f[%d].value.i = ~f[%d].value.i;\n", d - 1, d - 1);
+            break;
+        case NCS_VM_OP_NOTI:
+            fprintf(stream, "    f[%d].value.i = (f[%d].value.i == 0) ? 1 : 0;\n", d - 1, d - 1);
+            break;
+        case NCS_VM_OP_JMP:
+            fprintf(stream, "    goto L_%d;\n", in->a);
+            break;
+        case NCS_VM_OP_JZ:
+        case NCS_VM_OP_JNZ:
+            fprintf(stream, "    if (f[%d].value.i %s 0) goto L_%d;\n", d - 1, in->op == NCS_VM_OP_JZ ? "==" : "!=", in->a);
+            break;
+        case NCS_VM_OP_JSR: {
+            ncs_vm_native_function_name(analysis, (uint32_t)in->a, callee, sizeof(callee));
+            fprintf(stream, "    result = %s(c, &f[%d]);\n", callee, d);
+            const NcsVmNativeFunction& function = analysis->functions.find((uint32_t)in->a)->second;
+            fprintf(stream, function.returns ? "    if (result != NCS_VM_OK) return result;\n" : "    return result;\n");
+            break;
+        }
+        case NCS_VM_OP_RETN:
+            fprintf(stream, "    return NCS_VM_OK;\n");
+            break;
+        case NCS_VM_OP_DESTRUCT:
+            ncs_vm_native_emit_below_bp(analysis, index, d - n, stream);
+            fprintf(stream, "    memmove(&f[%d], &f[%d], %d * sizeof(NcsVmValue));\n", d - n, d - n + in->a, in->b);
+            break;
+        case NCS_VM_OP_MOVSP:
+            ncs_vm_native_emit_below_bp(analysis, index, d + in->a, stream);
+            break;
+        case NCS_VM_OP_DECSP:
+        case NCS_VM_OP_INCSP:
+            ncs_vm_native_emit_below_bp(analysis, index, d + in->a, stream);
+            fprintf(stream, "    ncs_aot_step(&f[%d], %d);\n", d + in->a, in->op == NCS_VM_OP_INCSP ? 1 : -1);
+            break;
+        case NCS_VM_OP_DECBP:
+        case NCS_VM_OP_INCBP:
+            fprintf(stream, "    vm->globalsDirty = 1;\n");
+            fprintf(stream, "    ncs_aot_step(&%s, %d);\n", ncs_vm_native_bp_cell(in->a).c_str(),
+                    in->op == NCS_VM_OP_INCBP ? 1 : -1);
+            break;
+        case NCS_VM_OP_SAVEBP:
+            fprintf(stream, "    f[%d] = ncs_aot_cell(NCS_VM_TYPE_INT, c->bp); c->bp = (uint32_t)(&f[%d] - c->stack);\n", d, d);
+            break;
+        case NCS_VM_OP_RESTOREBP:
+            fprintf(stream, "    if (f[%d].type != NCS_VM_TYPE_INT || (uint32_t)f[%d].value.i > (uint32_t)(&f[%d] - c->stack))\n",
+                    d - 1, d - 1, d - 1);
+            fprintf(stream, "        NCS_AOT_FAIL(NCS_VM_ERROR_TYPE_MISMATCH, 0x%08Xu, %d);\n", in->offset, d - 1);
+            fprintf(stream, "    c->bp = (uint32_t)f[%d].value.i; vm->globalsDirty = 1;\n", d - 1);
+            break;
+        case NCS_VM_OP_STORE_STATE:
+            fprintf(stream, "    vm->sp = (uint32_t)(&f[%d] - c->stack); vm->bp = c->bp;\n", d);
+            fprintf(stream, "    result = ncs_vm_store_state(vm, %uu, %uu, %uu);\n", index + 2, (uint32_t)in->a, (uint32_t)in->b);
+            fprintf(stream, "    if (result != NCS_VM_OK) NCS_AOT_FAIL(result, 0x%08Xu, %d);\n", in->offset, d);
+            break;
+        default:                       // NOP only changes the depth
+            break;
+    }
+}
+
+static void ncs_vm_native_emit_function(const NcsVmNativeAnalysis* analysis, uint32_t entry, FILE* stream)
+{
+    char name[32];
+    ncs_vm_native_function_name(analysis, entry, name, sizeof(name));
+    fprintf(stream, "\nstatic int %s(NcsVmNativeContext* c, NcsVmValue* f)\n{\n", name);
+    fprintf(stream, "    NcsVm* const vm = c->vm;\n    int result = NCS_VM_OK;\n    (void)vm;\n    (void)result;\n");
+    for (uint32_t i = 0; i < analysis->depth.size(); i++) {
+        if (analysis->depth[i] != NCS_VM_NATIVE_UNREACHED && analysis->owner[i] == entry) {
+            ncs_vm_native_emit_instruction(analysis, i, stream);
+        }
+    }
+    fprintf(stream, "}\n");
+}
+
+int ncs_vm_native_emit(const NcsVmProgram* program, const char* resref, FILE* stream)
+{
+    std::string symbol = ncs_vm_native_key(resref);
+    if (!program->verified || program->fusedSequences != 0 || program->code.size() < 2 ||
+        symbol.empty() || symbol.size() > NCS_VM_NATIVE_RESREF_MAX) {
+        return NCS_VM_ERROR_UNSUPPORTED;
+    }
+    for (size_t i = 0; i < symbol.size(); i++) {
+        if (!isalnum((unsigned char)symbol[i]) && symbol[i] != '_') {
+            return NCS_VM_ERROR_UNSUPPORTED;
+        }
+    }
+
+    NcsVmNativeAnalysis analysis;
+    analysis.program = program;
+    analysis.depth.assign(program->code.size(), NCS_VM_NATIVE_UNREACHED);
+    analysis.owner.assign(program->code.size(), 0);
+    analysis.labelled.assign(program->code.size(), 0);
+    int result = ncs_vm_native_analyse(&analysis, 0, NCS_VM_NATIVE_START);
+    while (result == NCS_VM_OK && !analysis.blocks.empty()) {
+        uint32_t block = analysis.blocks.back();
+        analysis.blocks.pop_back();
+        if (analysis.functions.find(block) == analysis.functions.end()) {
+            result = ncs_vm_native_analyse(&analysis, block, NCS_VM_NATIVE_BLOCK);
+        }
+    }
+    if (result != NCS_VM_OK) {
+        return result;
+    }
+
+    fprintf(stream, "// Generated by ncs_vm_native_emit from %s.ncs (checksum 0x%08X); do not edit.\n\n",
+            symbol.c_str(), program->checksum);
+    fprintf(stream, "#include <string.h>\n\n#include \"ncs_vm_native.h\"\n\n");
+    fprintf(stream, "#define NCS_AOT_FAIL(error_, offset_, depth_) \\\n"
+                    "    do { c->vm->sp = (uint32_t)(&f[depth_] - c->stack); c->vm->errorOffset = (offset_); return (error_); } while (0)\n\n");
+    fprintf(stream, "static inline NcsVmValue ncs_aot_cell(uint8_t type, uint32_t handle)\n{\n"
+                    "    NcsVmValue cell;\n    cell.type = type;\n    cell.value.handle = handle;\n    return cell;\n}\n\n");
+    fprintf(stream, "static inline NcsVmValue ncs_aot_int(int32_t value)\n{\n"
+                    "    return ncs_aot_cell(NCS_VM_TYPE_INT, (uint32_t)value);\n}\n\n");
+    fprintf(stream, "static inline NcsVmValue ncs_aot_float(float value)\n{\n"
+                    "    NcsVmValue cell;\n    cell.type = NCS_VM_TYPE_FLOAT;\n    cell.value.f = value;\n    return cell;\n}\n\n");
+    // Field-wise, so a copy reads exactly what was stored (a whole-cell load
+    // after a one-byte type store would defeat store forwarding)
+    fprintf(stream, "static inline void ncs_aot_copy(NcsVmValue* to, const NcsVmValue* from)\n{\n"
+                    "    to->type = from->type;\n    to->value = from->value;\n}\n\n");
+    fprintf(stream, "static inline void ncs_aot_step(NcsVmValue* cell, int step)\n{\n"
+                    "    if (cell->type == NCS_VM_TYPE_FLOAT) cell->value.f += (float)step;\n"
+                    "    else cell->value.i = (int32_t)((uint32_t)cell->value.i + (uint32_t)step);\n}\n\n");
+
+    char name[32];
+    std::map<uint32_t, NcsVmNativeFunction>::const_iterator it;
+    for (it = analysis.functions.begin(); it != analysis.functions.end(); ++it) {
+        ncs_vm_native_function_name(&analysis, it->first, name, sizeof(name));
+        fprintf(stream, "static int %s(NcsVmNativeContext* c, NcsVmValue* f);\n", name);
+    }
+    for (it = analysis.functions.begin(); it != analysis.functions.end(); ++it) {
+        ncs_vm_native_emit_function(&analysis, it->first, stream);
+    }
+
+    // Entry points: the start and the STORE_STATE blocks, ascending
+    fprintf(stream, "\nstatic const uint32_t ncs_aot_entries[] = {");
+    uint32_t entryCount = 0;
+    for (it = analysis.functions.begin(); it != analysis.functions.end(); ++it) {
+        if (it->second.kind != NCS_VM_NATIVE_SUBROUTINE) {
+            fprintf(stream, "%s %uu", entryCount++ == 0 ? "" : ",", it->first);
+        }
+    }
+    fprintf(stream, " };\n\n");
+
+    fprintf(stream, "static int ncs_aot_entry(NcsVm* vm, uint32_t entryIndex)\n{\n");
+    fprintf(stream, "    NcsVmNativeContext c = { vm, vm->stack.data(), vm->bp, vm->stringBase };\n");
+    fprintf(stream, "    uint32_t base = vm->sp;\n    int32_t exitDepth = 0;\n    int result;\n");
+    fprintf(stream, "    switch (entryIndex) {\n");
+    for (it = analysis.functions.begin(); it != analysis.functions.end(); ++it) {
+        if (it->second.kind != NCS_VM_NATIVE_SUBROUTINE) {
+            ncs_vm_native_function_name(&analysis, it->first, name, sizeof(name));
+            fprintf(stream, "        case %u: result = %s(&c, c.stack + base); exitDepth = %d; break;\n",
+                    it->first, name, it->second.exitDepth);
+        }
+    }
+    fprintf(stream, "        default: return NCS_VM_ERROR_BAD_JUMP;\n    }\n");
+    fprintf(stream, "    if (result == NCS_VM_OK) {\n        vm->sp = (uint32_t)((int32_t)base + exitDepth);\n    }\n");
+    fprintf(stream, "    vm->bp = c.bp;\n    return result;\n}\n\n");
+
+    fprintf(stream, "static const NcsVmNativeScript ncs_aot_script = {\n");
+    fprintf(stream, "    \"%s\", 0x%08Xu, ncs_aot_entries, %u, ncs_aot_entry\n};\n\n", symbol.c_str(), program->checksum,
+            entryCount);
+    fprintf(stream, "NCS_VM_NATIVE_EXPORT const NcsVmNativeScript* " NCS_VM_NATIVE_SYMBOL_PREFIX "%s(void)\n{\n"
+                    "    return &ncs_aot_script;\n}\n", symbol.c_str());
+    return NCS_VM_OK;
+}
+
+int ncs_vm_native_translate(const uint8_t* data, size_t size, const NcsVmActionSignature* signatures,
+                            size_t signatureCount, const char* resref, FILE* stream, uint32_t* errorOffset)
+{
+    NcsVmProgram program;
+    int result = ncs_vm_load_with_flags(data, size, NCS_VM_LOAD_NO_FUSION, &program);
+    if (result == NCS_VM_OK) {
+        result = ncs_vm_verify(&program, signatures, signatureCount);
+    }
+    if (errorOffset != NULL) {
+        *errorOffset = program.errorOffset;
+    }
+    if (result != NCS_VM_OK) {
+        return result;
+    }
+    return ncs_vm_native_emit(&program, resref, stream);
+}
@@ -0,0 +1,146 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - AHEAD-OF-TIME NATIVE SCRIPTS
+// ============================================================================
+// ncs_vm_native_emit translates a verified script into C++: one function per
+// subroutine and per STORE_STATE block, every stack access a fixed slot
+// relative to the frame the function was entered with (depths are static
+// in verified code), jumps as gotos, JSR as a direct call and ACTION as a
+// call to ncs_vm_call_action. The generated translation unit defines an
+// NcsVmNativeScript and an exported accessor, so it can be linked into the
+// host or built into a plugin library loaded with ncs_vm_native_load.
+//
+// The host attaches a translation to a loaded program by resref. The
+// translation records the checksum of the NCS file it came from and is
+// only attached to that exact script, so a rebuilt .ncs falls back to the
+// bytecode until its translation is regenerated. Runs that need the
+// dispatch loop (budgets, profiling, tracing, bounds checks) always use
+// the bytecode.
+// ============================================================================
+
+#ifndef NCS_VM_NATIVE_H
+#define NCS_VM_NATIVE_H
+
+#include "ncs_vm.h"
+
+#define NCS_VM_NATIVE_SYMBOL_PREFIX "ncs_vm_native_"  // + resref: exported accessor
+#define NCS_VM_NATIVE_RESREF_MAX    16                // Longest resref, as in the resource tables
+
+#if defined(_WIN32)
+#define NCS_VM_NATIVE_EXPORT extern "C" __declspec(dllexport)
+#else
+#define NCS_VM_NATIVE_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+/**
+ * @brief Run a translated script from an entry point
+ *
+ * Same contract as ncs_vm_run_program (entryIndex 0) and ncs_vm_run_state
+ * (a STORE_STATE resume index, stack already rebuilt): starts at vm->sp
+ * and vm->bp and writes both back.
+ *
+ * @return NCS_VM_OK or an NcsVmResult error (vm->errorOffset is set)
+ */
+typedef int (*NcsVmNativeEntry)(NcsVm* vm, uint32_t entryIndex);
+
+/**
+ * @brief One translated script, as defined by the generated code
+ */
+typedef struct NcsVmNativeScript
+{
+    const char* resref;                // Lowercase resref the script was translated as
+    uint32_t checksum;                 // NcsVmProgram::checksum of the source file
+    const uint32_t* entries;           // Entry indices the translation covers, ascending
+    uint32_t entryCount;
+    NcsVmNativeEntry entry;
+} NcsVmNativeScript;
+
+/**
+ * @brief Registers shared by the functions of one native run
+ */
+typedef struct NcsVmNativeContext
+{
+    NcsVm* vm;
+    NcsVmValue* stack;
+    uint32_t bp;
+    uint32_t stringBase;               // Pool handle of the program's first CONSTS literal
+} NcsVmNativeContext;
+
+/**
+ * @brief Exported accessor every generated translation unit defines
+ */
+typedef const NcsVmNativeScript* (*NcsVmNativeAccessor)(void);
+
+// ============================================================================
+// TRANSLATION
+// ============================================================================
+
+/**
+ * @brief Write a C++ translation of a script
+ *
+ * The program must be loaded with NCS_VM_LOAD_NO_FUSION and accepted by
+ * ncs_vm_verify, which is what makes every stack depth static. Entry
+ * points are the program start and each STORE_STATE block.
+ *
+ * @param program Verified, unfused script
+ * @param resref Name the script is registered under (letters, digits, '_')
+ * @param stream Output stream
+ * @return NCS_VM_OK, NCS_VM_ERROR_UNSUPPORTED for a fused or unverified
+ *         program or an unusable resref, or NCS_VM_ERROR_UNBALANCED
+ */
+int ncs_vm_native_emit(const NcsVmProgram* program, const char* resref, FILE* stream);
+
+/**
+ * @brief Load, verify and translate an NCS file in one call
+ *
+ * @param data Complete NCS file contents
+ * @param size Byte count of data
+ * @param signatures Stack effect per routine number (see ncs_vm_verify)
+ * @param signatureCount Entries in signatures
+ * @param resref Name the script is registered under
+ * @param stream Output stream
+ * @param errorOffset Receives the offset that failed to load or verify (may be NULL)
+ * @return NCS_VM_OK or the NcsVmResult that prevented the translation
+ */
+int ncs_vm_native_translate(const uint8_t* data, size_t size, const NcsVmActionSignature* signatures,
+                            size_t signatureCount, const char* resref, FILE* stream, uint32_t* errorOffset);
+
+// ============================================================================
+// REGISTRY
+// ============================================================================
+
+/**
+ * @brief Make a translation available to ncs_vm_native_attach (replaces one with the same resref)
+ */
+void ncs_vm_native_register(const NcsVmNativeScript* script);
+
+/**
+ * @brief Load a plugin library and register the translation of one resref
+ *
+ * Looks up NCS_VM_NATIVE_SYMBOL_PREFIX + resref. The library stays loaded
+ * for the lifetime of the process.
+ *
+ * @param path Shared library path
+ * @param resref Script to register
+ * @return 1 on success, 0 if the library or symbol is missing
+ */
+int ncs_vm_native_load(const char* path, const char* resref);
+
+/**
+ * @brief Registered translation of a resref (case-insensitive), or NULL
+ */
+const NcsVmNativeScript* ncs_vm_native_find(const char* resref);
+
+/**
+ * @brief Attach the registered translation of a resref to a loaded program
+ *
+ * @return 1 if attached, 0 if none is registered or it was generated from
+ *         a different file (the program keeps running as bytecode)
+ */
+int ncs_vm_native_attach(NcsVmProgram* program, const char* resref);
+
+/**
+ * @brief Whether a translation covers an entry index
+ */
+int ncs_vm_native_has_entry(const NcsVmNativeScript* script, uint32_t entryIndex);
+
+#endif // NCS_VM_NATIVE_H
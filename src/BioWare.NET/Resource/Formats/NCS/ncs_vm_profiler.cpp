@@ -0,0 +1,382 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - EXECUTION PROFILER
+// ============================================================================
+
+#include "ncs_vm_profiler.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <system_error>
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+void ncs_vm_profiler_init(NcsVmProfiler* profiler)
+{
+    profiler->nodes.clear();
+    profiler->children.clear();
+    profiler->stack.clear();
+    profiler->truncatedFrames = 0;
+    profiler->scripts.clear();
+    profiler->periodMicroseconds = 0;
+    profiler->pendingSamples = 0;
+    profiler->running = 0;
+    profiler->stopSampler = 0;
+}
+
+void ncs_vm_profiler_clear(NcsVmProfiler* profiler)
+{
+    ncs_vm_profiler_stop_sampling(profiler);
+    ncs_vm_profiler_init(profiler);
+}
+
+static void ncs_vm_profiler_sample(NcsVmProfiler* profiler)
+{
+    std::chrono::microseconds period(profiler->periodMicroseconds);
+    while (!profiler->stopSampler.load()) {
+        std::this_thread::sleep_for(period);
+        if (profiler->running.load(std::memory_order_relaxed)) {
+            profiler->pendingSamples.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+int ncs_vm_profiler_start_sampling(NcsVmProfiler* profiler, uint32_t periodMicroseconds)
+{
+    ncs_vm_profiler_stop_sampling(profiler);
+    profiler->periodMicroseconds = periodMicroseconds != 0 ? periodMicroseconds : 1000;
+    profiler->stopSampler = 0;
+    try {
+        profiler->sampler = std::thread(ncs_vm_profiler_sample, profiler);
+    }
+    catch (const std::system_error&) {
+        profiler->periodMicroseconds = 0;
+        return 0;
+    }
+    return 1;
+}
+
+void ncs_vm_profiler_stop_sampling(NcsVmProfiler* profiler)
+{
+    if (profiler->sampler.joinable()) {
+        profiler->stopSampler = 1;
+        profiler->sampler.join();
+    }
+    profiler->periodMicroseconds = 0;
+}
+
+void ncs_vm_profiler_set_symbols(NcsVmProfiler* profiler, const NcsVmProgram* program, const char* scriptName,
+                                 const std::vector<NcsFunctionSymbol>* symbols)
+{
+    NcsVmProfileScript& script = profiler->scripts[program];
+    script.name = scriptName != NULL ? scriptName : "";
+    script.symbols.clear();
+    if (symbols != NULL) {
+        script.symbols = *symbols;
+    }
+}
+
+// ============================================================================
+// NDB DEBUG FILES
+// ============================================================================
+
+static int ncs_vm_ndb_line_file(const char* line, uint32_t* start, uint32_t* end)
+{
+    // l<file> <line> <start> <end>
+    char* next;
+    long file = strtol(line + 1, &next, 10);
+    strtoul(next, &next, 10);
+    *start = (uint32_t)strtoul(next, &next, 16);
+    *end = (uint32_t)strtoul(next, &next, 16);
+    return (int)file;
+}
+
+int ncs_vm_read_ndb(const char* text, size_t size, std::vector<NcsFunctionSymbol>* symbols)
+{
+    symbols->clear();
+    if (size < 3 || strncmp(text, "NDB", 3) != 0) {
+        return 0;
+    }
+
+    std::vector<std::string> files;
+    std::vector<uint32_t> ends;        // End offset per function record
+    std::vector<uint8_t> located;      // Function already has a source file
+    std::string line;
+    size_t position = 0;
+    while (position < size) {
+        size_t stop = position;
+        while (stop < size && text[stop] != '\n') {
+            stop++;
+        }
+        line.assign(text + position, stop - position);
+        position = stop + 1;
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+            line.erase(line.size() - 1);
+        }
+        if (line.empty()) {
+            continue;
+        }
+
+        if (line[0] == 'N' || line[0] == 'n') {
+            // N<index> <name>: the script itself, n<index> <name>: an include
+            char* next;
+            long index = strtol(line.c_str() + 1, &next, 10);
+            while (*next == ' ') {
+                next++;
+            }
+            if (index >= 0 && next != line.c_str() + 1) {
+                if ((size_t)index >= files.size()) {
+                    files.resize((size_t)index + 1);
+                }
+                files[(size_t)index] = next;
+            }
+        }
+        else if (line[0] == 'f' && line.size() > 1 && line[1] == ' ') {
+            // f <start> <end> <parameters> <return type> <name>
+            char* next;
+            NcsFunctionSymbol symbol;
+            symbol.offset = (uint32_t)strtoul(line.c_str() + 1, &next, 16);
+            uint32_t end = (uint32_t)strtoul(next, &next, 16);
+            size_t nameStart = line.find_last_of(' ');
+            symbol.name = line.substr(nameStart + 1);
+            symbols->push_back(symbol);
+            ends.push_back(end);
+            located.push_back(0);
+        }
+        else if (line[0] == 'l') {
+            uint32_t start;
+            uint32_t end;
+            int file = ncs_vm_ndb_line_file(line.c_str(), &start, &end);
+            if (file < 0 || (size_t)file >= files.size()) {
+                continue;
+            }
+            for (size_t i = 0; i < symbols->size(); i++) {
+                if (!located[i] && start >= (*symbols)[i].offset && start < ends[i]) {
+                    (*symbols)[i].sourceFile = files[(size_t)file];
+                    located[i] = 1;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+// ============================================================================
+// DISPATCH LOOP HOOKS
+// ============================================================================
+
+static uint32_t ncs_vm_profile_node(NcsVmProfiler* profiler, uint32_t parent, const NcsVmProgram* program,
+                                    uint32_t function)
+{
+    NcsVmProfileKey key(((uint64_t)parent << 32) | function, program);
+    std::map<NcsVmProfileKey, uint32_t>::iterator found = profiler->children.find(key);
+    if (found != profiler->children.end()) {
+        return found->second;
+    }
+
+    NcsVmProfileNode node;
+    node.program = program;
+    node.function = function;
+    node.parent = parent;
+    node.calls = 0;
+    node.instructions = 0;
+    node.samples = 0;
+    uint32_t index = (uint32_t)profiler->nodes.size();
+    profiler->nodes.push_back(node);
+    profiler->children[key] = index;
+    return index;
+}
+
+void ncs_vm_profile_enter(NcsVmProfiler* profiler, const NcsVmProgram* program, uint32_t function)
+{
+    ncs_vm_profile_leave(profiler);
+    uint32_t node = ncs_vm_profile_node(profiler, NCS_VM_PROFILE_ROOT, program, function);
+    profiler->nodes[node].calls++;
+    profiler->stack.push_back(node);
+}
+
+void ncs_vm_profile_call(NcsVmProfiler* profiler, const NcsVmProgram* program, uint32_t function)
+{
+    if (profiler->stack.empty() || profiler->stack.size() >= NCS_VM_PROFILE_MAX_DEPTH) {
+        profiler->truncatedFrames++;
+        return;
+    }
+    uint32_t node = ncs_vm_profile_node(profiler, profiler->stack.back(), program, function);
+    profiler->nodes[node].calls++;
+    profiler->stack.push_back(node);
+}
+
+void ncs_vm_profile_return(NcsVmProfiler* profiler)
+{
+    if (profiler->truncatedFrames > 0) {
+        profiler->truncatedFrames--;
+    }
+    else if (!profiler->stack.empty()) {
+        profiler->stack.pop_back();
+    }
+}
+
+void ncs_vm_profile_leave(NcsVmProfiler* profiler)
+{
+    profiler->stack.clear();
+    profiler->truncatedFrames = 0;
+}
+
+// ============================================================================
+// OUTPUT
+// ============================================================================
+
+static std::string ncs_vm_profile_script_name(const NcsVmProfiler* profiler, const NcsVmProgram* program)
+{
+    std::map<const NcsVmProgram*, NcsVmProfileScript>::const_iterator script = profiler->scripts.find(program);
+    if (script != profiler->scripts.end() && !script->second.name.empty()) {
+        return script->second.name;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "script_%p", (const void*)program);
+    return name;
+}
+
+static std::string ncs_vm_profile_function_name(const NcsVmProfiler* profiler, const NcsVmProgram* program,
+                                                uint32_t function)
+{
+    uint32_t offset = function < program->code.size() ? program->code[function].offset : 0;
+    std::map<const NcsVmProgram*, NcsVmProfileScript>::const_iterator script = profiler->scripts.find(program);
+    if (script != profiler->scripts.end()) {
+        const std::vector<NcsFunctionSymbol>& symbols = script->second.symbols;
+        for (size_t i = 0; i < symbols.size(); i++) {
+            if (symbols[i].offset == offset) {
+                return symbols[i].name;
+            }
+        }
+    }
+
+    char name[32];
+    if (function == 0) {
+        snprintf(name, sizeof(name), "_start");
+    }
+    else if (function >= 2 && program->code[function - 2].op == NCS_VM_OP_STORE_STATE) {
+        snprintf(name, sizeof(name), "action_%08X", offset);
+    }
+    else {
+        snprintf(name, sizeof(name), "sub_%08X", offset);
+    }
+    return name;
+}
+
+static uint64_t ncs_vm_profile_value(const NcsVmProfileNode* node, int metric)
+{
+    switch (metric) {
+        case NCS_VM_PROFILE_SAMPLES: return node->samples;
+        case NCS_VM_PROFILE_CALLS:   return node->calls;
+        default:                     return node->instructions;
+    }
+}
+
+void ncs_vm_profiler_write_folded(const NcsVmProfiler* profiler, int metric, FILE* stream)
+{
+    // Parents are always created before their children
+    std::vector<std::string> paths(profiler->nodes.size());
+    for (size_t i = 0; i < profiler->nodes.size(); i++) {
+        const NcsVmProfileNode* node = &profiler->nodes[i];
+        std::string frame = ncs_vm_profile_function_name(profiler, node->program, node->function);
+        if (node->parent == NCS_VM_PROFILE_ROOT) {
+            paths[i] = ncs_vm_profile_script_name(profiler, node->program) + ";" + frame;
+        }
+        else {
+            paths[i] = paths[node->parent] + ";" + frame;
+        }
+
+        uint64_t value = ncs_vm_profile_value(node, metric);
+        if (value != 0) {
+            fprintf(stream, "%s %llu\n", paths[i].c_str(), (unsigned long long)value);
+        }
+    }
+}
+
+typedef struct NcsVmProfileTotals
+{
+    std::string name;
+    uint64_t calls;
+    uint64_t selfInstructions;
+    uint64_t totalInstructions;        // Including callees, recursive paths counted once
+    uint64_t selfSamples;
+    uint64_t totalSamples;
+} NcsVmProfileTotals;
+
+static bool ncs_vm_profile_busier(const NcsVmProfileTotals& a, const NcsVmProfileTotals& b)
+{
+    if (a.totalInstructions != b.totalInstructions) {
+        return a.totalInstructions > b.totalInstructions;
+    }
+    return a.name < b.name;
+}
+
+void ncs_vm_profiler_print(const NcsVmProfiler* profiler, FILE* stream)
+{
+    size_t count = profiler->nodes.size();
+    std::vector<uint64_t> subtreeInstructions(count, 0);
+    std::vector<uint64_t> subtreeSamples(count, 0);
+    for (size_t i = count; i-- > 0;) {
+        const NcsVmProfileNode* node = &profiler->nodes[i];
+        subtreeInstructions[i] += node->instructions;
+        subtreeSamples[i] += node->samples;
+        if (node->parent != NCS_VM_PROFILE_ROOT) {
+            subtreeInstructions[node->parent] += subtreeInstructions[i];
+            subtreeSamples[node->parent] += subtreeSamples[i];
+        }
+    }
+
+    std::map<std::pair<const NcsVmProgram*, uint32_t>, NcsVmProfileTotals> functions;
+    for (size_t i = 0; i < count; i++) {
+        const NcsVmProfileNode* node = &profiler->nodes[i];
+        std::pair<const NcsVmProgram*, uint32_t> key(node->program, node->function);
+        std::map<std::pair<const NcsVmProgram*, uint32_t>, NcsVmProfileTotals>::iterator found = functions.find(key);
+        if (found == functions.end()) {
+            NcsVmProfileTotals totals;
+            totals.name = ncs_vm_profile_script_name(profiler, node->program) + ":" +
+                          ncs_vm_profile_function_name(profiler, node->program, node->function);
+            totals.calls = 0;
+            totals.selfInstructions = 0;
+            totals.totalInstructions = 0;
+            totals.selfSamples = 0;
+            totals.totalSamples = 0;
+            found = functions.insert(std::make_pair(key, totals)).first;
+        }
+        NcsVmProfileTotals* totals = &found->second;
+        totals->calls += node->calls;
+        totals->selfInstructions += node->instructions;
+        totals->selfSamples += node->samples;
+
+        // A recursive path is already inside the outermost activation's subtree
+        bool nested = false;
+        for (uint32_t up = node->parent; up != NCS_VM_PROFILE_ROOT && !nested; up = profiler->nodes[up].parent) {
+            nested = profiler->nodes[up].program == node->program && profiler->nodes[up].function == node->function;
+        }
+        if (!nested) {
+            totals->totalInstructions += subtreeInstructions[i];
+            totals->totalSamples += subtreeSamples[i];
+        }
+    }
+
+    std::vector<NcsVmProfileTotals> sorted;
+    for (std::map<std::pair<const NcsVmProgram*, uint32_t>, NcsVmProfileTotals>::const_iterator it = functions.begin();
+         it != functions.end(); ++it) {
+        sorted.push_back(it->second);
+    }
+    std::sort(sorted.begin(), sorted.end(), ncs_vm_profile_busier);
+
+    fprintf(stream, "%-40s %10s %14s %14s %10s %10s\n", "function", "calls", "self instr", "total instr",
+            "self smpl", "total smpl");
+    for (size_t i = 0; i < sorted.size(); i++) {
+        const NcsVmProfileTotals* totals = &sorted[i];
+        fprintf(stream, "%-40s %10llu %14llu %14llu %10llu %10llu\n", totals->name.c_str(),
+                (unsigned long long)totals->calls, (unsigned long long)totals->selfInstructions,
+                (unsigned long long)totals->totalInstructions, (unsigned long long)totals->selfSamples,
+                (unsigned long long)totals->totalSamples);
+    }
+}
@@ -0,0 +1,200 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - EXECUTION PROFILER
+// ============================================================================
+// Attributes executed instructions, calls and wall-clock samples to NCS
+// subroutines (JSR targets), keeping a call tree per script so the result
+// can be written as folded stacks ("a;b;c 123") for flamegraph tools.
+//
+// Exact mode counts every instruction and call; the counts are charged per
+// straight-line block at control transfers, like slice budgets. Sampling
+// mode adds a timer thread that raises a pending-sample counter every
+// period while a profiled machine is running; the dispatch loop takes the
+// pending samples at its next control transfer and charges them to the
+// subroutine executing at that point.
+//
+// Subroutines are named from NcsFunctionSymbol lists (for example those
+// read from the .ndb file nwnnsscomp writes in -d mode) and otherwise
+// "_start" / "sub_XXXXXXXX" as in the size report, and "action_XXXXXXXX"
+// for deferred STORE_STATE blocks. A profiler is attached by pointing
+// NcsVm::profiler at it; runs of that machine then use the profiled
+// dispatch loop.
+// ============================================================================
+
+#ifndef NCS_VM_PROFILER_H
+#define NCS_VM_PROFILER_H
+
+#include <atomic>
+#include <thread>
+
+#include "ncs_vm.h"
+#include "nwnnsscomp_size_report.h"
+
+#define NCS_VM_PROFILE_ROOT       0xFFFFFFFFu  // Parent of a script's entry node
+#define NCS_VM_PROFILE_MAX_DEPTH  256          // Deeper calls are charged to the deepest node
+
+enum NcsVmProfileMetric
+{
+    NCS_VM_PROFILE_INSTRUCTIONS = 0,   // Exact instruction counts
+    NCS_VM_PROFILE_SAMPLES,            // Wall-clock samples
+    NCS_VM_PROFILE_CALLS               // Exact call counts
+};
+
+/**
+ * @brief One call path: a subroutine reached through a particular chain of callers
+ */
+typedef struct NcsVmProfileNode
+{
+    const NcsVmProgram* program;       // Script the subroutine belongs to
+    uint32_t function;                 // Entry instruction index
+    uint32_t parent;                   // Node index, or NCS_VM_PROFILE_ROOT
+    uint64_t calls;                    // Times this path was entered
+    uint64_t instructions;             // Instructions executed in the subroutine itself
+    uint64_t samples;                  // Samples taken in the subroutine itself
+} NcsVmProfileNode;
+
+/**
+ * @brief Names for one program's subroutines
+ */
+typedef struct NcsVmProfileScript
+{
+    std::string name;                  // Script name, the first frame of every stack
+    std::vector<NcsFunctionSymbol> symbols; // Entry offsets as in the written stream
+} NcsVmProfileScript;
+
+/**
+ * @brief Child lookup key: ((parent node << 32) | entry instruction index, program)
+ */
+typedef std::pair<uint64_t, const NcsVmProgram*> NcsVmProfileKey;
+
+typedef struct NcsVmProfiler
+{
+    std::vector<NcsVmProfileNode> nodes;
+    std::map<NcsVmProfileKey, uint32_t> children; // (parent, program, function) -> node
+    std::vector<uint32_t> stack;       // Node of each active frame, innermost last
+    uint32_t truncatedFrames;          // Active frames beyond NCS_VM_PROFILE_MAX_DEPTH
+    std::map<const NcsVmProgram*, NcsVmProfileScript> scripts;
+    uint32_t periodMicroseconds;       // Sampling period, 0 when not sampling
+    std::atomic<uint32_t> pendingSamples; // Raised by the sampler, taken by the dispatch loop
+    std::atomic<int> running;          // A profiled machine is executing
+    std::atomic<int> stopSampler;
+    std::thread sampler;
+} NcsVmProfiler;
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+/**
+ * @brief Initialize an empty exact-count profiler
+ */
+void ncs_vm_profiler_init(NcsVmProfiler* profiler);
+
+/**
+ * @brief Stop sampling and drop all counts
+ */
+void ncs_vm_profiler_clear(NcsVmProfiler* profiler);
+
+/**
+ * @brief Start the sampling timer
+ *
+ * One profiler may be attached to one running machine at a time.
+ *
+ * @param profiler Profiler
+ * @param periodMicroseconds Interval between samples (0 = 1000)
+ * @return 1 on success, 0 if the timer thread could not be started
+ */
+int ncs_vm_profiler_start_sampling(NcsVmProfiler* profiler, uint32_t periodMicroseconds);
+
+/**
+ * @brief Stop and join the sampling timer (no-op when not sampling)
+ */
+void ncs_vm_profiler_stop_sampling(NcsVmProfiler* profiler);
+
+/**
+ * @brief Name a program and its subroutines in the output
+ *
+ * @param profiler Profiler
+ * @param program Loaded script
+ * @param scriptName Name of the first frame of its stacks (e.g. the resref)
+ * @param symbols Function symbols, or NULL to name subroutines by offset
+ */
+void ncs_vm_profiler_set_symbols(NcsVmProfiler* profiler, const NcsVmProgram* program, const char* scriptName,
+                                 const std::vector<NcsFunctionSymbol>* symbols);
+
+/**
+ * @brief Read function symbols from an NDB debug file (nwnnsscomp -d)
+ *
+ * Uses the file records ("N"/"n"), function records ("f start end ...
+ * name") and line records ("l<file> line start end") to give each
+ * function its entry offset and the file its first line belongs to.
+ * Offsets are taken as written, i.e. stream offsets including the
+ * 13-byte header. Unknown record types are ignored.
+ *
+ * @param text NDB file contents
+ * @param size Byte count of text
+ * @param symbols Receives one symbol per function record
+ * @return 1 on success, 0 if the text does not start with an "NDB" header
+ */
+int ncs_vm_read_ndb(const char* text, size_t size, std::vector<NcsFunctionSymbol>* symbols);
+
+// ============================================================================
+// OUTPUT
+// ============================================================================
+
+/**
+ * @brief Write one "frame;frame;... count" line per call path with a nonzero count
+ *
+ * The first frame is the script name; the output is accepted unchanged by
+ * flamegraph.pl and speedscope.
+ *
+ * @param profiler Profiler
+ * @param metric Count to write
+ * @param stream Output stream
+ */
+void ncs_vm_profiler_write_folded(const NcsVmProfiler* profiler, int metric, FILE* stream);
+
+/**
+ * @brief Print calls and self/total instructions and samples per subroutine, busiest first
+ */
+void ncs_vm_profiler_print(const NcsVmProfiler* profiler, FILE* stream);
+
+// ============================================================================
+// DISPATCH LOOP HOOKS
+// ============================================================================
+
+/**
+ * @brief Enter a script's entry point (run or deferred block) as the outermost frame
+ */
+void ncs_vm_profile_enter(NcsVmProfiler* profiler, const NcsVmProgram* program, uint32_t function);
+
+/**
+ * @brief Push a JSR frame
+ */
+void ncs_vm_profile_call(NcsVmProfiler* profiler, const NcsVmProgram* program, uint32_t function);
+
+/**
+ * @brief Pop the innermost frame
+ */
+void ncs_vm_profile_return(NcsVmProfiler* profiler);
+
+/**
+ * @brief Drop all frames after a run finished or failed
+ */
+void ncs_vm_profile_leave(NcsVmProfiler* profiler);
+
+/**
+ * @brief Charge a straight-line block and any pending samples to the innermost frame
+ */
+inline void ncs_vm_profile_charge(NcsVmProfiler* profiler, int64_t instructions)
+{
+    if (profiler->stack.empty()) {
+        return;
+    }
+    NcsVmProfileNode* node = &profiler->nodes[profiler->stack.back()];
+    node->instructions += (uint64_t)instructions;
+    if (profiler->pendingSamples.load(std::memory_order_relaxed) != 0) {
+        node->samples += profiler->pendingSamples.exchange(0, std::memory_order_relaxed);
+    }
+}
+
+#endif // NCS_VM_PROFILER_H
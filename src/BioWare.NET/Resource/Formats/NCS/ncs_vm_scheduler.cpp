@@ -0,0 +1,392 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - WORK-STEALING SCRIPT SCHEDULER
+// ============================================================================
+// Each worker owns a deque of job indices guarded by its own mutex: the
+// owner pops from the back, thieves take from the front, so contention is
+// limited to a worker that has run dry. Jobs are independent and the batch
+// is known up front, so no job is ever pushed while the batch runs.
+//
+// A batch ends when every worker, not every job, is done: each worker
+// counts itself out of the batch once it finds no job left anywhere, and
+// the next batch is only dealt after all of them have, so no worker can
+// still be inside a previous batch when the queues and job array change.
+// ============================================================================
+
+#include "ncs_vm_scheduler.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+typedef struct NcsVmWorker
+{
+    NcsVm vm;
+    NcsVmCommandBuffer buffer;
+    std::deque<size_t> queue;          // Job indices dealt to this worker
+    std::mutex queueLock;
+    std::thread thread;
+    uint32_t steals;                   // Jobs taken from other workers this batch
+} NcsVmWorker;
+
+struct NcsVmScheduler
+{
+    std::vector<NcsVmWorker*> workers;
+    NcsVm prototype;                   // Configuration worker machines are set up from
+    std::mutex lock;
+    std::condition_variable wake;      // A batch was started or the pool is stopping
+    std::condition_variable done;      // The last worker left the current batch
+    NcsVmJob* jobs;
+    uint64_t generation;               // Incremented per batch
+    size_t busy;                       // Workers that have not yet left the current batch
+    bool stopping;
+};
+
+// ============================================================================
+// WORKERS
+// ============================================================================
+
+static bool ncs_vm_scheduler_next_job(NcsVmScheduler* scheduler, size_t self, size_t* job)
+{
+    NcsVmWorker* worker = scheduler->workers[self];
+    {
+        std::lock_guard<std::mutex> guard(worker->queueLock);
+        if (!worker->queue.empty()) {
+            *job = worker->queue.back();
+            worker->queue.pop_back();
+            return true;
+        }
+    }
+
+    size_t count = scheduler->workers.size();
+    for (size_t k = 1; k < count; k++) {
+        NcsVmWorker* victim = scheduler->workers[(self + k) % count];
+        std::lock_guard<std::mutex> guard(victim->queueLock);
+        if (!victim->queue.empty()) {
+            *job = victim->queue.front();
+            victim->queue.pop_front();
+            worker->steals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Set up a worker machine from the scheduler's prototype
+ */
+static void ncs_vm_scheduler_configure(NcsVm* vm, const NcsVm* prototype)
+{
+    ncs_vm_init(vm, (uint32_t)prototype->stack.size());
+    vm->actions = prototype->actions;
+    vm->defaultAction = prototype->defaultAction;
+    vm->objectSelf = prototype->objectSelf;
+    ncs_vm_set_budget(vm, prototype->budgetInstructions, prototype->budgetMicroseconds);
+}
+
+static void ncs_vm_scheduler_run_job(NcsVmScheduler* scheduler, NcsVmWorker* worker, NcsVmJob* job, size_t index)
+{
+    worker->buffer.job = (uint32_t)index;
+    worker->buffer.sequence = 0;
+
+    // A run suspended in an earlier batch continues on its own machine
+    if (job->suspended != NULL) {
+        NcsVm* vm = job->suspended;
+        vm->commands = &worker->buffer;
+        job->result = ncs_vm_resume(vm);
+        job->errorOffset = vm->errorOffset;
+        vm->commands = NULL;
+        if (job->result != NCS_VM_SUSPENDED) {
+            delete vm;
+            job->suspended = NULL;
+        }
+        return;
+    }
+
+    NcsVm* vm = &worker->vm;
+    ncs_vm_reset(vm);
+    vm->objectSelf = job->objectSelf;
+    vm->commands = &worker->buffer;
+
+    job->result = job->state != NULL ? ncs_vm_run_state(vm, job->program, job->state)
+                                     : ncs_vm_run_program(vm, job->program);
+    job->errorOffset = vm->errorOffset;
+    vm->commands = NULL;
+
+    // Hand the suspended run back with the job and give the worker a fresh machine
+    if (job->result == NCS_VM_SUSPENDED) {
+        job->suspended = new NcsVm();
+        std::swap(*job->suspended, worker->vm);
+        ncs_vm_scheduler_configure(&worker->vm, &scheduler->prototype);
+    }
+}
+
+static void ncs_vm_scheduler_worker(NcsVmScheduler* scheduler, size_t self)
+{
+    NcsVmWorker* worker = scheduler->workers[self];
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> guard(scheduler->lock);
+    for (;;) {
+        while (!scheduler->stopping && scheduler->generation == seen) {
+            scheduler->wake.wait(guard);
+        }
+        if (scheduler->stopping) {
+            return;
+        }
+        seen = scheduler->generation;
+        NcsVmJob* jobs = scheduler->jobs;
+        guard.unlock();
+
+        size_t index;
+        while (ncs_vm_scheduler_next_job(scheduler, self, &index)) {
+            ncs_vm_scheduler_run_job(scheduler, worker, &jobs[index], index);
+        }
+
+        guard.lock();
+        if (--scheduler->busy == 0) {
+            scheduler->done.notify_all();
+        }
+    }
+}
+
+// ============================================================================
+// SCHEDULER
+// ============================================================================
+
+NcsVmScheduler* ncs_vm_scheduler_create(uint32_t workerCount, const NcsVm* prototype)
+{
+    if (workerCount == 0) {
+        workerCount = std::thread::hardware_concurrency();
+        if (workerCount == 0) {
+            workerCount = 1;
+        }
+    }
+
+    NcsVmScheduler* scheduler = new NcsVmScheduler();
+    scheduler->jobs = NULL;
+    scheduler->generation = 0;
+    scheduler->busy = 0;
+    scheduler->stopping = false;
+    ncs_vm_scheduler_configure(&scheduler->prototype, prototype);
+
+    for (uint32_t i = 0; i < workerCount; i++) {
+        NcsVmWorker* worker = new NcsVmWorker();
+        ncs_vm_scheduler_configure(&worker->vm, prototype);
+        worker->buffer.job = 0;
+        worker->buffer.sequence = 0;
+        worker->steals = 0;
+        scheduler->workers.push_back(worker);
+    }
+
+    for (size_t i = 0; i < scheduler->workers.size(); i++) {
+        try {
+            scheduler->workers[i]->thread = std::thread(ncs_vm_scheduler_worker, scheduler, i);
+        }
+        catch (const std::system_error&) {
+            ncs_vm_scheduler_destroy(scheduler);
+            return NULL;
+        }
+    }
+    return scheduler;
+}
+
+void ncs_vm_scheduler_destroy(NcsVmScheduler* scheduler)
+{
+    if (scheduler == NULL) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(scheduler->lock);
+        scheduler->stopping = true;
+    }
+    scheduler->wake.notify_all();
+    for (size_t i = 0; i < scheduler->workers.size(); i++) {
+        if (scheduler->workers[i]->thread.joinable()) {
+            scheduler->workers[i]->thread.join();
+        }
+        delete scheduler->workers[i];
+    }
+    delete scheduler;
+}
+
+uint32_t ncs_vm_scheduler_worker_count(const NcsVmScheduler* scheduler)
+{
+    return (uint32_t)scheduler->workers.size();
+}
+
+static bool ncs_vm_command_before(const NcsVmCommand& a, const NcsVmCommand& b)
+{
+    return a.job != b.job ? a.job < b.job : a.sequence < b.sequence;
+}
+
+uint32_t ncs_vm_scheduler_run(NcsVmScheduler* scheduler, NcsVmJob* jobs, size_t count,
+                              NcsVmCommandApply apply, void* userData, NcsVmSchedulerStats* stats)
+{
+    size_t workerCount = scheduler->workers.size();
+    for (size_t i = 0; i < workerCount; i++) {
+        scheduler->workers[i]->steals = 0;
+        scheduler->workers[i]->buffer.commands.clear();
+    }
+
+    if (count > 0) {
+        // Deal round-robin; each worker runs its share in dealt order
+        for (size_t w = 0; w < workerCount; w++) {
+            NcsVmWorker* worker = scheduler->workers[w];
+            std::lock_guard<std::mutex> queueGuard(worker->queueLock);
+            for (size_t i = w; i < count; i += workerCount) {
+                worker->queue.push_front(i);
+            }
+        }
+
+        std::unique_lock<std::mutex> guard(scheduler->lock);
+        scheduler->jobs = jobs;
+        scheduler->busy = workerCount;
+        scheduler->generation++;
+        scheduler->wake.notify_all();
+        while (scheduler->busy != 0) {
+            scheduler->done.wait(guard);
+        }
+        scheduler->jobs = NULL;
+    }
+
+    // Merge: every job ran on exactly one worker, so (job, sequence) is a total order
+    std::vector<NcsVmCommand> merged;
+    uint32_t steals = 0;
+    for (size_t i = 0; i < workerCount; i++) {
+        NcsVmWorker* worker = scheduler->workers[i];
+        steals += worker->steals;
+        for (size_t k = 0; k < worker->buffer.commands.size(); k++) {
+            merged.push_back(NcsVmCommand());
+            std::swap(merged.back(), worker->buffer.commands[k]);
+        }
+        worker->buffer.commands.clear();
+    }
+    std::sort(merged.begin(), merged.end(), ncs_vm_command_before);
+
+    if (apply != NULL) {
+        for (size_t i = 0; i < merged.size(); i++) {
+            apply(&merged[i], userData);
+        }
+    }
+
+    uint32_t failures = 0;
+    uint32_t suspended = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (jobs[i].result == NCS_VM_SUSPENDED) {
+            suspended++;
+        }
+        else if (jobs[i].result != NCS_VM_OK) {
+            failures++;
+        }
+    }
+    if (stats != NULL) {
+        stats->jobs = (uint32_t)count;
+        stats->steals = steals;
+        stats->commands = (uint32_t)merged.size();
+        stats->failures = failures;
+        stats->suspended = suspended;
+    }
+    return failures;
+}
+
+void ncs_vm_scheduler_discard(NcsVmJob* job)
+{
+    delete job->suspended;
+    job->suspended = NULL;
+}
+
+// ============================================================================
+// DEFERRED ACTIONS
+// ============================================================================
+
+/**
+ * @brief Replace pool handles in string cells with indices into command->strings
+ */
+static void ncs_vm_detach_strings(const NcsVm* vm, NcsVmValue* cells, size_t count, NcsVmCommand* command)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (cells[i].type == NCS_VM_TYPE_STRING) {
+            command->strings.push_back(ncs_vm_string(vm, cells[i].value.handle));
+            cells[i].value.handle = (uint32_t)(command->strings.size() - 1);
+        }
+    }
+}
+
+static NcsVmCommand* ncs_vm_begin_command(NcsVm* vm, uint16_t routine)
+{
+    NcsVmCommandBuffer* buffer = vm->commands;
+    buffer->commands.push_back(NcsVmCommand());
+    NcsVmCommand* command = &buffer->commands.back();
+    command->job = buffer->job;
+    command->sequence = buffer->sequence++;
+    command->routine = routine;
+    command->objectSelf = vm->objectSelf;
+    command->hasState = 0;
+    return command;
+}
+
+int ncs_vm_defer_command(NcsVm* vm, uint16_t routine, uint32_t argumentCells)
+{
+    if (vm->commands == NULL) {
+        return NCS_VM_ERROR_UNSUPPORTED;
+    }
+    if (argumentCells > vm->sp) {
+        return NCS_VM_ERROR_STACK_UNDERFLOW;
+    }
+
+    NcsVmCommand* command = ncs_vm_begin_command(vm, routine);
+    command->arguments.assign(vm->stack.begin() + (vm->sp - argumentCells), vm->stack.begin() + vm->sp);
+    vm->sp -= argumentCells;
+    ncs_vm_detach_strings(vm, command->arguments.data(), command->arguments.size(), command);
+    return NCS_VM_OK;
+}
+
+static int ncs_vm_deferred_action(NcsVm* vm, uint16_t routine, uint8_t argumentCount, void* userData)
+{
+    const NcsVmActionInfo* info = (const NcsVmActionInfo*)userData;
+    if (argumentCount != info->argumentCount) {
+        return NCS_VM_ERROR_TYPE_MISMATCH;
+    }
+    if (vm->commands == NULL) {
+        return NCS_VM_ERROR_UNSUPPORTED;
+    }
+
+    bool takesAction = false;
+    for (uint8_t i = 0; i < info->argumentCount; i++) {
+        if (info->argumentTypes[i] == NCS_VM_SCRIPT_ACTION) {
+            takesAction = true;
+        }
+    }
+
+    NcsVmValue cells[NCS_VM_ACTION_MAX_CELLS];
+    int result = ncs_vm_pop_arguments(vm, info, cells);
+    if (result != NCS_VM_OK) {
+        return result;
+    }
+
+    NcsVmCommand* command = ncs_vm_begin_command(vm, routine);
+    command->arguments.assign(cells, cells + info->argumentCells);
+    ncs_vm_detach_strings(vm, command->arguments.data(), command->arguments.size(), command);
+
+    if (takesAction) {
+        result = ncs_vm_take_stored_state(vm, &command->state);
+        if (result != NCS_VM_OK) {
+            vm->commands->commands.pop_back();
+            vm->commands->sequence--;
+            return result;
+        }
+        command->hasState = 1;
+    }
+    return NCS_VM_OK;
+}
+
+int ncs_vm_register_deferred_action(NcsVm* vm, uint16_t routine, const NcsVmActionInfo* info)
+{
+    if (info->resultCells != 0) {
+        return NCS_VM_ERROR_UNSUPPORTED;
+    }
+    ncs_vm_register_action(vm, routine, ncs_vm_deferred_action, (void*)info);
+    return NCS_VM_OK;
+}
@@ -0,0 +1,163 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - WORK-STEALING SCRIPT SCHEDULER
+// ============================================================================
+// Runs batches of independent script invocations (heartbeat, perception,
+// user-defined events, resumed DelayCommand continuations) on a pool of
+// worker threads, each with its own NcsVm. Jobs are dealt round-robin to
+// per-worker deques; an idle worker steals from the others.
+//
+// During a batch the world must be read-only: ACTION handlers that change
+// world state are registered with ncs_vm_register_deferred_action and only
+// record an NcsVmCommand in their worker's buffer. When the batch is done
+// the buffers are merged, ordered by (job index, order within the job) and
+// applied on the calling thread, so the outcome does not depend on which
+// worker ran which job or on timing.
+// ============================================================================
+
+#ifndef NCS_VM_SCHEDULER_H
+#define NCS_VM_SCHEDULER_H
+
+#include "ncs_vm.h"
+
+/**
+ * @brief Engine call recorded during a batch, applied after it
+ *
+ * String values are copied out of the worker's string pool (which is
+ * reclaimed between jobs): string cells in arguments hold an index into
+ * strings instead of a pool handle, and state carries its own texts.
+ */
+typedef struct NcsVmCommand
+{
+    uint32_t job;                      // Index of the job in its batch
+    uint32_t sequence;                 // Order within the job
+    uint16_t routine;                  // ACTION routine number
+    uint32_t objectSelf;               // OBJECT_SELF of the job
+    std::vector<NcsVmValue> arguments; // Argument cells, bottom of stack (first argument) first
+    std::vector<std::string> strings;  // Text of string argument cells
+    NcsVmSavedState state;             // Continuation for an action-typed argument
+    int hasState;                      // state is valid
+} NcsVmCommand;
+
+/**
+ * @brief Per-worker command buffer
+ */
+typedef struct NcsVmCommandBuffer
+{
+    std::vector<NcsVmCommand> commands;
+    uint32_t job;                      // Job being executed
+    uint32_t sequence;                 // Next sequence number within that job
+} NcsVmCommandBuffer;
+
+/**
+ * @brief One script invocation
+ */
+typedef struct NcsVmJob
+{
+    const NcsVmProgram* program;       // Shared, read-only during the batch
+    const NcsVmSavedState* state;      // Continuation to resume, or NULL to run from the start
+    uint32_t objectSelf;               // OBJECT_SELF for the run
+    int result;                        // NcsVmResult of the run
+    uint32_t errorOffset;              // Offset of the failing instruction
+    NcsVm* suspended;                  // Machine of a suspended run to continue, or NULL
+} NcsVmJob;
+
+typedef struct NcsVmSchedulerStats
+{
+    uint32_t jobs;                     // Jobs run
+    uint32_t steals;                   // Jobs run by a worker other than the one they were dealt to
+    uint32_t commands;                 // Deferred commands applied
+    uint32_t failures;                 // Jobs that ended with an error
+    uint32_t suspended;                // Jobs that used up their slice budget (NCS_VM_SUSPENDED)
+} NcsVmSchedulerStats;
+
+/**
+ * @brief Applies one deferred command to the world (called on the thread running the batch)
+ */
+typedef void (*NcsVmCommandApply)(const NcsVmCommand* command, void* userData);
+
+typedef struct NcsVmScheduler NcsVmScheduler;
+
+// ============================================================================
+// SCHEDULER
+// ============================================================================
+
+/**
+ * @brief Start a pool of workers
+ *
+ * Each worker gets its own machine with the stack size, ACTION handlers,
+ * default handler, OBJECT_SELF and slice budget of prototype. Handlers run
+ * concurrently and must only read world state (or defer their changes).
+ *
+ * @param workerCount Worker threads (0 = hardware concurrency)
+ * @param prototype Machine whose configuration the workers copy
+ * @return New scheduler, or NULL if a thread could not be started
+ */
+NcsVmScheduler* ncs_vm_scheduler_create(uint32_t workerCount, const NcsVm* prototype);
+
+/**
+ * @brief Stop and join the workers and free the scheduler
+ */
+void ncs_vm_scheduler_destroy(NcsVmScheduler* scheduler);
+
+/**
+ * @brief Number of worker threads
+ */
+uint32_t ncs_vm_scheduler_worker_count(const NcsVmScheduler* scheduler);
+
+/**
+ * @brief Run a batch of jobs, then apply their deferred commands
+ *
+ * A job that exhausts the prototype's slice budget ends with
+ * NCS_VM_SUSPENDED and takes the machine holding its run in
+ * job->suspended. Passing the job in a later batch continues that run
+ * (program, state and objectSelf are then ignored); the machine is freed
+ * once the run ends, or by ncs_vm_scheduler_discard. New jobs must have
+ * suspended set to NULL.
+ *
+ * @param scheduler Scheduler
+ * @param jobs Jobs; result, errorOffset and suspended are filled in
+ * @param count Number of jobs
+ * @param apply Callback for each deferred command, in (job, sequence) order (may be NULL)
+ * @param userData Passed to apply
+ * @param stats Receives batch statistics (may be NULL)
+ * @return Number of jobs that ended with an error (neither NCS_VM_OK nor NCS_VM_SUSPENDED)
+ */
+uint32_t ncs_vm_scheduler_run(NcsVmScheduler* scheduler, NcsVmJob* jobs, size_t count,
+                              NcsVmCommandApply apply, void* userData, NcsVmSchedulerStats* stats);
+
+/**
+ * @brief Free the suspended run of a job that will not be run again
+ */
+void ncs_vm_scheduler_discard(NcsVmJob* job);
+
+// ============================================================================
+// DEFERRED ACTIONS
+// ============================================================================
+
+/**
+ * @brief Pop a routine's arguments into the machine's command buffer
+ *
+ * For use inside ACTION handlers of world-mutating routines.
+ *
+ * @param vm Running machine
+ * @param routine ACTION routine number
+ * @param argumentCells Stack cells the arguments occupy
+ * @return NCS_VM_OK, NCS_VM_ERROR_STACK_UNDERFLOW, or NCS_VM_ERROR_UNSUPPORTED
+ *         when the machine is not running under a scheduler
+ */
+int ncs_vm_defer_command(NcsVm* vm, uint16_t routine, uint32_t argumentCells);
+
+/**
+ * @brief Register a handler that defers a void routine instead of executing it
+ *
+ * Routines with an action-typed argument (AssignCommand, DelayCommand)
+ * also take the stored STORE_STATE continuation into the command.
+ *
+ * @param vm Machine (typically the scheduler prototype)
+ * @param routine ACTION routine number
+ * @param info Routine declaration (from the generated action table)
+ * @return NCS_VM_OK, or NCS_VM_ERROR_UNSUPPORTED for a routine that returns a value
+ */
+int ncs_vm_register_deferred_action(NcsVm* vm, uint16_t routine, const NcsVmActionInfo* info);
+
+#endif // NCS_VM_SCHEDULER_H
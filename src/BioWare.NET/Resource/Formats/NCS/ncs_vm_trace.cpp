@@ -0,0 +1,516 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - EXECUTION TRACE RECORDING AND REPLAY
+// ============================================================================
+
+#include "ncs_vm_trace.h"
+
+#include <string.h>
+
+#include <chrono>
+#include <system_error>
+
+// ============================================================================
+// ENCODING
+// ============================================================================
+
+static void ncs_vm_trace_put_varint(std::vector<uint8_t>* out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out->push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out->push_back((uint8_t)value);
+}
+
+static uint32_t ncs_vm_trace_zigzag(uint32_t value, uint32_t previous)
+{
+    int32_t delta = (int32_t)(value - previous);
+    return ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+}
+
+static uint32_t ncs_vm_trace_unzigzag(uint32_t encoded, uint32_t previous)
+{
+    uint32_t delta = (encoded >> 1) ^ (0u - (encoded & 1));
+    return previous + delta;
+}
+
+/**
+ * @brief Encode one cell; previous is updated to the cell's bits
+ */
+static void ncs_vm_trace_put_cell(std::vector<uint8_t>* out, const NcsVm* vm, const NcsVmValue* cell,
+                                  uint32_t* previous)
+{
+    out->push_back(cell->type);
+    if (cell->type == NCS_VM_TYPE_STRING) {
+        const std::string& text = ncs_vm_string(vm, cell->value.handle);
+        ncs_vm_trace_put_varint(out, text.size());
+        out->insert(out->end(), text.begin(), text.end());
+        return;
+    }
+    ncs_vm_trace_put_varint(out, ncs_vm_trace_zigzag(cell->value.handle, *previous));
+    *previous = cell->value.handle;
+}
+
+// ============================================================================
+// RING AND WRITER THREAD
+// ============================================================================
+
+static void ncs_vm_trace_write_loop(NcsVmTraceRecorder* recorder)
+{
+    size_t mask = recorder->ring.size() - 1;
+    for (;;) {
+        int stopping = recorder->stopping.load();
+        size_t head = recorder->head.load(std::memory_order_acquire);
+        size_t tail = recorder->tail.load(std::memory_order_relaxed);
+        if (head == tail) {
+            if (stopping) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        while (tail != head) {
+            size_t start = tail & mask;
+            size_t count = head - tail;
+            if (count > recorder->ring.size() - start) {
+                count = recorder->ring.size() - start;
+            }
+            fwrite(&recorder->ring[start], 1, count, recorder->stream);
+            tail += count;
+        }
+        recorder->tail.store(tail, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief Copy bytes into the ring; waits only while the ring is full
+ */
+static void ncs_vm_trace_push(NcsVmTraceRecorder* recorder, const uint8_t* data, size_t size)
+{
+    size_t capacity = recorder->ring.size();
+    size_t mask = capacity - 1;
+    size_t head = recorder->head.load(std::memory_order_relaxed);
+    while (size > 0) {
+        size_t space = capacity - (head - recorder->tail.load(std::memory_order_acquire));
+        if (space == 0) {
+            recorder->stalls.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();
+            continue;
+        }
+        size_t start = head & mask;
+        size_t count = size < space ? size : space;
+        if (count > capacity - start) {
+            count = capacity - start;
+        }
+        memcpy(&recorder->ring[start], data, count);
+        data += count;
+        size -= count;
+        head += count;
+        recorder->head.store(head, std::memory_order_release);
+    }
+}
+
+static void ncs_vm_trace_emit(NcsVmTraceRecorder* recorder)
+{
+    ncs_vm_trace_push(recorder, recorder->scratch.data(), recorder->scratch.size());
+    recorder->bytes += recorder->scratch.size();
+    recorder->events++;
+    recorder->scratch.clear();
+}
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+int ncs_vm_trace_begin(NcsVmTraceRecorder* recorder, FILE* stream, size_t ringBytes,
+                       const NcsVmActionSignature* signatures, size_t signatureCount)
+{
+    size_t capacity = 64;
+    size_t wanted = ringBytes != 0 ? ringBytes : NCS_VM_TRACE_RING_BYTES;
+    while (capacity < wanted) {
+        capacity <<= 1;
+    }
+    recorder->ring.assign(capacity, 0);
+    recorder->head = 0;
+    recorder->tail = 0;
+    recorder->stream = stream;
+    recorder->stopping = 0;
+    recorder->signatures.assign(signatures, signatures + (signatures != NULL ? signatureCount : 0));
+    recorder->scriptIds.clear();
+    recorder->lastResults.clear();
+    recorder->lastScript = 0;
+    recorder->runInstructions = 0;
+    recorder->scratch.clear();
+    recorder->events = 0;
+    recorder->bytes = 0;
+    recorder->stalls = 0;
+
+    fwrite(NCS_VM_TRACE_MAGIC, 1, 4, stream);
+    fputc(NCS_VM_TRACE_VERSION, stream);
+    try {
+        recorder->writer = std::thread(ncs_vm_trace_write_loop, recorder);
+    }
+    catch (const std::system_error&) {
+        return 0;
+    }
+    return 1;
+}
+
+void ncs_vm_trace_end(NcsVmTraceRecorder* recorder)
+{
+    if (recorder->writer.joinable()) {
+        recorder->stopping = 1;
+        recorder->writer.join();
+    }
+    fflush(recorder->stream);
+}
+
+void ncs_vm_trace_set_script_id(NcsVmTraceRecorder* recorder, const NcsVmProgram* program, uint32_t scriptId)
+{
+    recorder->scriptIds[program] = scriptId;
+}
+
+void ncs_vm_trace_seed(NcsVmTraceRecorder* recorder, uint64_t seed)
+{
+    recorder->scratch.push_back(NCS_VM_TRACE_SEED);
+    ncs_vm_trace_put_varint(&recorder->scratch, seed);
+    ncs_vm_trace_emit(recorder);
+}
+
+void ncs_vm_trace_run(NcsVmTraceRecorder* recorder, const NcsVm* vm, const NcsVmProgram* program,
+                      uint32_t entry, const NcsVmSavedState* state)
+{
+    std::map<const NcsVmProgram*, uint32_t>::const_iterator found = recorder->scriptIds.find(program);
+    uint32_t scriptId = found != recorder->scriptIds.end() ? found->second : NCS_VM_TRACE_NO_SCRIPT;
+    std::vector<uint8_t>* out = &recorder->scratch;
+
+    out->push_back(NCS_VM_TRACE_RUN);
+    ncs_vm_trace_put_varint(out, ncs_vm_trace_zigzag(scriptId, recorder->lastScript));
+    ncs_vm_trace_put_varint(out, vm->objectSelf);
+    ncs_vm_trace_put_varint(out, entry);
+    out->push_back(state != NULL ? 1 : 0);
+    if (state != NULL) {
+        // The state is already on the stack, with its strings in the pool
+        size_t globalCells = state->globals ? state->globals->values.size() : 0;
+        size_t localCells = state->locals.values.size();
+        ncs_vm_trace_put_varint(out, globalCells);
+        ncs_vm_trace_put_varint(out, localCells);
+        uint32_t previous = 0;
+        for (size_t i = 0; i < globalCells + localCells; i++) {
+            ncs_vm_trace_put_cell(out, vm, &vm->stack[i], &previous);
+        }
+    }
+    else {
+        // Whatever the host pushed before the run
+        ncs_vm_trace_put_varint(out, vm->bp);
+        ncs_vm_trace_put_varint(out, vm->sp);
+        uint32_t previous = 0;
+        for (uint32_t i = 0; i < vm->sp; i++) {
+            ncs_vm_trace_put_cell(out, vm, &vm->stack[i], &previous);
+        }
+    }
+    recorder->lastScript = scriptId;
+    recorder->runInstructions = 0;
+    ncs_vm_trace_emit(recorder);
+}
+
+void ncs_vm_trace_action(NcsVmTraceRecorder* recorder, const NcsVm* vm, uint16_t routine, uint32_t spBefore,
+                         int tookState)
+{
+    uint32_t popped;
+    uint32_t pushed;
+    if (routine < recorder->signatures.size() && recorder->signatures[routine].argumentCells >= 0) {
+        popped = (uint32_t)recorder->signatures[routine].argumentCells;
+        pushed = recorder->signatures[routine].resultCells;
+    }
+    else {
+        popped = spBefore > vm->sp ? spBefore - vm->sp : 0;
+        pushed = vm->sp > spBefore ? vm->sp - spBefore : 0;
+    }
+    if (pushed > vm->sp) {
+        pushed = vm->sp;
+    }
+
+    std::vector<uint8_t>* out = &recorder->scratch;
+    out->push_back(NCS_VM_TRACE_ACTION);
+    ncs_vm_trace_put_varint(out, routine);
+    ncs_vm_trace_put_varint(out, popped);
+    ncs_vm_trace_put_varint(out, pushed);
+    out->push_back(tookState ? 1 : 0);
+
+    size_t slots = ((size_t)routine + 1) * 3;
+    if (recorder->lastResults.size() < slots) {
+        recorder->lastResults.resize(slots, 0);
+    }
+    for (uint32_t k = 0; k < pushed; k++) {
+        uint32_t unused = 0;
+        uint32_t* previous = k < 3 ? &recorder->lastResults[(size_t)routine * 3 + k] : &unused;
+        ncs_vm_trace_put_cell(out, vm, &vm->stack[vm->sp - pushed + k], previous);
+    }
+    ncs_vm_trace_emit(recorder);
+}
+
+void ncs_vm_trace_slice(NcsVmTraceRecorder* recorder, uint64_t instructions)
+{
+    recorder->runInstructions += instructions;
+}
+
+void ncs_vm_trace_finish(NcsVmTraceRecorder* recorder, const NcsVm* vm, int result)
+{
+    std::vector<uint8_t>* out = &recorder->scratch;
+    out->push_back(NCS_VM_TRACE_END);
+    ncs_vm_trace_put_varint(out, (uint32_t)result);
+    ncs_vm_trace_put_varint(out, recorder->runInstructions);
+    ncs_vm_trace_put_varint(out, vm->sp);
+    ncs_vm_trace_emit(recorder);
+}
+
+// ============================================================================
+// REPLAY
+// ============================================================================
+
+typedef struct NcsVmTraceReader
+{
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+    int failed;                        // Read past the end or a malformed value
+    std::vector<uint32_t> lastResults;
+    uint32_t lastScript;
+    uint64_t events;                   // Events read so far
+    NcsVmTraceReplayStats* stats;
+} NcsVmTraceReader;
+
+static uint64_t ncs_vm_trace_get_varint(NcsVmTraceReader* reader)
+{
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (reader->position >= reader->size) {
+            reader->failed = 1;
+            return 0;
+        }
+        uint8_t byte = reader->data[reader->position++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    reader->failed = 1;
+    return 0;
+}
+
+static uint8_t ncs_vm_trace_get_byte(NcsVmTraceReader* reader)
+{
+    if (reader->position >= reader->size) {
+        reader->failed = 1;
+        return 0;
+    }
+    return reader->data[reader->position++];
+}
+
+/**
+ * @brief Decode one cell, interning string text into the machine's pool
+ */
+static NcsVmValue ncs_vm_trace_get_cell(NcsVmTraceReader* reader, NcsVm* vm, uint32_t* previous)
+{
+    NcsVmValue cell;
+    cell.type = ncs_vm_trace_get_byte(reader);
+    if (cell.type == NCS_VM_TYPE_STRING) {
+        uint64_t length = ncs_vm_trace_get_varint(reader);
+        if (length > reader->size - reader->position) {
+            reader->failed = 1;
+            length = 0;
+        }
+        vm->strings.push_back(std::string((const char*)reader->data + reader->position, (size_t)length));
+        reader->position += (size_t)length;
+        cell.value.handle = (uint32_t)(vm->strings.size() - 1);
+        return cell;
+    }
+    cell.value.handle = ncs_vm_trace_unzigzag((uint32_t)ncs_vm_trace_get_varint(reader), *previous);
+    *previous = cell.value.handle;
+    return cell;
+}
+
+/**
+ * @brief ACTION handler answering every routine from the next ACTION event
+ */
+static int ncs_vm_trace_replay_action(NcsVm* vm, uint16_t routine, uint8_t argumentCount, void* userData)
+{
+    (void)argumentCount;
+    NcsVmTraceReader* reader = (NcsVmTraceReader*)userData;
+
+    // The recorded handler failed here: fail the same way and leave END for the run
+    if (reader->position < reader->size && reader->data[reader->position] == NCS_VM_TRACE_END) {
+        size_t position = reader->position++;
+        int result = (int)ncs_vm_trace_get_varint(reader);
+        reader->position = position;
+        return result != NCS_VM_OK ? result : NCS_VM_ERROR_TRACE_MISMATCH;
+    }
+
+    reader->events++;
+    if (ncs_vm_trace_get_byte(reader) != NCS_VM_TRACE_ACTION ||
+        ncs_vm_trace_get_varint(reader) != routine || reader->failed) {
+        return NCS_VM_ERROR_TRACE_MISMATCH;
+    }
+    uint32_t popped = (uint32_t)ncs_vm_trace_get_varint(reader);
+    uint32_t pushed = (uint32_t)ncs_vm_trace_get_varint(reader);
+    int tookState = ncs_vm_trace_get_byte(reader);
+    if (popped > vm->sp) {
+        return NCS_VM_ERROR_TRACE_MISMATCH;
+    }
+    vm->sp -= popped;
+
+    size_t slots = ((size_t)routine + 1) * 3;
+    if (reader->lastResults.size() < slots) {
+        reader->lastResults.resize(slots, 0);
+    }
+    for (uint32_t k = 0; k < pushed; k++) {
+        uint32_t unused = 0;
+        uint32_t* previous = k < 3 ? &reader->lastResults[(size_t)routine * 3 + k] : &unused;
+        NcsVmValue cell = ncs_vm_trace_get_cell(reader, vm, previous);
+        int result = ncs_vm_push_handle(vm, cell.type, cell.value.handle);
+        if (result != NCS_VM_OK) {
+            return result;
+        }
+    }
+    if (reader->failed) {
+        return NCS_VM_ERROR_TRACE_MISMATCH;
+    }
+    if (tookState) {
+        NcsVmSavedState discarded;
+        if (ncs_vm_take_stored_state(vm, &discarded) != NCS_VM_OK) {
+            return NCS_VM_ERROR_TRACE_MISMATCH;
+        }
+    }
+    reader->stats->actions++;
+    return NCS_VM_OK;
+}
+
+/**
+ * @brief Replay one RUN event through its END event
+ */
+static int ncs_vm_trace_replay_run(NcsVmTraceReader* reader, NcsVm* vm, NcsVmTraceResolve resolve, void* userData)
+{
+    uint32_t scriptId = ncs_vm_trace_unzigzag((uint32_t)ncs_vm_trace_get_varint(reader), reader->lastScript);
+    reader->lastScript = scriptId;
+    uint32_t objectSelf = (uint32_t)ncs_vm_trace_get_varint(reader);
+    uint32_t entry = (uint32_t)ncs_vm_trace_get_varint(reader);
+    int hasState = ncs_vm_trace_get_byte(reader);
+
+    ncs_vm_reset(vm);
+    vm->objectSelf = objectSelf;
+    NcsVmSavedState state;
+    if (hasState) {
+        uint64_t globalCells = ncs_vm_trace_get_varint(reader);
+        uint64_t localCells = ncs_vm_trace_get_varint(reader);
+        if (globalCells + localCells > vm->stack.size()) {
+            return NCS_VM_ERROR_BAD_PROGRAM;
+        }
+        std::vector<NcsVmValue> cells((size_t)(globalCells + localCells));
+        uint32_t previous = 0;
+        for (size_t i = 0; i < cells.size(); i++) {
+            cells[i] = ncs_vm_trace_get_cell(reader, vm, &previous);
+        }
+        if (globalCells > 0) {
+            NcsVmCells* globals = new NcsVmCells();
+            ncs_vm_copy_cells(vm, cells.data(), (size_t)globalCells, globals);
+            state.globals.reset(globals);
+        }
+        ncs_vm_copy_cells(vm, cells.data() + globalCells, (size_t)localCells, &state.locals);
+        state.resumeIndex = entry;
+    }
+    else {
+        uint32_t bp = (uint32_t)ncs_vm_trace_get_varint(reader);
+        uint64_t cells = ncs_vm_trace_get_varint(reader);
+        if (cells > vm->stack.size() || bp > cells) {
+            return NCS_VM_ERROR_BAD_PROGRAM;
+        }
+        uint32_t previous = 0;
+        for (uint32_t i = 0; i < (uint32_t)cells; i++) {
+            vm->stack[i] = ncs_vm_trace_get_cell(reader, vm, &previous);
+        }
+        vm->sp = (uint32_t)cells;
+        vm->bp = bp;
+    }
+    if (reader->failed) {
+        return NCS_VM_ERROR_BAD_PROGRAM;
+    }
+
+    const NcsVmProgram* program = resolve(scriptId, userData);
+    if (program == NULL || entry >= program->code.size()) {
+        return NCS_VM_ERROR_BAD_PROGRAM;
+    }
+
+    int result = hasState ? ncs_vm_run_state(vm, program, &state) : ncs_vm_run_program(vm, program);
+    uint64_t instructions = vm->sliceInstructions;
+    while (result == NCS_VM_SUSPENDED) {
+        result = ncs_vm_resume(vm);
+        instructions += vm->sliceInstructions;
+    }
+    reader->stats->instructions += instructions;
+
+    reader->events++;
+    if (ncs_vm_trace_get_byte(reader) != NCS_VM_TRACE_END) {
+        return NCS_VM_ERROR_TRACE_MISMATCH;
+    }
+    uint32_t recordedResult = (uint32_t)ncs_vm_trace_get_varint(reader);
+    uint64_t recordedInstructions = ncs_vm_trace_get_varint(reader);
+    uint32_t recordedSp = (uint32_t)ncs_vm_trace_get_varint(reader);
+    // A handler that failed may have left the stack anywhere, so SP is only compared for clean runs
+    if (reader->failed || recordedResult != (uint32_t)result || recordedInstructions != instructions ||
+        (result == NCS_VM_OK && recordedSp != vm->sp)) {
+        return NCS_VM_ERROR_TRACE_MISMATCH;
+    }
+    return NCS_VM_OK;
+}
+
+int ncs_vm_trace_replay(const uint8_t* data, size_t size, NcsVmTraceResolve resolve, void* userData,
+                        uint32_t stackCells, NcsVmTraceReplayStats* stats)
+{
+    NcsVmTraceReplayStats localStats;
+    if (stats == NULL) {
+        stats = &localStats;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (size < 5 || memcmp(data, NCS_VM_TRACE_MAGIC, 4) != 0 || data[4] != NCS_VM_TRACE_VERSION) {
+        return NCS_VM_ERROR_BAD_PROGRAM;
+    }
+
+    NcsVmTraceReader reader;
+    reader.data = data;
+    reader.size = size;
+    reader.position = 5;
+    reader.failed = 0;
+    reader.lastScript = 0;
+    reader.events = 0;
+    reader.stats = stats;
+
+    NcsVm vm;
+    ncs_vm_init(&vm, stackCells);
+    ncs_vm_set_default_action(&vm, ncs_vm_trace_replay_action, &reader);
+
+    while (reader.position < reader.size) {
+        stats->failedEvent = reader.events++;
+        uint8_t event = ncs_vm_trace_get_byte(&reader);
+        int result;
+        if (event == NCS_VM_TRACE_RUN) {
+            result = ncs_vm_trace_replay_run(&reader, &vm, resolve, userData);
+            stats->runs++;
+        }
+        else if (event == NCS_VM_TRACE_SEED) {
+            ncs_vm_trace_get_varint(&reader);
+            stats->seeds++;
+            result = reader.failed ? NCS_VM_ERROR_BAD_PROGRAM : NCS_VM_OK;
+        }
+        else {
+            // ACTION and END events only occur inside a run
+            result = NCS_VM_ERROR_BAD_PROGRAM;
+        }
+        if (result != NCS_VM_OK) {
+            stats->failedEvent = reader.events - 1;
+            return result;
+        }
+    }
+    stats->failedEvent = 0;
+    return NCS_VM_OK;
+}
@@ -0,0 +1,184 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - EXECUTION TRACE RECORDING AND REPLAY
+// ============================================================================
+// A script run is deterministic given its program, OBJECT_SELF, its
+// starting state and whatever the engine returned from ACTION calls. The
+// recorder writes exactly that: one RUN event per invocation (script id,
+// OBJECT_SELF, entry point and the cells it starts with: the saved cells
+// of a resumed continuation or whatever the host pushed), one ACTION event per engine call (cells popped, result cells
+// pushed, whether the STORE_STATE continuation was taken), host SEED
+// events, and an END event with the result, instruction count and final
+// SP used to detect divergence on replay.
+//
+// Events are varint-encoded; ACTION results are delta-encoded against the
+// previous result of the same routine (object ids and counters change
+// little between calls) and script ids against the previous run. The
+// encoded bytes go through a single-producer/single-consumer lock-free
+// ring to a writer thread, so the script thread never waits on I/O; it
+// only spins if the ring is full (counted in NcsVmTraceRecorder::stalls).
+//
+// Replay needs no engine: each ACTION is satisfied from the trace.
+//
+// Stream layout: "NCST" + NCS_VM_TRACE_VERSION, then events
+//   RUN    0x01 zz(scriptId delta) objectSelf entry hasState
+//               (globals locals cells... | bp sp cells...)
+//   ACTION 0x02 routine popped pushed flags cells...
+//   SEED   0x03 seed
+//   END    0x04 result instructions sp
+// Integers are LEB128 varints, zz = zigzag; a cell is its NcsVmType byte
+// followed by the zigzag delta of its bits, or the length and text of a
+// string.
+// ============================================================================
+
+#ifndef NCS_VM_TRACE_H
+#define NCS_VM_TRACE_H
+
+#include <atomic>
+#include <thread>
+
+#include "ncs_vm.h"
+
+#define NCS_VM_TRACE_MAGIC          "NCST"
+#define NCS_VM_TRACE_VERSION        1
+#define NCS_VM_TRACE_RING_BYTES     (1u << 20)  // Default ring size
+#define NCS_VM_TRACE_NO_SCRIPT      0xFFFFFFFFu // Script id of programs not registered
+
+enum NcsVmTraceEvent
+{
+    NCS_VM_TRACE_RUN = 1,
+    NCS_VM_TRACE_ACTION,
+    NCS_VM_TRACE_SEED,
+    NCS_VM_TRACE_END
+};
+
+typedef struct NcsVmTraceRecorder
+{
+    std::vector<uint8_t> ring;         // Power-of-two capacity
+    std::atomic<size_t> head;          // Bytes produced (written by the script thread)
+    std::atomic<size_t> tail;          // Bytes consumed (written by the writer thread)
+    FILE* stream;
+    std::thread writer;
+    std::atomic<int> stopping;
+    std::vector<NcsVmActionSignature> signatures; // Cells popped/pushed per routine
+    std::map<const NcsVmProgram*, uint32_t> scriptIds;
+    std::vector<uint32_t> lastResults; // Previous result cells per routine, 3 per routine
+    uint32_t lastScript;               // Script id of the previous RUN
+    uint64_t runInstructions;          // Instructions of the current run so far
+    std::vector<uint8_t> scratch;      // Event being encoded
+    uint64_t events;                   // Events recorded
+    uint64_t bytes;                    // Encoded bytes recorded
+    std::atomic<uint64_t> stalls;      // Times the script thread waited for ring space
+} NcsVmTraceRecorder;
+
+/**
+ * @brief Resolves a recorded script id to its program during replay
+ *
+ * @return The program, or NULL if it is not available
+ */
+typedef const NcsVmProgram* (*NcsVmTraceResolve)(uint32_t scriptId, void* userData);
+
+typedef struct NcsVmTraceReplayStats
+{
+    uint64_t runs;                     // RUN events replayed
+    uint64_t actions;                  // ACTION events consumed
+    uint64_t seeds;                    // SEED events seen
+    uint64_t instructions;             // Instructions executed
+    uint64_t failedEvent;              // Index of the event that diverged or failed to decode
+} NcsVmTraceReplayStats;
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+/**
+ * @brief Start recording to a stream
+ *
+ * Attach with vm->recorder = recorder. One recorder serves one machine
+ * (the ring has a single producer); give each scheduler worker its own.
+ *
+ * @param recorder Recorder to initialize
+ * @param stream Open binary stream the writer thread appends to
+ * @param ringBytes Ring size, rounded up to a power of two (0 = NCS_VM_TRACE_RING_BYTES)
+ * @param signatures Stack effect per routine (from ncs_vm_action_signatures), or NULL
+ * @param signatureCount Entries in signatures
+ * @return 1 on success, 0 if the writer thread could not be started
+ */
+int ncs_vm_trace_begin(NcsVmTraceRecorder* recorder, FILE* stream, size_t ringBytes,
+                       const NcsVmActionSignature* signatures, size_t signatureCount);
+
+/**
+ * @brief Flush the ring, stop the writer thread and flush the stream
+ */
+void ncs_vm_trace_end(NcsVmTraceRecorder* recorder);
+
+/**
+ * @brief Give a program the id RUN events record for it (and replay resolves)
+ */
+void ncs_vm_trace_set_script_id(NcsVmTraceRecorder* recorder, const NcsVmProgram* program, uint32_t scriptId);
+
+/**
+ * @brief Record a random seed or other host input the engine derived outside ACTION calls
+ */
+void ncs_vm_trace_seed(NcsVmTraceRecorder* recorder, uint64_t seed);
+
+// ============================================================================
+// VM HOOKS
+// ============================================================================
+
+/**
+ * @brief Record the start of a run (state is NULL for a run from the program start)
+ */
+void ncs_vm_trace_run(NcsVmTraceRecorder* recorder, const NcsVm* vm, const NcsVmProgram* program,
+                      uint32_t entry, const NcsVmSavedState* state);
+
+/**
+ * @brief Record an ACTION call after its handler returned
+ *
+ * Without a signature for the routine the net stack change decides: a
+ * growth is recorded as pushed cells, a shrink as popped cells.
+ *
+ * @param recorder Recorder
+ * @param vm Machine (SP after the handler)
+ * @param routine Routine number
+ * @param spBefore SP before the handler ran
+ * @param tookState The handler took the stored STORE_STATE continuation
+ */
+void ncs_vm_trace_action(NcsVmTraceRecorder* recorder, const NcsVm* vm, uint16_t routine, uint32_t spBefore,
+                         int tookState);
+
+/**
+ * @brief Add a slice's instructions to the current run
+ */
+void ncs_vm_trace_slice(NcsVmTraceRecorder* recorder, uint64_t instructions);
+
+/**
+ * @brief Record the end of a run
+ */
+void ncs_vm_trace_finish(NcsVmTraceRecorder* recorder, const NcsVm* vm, int result);
+
+// ============================================================================
+// REPLAY
+// ============================================================================
+
+/**
+ * @brief Re-execute a recorded trace without an engine
+ *
+ * Every run is executed on a private machine whose ACTION calls are
+ * answered from the trace. A run whose routine sequence, result,
+ * instruction count or final SP differs from the recording stops the
+ * replay with NCS_VM_ERROR_TRACE_MISMATCH. A recorded run that failed
+ * replays successfully if it fails the same way at the same point.
+ *
+ * @param data Trace bytes
+ * @param size Byte count of data
+ * @param resolve Maps script ids to loaded programs
+ * @param userData Passed to resolve
+ * @param stackCells Stack size of the replay machine (0 = NCS_VM_DEFAULT_STACK_CELLS)
+ * @param stats Receives counts and the failing event (may be NULL)
+ * @return NCS_VM_OK, NCS_VM_ERROR_BAD_PROGRAM for a malformed trace or
+ *         unresolved script, or NCS_VM_ERROR_TRACE_MISMATCH
+ */
+int ncs_vm_trace_replay(const uint8_t* data, size_t size, NcsVmTraceResolve resolve, void* userData,
+                        uint32_t stackCells, NcsVmTraceReplayStats* stats);
+
+#endif // NCS_VM_TRACE_H
@@ -0,0 +1,741 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - STATIC STACK AND TYPE VERIFIER
+// ============================================================================
+// Depths are counted in cells relative to the entry of the subroutine being
+// analysed. Cells below the entry belong to the caller; the verifier keeps a
+// window of NCS_VM_VERIFY_WINDOW of them, typed as "caller cell n", so a
+// subroutine summary can say which caller cells it overwrote and with what.
+//
+// A summary is keyed on the subroutine entry, the BP it was entered with
+// and its absolute entry depth. Most subroutines do not depend on the
+// absolute depth and are summarized once with it unknown; one that executes
+// SAVEBP (the globals routine around main) is summarized again per absolute
+// depth, which every caller knows because roots start at a known depth.
+// ============================================================================
+
+#include "ncs_vm.h"
+
+#include <limits.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+#define NCS_VM_VERIFY_WINDOW    127          // Caller cells a subroutine may reach below its entry
+#define NCS_VM_VERIFY_TOP       0x7F         // Unknown or conflicting type
+#define NCS_VM_VERIFY_PARAM     0x80         // | n: caller cell n below the entry, unchanged
+#define NCS_VM_VERIFY_UNKNOWN   INT32_MIN    // BP or absolute depth not known statically
+#define NCS_VM_VERIFY_NONE      UINT32_MAX   // No successor
+#define NCS_VM_VERIFY_NEEDS_ABSOLUTE  (-1)   // Internal: SAVEBP reached with the absolute depth unknown
+
+/**
+ * @brief Abstract machine state before one instruction
+ */
+typedef struct NcsVmVerifyState
+{
+    int32_t depth;                     // Cells above the subroutine entry (negative once arguments are popped)
+    int32_t bp;                        // BP in root coordinates, or NCS_VM_VERIFY_UNKNOWN
+    std::vector<uint8_t> types;        // Cells from -NCS_VM_VERIFY_WINDOW up to depth - 1
+} NcsVmVerifyState;
+
+enum NcsVmFunctionStatus
+{
+    NCS_VM_FUNCTION_DONE = 0,
+    NCS_VM_FUNCTION_NEEDS_ABSOLUTE     // Executes SAVEBP: summarize per absolute entry depth instead
+};
+
+/**
+ * @brief Context a subroutine summary was computed for
+ */
+typedef struct NcsVmFunctionKey
+{
+    uint32_t entry;
+    int32_t entryBp;                   // BP on entry, or NCS_VM_VERIFY_UNKNOWN
+    int32_t entryAbsolute;             // Absolute depth on entry, or NCS_VM_VERIFY_UNKNOWN
+
+    bool operator<(const NcsVmFunctionKey& other) const
+    {
+        if (entry != other.entry) {
+            return entry < other.entry;
+        }
+        if (entryBp != other.entryBp) {
+            return entryBp < other.entryBp;
+        }
+        return entryAbsolute < other.entryAbsolute;
+    }
+} NcsVmFunctionKey;
+
+/**
+ * @brief Effect of one subroutine, applied at every JSR to it
+ */
+typedef struct NcsVmFunctionSummary
+{
+    int status;                        // NcsVmFunctionStatus
+    int32_t reach;                     // Lowest cell touched, relative to the entry (<= 0)
+    int32_t maxDepth;                  // Highest depth, callees and ACTION results included
+    int32_t requiredEntry;             // Absolute entry depth every access needs
+    bool changesBp;                    // Executes SAVEBP or RESTOREBP
+    bool returns;                      // Some path reaches RETN
+    int32_t exitDepth;                 // Depth at RETN
+    std::vector<uint8_t> exitTypes;    // Types at RETN (same layout as NcsVmVerifyState::types)
+} NcsVmFunctionSummary;
+
+typedef struct NcsVmVerifier
+{
+    NcsVmProgram* program;
+    const NcsVmActionSignature* signatures;
+    size_t signatureCount;
+    std::vector<uint32_t> owner;       // Entry of the subroutine that reached each instruction
+    std::vector<uint8_t> active;       // Per entry: being analysed, so a JSR back to it is recursion
+    std::map<NcsVmFunctionKey, NcsVmFunctionSummary> functions;
+    std::vector<uint32_t> deferred;    // STORE_STATE instructions seen, in discovery order
+    std::set<uint32_t> deferredSeen;
+    uint32_t errorIndex;
+} NcsVmVerifier;
+
+// ============================================================================
+// ABSTRACT STACK
+// ============================================================================
+
+static bool ncs_vm_verify_is(uint8_t type, uint8_t expected)
+{
+    return type == expected || type >= NCS_VM_VERIFY_TOP;
+}
+
+static uint8_t ncs_vm_verify_merge_type(uint8_t a, uint8_t b)
+{
+    return a == b ? a : (uint8_t)NCS_VM_VERIFY_TOP;
+}
+
+/**
+ * @brief Check that cells [position, position + cells) are live and record the reach
+ *
+ * @return Index of position in state->types, or -1
+ */
+static int32_t ncs_vm_verify_cells(const NcsVmVerifyState* state, NcsVmFunctionSummary* function,
+                                   int32_t position, int32_t cells)
+{
+    if (position < -NCS_VM_VERIFY_WINDOW || cells < 0 || position + cells > state->depth) {
+        return -1;
+    }
+    function->reach = std::min(function->reach, position);
+    return position + NCS_VM_VERIFY_WINDOW;
+}
+
+static int ncs_vm_verify_pop(NcsVmVerifyState* state, NcsVmFunctionSummary* function, int32_t cells)
+{
+    if (ncs_vm_verify_cells(state, function, state->depth - cells, cells) < 0) {
+        return NCS_VM_ERROR_STACK_UNDERFLOW;
+    }
+    state->depth -= cells;
+    state->types.resize((size_t)(state->depth + NCS_VM_VERIFY_WINDOW));
+    return NCS_VM_OK;
+}
+
+static void ncs_vm_verify_push(NcsVmVerifyState* state, NcsVmFunctionSummary* function, uint8_t type)
+{
+    state->types.push_back(type);
+    state->depth++;
+    function->maxDepth = std::max(function->maxDepth, state->depth);
+}
+
+/**
+ * @brief Type of the cell count cells below the top
+ */
+static uint8_t ncs_vm_verify_peek(const NcsVmVerifyState* state, int32_t count)
+{
+    int32_t index = state->depth - count + NCS_VM_VERIFY_WINDOW;
+    return index >= 0 ? state->types[index] : (uint8_t)NCS_VM_VERIFY_TOP;
+}
+
+/**
+ * @brief Pop two operands of the given types and push one result
+ */
+static int ncs_vm_verify_binary(NcsVmVerifyState* state, NcsVmFunctionSummary* function,
+                                uint8_t left, uint8_t right, uint8_t result)
+{
+    if (state->depth - 2 < -NCS_VM_VERIFY_WINDOW) {
+        return NCS_VM_ERROR_STACK_UNDERFLOW;
+    }
+    if (!ncs_vm_verify_is(ncs_vm_verify_peek(state, 2), left) ||
+        !ncs_vm_verify_is(ncs_vm_verify_peek(state, 1), right)) {
+        return NCS_VM_ERROR_TYPE_MISMATCH;
+    }
+    int popped = ncs_vm_verify_pop(state, function, 2);
+    if (popped == NCS_VM_OK) {
+        ncs_vm_verify_push(state, function, result);
+    }
+    return popped;
+}
+
+/**
+ * @brief Pop two scalar operands of one type and push the int result (EQUAL/NEQUAL)
+ *
+ * Either side may be a parameter or unknown cell, so the known side fixes
+ * the type; only two known, different tags are a mismatch.
+ */
+static int ncs_vm_verify_equality(NcsVmVerifyState* state, NcsVmFunctionSummary* function)
+{
+    uint8_t left = ncs_vm_verify_peek(state, 2);
+    uint8_t expected = left >= NCS_VM_VERIFY_TOP ? ncs_vm_verify_peek(state, 1) : left;
+    return ncs_vm_verify_binary(state, function, expected, expected, NCS_VM_TYPE_INT);
+}
+
+/**
+ * @brief Pop operandCells float cells and push resultCells float cells (vector math)
+ */
+static int ncs_vm_verify_floats(NcsVmVerifyState* state, NcsVmFunctionSummary* function,
+                                int32_t operandCells, int32_t resultCells)
+{
+    for (int32_t k = 1; k <= operandCells && k <= state->depth + NCS_VM_VERIFY_WINDOW; k++) {
+        if (!ncs_vm_verify_is(ncs_vm_verify_peek(state, k), NCS_VM_TYPE_FLOAT)) {
+            return NCS_VM_ERROR_TYPE_MISMATCH;
+        }
+    }
+    int popped = ncs_vm_verify_pop(state, function, operandCells);
+    for (int32_t k = 0; popped == NCS_VM_OK && k < resultCells; k++) {
+        ncs_vm_verify_push(state, function, NCS_VM_TYPE_FLOAT);
+    }
+    return popped;
+}
+
+/**
+ * @brief Check a BP-relative access and record the entry depth it needs
+ */
+static int ncs_vm_verify_bp_cells(const NcsVmVerifyState* state, NcsVmFunctionSummary* function,
+                                  int32_t offset, int32_t cells)
+{
+    if (state->bp == NCS_VM_VERIFY_UNKNOWN) {
+        return NCS_VM_ERROR_UNSUPPORTED;
+    }
+    int64_t first = (int64_t)state->bp + offset;
+    if (first < 0) {
+        return NCS_VM_ERROR_STACK_UNDERFLOW;
+    }
+    // bp + offset + cells <= entry + depth
+    int64_t required = first + cells - state->depth;
+    if (required > INT32_MAX) {
+        return NCS_VM_ERROR_STACK_UNDERFLOW;
+    }
+    function->requiredEntry = std::max(function->requiredEntry, (int32_t)required);
+    return NCS_VM_OK;
+}
+
+/**
+ * @brief Join state into target; the depth must agree
+ *
+ * @return NCS_VM_OK, or NCS_VM_ERROR_UNBALANCED; *changed is set when target grew
+ */
+static int ncs_vm_verify_merge(NcsVmVerifyState* target, uint8_t* reached, const NcsVmVerifyState* state, bool* changed)
+{
+    if (!*reached) {
+        *target = *state;
+        *reached = 1;
+        *changed = true;
+        return NCS_VM_OK;
+    }
+    if (target->depth != state->depth) {
+        return NCS_VM_ERROR_UNBALANCED;
+    }
+    *changed = false;
+    if (target->bp != state->bp && target->bp != NCS_VM_VERIFY_UNKNOWN) {
+        target->bp = NCS_VM_VERIFY_UNKNOWN;
+        *changed = true;
+    }
+    for (size_t k = 0; k < target->types.size(); k++) {
+        uint8_t merged = ncs_vm_verify_merge_type(target->types[k], state->types[k]);
+        if (merged != target->types[k]) {
+            target->types[k] = merged;
+            *changed = true;
+        }
+    }
+    return NCS_VM_OK;
+}
+
+/**
+ * @brief NcsVmOp an instruction had before ncs_vm_fuse_program rewrote it
+ */
+static uint8_t ncs_vm_verify_unfused_op(const NcsVmInstruction* in)
+{
+    switch (in->op) {
+        case NCS_VM_OP_CPDOWNSP_MOVSP:                      return NCS_VM_OP_CPDOWNSP;
+        case NCS_VM_OP_CONST_CPDOWNSP_MOVSP:                return NCS_VM_OP_CONST;
+        case NCS_VM_OP_CPTOPSP_CONST_ADDII_CPDOWNSP_MOVSP:
+        case NCS_VM_OP_CPTOPSP_JZ:
+        case NCS_VM_OP_CPTOPSP_JNZ:
+        case NCS_VM_OP_CPTOPSP_CONST_COMPAREII_JZ:          return NCS_VM_OP_CPTOPSP;
+        case NCS_VM_OP_COMPAREII_JZ:                        return in->type;
+        default:                                            return in->op;
+    }
+}
+
+// ============================================================================
+// TRANSFER FUNCTION
+// ============================================================================
+
+static int ncs_vm_verify_function(NcsVmVerifier* verifier, uint32_t entry, int32_t entryBp, int32_t entryAbsolute,
+                                  NcsVmFunctionSummary** summary);
+
+/**
+ * @brief Apply the summary of a called subroutine at a JSR
+ */
+static int ncs_vm_verify_call(NcsVmVerifier* verifier, NcsVmVerifyState* state, NcsVmFunctionSummary* function,
+                              int32_t entryAbsolute, uint32_t target, bool* returns)
+{
+    // Try the summary that holds at any absolute depth first
+    NcsVmFunctionSummary* callee = NULL;
+    int result = ncs_vm_verify_function(verifier, target, state->bp, NCS_VM_VERIFY_UNKNOWN, &callee);
+    if (result == NCS_VM_VERIFY_NEEDS_ABSOLUTE && entryAbsolute != NCS_VM_VERIFY_UNKNOWN) {
+        result = ncs_vm_verify_function(verifier, target, state->bp, entryAbsolute + state->depth, &callee);
+    }
+    if (result != NCS_VM_OK) {
+        return result;
+    }
+
+    int32_t lowest = state->depth + callee->reach;
+    if (lowest < -NCS_VM_VERIFY_WINDOW || state->depth + callee->exitDepth < -NCS_VM_VERIFY_WINDOW) {
+        return NCS_VM_ERROR_STACK_UNDERFLOW;
+    }
+    function->reach = std::min(function->reach, lowest);
+    function->requiredEntry = std::max(function->requiredEntry, callee->requiredEntry - state->depth);
+    function->maxDepth = std::max(function->maxDepth, state->depth + callee->maxDepth);
+    function->changesBp = function->changesBp || callee->changesBp;
+
+    *returns = callee->returns;
+    if (!callee->returns) {
+        return NCS_VM_OK;
+    }
+
+    // Cells the callee may have touched take its exit types; caller cells it
+    // left alone map back through their "caller cell n" tags
+    int32_t exitDepth = state->depth + callee->exitDepth;
+    std::vector<uint8_t> types(state->types.begin(), state->types.begin() + (lowest + NCS_VM_VERIFY_WINDOW));
+    for (int32_t position = callee->reach; position < callee->exitDepth; position++) {
+        uint8_t type = callee->exitTypes[position + NCS_VM_VERIFY_WINDOW];
+        if (type & NCS_VM_VERIFY_PARAM) {
+            type = ncs_vm_verify_peek(state, (int32_t)(type & ~NCS_VM_VERIFY_PARAM));
+        }
+        types.push_back(type);
+    }
+    state->types.swap(types);
+    state->depth = exitDepth;
+    if (callee->changesBp) {
+        state->bp = NCS_VM_VERIFY_UNKNOWN;
+    }
+    return NCS_VM_OK;
+}
+
+/**
+ * @brief Record a RETN in the subroutine summary
+ */
+static int ncs_vm_verify_return(NcsVmFunctionSummary* function, const NcsVmVerifyState* state)
+{
+    if (!function->returns) {
+        function->returns = true;
+        function->exitDepth = state->depth;
+        function->exitTypes = state->types;
+        return NCS_VM_OK;
+    }
+    if (function->exitDepth != state->depth) {
+        return NCS_VM_ERROR_UNBALANCED;
+    }
+    for (size_t k = 0; k < function->exitTypes.size(); k++) {
+        function->exitTypes[k] = ncs_vm_verify_merge_type(function->exitTypes[k], state->types[k]);
+    }
+    return NCS_VM_OK;
+}
+
+/**
+ * @brief Execute one instruction abstractly
+ *
+ * @param next Receives the fall-through successor or NCS_VM_VERIFY_NONE
+ * @param branch Receives the jump successor or NCS_VM_VERIFY_NONE
+ */
+static int ncs_vm_verify_step(NcsVmVerifier* verifier, NcsVmFunctionSummary* function, int32_t entryAbsolute,
+                              uint32_t index, NcsVmVerifyState* state, uint32_t* next, uint32_t* branch)
+{
+    NcsVmInstruction* in = &verifier->program->code[index];
+    int32_t at;
+    int result;
+
+    *next = index + 1;
+    *branch = NCS_VM_VERIFY_NONE;
+
+    switch (ncs_vm_verify_unfused_op(in)) {
+        case NCS_VM_OP_CPDOWNSP: {
+            int32_t source = ncs_vm_verify_cells(state, function, state->depth - in->count, in->count);
+            at = ncs_vm_verify_cells(state, function, state->depth + in->a, in->count);
+            if (source < 0 || at < 0) {
+                return NCS_VM_ERROR_STACK_UNDERFLOW;
+            }
+            std::copy(state->types.begin() + source, state->types.begin() + source + in->count,
+                      state->types.begin() + at);
+            return NCS_VM_OK;
+        }
+
+        case NCS_VM_OP_CPTOPSP: {
+            at = ncs_vm_verify_cells(state, function, state->depth + in->a, in->count);
+            if (at < 0) {
+                return NCS_VM_ERROR_STACK_UNDERFLOW;
+            }
+            std::vector<uint8_t> copied(state->types.begin() + at, state->types.begin() + at + in->count);
+            for (size_t k = 0; k < copied.size(); k++) {
+                ncs_vm_verify_push(state, function, copied[k]);
+            }
+            return NCS_VM_OK;
+        }
+
+        case NCS_VM_OP_RSADD:
+        case NCS_VM_OP_CONST:
+            ncs_vm_verify_push(state, function, in->type);
+            return NCS_VM_OK;
+
+        case NCS_VM_OP_CONSTS:
+            ncs_vm_verify_push(state, function, NCS_VM_TYPE_STRING);
+            return NCS_VM_OK;
+
+        case NCS_VM_OP_CONSTO:
+            ncs_vm_verify_push(state, function, NCS_VM_TYPE_OBJECT);
+            return NCS_VM_OK;
+
+        case NCS_VM_OP_ACTION: {
+            uint16_t routine = (uint16_t)in->a;
+            if (routine >= verifier->signatureCount || verifier->signatures[routine].argumentCells < 0) {
+                return NCS_VM_ERROR_UNKNOWN_ACTION;
+            }
+            const NcsVmActionSignature* signature = &verifier->signatures[routine];
+            result = ncs_vm_verify_pop(state, function, signature->argumentCells);
+            for (int k = 0; result == NCS_VM_OK && k < signature->resultCells; k++) {
+                ncs_vm_verify_push(state, function, signature->resultType);
+            }
+            in->b = (int32_t)signature->resultCells - signature->argumentCells;
+            return result;
+        }
+
+        case NCS_VM_OP_LOGANDII: case NCS_VM_OP_LOGORII: case NCS_VM_OP_INCORII:
+        case NCS_VM_OP_EXCORII: case NCS_VM_OP_BOOLANDII:
+        case NCS_VM_OP_GEQII: case NCS_VM_OP_GTII: case NCS_VM_OP_LTII: case NCS_VM_OP_LEQII:
+        case NCS_VM_OP_SHLEFTII: case NCS_VM_OP_SHRIGHTII: case NCS_VM_OP_USHRIGHTII:
+        case NCS_VM_OP_ADDII: case NCS_VM_OP_SUBII: case NCS_VM_OP_MULII: case NCS_VM_OP_DIVII: case NCS_VM_OP_MODII:
+            return ncs_vm_verify_binary(state, function, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT, NCS_VM_TYPE_INT);
+
+        case NCS_VM_OP_EQUAL: case NCS_VM_OP_NEQUAL:
+            return ncs_vm_verify_equality(state, function);
+        case NCS_VM_OP_EQUALFF: case NCS_VM_OP_NEQUALFF:
+        case NCS_VM_OP_GEQFF: case NCS_VM_OP_GTFF: case NCS_VM_OP_LTFF: case NCS_VM_OP_LEQFF:
+            return ncs_vm_verify_binary(state, function, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_INT);
+        case NCS_VM_OP_EQUALSS: case NCS_VM_OP_NEQUALSS:
+            return ncs_vm_verify_binary(state, function, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_INT);
+        case NCS_VM_OP_EQUALTT: case NCS_VM_OP_NEQUALTT:
+            result = ncs_vm_verify_pop(state, function, 2 * (int32_t)in->count);
+            if (result == NCS_VM_OK) {
+                ncs_vm_verify_push(state, function, NCS_VM_TYPE_INT);
+            }
+            return result;
+
+        case NCS_VM_OP_ADDIF: case NCS_VM_OP_SUBIF: case NCS_VM_OP_MULIF: case NCS_VM_OP_DIVIF:
+            return ncs_vm_verify_binary(state, function, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT);
+        case NCS_VM_OP_ADDFI: case NCS_VM_OP_SUBFI: case NCS_VM_OP_MULFI: case NCS_VM_OP_DIVFI:
+            return ncs_vm_verify_binary(state, function, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_INT, NCS_VM_TYPE_FLOAT);
+        case NCS_VM_OP_ADDFF: case NCS_VM_OP_SUBFF: case NCS_VM_OP_MULFF: case NCS_VM_OP_DIVFF:
+            return ncs_vm_verify_binary(state, function, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT, NCS_VM_TYPE_FLOAT);
+        case NCS_VM_OP_ADDSS:
+            return ncs_vm_verify_binary(state, function, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING, NCS_VM_TYPE_STRING);
+        case NCS_VM_OP_ADDVV: case NCS_VM_OP_SUBVV:
+            return ncs_vm_verify_floats(state, function, 6, 3);
+        case NCS_VM_OP_MULVF: case NCS_VM_OP_DIVVF: case NCS_VM_OP_MULFV:
+            return ncs_vm_verify_floats(state, function, 4, 3);
+
+        case NCS_VM_OP_NEGI: case NCS_VM_OP_COMPI: case NCS_VM_OP_NOTI:
+            if (ncs_vm_verify_cells(state, function, state->depth - 1, 1) < 0) {
+                return NCS_VM_ERROR_STACK_UNDERFLOW;
+            }
+            return ncs_vm_verify_is(ncs_vm_verify_peek(state, 1), NCS_VM_TYPE_INT) ? NCS_VM_OK : NCS_VM_ERROR_TYPE_MISMATCH;
+        case NCS_VM_OP_NEGF:
+            if (ncs_vm_verify_cells(state, function, state->depth - 1, 1) < 0) {
+                return NCS_VM_ERROR_STACK_UNDERFLOW;
+            }
+            return ncs_vm_verify_is(ncs_vm_verify_peek(state, 1), NCS_VM_TYPE_FLOAT) ? NCS_VM_OK : NCS_VM_ERROR_TYPE_MISMATCH;
+
+        case NCS_VM_OP_MOVSP:
+            return ncs_vm_verify_pop(state, function, -in->a);
+
+        case NCS_VM_OP_JMP:
+            *next = NCS_VM_VERIFY_NONE;
+            *branch = (uint32_t)in->a;
+            return NCS_VM_OK;
+
+        case NCS_VM_OP_JSR: {
+            bool returns = false;
+            result = ncs_vm_verify_call(verifier, state, function, entryAbsolute, (uint32_t)in->a, &returns);
+            if (!returns) {
+                *next = NCS_VM_VERIFY_NONE;
+            }
+            return result;
+        }
+
+        case NCS_VM_OP_JZ: case NCS_VM_OP_JNZ:
+            if (!ncs_vm_verify_is(ncs_vm_verify_peek(state, 1), NCS_VM_TYPE_INT)) {
+                return NCS_VM_ERROR_TYPE_MISMATCH;
+            }
+            *branch = (uint32_t)in->a;
+            return ncs_vm_verify_pop(state, function, 1);
+
+        case NCS_VM_OP_RETN:
+            *next = NCS_VM_VERIFY_NONE;
+            return ncs_vm_verify_return(function, state);
+
+        case NCS_VM_OP_DESTRUCT: {
+            at = ncs_vm_verify_cells(state, function, state->depth - in->count, in->count);
+            if (at < 0) {
+                return NCS_VM_ERROR_STACK_UNDERFLOW;
+            }
+            std::vector<uint8_t> kept(state->types.begin() + at + in->a, state->types.begin() + at + in->a + in->b);
+            ncs_vm_verify_pop(state, function, in->count);
+            for (size_t k = 0; k < kept.size(); k++) {
+                ncs_vm_verify_push(state, function, kept[k]);
+            }
+            return NCS_VM_OK;
+        }
+
+        case NCS_VM_OP_DECSP: case NCS_VM_OP_INCSP:
+            at = ncs_vm_verify_cells(state, function, state->depth + in->a, 1);
+            if (at < 0) {
+                return NCS_VM_ERROR_STACK_UNDERFLOW;
+            }
+            return (ncs_vm_verify_is(state->types[at], NCS_VM_TYPE_INT) ||
+                    state->types[at] == NCS_VM_TYPE_FLOAT) ? NCS_VM_OK : NCS_VM_ERROR_TYPE_MISMATCH;
+
+        case NCS_VM_OP_DECBP: case NCS_VM_OP_INCBP:
+            return ncs_vm_verify_bp_cells(state, function, in->a, 1);
+
+        case NCS_VM_OP_CPDOWNBP:
+            if (ncs_vm_verify_cells(state, function, state->depth - in->count, in->count) < 0) {
+                return NCS_VM_ERROR_STACK_UNDERFLOW;
+            }
+            return ncs_vm_verify_bp_cells(state, function, in->a, in->count);
+
+        case NCS_VM_OP_CPTOPBP:
+            // Globals are not typed: the copies are unknown
+            result = ncs_vm_verify_bp_cells(state, function, in->a, in->count);
+            for (int k = 0; result == NCS_VM_OK && k < in->count; k++) {
+                ncs_vm_verify_push(state, function, NCS_VM_VERIFY_TOP);
+            }
+            return result;
+
+        case NCS_VM_OP_SAVEBP:
+            // The new BP is absolute: the caller analyses this subroutine again with its depth
+            if (entryAbsolute == NCS_VM_VERIFY_UNKNOWN) {
+                return NCS_VM_VERIFY_NEEDS_ABSOLUTE;
+            }
+            state->bp = entryAbsolute + state->depth;
+            ncs_vm_verify_push(state, function, NCS_VM_TYPE_INT);
+            function->changesBp = true;
+            return NCS_VM_OK;
+
+        case NCS_VM_OP_RESTOREBP:
+            if (!ncs_vm_verify_is(ncs_vm_verify_peek(state, 1), NCS_VM_TYPE_INT)) {
+                return NCS_VM_ERROR_TYPE_MISMATCH;
+            }
+            state->bp = NCS_VM_VERIFY_UNKNOWN;
+            function->changesBp = true;
+            return ncs_vm_verify_pop(state, function, 1);
+
+        case NCS_VM_OP_STORE_STATE:
+            if (verifier->deferredSeen.insert(index).second) {
+                verifier->deferred.push_back(index);
+            }
+            return NCS_VM_OK;
+
+        case NCS_VM_OP_NOP:
+            return NCS_VM_OK;
+
+        case NCS_VM_OP_END:
+            return NCS_VM_ERROR_END_OF_CODE;
+
+        default:
+            return NCS_VM_ERROR_BAD_OPCODE;
+    }
+}
+
+// ============================================================================
+// SUBROUTINE ANALYSIS
+// ============================================================================
+
+/**
+ * @brief Run the worklist over one subroutine in one context
+ */
+static int ncs_vm_verify_body(NcsVmVerifier* verifier, uint32_t entry, int32_t entryBp, int32_t entryAbsolute,
+                              NcsVmFunctionSummary* function)
+{
+    function->status = NCS_VM_FUNCTION_DONE;
+    function->reach = 0;
+    function->maxDepth = 0;
+    function->requiredEntry = 0;
+    function->changesBp = false;
+    function->returns = false;
+    function->exitDepth = 0;
+
+    NcsVmVerifyState start;
+    start.depth = 0;
+    start.bp = entryBp;
+    start.types.resize(NCS_VM_VERIFY_WINDOW);
+    for (int32_t k = 0; k < NCS_VM_VERIFY_WINDOW; k++) {
+        start.types[k] = (uint8_t)(NCS_VM_VERIFY_PARAM | (NCS_VM_VERIFY_WINDOW - k));
+    }
+
+    // States are per context: the same code entered at another BP or depth is a separate analysis
+    std::map<uint32_t, NcsVmVerifyState> states;
+    std::vector<uint8_t> reached(verifier->program->code.size(), 0);
+    std::vector<uint32_t> worklist;
+    bool changed = false;
+    if (verifier->owner[entry] != NCS_VM_VERIFY_NONE && verifier->owner[entry] != entry) {
+        verifier->errorIndex = entry;
+        return NCS_VM_ERROR_UNSUPPORTED;
+    }
+    ncs_vm_verify_merge(&states[entry], &reached[entry], &start, &changed);
+    verifier->owner[entry] = entry;
+    worklist.push_back(entry);
+
+    while (!worklist.empty()) {
+        uint32_t index = worklist.back();
+        worklist.pop_back();
+
+        NcsVmVerifyState state = states[index];
+        uint32_t successors[2];
+        int result = ncs_vm_verify_step(verifier, function, entryAbsolute, index, &state,
+                                        &successors[0], &successors[1]);
+        if (result != NCS_VM_OK) {
+            if (result != NCS_VM_VERIFY_NEEDS_ABSOLUTE && verifier->errorIndex == NCS_VM_VERIFY_NONE) {
+                verifier->errorIndex = index;
+            }
+            return result;
+        }
+
+        for (int k = 0; k < 2; k++) {
+            uint32_t successor = successors[k];
+            if (successor == NCS_VM_VERIFY_NONE) {
+                continue;
+            }
+            if (successor >= verifier->program->code.size()) {
+                verifier->errorIndex = index;
+                return NCS_VM_ERROR_BAD_JUMP;
+            }
+            // Code shared between subroutines would need one state per caller
+            if (verifier->owner[successor] != NCS_VM_VERIFY_NONE && verifier->owner[successor] != entry) {
+                verifier->errorIndex = index;
+                return NCS_VM_ERROR_UNSUPPORTED;
+            }
+            verifier->owner[successor] = entry;
+            result = ncs_vm_verify_merge(&states[successor], &reached[successor], &state, &changed);
+            if (result != NCS_VM_OK) {
+                verifier->errorIndex = successor;
+                return result;
+            }
+            if (changed) {
+                worklist.push_back(successor);
+            }
+        }
+    }
+
+    function->requiredEntry = std::max(function->requiredEntry, -function->reach);
+    return NCS_VM_OK;
+}
+
+/**
+ * @brief Summarize the subroutine starting at entry (once per entry context)
+ *
+ * @param entryBp BP on entry, or NCS_VM_VERIFY_UNKNOWN
+ * @param entryAbsolute Absolute depth on entry, or NCS_VM_VERIFY_UNKNOWN for a summary that
+ *                      holds at any depth (NCS_VM_VERIFY_NEEDS_ABSOLUTE if the subroutine has none)
+ */
+static int ncs_vm_verify_function(NcsVmVerifier* verifier, uint32_t entry, int32_t entryBp, int32_t entryAbsolute,
+                                  NcsVmFunctionSummary** summary)
+{
+    NcsVmFunctionKey key;
+    key.entry = entry;
+    key.entryBp = entryBp;
+    key.entryAbsolute = entryAbsolute;
+    std::map<NcsVmFunctionKey, NcsVmFunctionSummary>::iterator found = verifier->functions.find(key);
+    if (found != verifier->functions.end()) {
+        *summary = &found->second;
+        return found->second.status == NCS_VM_FUNCTION_NEEDS_ABSOLUTE ? NCS_VM_VERIFY_NEEDS_ABSOLUTE : NCS_VM_OK;
+    }
+    if (verifier->active[entry]) {
+        verifier->errorIndex = entry;
+        return NCS_VM_ERROR_UNSUPPORTED;
+    }
+
+    NcsVmFunctionSummary function;
+    verifier->active[entry] = 1;
+    int result = ncs_vm_verify_body(verifier, entry, entryBp, entryAbsolute, &function);
+    verifier->active[entry] = 0;
+    if (result == NCS_VM_VERIFY_NEEDS_ABSOLUTE) {
+        function.status = NCS_VM_FUNCTION_NEEDS_ABSOLUTE;
+    }
+    else if (result != NCS_VM_OK) {
+        return result;
+    }
+    *summary = &(verifier->functions[key] = function);
+    return result;
+}
+
+/**
+ * @brief Analyse an entry point whose absolute depth is known
+ *
+ * @param maxStackCells Raised to the entry point's absolute peak depth
+ */
+static int ncs_vm_verify_root(NcsVmVerifier* verifier, uint32_t entry, int32_t entryBp, int32_t entryAbsolute,
+                              uint32_t* maxStackCells)
+{
+    NcsVmFunctionSummary* root = NULL;
+    int result = ncs_vm_verify_function(verifier, entry, entryBp, entryAbsolute, &root);
+    if (result != NCS_VM_OK) {
+        return result;
+    }
+    if (root->requiredEntry > entryAbsolute) {
+        verifier->errorIndex = entry;
+        return NCS_VM_ERROR_STACK_UNDERFLOW;
+    }
+    *maxStackCells = std::max(*maxStackCells, (uint32_t)(entryAbsolute + root->maxDepth));
+    return NCS_VM_OK;
+}
+
+int ncs_vm_verify(NcsVmProgram* program, const NcsVmActionSignature* signatures, size_t signatureCount)
+{
+    program->verified = 0;
+    program->maxStackCells = 0;
+    if (program->code.size() < 2) {
+        return NCS_VM_ERROR_BAD_PROGRAM;
+    }
+
+    NcsVmVerifier verifier;
+    verifier.program = program;
+    verifier.signatures = signatures;
+    verifier.signatureCount = signatures != NULL ? signatureCount : 0;
+    verifier.owner.assign(program->code.size(), NCS_VM_VERIFY_NONE);
+    verifier.active.assign(program->code.size(), 0);
+    verifier.errorIndex = NCS_VM_VERIFY_NONE;
+
+    // The host may have pushed cells before the run: depths are relative to
+    // that starting SP, which is the worst case (0) for underflow
+    uint32_t maxStackCells = 0;
+    int result = ncs_vm_verify_root(&verifier, 0, NCS_VM_VERIFY_UNKNOWN, 0, &maxStackCells);
+
+    // Deferred blocks start on a fresh stack of saved globals and locals
+    for (size_t k = 0; result == NCS_VM_OK && k < verifier.deferred.size(); k++) {
+        const NcsVmInstruction& store = program->code[verifier.deferred[k]];
+        uint32_t block = verifier.deferred[k] + 2;
+        result = ncs_vm_verify_root(&verifier, block, store.a, store.a + store.b, &maxStackCells);
+    }
+
+    if (result != NCS_VM_OK) {
+        uint32_t errorIndex = verifier.errorIndex != NCS_VM_VERIFY_NONE ? verifier.errorIndex : 0;
+        program->errorOffset = program->code[errorIndex].offset;
+        return result;
+    }
+
+    program->verified = 1;
+    program->maxStackCells = maxStackCells;
+    return NCS_VM_OK;
+}
@@ -0,0 +1,374 @@
+// ============================================================================
+// NWNNSSCOMP COMPILE BENCHMARK
+// ============================================================================
+
+#include "nwnnsscomp_bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// ============================================================================
+// ALLOCATION COUNTING
+// ============================================================================
+
+#if NWNNSSCOMP_BENCH_COUNT_ALLOCATIONS
+
+static std::atomic<uint64_t> g_benchAllocations(0);
+
+void* operator new(size_t size)
+{
+    g_benchAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* block = malloc(size != 0 ? size : 1);
+    if (block == NULL) {
+        throw std::bad_alloc();
+    }
+    return block;
+}
+
+void operator delete(void* block) noexcept
+{
+    free(block);
+}
+
+// Sized forms: without them a C++14 library may free operator new's blocks with its own allocator
+void operator delete(void* block, size_t) noexcept
+{
+    free(block);
+}
+
+void operator delete[](void* block, size_t) noexcept
+{
+    free(block);
+}
+
+uint64_t nwnnsscomp_bench_allocations()
+{
+    return g_benchAllocations.load(std::memory_order_relaxed);
+}
+
+#else
+
+uint64_t nwnnsscomp_bench_allocations()
+{
+    return 0;
+}
+
+#endif
+
+// ============================================================================
+// MEASUREMENT
+// ============================================================================
+
+/**
+ * @brief Peak resident set size of this process and of its waited-for children, in kilobytes
+ */
+static uint64_t nwnnsscomp_bench_peak_rss()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return (uint64_t)counters.PeakWorkingSetSize / 1024;
+#else
+    struct rusage self;
+    struct rusage children;
+    if (getrusage(RUSAGE_SELF, &self) != 0 || getrusage(RUSAGE_CHILDREN, &children) != 0) {
+        return 0;
+    }
+    uint64_t peak = (uint64_t)std::max(self.ru_maxrss, children.ru_maxrss);
+#if defined(__APPLE__)
+    peak /= 1024;                      // ru_maxrss is in bytes on macOS
+#endif
+    return peak;
+#endif
+}
+
+/**
+ * @brief Nearest-rank percentile of a sorted sample
+ */
+static double nwnnsscomp_bench_percentile(const std::vector<double>& sorted, double percentile)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t rank = (size_t)(percentile / 100.0 * (double)sorted.size() + 0.999999);
+    if (rank == 0) {
+        rank = 1;
+    }
+    return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+static int nwnnsscomp_bench_read_source(const std::string& path, std::string* source)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    source->clear();
+    char buffer[65536];
+    size_t count;
+    while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        source->append(buffer, count);
+    }
+    int ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+int nwnnsscomp_bench_corpus(const char* directory, const NwnRoundtripTools* tools, const NwnBenchOptions* options,
+                            std::vector<NwnBenchScript>* scripts, NwnBenchSummary* summary)
+{
+    memset(summary, 0, sizeof(*summary));
+    summary->allocationsPerScript = -1.0;
+    scripts->clear();
+
+    std::vector<std::string> paths;
+    if (!nwnnsscomp_list_corpus(directory, &paths)) {
+        return 0;
+    }
+
+    // Sources are read up front so file I/O stays out of the timings
+    std::vector<std::string> sources;
+    std::vector<uint8_t> readable;
+    for (size_t i = 0; i < paths.size(); i++) {
+        const std::string& path = paths[i];
+        if (path.size() < 4 || (path.compare(path.size() - 4, 4, ".nss") != 0 &&
+                                path.compare(path.size() - 4, 4, ".NSS") != 0)) {
+            continue;
+        }
+        NwnBenchScript script;
+        script.path = path;
+        script.ncsBytes = 0;
+        script.failed = false;
+        script.milliseconds = 0.0;
+        std::string source;
+        readable.push_back((uint8_t)nwnnsscomp_bench_read_source(std::string(directory) + "/" + path, &source));
+        script.failed = !readable.back();
+        script.sourceBytes = (uint32_t)source.size();
+        scripts->push_back(script);
+        sources.push_back(source);
+    }
+    if (scripts->empty()) {
+        return 0;
+    }
+
+    const uint32_t iterations = options->iterations != 0 ? options->iterations : NWNNSSCOMP_BENCH_DEFAULT_ITERATIONS;
+    std::vector<uint8_t> ncs;
+    std::string message;
+    for (uint32_t pass = 0; pass < options->warmup; pass++) {
+        for (size_t i = 0; i < scripts->size(); i++) {
+            if (readable[i]) {
+                tools->compile(sources[i], (*scripts)[i].path, &ncs, &message, tools->userData);
+            }
+        }
+    }
+
+    // samples[i * iterations + pass]: milliseconds of script i in one pass
+    std::vector<double> samples(scripts->size() * iterations, 0.0);
+    uint64_t allocationsBefore = nwnnsscomp_bench_allocations();
+    std::chrono::steady_clock::time_point runStart = std::chrono::steady_clock::now();
+    for (uint32_t pass = 0; pass < iterations; pass++) {
+        for (size_t i = 0; i < scripts->size(); i++) {
+            NwnBenchScript& script = (*scripts)[i];
+            if (!readable[i]) {
+                continue;
+            }
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            int compiled = tools->compile(sources[i], script.path, &ncs, &message, tools->userData);
+            samples[i * iterations + pass] =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (pass == 0) {
+                script.failed = !compiled;
+                script.ncsBytes = compiled ? (uint32_t)ncs.size() : 0;
+            }
+        }
+    }
+    summary->seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+    uint64_t allocations = nwnnsscomp_bench_allocations() - allocationsBefore;
+
+    std::vector<double> perScript(iterations);
+    for (size_t i = 0; i < scripts->size(); i++) {
+        perScript.assign(samples.begin() + i * iterations, samples.begin() + (i + 1) * iterations);
+        std::sort(perScript.begin(), perScript.end());
+        (*scripts)[i].milliseconds = perScript[iterations / 2];
+        if ((*scripts)[i].failed) {
+            summary->failed++;
+        }
+    }
+    std::sort(samples.begin(), samples.end());
+
+    summary->scripts = (uint32_t)scripts->size();
+    summary->iterations = iterations;
+    summary->scriptsPerSecond =
+        summary->seconds > 0.0 ? (double)summary->scripts * iterations / summary->seconds : 0.0;
+    summary->p50Milliseconds = nwnnsscomp_bench_percentile(samples, 50.0);
+    summary->p99Milliseconds = nwnnsscomp_bench_percentile(samples, 99.0);
+    summary->peakRssKilobytes = nwnnsscomp_bench_peak_rss();
+    if (options->countAllocations && NWNNSSCOMP_BENCH_COUNT_ALLOCATIONS) {
+        summary->allocationsPerScript = (double)allocations / ((double)summary->scripts * iterations);
+    }
+    return 1;
+}
+
+// ============================================================================
+// OUTPUT AND BASELINE
+// ============================================================================
+
+void nwnnsscomp_write_bench_json(const std::vector<NwnBenchScript>* scripts, const NwnBenchSummary* summary,
+                                 FILE* stream)
+{
+    fprintf(stream,
+            "{\n  \"scripts\": %u,\n  \"failed\": %u,\n  \"iterations\": %u,\n  \"seconds\": %.3f,\n"
+            "  \"scriptsPerSecond\": %.2f,\n  \"p50Ms\": %.3f,\n  \"p99Ms\": %.3f,\n  \"peakRssKb\": %llu,\n",
+            summary->scripts, summary->failed, summary->iterations, summary->seconds, summary->scriptsPerSecond,
+            summary->p50Milliseconds, summary->p99Milliseconds, (unsigned long long)summary->peakRssKilobytes);
+    if (summary->allocationsPerScript >= 0.0) {
+        fprintf(stream, "  \"allocationsPerScript\": %.1f,\n", summary->allocationsPerScript);
+    }
+    else {
+        fputs("  \"allocationsPerScript\": null,\n", stream);
+    }
+    fputs("  \"results\": [", stream);
+    for (size_t i = 0; i < scripts->size(); i++) {
+        const NwnBenchScript& script = (*scripts)[i];
+        // Corpus paths are plain relative file names; only quotes and backslashes need escaping
+        fputs(i == 0 ? "\n    {\"path\": \"" : ",\n    {\"path\": \"", stream);
+        for (size_t c = 0; c < script.path.size(); c++) {
+            if (script.path[c] == '"' || script.path[c] == '\\') {
+                fputc('\\', stream);
+            }
+            fputc(script.path[c], stream);
+        }
+        fprintf(stream, "\", \"sourceBytes\": %u, \"ncsBytes\": %u, \"ms\": %.3f%s}", script.sourceBytes,
+                script.ncsBytes, script.milliseconds, script.failed ? ", \"failed\": true" : "");
+    }
+    fputs(scripts->empty() ? "]\n}\n" : "\n  ]\n}\n", stream);
+}
+
+/**
+ * @brief Find a top-level number field ("key": value) before the results array
+ *
+ * @return 1 if found (null leaves value unchanged), 0 otherwise
+ */
+static int nwnnsscomp_bench_field(const std::string& text, const char* key, double* value)
+{
+    std::string quoted = std::string("\"") + key + "\"";
+    size_t position = text.find(quoted);
+    size_t results = text.find("\"results\"");
+    if (position == std::string::npos || (results != std::string::npos && position > results)) {
+        return 0;
+    }
+    position = text.find(':', position + quoted.size());
+    if (position == std::string::npos) {
+        return 0;
+    }
+    const char* start = text.c_str() + position + 1;
+    while (*start == ' ' || *start == '\t' || *start == '\r' || *start == '\n') {
+        start++;
+    }
+    if (strncmp(start, "null", 4) == 0) {
+        return 1;
+    }
+    char* end;
+    double number = strtod(start, &end);
+    if (end == start) {
+        return 0;
+    }
+    *value = number;
+    return 1;
+}
+
+int nwnnsscomp_read_bench_baseline(const char* path, NwnBenchSummary* baseline)
+{
+    std::string text;
+    if (!nwnnsscomp_bench_read_source(path, &text)) {
+        return 0;
+    }
+    // Machine metrics may be null in a baseline that only fixes the corpus
+    double scripts = 0.0;
+    double failed = 0.0;
+    double iterations = 0.0;
+    double peak = 0.0;
+    memset(baseline, 0, sizeof(*baseline));
+    baseline->allocationsPerScript = -1.0;
+    if (!nwnnsscomp_bench_field(text, "scripts", &scripts) || !nwnnsscomp_bench_field(text, "failed", &failed) ||
+        !nwnnsscomp_bench_field(text, "iterations", &iterations) ||
+        !nwnnsscomp_bench_field(text, "seconds", &baseline->seconds) ||
+        !nwnnsscomp_bench_field(text, "scriptsPerSecond", &baseline->scriptsPerSecond) ||
+        !nwnnsscomp_bench_field(text, "p50Ms", &baseline->p50Milliseconds) ||
+        !nwnnsscomp_bench_field(text, "p99Ms", &baseline->p99Milliseconds) ||
+        !nwnnsscomp_bench_field(text, "peakRssKb", &peak) ||
+        !nwnnsscomp_bench_field(text, "allocationsPerScript", &baseline->allocationsPerScript)) {
+        return 0;
+    }
+    baseline->scripts = (uint32_t)scripts;
+    baseline->failed = (uint32_t)failed;
+    baseline->iterations = (uint32_t)iterations;
+    baseline->peakRssKilobytes = (uint64_t)peak;
+    return 1;
+}
+
+/**
+ * @brief Print one metric and whether it regressed
+ *
+ * @param baseline Baseline value; zero or below (null in the file) is not recorded and not gated
+ * @param higherIsBetter True for throughput, false for latency and memory
+ * @return 1 if the metric regressed, 0 otherwise
+ */
+static uint32_t nwnnsscomp_bench_metric(FILE* stream, const char* name, double current, double baseline,
+                                        double tolerance, bool higherIsBetter)
+{
+    if (baseline <= 0.0) {
+        fprintf(stream, "%-22s %12.3f  baseline %12s\n", name, current, "not recorded");
+        return 0;
+    }
+    double change = (current - baseline) / baseline;
+    bool regressed = higherIsBetter ? change < -tolerance : change > tolerance;
+    fprintf(stream, "%-22s %12.3f  baseline %12.3f  %+7.1f%%  (limit %c%.0f%%)%s\n", name, current, baseline,
+            change * 100.0, higherIsBetter ? '-' : '+', tolerance * 100.0, regressed ? "  REGRESSION" : "");
+    return regressed ? 1 : 0;
+}
+
+uint32_t nwnnsscomp_bench_compare(const NwnBenchSummary* current, const NwnBenchSummary* baseline, FILE* stream)
+{
+    uint32_t regressions = 0;
+    if (current->scripts != baseline->scripts) {
+        fprintf(stream, "%-22s %12u  baseline %12u  REGRESSION (corpus changed)\n", "scripts", current->scripts,
+                baseline->scripts);
+        regressions++;
+    }
+    regressions += nwnnsscomp_bench_metric(stream, "scripts/sec", current->scriptsPerSecond,
+                                           baseline->scriptsPerSecond, NWNNSSCOMP_BENCH_THROUGHPUT_TOLERANCE, true);
+    regressions += nwnnsscomp_bench_metric(stream, "p50 ms", current->p50Milliseconds, baseline->p50Milliseconds,
+                                           NWNNSSCOMP_BENCH_P50_TOLERANCE, false);
+    regressions += nwnnsscomp_bench_metric(stream, "p99 ms", current->p99Milliseconds, baseline->p99Milliseconds,
+                                           NWNNSSCOMP_BENCH_P99_TOLERANCE, false);
+    regressions += nwnnsscomp_bench_metric(stream, "peak RSS KB", (double)current->peakRssKilobytes,
+                                           (double)baseline->peakRssKilobytes, NWNNSSCOMP_BENCH_MEMORY_TOLERANCE,
+                                           false);
+    if (current->allocationsPerScript >= 0.0) {
+        regressions += nwnnsscomp_bench_metric(stream, "allocations/script", current->allocationsPerScript,
+                                               baseline->allocationsPerScript, NWNNSSCOMP_BENCH_MEMORY_TOLERANCE,
+                                               false);
+    }
+    if (current->failed > baseline->failed) {
+        fprintf(stream, "%-22s %12u  baseline %12u  REGRESSION\n", "failed scripts", current->failed,
+                baseline->failed);
+        regressions++;
+    }
+    return regressions;
+}
@@ -0,0 +1,118 @@
+// ============================================================================
+// NWNNSSCOMP COMPILE BENCHMARK
+// ============================================================================
+// Compiles every .nss file of a corpus directory a fixed number of times,
+// one script at a time, and reports throughput (scripts per second), the
+// p50/p99 latency over every compile, peak resident set size and heap
+// allocations per script. The corpus is fixed: bench/corpus holds
+// synthetic scripts of graded sizes from scripts/generate_nss_corpus.py
+// with a fixed seed (see bench/README.md).
+//
+// The result can be written as JSON and checked in as a baseline; a later
+// run compared against that baseline reports every metric that got worse
+// by more than its tolerance, so a slowdown fails the run instead of
+// showing up in production builds. Wall-clock metrics get wider
+// tolerances than the memory metrics, which are close to deterministic.
+// A changed script count or more failed scripts always fails; a machine
+// metric the baseline leaves null is printed but not gated.
+//
+// Allocations are counted by replacing the global operator new and
+// operator delete (plain and sized) while NWNNSSCOMP_BENCH_COUNT_ALLOCATIONS
+// is nonzero. They are only meaningful for in-process compile tools, which
+// nwnnsscomp -Y uses; external commands run in a child process, whose peak
+// RSS is still reported (RUSAGE_CHILDREN).
+// ============================================================================
+
+#ifndef NWNNSSCOMP_BENCH_H
+#define NWNNSSCOMP_BENCH_H
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "nwnnsscomp_roundtrip.h"
+
+#ifndef NWNNSSCOMP_BENCH_COUNT_ALLOCATIONS
+#define NWNNSSCOMP_BENCH_COUNT_ALLOCATIONS  1  // Replace operator new to count allocations
+#endif
+
+#define NWNNSSCOMP_BENCH_DEFAULT_ITERATIONS    5     // Timed passes over the corpus
+#define NWNNSSCOMP_BENCH_THROUGHPUT_TOLERANCE  0.10  // Allowed drop in scripts per second
+#define NWNNSSCOMP_BENCH_P50_TOLERANCE         0.10  // Allowed rise in median latency
+#define NWNNSSCOMP_BENCH_P99_TOLERANCE         0.25  // Allowed rise in tail latency
+#define NWNNSSCOMP_BENCH_MEMORY_TOLERANCE      0.05  // Allowed rise in peak RSS and allocations per script
+
+typedef struct NwnBenchOptions
+{
+    uint32_t iterations;               // Timed passes (0 = NWNNSSCOMP_BENCH_DEFAULT_ITERATIONS)
+    uint32_t warmup;                   // Untimed passes before the first timed one
+    bool countAllocations;             // Report allocations (in-process tools only)
+} NwnBenchOptions;
+
+typedef struct NwnBenchScript
+{
+    std::string path;                  // Relative to the corpus directory
+    uint32_t sourceBytes;
+    uint32_t ncsBytes;                 // Compiled size (0 if the compile failed)
+    bool failed;
+    double milliseconds;               // Median over the timed passes
+} NwnBenchScript;
+
+typedef struct NwnBenchSummary
+{
+    uint32_t scripts;
+    uint32_t failed;                   // Scripts whose compile failed
+    uint32_t iterations;
+    double seconds;                    // Wall time of the timed passes
+    double scriptsPerSecond;
+    double p50Milliseconds;            // Over every timed compile
+    double p99Milliseconds;
+    uint64_t peakRssKilobytes;         // Largest of this process and its children
+    double allocationsPerScript;       // -1 when not counted
+} NwnBenchSummary;
+
+/**
+ * @brief Benchmark the compiler over every .nss file below a directory
+ *
+ * @param directory Corpus directory (searched recursively)
+ * @param tools Compiler (decompile is not used)
+ * @param options Passes and allocation counting
+ * @param scripts Receives one entry per script, in corpus order
+ * @param summary Receives the aggregate metrics
+ * @return 1 if the corpus was read and holds at least one script, 0 otherwise
+ */
+int nwnnsscomp_bench_corpus(const char* directory, const NwnRoundtripTools* tools, const NwnBenchOptions* options,
+                            std::vector<NwnBenchScript>* scripts, NwnBenchSummary* summary);
+
+/**
+ * @brief Heap allocations made so far by this process (0 when not counted)
+ */
+uint64_t nwnnsscomp_bench_allocations();
+
+/**
+ * @brief Write the summary and every script as one JSON object (the baseline format)
+ */
+void nwnnsscomp_write_bench_json(const std::vector<NwnBenchScript>* scripts, const NwnBenchSummary* summary,
+                                 FILE* stream);
+
+/**
+ * @brief Read the summary of a JSON file written by nwnnsscomp_write_bench_json
+ *
+ * @return 1 on success, 0 if the file cannot be read or lacks a summary field
+ */
+int nwnnsscomp_read_bench_baseline(const char* path, NwnBenchSummary* baseline);
+
+/**
+ * @brief Compare a run against a baseline, printing one line per metric
+ *
+ * A metric regresses when it is worse than the baseline by more than its
+ * tolerance; a different script count or more failed scripts than the
+ * baseline is always a regression. Metrics the baseline does not record
+ * (null, read as zero or below) are printed but not gated.
+ *
+ * @return Number of regressed metrics
+ */
+uint32_t nwnnsscomp_bench_compare(const NwnBenchSummary* current, const NwnBenchSummary* baseline, FILE* stream);
+
+#endif // NWNNSSCOMP_BENCH_H
@@ -0,0 +1,623 @@
+// ============================================================================
+// NWNNSSCOMP STRUCTURAL BYTECODE DIFF
+// ============================================================================
+
+#include "nwnnsscomp_diff.h"
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "nwnnsscomp_disasm.h"
+#include "nwnnsscomp_roundtrip.h"
+
+#define NWNNSSCOMP_DIFF_FNV_BASIS  0xcbf29ce484222325ULL
+#define NWNNSSCOMP_DIFF_FNV_PRIME  0x100000001b3ULL
+
+typedef struct NwnDiffFunction
+{
+    uint32_t first;                    // First instruction index
+    uint32_t last;                     // One past the last instruction index
+    uint64_t hash;                     // Body hash (relative jumps, JSR targets left out)
+    std::string name;                  // "_start" or "sub_XXXXXXXX"
+} NwnDiffFunction;
+
+typedef struct NwnDiffSide
+{
+    const NcsProgram* program;
+    std::vector<uint64_t> tokens;      // Per-instruction hash, jump targets left out
+    std::vector<NwnDiffFunction> functions;
+    std::vector<uint32_t> functionOf;  // Function index per instruction
+} NwnDiffSide;
+
+// ============================================================================
+// HASHING
+// ============================================================================
+
+static inline uint64_t nwnnsscomp_diff_mix(uint64_t hash, uint64_t value)
+{
+    for (int i = 0; i < 8; i++) {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= NWNNSSCOMP_DIFF_FNV_PRIME;
+    }
+    return hash;
+}
+
+static uint64_t nwnnsscomp_instruction_token(const NcsInstruction* instruction)
+{
+    uint64_t hash = nwnnsscomp_diff_mix(NWNNSSCOMP_DIFF_FNV_BASIS,
+                                        instruction->opcode | ((uint64_t)instruction->qualifier << 8));
+    if (ncs_is_jump(instruction->opcode)) {
+        return hash;
+    }
+    hash = nwnnsscomp_diff_mix(hash, (uint32_t)instruction->arg0 | ((uint64_t)(uint32_t)instruction->arg1 << 32));
+    hash = nwnnsscomp_diff_mix(hash, (uint32_t)instruction->arg2 | ((uint64_t)instruction->text.size() << 32));
+    for (size_t i = 0; i < instruction->text.size(); i++) {
+        hash ^= (uint8_t)instruction->text[i];
+        hash *= NWNNSSCOMP_DIFF_FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Whether two instructions match exactly, jump targets aside
+ */
+static bool nwnnsscomp_same_operands(const NcsInstruction* a, const NcsInstruction* b)
+{
+    if (a->opcode != b->opcode || a->qualifier != b->qualifier) {
+        return false;
+    }
+    return ncs_is_jump(a->opcode) ||
+           (a->arg0 == b->arg0 && a->arg1 == b->arg1 && a->arg2 == b->arg2 && a->text == b->text);
+}
+
+/**
+ * @brief Tokenize a program and split it at the program start and every JSR target
+ */
+static void nwnnsscomp_diff_prepare(const NcsProgram* program, NwnDiffSide* side)
+{
+    const std::vector<NcsInstruction>& instructions = program->instructions;
+    side->program = program;
+    side->tokens.resize(instructions.size());
+    side->functionOf.resize(instructions.size());
+    side->functions.clear();
+
+    std::vector<uint8_t> entries(instructions.size(), 0);
+    if (!instructions.empty()) {
+        entries[0] = 1;
+    }
+    for (size_t i = 0; i < instructions.size(); i++) {
+        side->tokens[i] = nwnnsscomp_instruction_token(&instructions[i]);
+        if (instructions[i].opcode == NCS_OP_JSR && instructions[i].jumpTarget >= 0) {
+            entries[instructions[i].jumpTarget] = 1;
+        }
+    }
+
+    for (size_t i = 0; i < instructions.size(); i++) {
+        if (entries[i]) {
+            NwnDiffFunction function;
+            char name[32];
+            if (i == 0) {
+                snprintf(name, sizeof(name), "_start");
+            }
+            else {
+                snprintf(name, sizeof(name), "sub_%08X", instructions[i].offset);
+            }
+            function.name = name;
+            function.first = (uint32_t)i;
+            function.last = (uint32_t)i;
+            function.hash = NWNNSSCOMP_DIFF_FNV_BASIS;
+            side->functions.push_back(function);
+        }
+        side->functionOf[i] = (uint32_t)side->functions.size() - 1;
+        side->functions.back().last = (uint32_t)i + 1;
+    }
+
+    for (size_t f = 0; f < side->functions.size(); f++) {
+        NwnDiffFunction& function = side->functions[f];
+        uint64_t hash = NWNNSSCOMP_DIFF_FNV_BASIS;
+        for (uint32_t i = function.first; i < function.last; i++) {
+            hash = nwnnsscomp_diff_mix(hash, side->tokens[i]);
+            const NcsInstruction& instruction = instructions[i];
+            if (instruction.jumpTarget >= 0 && instruction.opcode != NCS_OP_JSR) {
+                bool inside = (uint32_t)instruction.jumpTarget >= function.first &&
+                              (uint32_t)instruction.jumpTarget < function.last;
+                hash = nwnnsscomp_diff_mix(hash, inside ? (uint64_t)(instruction.jumpTarget - function.first)
+                                                        : ~0ULL);
+            }
+        }
+        function.hash = hash;
+    }
+}
+
+// ============================================================================
+// ALIGNMENT
+// ============================================================================
+
+/**
+ * @brief Myers diff of two hash sequences
+ *
+ * Common prefix and suffix are matched first. If the middle needs more
+ * than NWNNSSCOMP_DIFF_MAX_TRACE trace cells it is left unmatched.
+ *
+ * @param match Receives, for each element of a, the index it matches in b or -1
+ */
+static void nwnnsscomp_align(const uint64_t* a, size_t n, const uint64_t* b, size_t m, std::vector<int32_t>* match)
+{
+    match->assign(n, -1);
+    size_t prefix = 0;
+    while (prefix < n && prefix < m && a[prefix] == b[prefix]) {
+        (*match)[prefix] = (int32_t)prefix;
+        prefix++;
+    }
+    size_t suffix = 0;
+    while (suffix < n - prefix && suffix < m - prefix && a[n - 1 - suffix] == b[m - 1 - suffix]) {
+        (*match)[n - 1 - suffix] = (int32_t)(m - 1 - suffix);
+        suffix++;
+    }
+    const int32_t rows = (int32_t)(n - prefix - suffix);
+    const int32_t columns = (int32_t)(m - prefix - suffix);
+    if (rows == 0 || columns == 0) {
+        return;
+    }
+    a += prefix;
+    b += prefix;
+
+    // v[k] = furthest x on diagonal k; trace[d] keeps v before step d over k in [-d-1, d+1]
+    const int32_t maxD = rows + columns;
+    std::vector<int32_t> v(2 * (size_t)maxD + 3, 0);
+    const int32_t center = maxD + 1;
+    std::vector<std::vector<int32_t> > trace;
+    size_t cells = 0;
+    int32_t found = -1;
+    for (int32_t d = 0; d <= maxD && found < 0; d++) {
+        cells += 2 * (size_t)d + 3;
+        if (cells > NWNNSSCOMP_DIFF_MAX_TRACE) {
+            return;
+        }
+        trace.push_back(std::vector<int32_t>(v.begin() + (center - d - 1), v.begin() + (center + d + 2)));
+        for (int32_t k = -d; k <= d; k += 2) {
+            int32_t x = (k == -d || (k != d && v[center + k - 1] < v[center + k + 1])) ? v[center + k + 1]
+                                                                                      : v[center + k - 1] + 1;
+            int32_t y = x - k;
+            while (x < rows && y < columns && a[x] == b[y]) {
+                x++;
+                y++;
+            }
+            v[center + k] = x;
+            if (x >= rows && y >= columns) {
+                found = d;
+                break;
+            }
+        }
+    }
+
+    int32_t x = rows;
+    int32_t y = columns;
+    for (int32_t d = found; d > 0; d--) {
+        const std::vector<int32_t>& previous = trace[d];
+        int32_t k = x - y;
+        // previous[k + d + 1] is v[k] before step d
+        int32_t previousK = (k == -d || (k != d && previous[k - 1 + d + 1] < previous[k + 1 + d + 1])) ? k + 1
+                                                                                                       : k - 1;
+        int32_t previousX = previous[previousK + d + 1];
+        int32_t previousY = previousX - previousK;
+        while (x > previousX && y > previousY) {
+            x--;
+            y--;
+            (*match)[prefix + x] = (int32_t)(prefix + y);
+        }
+        x = previousX;
+        y = previousY;
+    }
+    while (x > 0 && y > 0) {
+        x--;
+        y--;
+        (*match)[prefix + x] = (int32_t)(prefix + y);
+    }
+}
+
+/**
+ * @brief Pair subroutines: equal hashes by alignment, the rest in order between them
+ */
+static void nwnnsscomp_pair_functions(const NwnDiffSide* a, const NwnDiffSide* b, std::vector<int32_t>* pairA)
+{
+    std::vector<uint64_t> hashesA(a->functions.size());
+    std::vector<uint64_t> hashesB(b->functions.size());
+    for (size_t i = 0; i < hashesA.size(); i++) {
+        hashesA[i] = a->functions[i].hash;
+    }
+    for (size_t i = 0; i < hashesB.size(); i++) {
+        hashesB[i] = b->functions[i].hash;
+    }
+    nwnnsscomp_align(hashesA.data(), hashesA.size(), hashesB.data(), hashesB.size(), pairA);
+
+    size_t nextB = 0;
+    size_t i = 0;
+    while (i < pairA->size()) {
+        if ((*pairA)[i] >= 0) {
+            nextB = (size_t)(*pairA)[i] + 1;
+            i++;
+            continue;
+        }
+        // Gap: unmatched A functions up to the next match, unmatched B functions before it
+        size_t gapEnd = i;
+        while (gapEnd < pairA->size() && (*pairA)[gapEnd] < 0) {
+            gapEnd++;
+        }
+        size_t limitB = gapEnd < pairA->size() ? (size_t)(*pairA)[gapEnd] : hashesB.size();
+        for (; i < gapEnd && nextB < limitB; i++, nextB++) {
+            (*pairA)[i] = (int32_t)nextB;
+        }
+        i = gapEnd;
+    }
+}
+
+// ============================================================================
+// OUTPUT
+// ============================================================================
+
+static void nwnnsscomp_format_instruction(const NcsProgram* program, size_t index, std::string* out)
+{
+    const NcsInstruction& instruction = program->instructions[index];
+    char text[64];
+    ncs_format_mnemonic(instruction.opcode, instruction.qualifier, text, sizeof(text));
+    out->append(text);
+
+    switch (instruction.opcode) {
+        case NCS_OP_JMP: case NCS_OP_JSR: case NCS_OP_JZ: case NCS_OP_JNZ:
+            snprintf(text, sizeof(text), " %08x",
+                     instruction.jumpTarget >= 0 ? program->instructions[instruction.jumpTarget].offset : 0u);
+            out->append(text);
+            return;
+        case NCS_OP_CONST:
+            if (instruction.qualifier == NCS_Q_STRING) {
+                out->append(" \"");
+                out->append(instruction.text);
+                out->append("\"");
+            }
+            else if (instruction.qualifier == NCS_Q_FLOAT) {
+                float value;
+                memcpy(&value, &instruction.arg0, sizeof(value));
+                snprintf(text, sizeof(text), " %.9g", value);
+                out->append(text);
+            }
+            else {
+                snprintf(text, sizeof(text), " %d", instruction.arg0);
+                out->append(text);
+            }
+            return;
+        case NCS_OP_CPDOWNSP: case NCS_OP_CPTOPSP: case NCS_OP_CPDOWNBP: case NCS_OP_CPTOPBP:
+        case NCS_OP_ACTION: case NCS_OP_STORE_STATE:
+            snprintf(text, sizeof(text), " %d, %d", instruction.arg0, instruction.arg1);
+            out->append(text);
+            return;
+        case NCS_OP_DESTRUCT:
+            snprintf(text, sizeof(text), " %d, %d, %d", instruction.arg0, instruction.arg1, instruction.arg2);
+            out->append(text);
+            return;
+        case NCS_OP_MOVSP: case NCS_OP_DECSP: case NCS_OP_INCSP: case NCS_OP_DECBP: case NCS_OP_INCBP:
+            snprintf(text, sizeof(text), " %d", instruction.arg0);
+            out->append(text);
+            return;
+        case NCS_OP_EQUAL: case NCS_OP_NEQUAL:
+            if (instruction.qualifier == NCS_Q_STRUCT_STRUCT) {
+                snprintf(text, sizeof(text), " %d", instruction.arg0);
+                out->append(text);
+            }
+            return;
+        default:
+            return;
+    }
+}
+
+typedef struct NwnDiffOutput
+{
+    FILE* stream;
+    const char* nameA;
+    const char* nameB;
+    bool fileHeader;                   // "---/+++" already written
+    std::string hunk;                  // Hunk header waiting for its first difference
+    std::string line;
+} NwnDiffOutput;
+
+static void nwnnsscomp_diff_line(NwnDiffOutput* output, const std::string& line)
+{
+    if (output->stream == NULL) {
+        return;
+    }
+    if (!output->fileHeader) {
+        fprintf(output->stream, "--- %s\n+++ %s\n", output->nameA, output->nameB);
+        output->fileHeader = true;
+    }
+    if (!output->hunk.empty()) {
+        fputs(output->hunk.c_str(), output->stream);
+        output->hunk.clear();
+    }
+    fputs(line.c_str(), output->stream);
+}
+
+static void nwnnsscomp_diff_removed(NwnDiffOutput* output, const NwnDiffSide* side, uint32_t index, char sign)
+{
+    char prefix[16];
+    snprintf(prefix, sizeof(prefix), "%c%08x ", sign, side->program->instructions[index].offset);
+    output->line = prefix;
+    nwnnsscomp_format_instruction(side->program, index, &output->line);
+    output->line.push_back('\n');
+    nwnnsscomp_diff_line(output, output->line);
+}
+
+/**
+ * @brief Report the differences of one subroutine pair
+ *
+ * @return Number of differences
+ */
+static uint32_t nwnnsscomp_diff_pair(NwnDiffOutput* output, const NwnDiffSide* a, const NwnDiffSide* b,
+                                     uint32_t functionA, uint32_t functionB, const std::vector<int32_t>& match,
+                                     const std::vector<int32_t>& pairA, NwnDiffStats* stats)
+{
+    const NwnDiffFunction& fa = a->functions[functionA];
+    const NwnDiffFunction& fb = b->functions[functionB];
+    output->hunk = "@@ " + fa.name + " -> " + fb.name + " @@\n";
+    uint32_t differences = 0;
+
+    uint32_t i = fa.first;
+    uint32_t j = fb.first;
+    while (i < fa.last || j < fb.last) {
+        if (i < fa.last && (match[i] < 0 || (uint32_t)match[i] >= fb.last)) {
+            nwnnsscomp_diff_removed(output, a, i++, '-');
+            stats->removedInstructions++;
+            differences++;
+            continue;
+        }
+        if (j < fb.last && (i >= fa.last || j < (uint32_t)match[i])) {
+            nwnnsscomp_diff_removed(output, b, j++, '+');
+            stats->addedInstructions++;
+            differences++;
+            continue;
+        }
+
+        const NcsInstruction& ia = a->program->instructions[i];
+        const NcsInstruction& ib = b->program->instructions[j];
+        if (!nwnnsscomp_same_operands(&ia, &ib)) {
+            // Token hash collision: report it as a replacement
+            nwnnsscomp_diff_removed(output, a, i, '-');
+            nwnnsscomp_diff_removed(output, b, j, '+');
+            stats->removedInstructions++;
+            stats->addedInstructions++;
+            differences += 2;
+        }
+        else if (ncs_is_jump(ia.opcode) && ia.jumpTarget >= 0 && ib.jumpTarget >= 0) {
+            bool same;
+            if (ia.opcode == NCS_OP_JSR) {
+                same = pairA[a->functionOf[ia.jumpTarget]] == (int32_t)b->functionOf[ib.jumpTarget];
+            }
+            else {
+                same = match[ia.jumpTarget] == ib.jumpTarget;
+            }
+            if (!same) {
+                char text[128];
+                char mnemonic[32];
+                ncs_format_mnemonic(ia.opcode, ia.qualifier, mnemonic, sizeof(mnemonic));
+                snprintf(text, sizeof(text), "~%08x %08x %s %08x -> %08x\n", ia.offset, ib.offset, mnemonic,
+                         a->program->instructions[ia.jumpTarget].offset,
+                         b->program->instructions[ib.jumpTarget].offset);
+                nwnnsscomp_diff_line(output, text);
+                stats->retargetedJumps++;
+                differences++;
+            }
+        }
+        i++;
+        j++;
+    }
+    output->hunk.clear();
+    return differences;
+}
+
+uint32_t nwnnsscomp_diff_programs(const NcsProgram* a, const NcsProgram* b, const char* nameA, const char* nameB,
+                                  FILE* stream, NwnDiffStats* stats)
+{
+    NwnDiffStats localStats;
+    if (stats == NULL) {
+        stats = &localStats;
+    }
+    memset(stats, 0, sizeof(*stats));
+
+    NwnDiffSide sideA;
+    NwnDiffSide sideB;
+    nwnnsscomp_diff_prepare(a, &sideA);
+    nwnnsscomp_diff_prepare(b, &sideB);
+    stats->functionsA = (uint32_t)sideA.functions.size();
+    stats->functionsB = (uint32_t)sideB.functions.size();
+
+    std::vector<int32_t> pairA;
+    nwnnsscomp_pair_functions(&sideA, &sideB, &pairA);
+
+    // Instruction alignment of every pair, kept program-wide so jumps can be checked across it
+    std::vector<int32_t> match(a->instructions.size(), -1);
+    std::vector<int32_t> local;
+    for (size_t f = 0; f < pairA.size(); f++) {
+        if (pairA[f] < 0) {
+            continue;
+        }
+        const NwnDiffFunction& fa = sideA.functions[f];
+        const NwnDiffFunction& fb = sideB.functions[pairA[f]];
+        nwnnsscomp_align(sideA.tokens.data() + fa.first, fa.last - fa.first, sideB.tokens.data() + fb.first,
+                         fb.last - fb.first, &local);
+        for (size_t i = 0; i < local.size(); i++) {
+            match[fa.first + i] = local[i] < 0 ? -1 : (int32_t)fb.first + local[i];
+        }
+    }
+
+    NwnDiffOutput output;
+    output.stream = stream;
+    output.nameA = nameA;
+    output.nameB = nameB;
+    output.fileHeader = false;
+    uint32_t differences = 0;
+    char text[128];
+
+    size_t nextB = 0;
+    for (size_t f = 0; f <= pairA.size(); f++) {
+        size_t limitB = f < pairA.size() ? (pairA[f] >= 0 ? (size_t)pairA[f] : nextB) : sideB.functions.size();
+        for (; nextB < limitB; nextB++) {
+            const NwnDiffFunction& fb = sideB.functions[nextB];
+            snprintf(text, sizeof(text), "@@ +%s (%u instructions) @@\n", fb.name.c_str(), fb.last - fb.first);
+            nwnnsscomp_diff_line(&output, text);
+            stats->addedFunctions++;
+            differences++;
+        }
+        if (f == pairA.size()) {
+            break;
+        }
+        if (pairA[f] < 0) {
+            const NwnDiffFunction& fa = sideA.functions[f];
+            snprintf(text, sizeof(text), "@@ -%s (%u instructions) @@\n", fa.name.c_str(), fa.last - fa.first);
+            nwnnsscomp_diff_line(&output, text);
+            stats->removedFunctions++;
+            differences++;
+            continue;
+        }
+        uint32_t pairDifferences = nwnnsscomp_diff_pair(&output, &sideA, &sideB, (uint32_t)f, (uint32_t)pairA[f],
+                                                        match, pairA, stats);
+        if (pairDifferences == 0) {
+            stats->identicalFunctions++;
+        }
+        else {
+            stats->changedFunctions++;
+        }
+        differences += pairDifferences;
+        nextB = (size_t)pairA[f] + 1;
+    }
+    return differences;
+}
+
+// ============================================================================
+// FILES
+// ============================================================================
+
+static void nwnnsscomp_add_diff_stats(NwnDiffStats* total, const NwnDiffStats* stats)
+{
+    total->functionsA += stats->functionsA;
+    total->functionsB += stats->functionsB;
+    total->identicalFunctions += stats->identicalFunctions;
+    total->changedFunctions += stats->changedFunctions;
+    total->removedFunctions += stats->removedFunctions;
+    total->addedFunctions += stats->addedFunctions;
+    total->removedInstructions += stats->removedInstructions;
+    total->addedInstructions += stats->addedInstructions;
+    total->retargetedJumps += stats->retargetedJumps;
+}
+
+/**
+ * @brief Diff two mapped files
+ *
+ * @return 1 if they differ, 0 if not, -1 if either does not decode
+ */
+static int nwnnsscomp_diff_mapped(const NwnMappedFile* fileA, const NwnMappedFile* fileB, const char* nameA,
+                                  const char* nameB, FILE* stream, NwnDiffStats* total)
+{
+    if (fileA->size == fileB->size && (fileA->size == 0 || memcmp(fileA->data, fileB->data, fileA->size) == 0)) {
+        return 0;
+    }
+    NcsProgram a;
+    NcsProgram b;
+    int resultA = ncs_decode_program(fileA->data, fileA->size, &a);
+    int resultB = ncs_decode_program(fileB->data, fileB->size, &b);
+    if (resultA != NCS_OK || resultB != NCS_OK) {
+        fprintf(stream, "!!! %s: %s\n", resultA != NCS_OK ? nameA : nameB,
+                ncs_result_string(resultA != NCS_OK ? resultA : resultB));
+        return -1;
+    }
+    NwnDiffStats stats;
+    uint32_t differences = nwnnsscomp_diff_programs(&a, &b, nameA, nameB, stream, &stats);
+    if (total != NULL) {
+        nwnnsscomp_add_diff_stats(total, &stats);
+    }
+    return differences != 0 ? 1 : 0;
+}
+
+/**
+ * @brief Whether a corpus path names a compiled script
+ */
+static bool nwnnsscomp_is_ncs_path(const std::string& path)
+{
+    return path.size() >= 4 &&
+           (path.compare(path.size() - 4, 4, ".ncs") == 0 || path.compare(path.size() - 4, 4, ".NCS") == 0);
+}
+
+int nwnnsscomp_diff_paths(const char* pathA, const char* pathB, FILE* stream, NwnDiffStats* stats)
+{
+    if (stats != NULL) {
+        memset(stats, 0, sizeof(*stats));
+    }
+
+    NwnMappedFile fileA;
+    NwnMappedFile fileB;
+    if (nwnnsscomp_map_file(pathA, &fileA)) {
+        if (!nwnnsscomp_map_file(pathB, &fileB)) {
+            nwnnsscomp_unmap_file(&fileA);
+            return -1;
+        }
+        int result = nwnnsscomp_diff_mapped(&fileA, &fileB, pathA, pathB, stream, stats);
+        nwnnsscomp_unmap_file(&fileA);
+        nwnnsscomp_unmap_file(&fileB);
+        return result;
+    }
+
+    std::vector<std::string> listA;
+    std::vector<std::string> listB;
+    if (!nwnnsscomp_list_corpus(pathA, &listA) || !nwnnsscomp_list_corpus(pathB, &listB)) {
+        return -1;
+    }
+
+    // Both lists are sorted: walk them together
+    int differing = 0;
+    std::string rootA = pathA;
+    std::string rootB = pathB;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < listA.size() || j < listB.size()) {
+        if (i < listA.size() && !nwnnsscomp_is_ncs_path(listA[i])) {
+            i++;
+            continue;
+        }
+        if (j < listB.size() && !nwnnsscomp_is_ncs_path(listB[j])) {
+            j++;
+            continue;
+        }
+        if (j >= listB.size() || (i < listA.size() && listA[i] < listB[j])) {
+            fprintf(stream, "Only in %s: %s\n", pathA, listA[i++].c_str());
+            differing++;
+            continue;
+        }
+        if (i >= listA.size() || listB[j] < listA[i]) {
+            fprintf(stream, "Only in %s: %s\n", pathB, listB[j++].c_str());
+            differing++;
+            continue;
+        }
+
+        std::string nameA = rootA + "/" + listA[i];
+        std::string nameB = rootB + "/" + listB[j];
+        i++;
+        j++;
+        if (!nwnnsscomp_map_file(nameA.c_str(), &fileA)) {
+            fprintf(stream, "!!! %s: cannot read\n", nameA.c_str());
+            differing++;
+            continue;
+        }
+        if (!nwnnsscomp_map_file(nameB.c_str(), &fileB)) {
+            nwnnsscomp_unmap_file(&fileA);
+            fprintf(stream, "!!! %s: cannot read\n", nameB.c_str());
+            differing++;
+            continue;
+        }
+        if (nwnnsscomp_diff_mapped(&fileA, &fileB, nameA.c_str(), nameB.c_str(), stream, stats) != 0) {
+            differing++;
+        }
+        nwnnsscomp_unmap_file(&fileA);
+        nwnnsscomp_unmap_file(&fileB);
+    }
+    return differing;
+}
@@ -0,0 +1,74 @@
+// ============================================================================
+// NWNNSSCOMP STRUCTURAL BYTECODE DIFF
+// ============================================================================
+// Compares two compiled scripts instruction by instruction instead of byte
+// by byte, so one inserted instruction does not turn every later jump into
+// a difference.
+//
+// Both programs are split into subroutines (the program start and every
+// JSR target). Each subroutine is hashed over its instructions, with jump
+// targets taken relative to the subroutine and JSR targets left out, and
+// the two subroutine sequences are aligned on those hashes; unmatched
+// subroutines between two aligned ones are paired in order. Within a pair,
+// instructions are aligned on per-instruction hashes (operands included,
+// jump targets excluded) with a Myers diff, and a jump that aligns with a
+// jump is reported only if its target does not align with the other's
+// target (JSR targets: with the paired subroutine).
+//
+// Output lists only the differences, one hunk per subroutine pair:
+//   @@ sub_0000002A -> sub_0000002E @@
+//   -0000003a CONSTI 1
+//   +0000003e CONSTI 2
+//   ~00000040 00000044 JZ 0000005a -> 00000060
+// ============================================================================
+
+#ifndef NWNNSSCOMP_DIFF_H
+#define NWNNSSCOMP_DIFF_H
+
+#include <stdio.h>
+
+#include "ncs_bytecode.h"
+
+#define NWNNSSCOMP_DIFF_MAX_TRACE  (1u << 24)  // Myers trace cells per subroutine before giving up on alignment
+
+typedef struct NwnDiffStats
+{
+    uint32_t functionsA;               // Subroutines in the first program
+    uint32_t functionsB;               // Subroutines in the second program
+    uint32_t identicalFunctions;       // Pairs without any difference
+    uint32_t changedFunctions;         // Pairs with at least one difference
+    uint32_t removedFunctions;         // Subroutines only in the first program
+    uint32_t addedFunctions;           // Subroutines only in the second program
+    uint32_t removedInstructions;      // "-" lines
+    uint32_t addedInstructions;        // "+" lines
+    uint32_t retargetedJumps;          // "~" lines
+} NwnDiffStats;
+
+/**
+ * @brief Diff two decoded programs
+ *
+ * @param a First program
+ * @param b Second program
+ * @param nameA Name printed for the first program
+ * @param nameB Name printed for the second program
+ * @param stream Output stream, or NULL to only count
+ * @param stats Receives the counts (may be NULL)
+ * @return Number of differences (0 when the programs are equivalent)
+ */
+uint32_t nwnnsscomp_diff_programs(const NcsProgram* a, const NcsProgram* b, const char* nameA, const char* nameB,
+                                  FILE* stream, NwnDiffStats* stats);
+
+/**
+ * @brief Diff two .ncs files, or every same-named .ncs pair below two directories
+ *
+ * Byte-identical files are skipped without decoding.
+ *
+ * @param pathA First file or directory
+ * @param pathB Second file or directory
+ * @param stream Output stream
+ * @param stats Receives the counts summed over every pair (may be NULL)
+ * @return Number of differing file pairs, or -1 if an input cannot be read or decoded
+ */
+int nwnnsscomp_diff_paths(const char* pathA, const char* pathB, FILE* stream, NwnDiffStats* stats);
+
+#endif // NWNNSSCOMP_DIFF_H
@@ -0,0 +1,679 @@
+// ============================================================================
+// NWNNSSCOMP DISASSEMBLER
+// ============================================================================
+// The decoder looks up each opcode byte in a 256-entry layout table and
+// each opcode/qualifier pair in a table of preformatted mnemonics, so the
+// inner loop is a table load, a bounds check and a few appends. Jump
+// targets are printed as computed and not checked against instruction
+// boundaries (ncs_decode_program does that for tools that need it).
+// ============================================================================
+
+#include "nwnnsscomp_disasm.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <vector>
+
+#include "nwnnsscomp_roundtrip.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// MAPPED FILES
+// ============================================================================
+
+int nwnnsscomp_map_file(const char* path, NwnMappedFile* file)
+{
+    file->data = NULL;
+    file->size = 0;
+#if defined(_WIN32)
+    file->fileHandle = NULL;
+    file->mappingHandle = NULL;
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size)) {
+        CloseHandle(handle);
+        return 0;
+    }
+    file->fileHandle = handle;
+    if (size.QuadPart == 0) {
+        return 1;
+    }
+    HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) {
+        CloseHandle(handle);
+        file->fileHandle = NULL;
+        return 0;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == NULL) {
+        CloseHandle(mapping);
+        CloseHandle(handle);
+        file->fileHandle = NULL;
+        return 0;
+    }
+    file->mappingHandle = mapping;
+    file->data = (const uint8_t*)view;
+    file->size = (size_t)size.QuadPart;
+    return 1;
+#else
+    file->descriptor = open(path, O_RDONLY);
+    if (file->descriptor < 0) {
+        return 0;
+    }
+    struct stat info;
+    if (fstat(file->descriptor, &info) != 0 || !S_ISREG(info.st_mode)) {
+        close(file->descriptor);
+        file->descriptor = -1;
+        return 0;
+    }
+    if (info.st_size == 0) {
+        return 1;
+    }
+    void* view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file->descriptor, 0);
+    if (view == MAP_FAILED) {
+        close(file->descriptor);
+        file->descriptor = -1;
+        return 0;
+    }
+#if defined(MADV_SEQUENTIAL)
+    madvise(view, (size_t)info.st_size, MADV_SEQUENTIAL);
+#endif
+    file->data = (const uint8_t*)view;
+    file->size = (size_t)info.st_size;
+    return 1;
+#endif
+}
+
+void nwnnsscomp_unmap_file(NwnMappedFile* file)
+{
+#if defined(_WIN32)
+    if (file->data != NULL) {
+        UnmapViewOfFile(file->data);
+    }
+    if (file->mappingHandle != NULL) {
+        CloseHandle((HANDLE)file->mappingHandle);
+    }
+    if (file->fileHandle != NULL) {
+        CloseHandle((HANDLE)file->fileHandle);
+    }
+    file->fileHandle = NULL;
+    file->mappingHandle = NULL;
+#else
+    if (file->data != NULL) {
+        munmap((void*)file->data, file->size);
+    }
+    if (file->descriptor >= 0) {
+        close(file->descriptor);
+    }
+    file->descriptor = -1;
+#endif
+    file->data = NULL;
+    file->size = 0;
+}
+
+// ============================================================================
+// DECODER TABLES
+// ============================================================================
+
+enum NwnDisasmLayout
+{
+    NWN_LAYOUT_INVALID = 0,            // Not an NCSByteCode opcode
+    NWN_LAYOUT_NONE,                   // No operands
+    NWN_LAYOUT_STACK_COPY,             // int32 offset, uint16 size
+    NWN_LAYOUT_CONST,                  // int32, float bits, or uint16 length + text
+    NWN_LAYOUT_ACTION,                 // uint16 routine, uint8 argument count
+    NWN_LAYOUT_OFFSET,                 // int32 stack offset
+    NWN_LAYOUT_JUMP,                   // int32 offset relative to the instruction
+    NWN_LAYOUT_DESTRUCT,               // uint16 size, int16 keep offset, uint16 keep size
+    NWN_LAYOUT_STORE_STATE,            // uint32 BP bytes, uint32 SP bytes
+    NWN_LAYOUT_EQUAL                   // uint16 struct size for the TT qualifier
+};
+
+#define NWN_DISASM_MNEMONIC_MAX 16
+
+typedef struct NwnDisasmTables
+{
+    uint8_t layout[256];                                            // NwnDisasmLayout per opcode byte
+    char mnemonic[NCS_OP_COUNT][256][NWN_DISASM_MNEMONIC_MAX];      // Per opcode and qualifier
+    uint8_t mnemonicLength[NCS_OP_COUNT][256];
+} NwnDisasmTables;
+
+static NwnDisasmTables g_disasmTables;
+
+static bool nwnnsscomp_build_disasm_tables()
+{
+    memset(g_disasmTables.layout, NWN_LAYOUT_INVALID, sizeof(g_disasmTables.layout));
+    for (int opcode = 0; opcode < NCS_OP_COUNT; opcode++) {
+        uint8_t layout;
+        switch (opcode) {
+            case NCS_OP_CPDOWNSP: case NCS_OP_CPTOPSP:
+            case NCS_OP_CPDOWNBP: case NCS_OP_CPTOPBP:
+                layout = NWN_LAYOUT_STACK_COPY;
+                break;
+            case NCS_OP_CONST:
+                layout = NWN_LAYOUT_CONST;
+                break;
+            case NCS_OP_ACTION:
+                layout = NWN_LAYOUT_ACTION;
+                break;
+            case NCS_OP_MOVSP:
+            case NCS_OP_DECSP: case NCS_OP_INCSP: case NCS_OP_DECBP: case NCS_OP_INCBP:
+                layout = NWN_LAYOUT_OFFSET;
+                break;
+            case NCS_OP_JMP: case NCS_OP_JSR: case NCS_OP_JZ: case NCS_OP_JNZ:
+                layout = NWN_LAYOUT_JUMP;
+                break;
+            case NCS_OP_DESTRUCT:
+                layout = NWN_LAYOUT_DESTRUCT;
+                break;
+            case NCS_OP_STORE_STATE:
+                layout = NWN_LAYOUT_STORE_STATE;
+                break;
+            case NCS_OP_EQUAL: case NCS_OP_NEQUAL:
+                layout = NWN_LAYOUT_EQUAL;
+                break;
+            default:
+                layout = strcmp(ncs_opcode_name((uint8_t)opcode), "UNKNOWN") == 0 ? NWN_LAYOUT_INVALID
+                                                                                     : NWN_LAYOUT_NONE;
+                break;
+        }
+        g_disasmTables.layout[opcode] = layout;
+
+        for (int qualifier = 0; qualifier < 256; qualifier++) {
+            char* mnemonic = g_disasmTables.mnemonic[opcode][qualifier];
+            int length = ncs_format_mnemonic((uint8_t)opcode, (uint8_t)qualifier, mnemonic, NWN_DISASM_MNEMONIC_MAX);
+            if (length < 0 || length >= NWN_DISASM_MNEMONIC_MAX) {
+                length = (int)strlen(mnemonic);
+            }
+            g_disasmTables.mnemonicLength[opcode][qualifier] = (uint8_t)length;
+        }
+    }
+    return true;
+}
+
+static const NwnDisasmTables* nwnnsscomp_disasm_tables()
+{
+    static const bool built = nwnnsscomp_build_disasm_tables();
+    (void)built;
+    return &g_disasmTables;
+}
+
+// ============================================================================
+// OUTPUT HELPERS
+// ============================================================================
+
+static inline uint16_t nwnnsscomp_read_le16(const uint8_t* p)
+{
+    return (uint16_t)(p[0] | ((uint32_t)p[1] << 8));
+}
+
+static inline uint32_t nwnnsscomp_read_le32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void nwnnsscomp_disasm_flush(NwnDisasmWriter* writer)
+{
+    if (!writer->buffer.empty()) {
+        fwrite(writer->buffer.data(), 1, writer->buffer.size(), writer->stream);
+        writer->buffer.clear();
+    }
+}
+
+static inline void nwnnsscomp_append_hex32(std::string* out, uint32_t value)
+{
+    static const char digits[] = "0123456789abcdef";
+    char text[8];
+    for (int i = 7; i >= 0; i--) {
+        text[i] = digits[value & 0xF];
+        value >>= 4;
+    }
+    out->append(text, 8);
+}
+
+static inline void nwnnsscomp_append_int(std::string* out, int64_t value)
+{
+    char text[24];
+    char* end = text + sizeof(text);
+    char* p = end;
+    uint64_t magnitude = value < 0 ? (uint64_t)0 - (uint64_t)value : (uint64_t)value;
+    do {
+        *--p = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) {
+        *--p = '-';
+    }
+    out->append(p, (size_t)(end - p));
+}
+
+static void nwnnsscomp_append_float(std::string* out, uint32_t bits, bool json)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    if (json && !isfinite(value)) {
+        out->append("null");
+        return;
+    }
+    char text[32];
+    int length = snprintf(text, sizeof(text), "%.9g", value);
+    out->append(text, (size_t)length);
+}
+
+/**
+ * @brief Append a quoted string with JSON escapes (also used for text output)
+ */
+static void nwnnsscomp_append_quoted(std::string* out, const char* text, size_t length)
+{
+    static const char digits[] = "0123456789abcdef";
+    out->push_back('"');
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)text[i];
+        switch (c) {
+            case '"':  out->append("\\\""); break;
+            case '\\': out->append("\\\\"); break;
+            case '\n': out->append("\\n");  break;
+            case '\r': out->append("\\r");  break;
+            case '\t': out->append("\\t");  break;
+            default:
+                if (c < 0x20 || c >= 0x7F) {
+                    // Script strings are in the game's 8-bit code page; keep JSON output ASCII
+                    out->append("\\u00");
+                    out->push_back(digits[c >> 4]);
+                    out->push_back(digits[c & 0xF]);
+                } else {
+                    out->push_back((char)c);
+                }
+                break;
+        }
+    }
+    out->push_back('"');
+}
+
+/**
+ * @brief Line prefix shared by every line of one script
+ */
+static std::string nwnnsscomp_disasm_prefix(const NwnDisasmWriter* writer, const std::string& name)
+{
+    std::string prefix;
+    if (writer->format == NWN_DISASM_JSON_LINES) {
+        prefix = "{\"script\":";
+        nwnnsscomp_append_quoted(&prefix, name.data(), name.size());
+    } else {
+        prefix = name;
+    }
+    return prefix;
+}
+
+static void nwnnsscomp_disasm_error(NwnDisasmWriter* writer, const std::string& prefix, uint32_t offset,
+                                    const char* message)
+{
+    std::string* out = &writer->buffer;
+    if (writer->format == NWN_DISASM_JSON_LINES) {
+        out->append(prefix);
+        out->append(",\"offset\":");
+        nwnnsscomp_append_int(out, offset);
+        out->append(",\"error\":");
+        nwnnsscomp_append_quoted(out, message, strlen(message));
+        out->append("}\n");
+    } else {
+        out->append(prefix);
+        out->append(" error ");
+        nwnnsscomp_append_hex32(out, offset);
+        out->push_back(' ');
+        out->append(message);
+        out->push_back('\n');
+    }
+    writer->stats.errors++;
+}
+
+// ============================================================================
+// DISASSEMBLY
+// ============================================================================
+
+void nwnnsscomp_disasm_begin(NwnDisasmWriter* writer, FILE* stream, int format)
+{
+    writer->stream = stream;
+    writer->format = format;
+    writer->buffer.clear();
+    writer->buffer.reserve(NWNNSSCOMP_DISASM_FLUSH_BYTES + 4096);
+    memset(&writer->stats, 0, sizeof(writer->stats));
+    nwnnsscomp_disasm_tables();
+}
+
+void nwnnsscomp_disasm_end(NwnDisasmWriter* writer)
+{
+    nwnnsscomp_disasm_flush(writer);
+    fflush(writer->stream);
+}
+
+int nwnnsscomp_disassemble_script(NwnDisasmWriter* writer, const std::string& name, const uint8_t* data,
+                                  size_t size)
+{
+    const NwnDisasmTables* tables = nwnnsscomp_disasm_tables();
+    const bool json = writer->format == NWN_DISASM_JSON_LINES;
+    const std::string prefix = nwnnsscomp_disasm_prefix(writer, name);
+    std::string* out = &writer->buffer;
+    writer->stats.scripts++;
+
+    if (size < NCS_HEADER_SIZE) {
+        nwnnsscomp_disasm_error(writer, prefix, 0, ncs_result_string(NCS_ERROR_TRUNCATED));
+        return NCS_ERROR_TRUNCATED;
+    }
+    if (memcmp(data, "NCS V1.0", 8) != 0 || data[8] != NCS_HEADER_MAGIC_BYTE) {
+        nwnnsscomp_disasm_error(writer, prefix, 0, ncs_result_string(NCS_ERROR_BAD_HEADER));
+        return NCS_ERROR_BAD_HEADER;
+    }
+    uint32_t end = ncs_read_be32(data + NCS_HEADER_SIZE_OFFSET);
+    if (end > size) {
+        nwnnsscomp_disasm_error(writer, prefix, NCS_HEADER_SIZE_OFFSET, ncs_result_string(NCS_ERROR_BAD_SIZE));
+        return NCS_ERROR_BAD_SIZE;
+    }
+
+    uint32_t position = NCS_HEADER_SIZE;
+    while (position < end) {
+        if (end - position < 2) {
+            nwnnsscomp_disasm_error(writer, prefix, position, ncs_result_string(NCS_ERROR_TRUNCATED));
+            return NCS_ERROR_TRUNCATED;
+        }
+        const uint8_t opcode = data[position];
+        const uint8_t qualifier = data[position + 1];
+        const uint8_t layout = tables->layout[opcode];
+        const uint8_t* operands = data + position + 2;
+        const uint32_t available = end - position - 2;
+
+        uint32_t operandSize;
+        switch (layout) {
+            case NWN_LAYOUT_INVALID:
+                nwnnsscomp_disasm_error(writer, prefix, position, ncs_result_string(NCS_ERROR_BAD_OPCODE));
+                return NCS_ERROR_BAD_OPCODE;
+            case NWN_LAYOUT_STACK_COPY:  operandSize = 6; break;
+            case NWN_LAYOUT_ACTION:      operandSize = 3; break;
+            case NWN_LAYOUT_OFFSET:      operandSize = 4; break;
+            case NWN_LAYOUT_JUMP:        operandSize = 4; break;
+            case NWN_LAYOUT_DESTRUCT:    operandSize = 6; break;
+            case NWN_LAYOUT_STORE_STATE: operandSize = 8; break;
+            case NWN_LAYOUT_EQUAL:       operandSize = qualifier == NCS_Q_STRUCT_STRUCT ? 2 : 0; break;
+            case NWN_LAYOUT_CONST:
+                operandSize = 4;
+                if (qualifier == NCS_Q_STRING) {
+                    operandSize = available >= 2 ? 2u + ncs_read_be16(operands) : 2u;
+                }
+                break;
+            default:                     operandSize = 0; break;
+        }
+        if (operandSize > available) {
+            nwnnsscomp_disasm_error(writer, prefix, position, ncs_result_string(NCS_ERROR_TRUNCATED));
+            return NCS_ERROR_TRUNCATED;
+        }
+
+        // Numeric operands, in encoding order
+        int64_t args[3];
+        int argCount = 0;
+        switch (layout) {
+            case NWN_LAYOUT_STACK_COPY:
+                args[0] = (int32_t)ncs_read_be32(operands);
+                args[1] = ncs_read_be16(operands + 4);
+                argCount = 2;
+                break;
+            case NWN_LAYOUT_ACTION:
+                args[0] = ncs_read_be16(operands);
+                args[1] = operands[2];
+                argCount = 2;
+                break;
+            case NWN_LAYOUT_OFFSET:
+            case NWN_LAYOUT_JUMP:
+                args[0] = (int32_t)ncs_read_be32(operands);
+                argCount = 1;
+                break;
+            case NWN_LAYOUT_DESTRUCT:
+                args[0] = ncs_read_be16(operands);
+                args[1] = (int16_t)ncs_read_be16(operands + 2);
+                args[2] = ncs_read_be16(operands + 4);
+                argCount = 3;
+                break;
+            case NWN_LAYOUT_STORE_STATE:
+                args[0] = (int32_t)ncs_read_be32(operands);
+                args[1] = (int32_t)ncs_read_be32(operands + 4);
+                argCount = 2;
+                break;
+            case NWN_LAYOUT_EQUAL:
+                if (operandSize != 0) {
+                    args[0] = ncs_read_be16(operands);
+                    argCount = 1;
+                }
+                break;
+            case NWN_LAYOUT_CONST:
+                if (qualifier != NCS_Q_STRING && qualifier != NCS_Q_FLOAT) {
+                    args[0] = (int32_t)ncs_read_be32(operands);
+                    argCount = 1;
+                }
+                break;
+            default:
+                break;
+        }
+
+        const char* mnemonic = tables->mnemonic[opcode][qualifier];
+        const size_t mnemonicLength = tables->mnemonicLength[opcode][qualifier];
+        if (json) {
+            out->append(prefix);
+            out->append(",\"offset\":");
+            nwnnsscomp_append_int(out, position);
+            out->append(",\"op\":\"");
+            out->append(mnemonic, mnemonicLength);
+            out->push_back('"');
+            if (layout == NWN_LAYOUT_CONST && qualifier == NCS_Q_STRING) {
+                out->append(",\"args\":[");
+                nwnnsscomp_append_quoted(out, (const char*)operands + 2, operandSize - 2);
+                out->push_back(']');
+            } else if (layout == NWN_LAYOUT_CONST && qualifier == NCS_Q_FLOAT) {
+                out->append(",\"args\":[");
+                nwnnsscomp_append_float(out, ncs_read_be32(operands), true);
+                out->push_back(']');
+            } else if (argCount > 0) {
+                out->append(",\"args\":[");
+                for (int i = 0; i < argCount; i++) {
+                    if (i > 0) {
+                        out->push_back(',');
+                    }
+                    nwnnsscomp_append_int(out, args[i]);
+                }
+                out->push_back(']');
+            }
+            if (layout == NWN_LAYOUT_JUMP) {
+                out->append(",\"target\":");
+                nwnnsscomp_append_int(out, (int64_t)position + args[0]);
+            }
+            out->append("}\n");
+        } else {
+            out->append(prefix);
+            out->push_back(' ');
+            nwnnsscomp_append_hex32(out, position);
+            out->push_back(' ');
+            out->append(mnemonic, mnemonicLength);
+            if (layout == NWN_LAYOUT_JUMP) {
+                out->push_back(' ');
+                nwnnsscomp_append_hex32(out, (uint32_t)(position + (uint32_t)args[0]));
+            } else if (layout == NWN_LAYOUT_CONST && qualifier == NCS_Q_STRING) {
+                out->push_back(' ');
+                nwnnsscomp_append_quoted(out, (const char*)operands + 2, operandSize - 2);
+            } else if (layout == NWN_LAYOUT_CONST && qualifier == NCS_Q_FLOAT) {
+                out->push_back(' ');
+                nwnnsscomp_append_float(out, ncs_read_be32(operands), false);
+            } else {
+                for (int i = 0; i < argCount; i++) {
+                    out->append(i == 0 ? " " : ", ");
+                    nwnnsscomp_append_int(out, args[i]);
+                }
+            }
+            out->push_back('\n');
+        }
+
+        writer->stats.instructions++;
+        position += 2 + operandSize;
+        if (out->size() >= NWNNSSCOMP_DISASM_FLUSH_BYTES) {
+            nwnnsscomp_disasm_flush(writer);
+        }
+    }
+
+    writer->stats.bytes += end;
+    return NCS_OK;
+}
+
+// ============================================================================
+// ARCHIVES
+// ============================================================================
+
+/**
+ * @brief Resource name from a 16-byte resref field, lowercased, plus ".ncs"
+ */
+static std::string nwnnsscomp_resource_name(const std::string& archive, const uint8_t* resref)
+{
+    std::string name = archive + "/";
+    for (int i = 0; i < 16 && resref[i] != '\0'; i++) {
+        char c = (char)resref[i];
+        name.push_back(c >= 'A' && c <= 'Z' ? (char)(c - 'A' + 'a') : c);
+    }
+    name.append(".ncs");
+    return name;
+}
+
+/**
+ * @brief Disassemble one archive resource after checking its bounds
+ */
+static void nwnnsscomp_disassemble_resource(NwnDisasmWriter* writer, const std::string& name, const uint8_t* data,
+                                            size_t size, uint32_t offset, uint32_t length)
+{
+    if (offset > size || length > size - offset) {
+        writer->stats.scripts++;
+        nwnnsscomp_disasm_error(writer, nwnnsscomp_disasm_prefix(writer, name), 0,
+                                "resource lies outside the archive");
+        return;
+    }
+    nwnnsscomp_disassemble_script(writer, name, data + offset, length);
+}
+
+int nwnnsscomp_disassemble_archive(NwnDisasmWriter* writer, const std::string& name, const uint8_t* data,
+                                   size_t size)
+{
+    if (size < 24 || memcmp(data + 4, "V1.0", 4) != 0) {
+        return -1;
+    }
+    int scripts = 0;
+
+    if (memcmp(data, "RIM ", 4) == 0) {
+        // type, version, reserved, entry count, key offset; keys are
+        // resref[16], type, id, offset, size (all uint32)
+        uint32_t entryCount = nwnnsscomp_read_le32(data + 12);
+        uint32_t keyOffset = nwnnsscomp_read_le32(data + 16);
+        if (keyOffset > size || entryCount > (size - keyOffset) / 32) {
+            return -1;
+        }
+        for (uint32_t i = 0; i < entryCount; i++) {
+            const uint8_t* key = data + keyOffset + (size_t)i * 32;
+            if (nwnnsscomp_read_le32(key + 16) != NWNNSSCOMP_RESTYPE_NCS) {
+                continue;
+            }
+            nwnnsscomp_disassemble_resource(writer, nwnnsscomp_resource_name(name, key), data, size,
+                                            nwnnsscomp_read_le32(key + 24), nwnnsscomp_read_le32(key + 28));
+            scripts++;
+        }
+        return scripts;
+    }
+
+    if (memcmp(data, "ERF ", 4) == 0 || memcmp(data, "MOD ", 4) == 0 || memcmp(data, "SAV ", 4) == 0 ||
+        memcmp(data, "HAK ", 4) == 0) {
+        // Keys are resref[16], id (uint32), type (uint16), unused (uint16);
+        // the resource list holds offset and size (uint32) in key order
+        if (size < 32) {
+            return -1;
+        }
+        uint32_t entryCount = nwnnsscomp_read_le32(data + 16);
+        uint32_t keyOffset = nwnnsscomp_read_le32(data + 24);
+        uint32_t resourceOffset = nwnnsscomp_read_le32(data + 28);
+        if (keyOffset > size || entryCount > (size - keyOffset) / 24 ||
+            resourceOffset > size || entryCount > (size - resourceOffset) / 8) {
+            return -1;
+        }
+        for (uint32_t i = 0; i < entryCount; i++) {
+            const uint8_t* key = data + keyOffset + (size_t)i * 24;
+            if (nwnnsscomp_read_le16(key + 20) != NWNNSSCOMP_RESTYPE_NCS) {
+                continue;
+            }
+            const uint8_t* resource = data + resourceOffset + (size_t)i * 8;
+            nwnnsscomp_disassemble_resource(writer, nwnnsscomp_resource_name(name, key), data, size,
+                                            nwnnsscomp_read_le32(resource), nwnnsscomp_read_le32(resource + 4));
+            scripts++;
+        }
+        return scripts;
+    }
+
+    return -1;
+}
+
+// ============================================================================
+// INPUTS
+// ============================================================================
+
+/**
+ * @brief Disassemble a mapped script or archive
+ */
+static int nwnnsscomp_disassemble_mapped(NwnDisasmWriter* writer, const std::string& name, const NwnMappedFile* file)
+{
+    if (file->size >= 8 && memcmp(file->data, "NCS V1.0", 8) == 0) {
+        nwnnsscomp_disassemble_script(writer, name, file->data, file->size);
+        return 1;
+    }
+    if (file->size > 0 && nwnnsscomp_disassemble_archive(writer, name, file->data, file->size) >= 0) {
+        return 1;
+    }
+    writer->stats.scripts++;
+    nwnnsscomp_disasm_error(writer, nwnnsscomp_disasm_prefix(writer, name), 0, "not an NCS file or archive");
+    return 0;
+}
+
+int nwnnsscomp_disassemble_path(NwnDisasmWriter* writer, const char* path)
+{
+    NwnMappedFile file;
+    if (nwnnsscomp_map_file(path, &file)) {
+        int ok = nwnnsscomp_disassemble_mapped(writer, path, &file);
+        nwnnsscomp_unmap_file(&file);
+        return ok;
+    }
+
+    std::vector<std::string> paths;
+    if (!nwnnsscomp_list_corpus(path, &paths)) {
+        nwnnsscomp_disasm_error(writer, nwnnsscomp_disasm_prefix(writer, path), 0, "cannot read input");
+        return 0;
+    }
+    std::string root = path;
+    for (size_t i = 0; i < paths.size(); i++) {
+        const std::string& relative = paths[i];
+        if (relative.size() < 4 || (relative.compare(relative.size() - 4, 4, ".ncs") != 0 &&
+                                    relative.compare(relative.size() - 4, 4, ".NCS") != 0)) {
+            continue;
+        }
+        std::string full = root + "/" + relative;
+        if (!nwnnsscomp_map_file(full.c_str(), &file)) {
+            writer->stats.scripts++;
+            nwnnsscomp_disasm_error(writer, nwnnsscomp_disasm_prefix(writer, relative), 0, "cannot read input");
+            continue;
+        }
+        nwnnsscomp_disassemble_mapped(writer, relative, &file);
+        nwnnsscomp_unmap_file(&file);
+    }
+    return 1;
+}
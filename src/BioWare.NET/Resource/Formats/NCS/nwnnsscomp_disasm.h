@@ -0,0 +1,140 @@
+// ============================================================================
+// NWNNSSCOMP DISASSEMBLER
+// ============================================================================
+// Bulk disassembly of compiled scripts for grepping and scripted analysis.
+// Inputs are memory-mapped and decoded in a single pass driven by a
+// per-opcode operand layout table, straight into a large output buffer:
+// no instruction list is built and nothing is allocated per instruction.
+//
+// An input is a .ncs file, an ERF/MOD/SAV/HAK or RIM archive (every NCS
+// resource in it is disassembled as "archive/resref.ncs") or a directory
+// (every .ncs below it). Two output formats:
+//   text        name offset MNEMONIC operands
+//                 k_ai_master.ncs 0000000d JSR 00000015
+//   JSON lines  one object per instruction
+//                 {"script":"k_ai_master.ncs","offset":13,"op":"JSR","args":[8],"target":21}
+// Offsets are hexadecimal in text and decimal in JSON; jump targets are
+// absolute byte offsets. A script that fails to decode gets an error line
+// (text: "name error offset message", JSON: an "error" object) and the run
+// moves on to the next script.
+// ============================================================================
+
+#ifndef NWNNSSCOMP_DISASM_H
+#define NWNNSSCOMP_DISASM_H
+
+#include <stdio.h>
+
+#include <string>
+
+#include "ncs_bytecode.h"
+
+#define NWNNSSCOMP_DISASM_FLUSH_BYTES  (1u << 18)  // Output buffered before each write
+#define NWNNSSCOMP_RESTYPE_NCS         2010        // Resource type of compiled scripts
+
+enum NwnDisasmFormat
+{
+    NWN_DISASM_TEXT = 0,
+    NWN_DISASM_JSON_LINES
+};
+
+typedef struct NwnDisasmStats
+{
+    uint64_t scripts;                  // Scripts disassembled (including failed ones)
+    uint64_t instructions;             // Instructions written
+    uint64_t bytes;                    // Script bytes decoded
+    uint32_t errors;                   // Scripts or inputs that failed
+} NwnDisasmStats;
+
+typedef struct NwnDisasmWriter
+{
+    FILE* stream;
+    int format;                        // NwnDisasmFormat
+    std::string buffer;                // Pending output
+    NwnDisasmStats stats;
+} NwnDisasmWriter;
+
+/**
+ * @brief Read-only view of a mapped file
+ */
+typedef struct NwnMappedFile
+{
+    const uint8_t* data;
+    size_t size;
+#if defined(_WIN32)
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int descriptor;
+#endif
+} NwnMappedFile;
+
+// ============================================================================
+// MAPPED FILES
+// ============================================================================
+
+/**
+ * @brief Map a whole file read-only
+ *
+ * An empty file maps successfully with data == NULL.
+ *
+ * @return 1 on success, 0 if the file cannot be opened or mapped
+ */
+int nwnnsscomp_map_file(const char* path, NwnMappedFile* file);
+
+/**
+ * @brief Release a mapping made by nwnnsscomp_map_file
+ */
+void nwnnsscomp_unmap_file(NwnMappedFile* file);
+
+// ============================================================================
+// DISASSEMBLY
+// ============================================================================
+
+/**
+ * @brief Prepare a writer
+ *
+ * @param writer Writer to initialize
+ * @param stream Output stream
+ * @param format NwnDisasmFormat
+ */
+void nwnnsscomp_disasm_begin(NwnDisasmWriter* writer, FILE* stream, int format);
+
+/**
+ * @brief Write any buffered output and flush the stream
+ */
+void nwnnsscomp_disasm_end(NwnDisasmWriter* writer);
+
+/**
+ * @brief Disassemble one NCS stream held in memory
+ *
+ * @param writer Output
+ * @param name Script name written on every line
+ * @param data Complete NCS file contents
+ * @param size Byte count of data
+ * @return NCS_OK or the NcsResult that stopped decoding
+ */
+int nwnnsscomp_disassemble_script(NwnDisasmWriter* writer, const std::string& name, const uint8_t* data,
+                                  size_t size);
+
+/**
+ * @brief Disassemble every NCS resource of an ERF/MOD/SAV/HAK or RIM archive held in memory
+ *
+ * @param writer Output
+ * @param name Archive name, prefixed to each resource name
+ * @param data Complete archive contents
+ * @param size Byte count of data
+ * @return Number of scripts disassembled, or -1 if data is not a readable archive
+ */
+int nwnnsscomp_disassemble_archive(NwnDisasmWriter* writer, const std::string& name, const uint8_t* data,
+                                   size_t size);
+
+/**
+ * @brief Disassemble a .ncs file, an archive or every .ncs below a directory
+ *
+ * The input kind is chosen from the file signature, not the extension.
+ *
+ * @return 1 on success, 0 if the input could not be read or was not recognized
+ */
+int nwnnsscomp_disassemble_path(NwnDisasmWriter* writer, const char* path);
+
+#endif // NWNNSSCOMP_DISASM_H
@@ -0,0 +1,405 @@
+// ============================================================================
+// NWNNSSCOMP LIBRARY FUNCTION FINGERPRINTS
+// ============================================================================
+
+#include "nwnnsscomp_fingerprint.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ncs_vm_profiler.h"
+#include "nwnnsscomp_disasm.h"
+#include "nwnnsscomp_roundtrip.h"
+
+#define NWNNSSCOMP_FINGERPRINT_FNV_BASIS  0xcbf29ce484222325ULL
+#define NWNNSSCOMP_FINGERPRINT_FNV_PRIME  0x100000001b3ULL
+#define NWNNSSCOMP_FINGERPRINT_BASE       0x9e3779b97f4a7c15ULL  // Rolling hash multiplier (odd)
+#define NWNNSSCOMP_FINGERPRINT_OUTSIDE    0xffffffffu            // Relative target of a jump out of the body
+
+// ============================================================================
+// FINGERPRINTS
+// ============================================================================
+
+static inline uint64_t nwnnsscomp_fingerprint_mix(uint64_t hash, uint64_t value)
+{
+    for (int i = 0; i < 8; i++) {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= NWNNSSCOMP_FINGERPRINT_FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Hash one instruction of the subroutine starting at index first
+ */
+static uint64_t nwnnsscomp_fingerprint_instruction(const NcsProgram* program, uint32_t index, uint32_t first,
+                                                   uint32_t last)
+{
+    const NcsInstruction& instruction = program->instructions[index];
+    uint64_t hash = nwnnsscomp_fingerprint_mix(NWNNSSCOMP_FINGERPRINT_FNV_BASIS,
+                                               instruction.opcode | ((uint64_t)instruction.qualifier << 8));
+    if (ncs_is_jump(instruction.opcode)) {
+        if (instruction.opcode == NCS_OP_JSR) {
+            return hash;
+        }
+        uint32_t target = NWNNSSCOMP_FINGERPRINT_OUTSIDE;
+        if (instruction.jumpTarget >= 0 && (uint32_t)instruction.jumpTarget >= first &&
+            (uint32_t)instruction.jumpTarget < last) {
+            target = (uint32_t)instruction.jumpTarget - first;
+        }
+        return nwnnsscomp_fingerprint_mix(hash, target);
+    }
+    hash = nwnnsscomp_fingerprint_mix(hash, (uint32_t)instruction.arg0 | ((uint64_t)(uint32_t)instruction.arg1 << 32));
+    hash = nwnnsscomp_fingerprint_mix(hash, (uint32_t)instruction.arg2 | ((uint64_t)instruction.text.size() << 32));
+    for (size_t i = 0; i < instruction.text.size(); i++) {
+        hash ^= (uint8_t)instruction.text[i];
+        hash *= NWNNSSCOMP_FINGERPRINT_FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t nwnnsscomp_fingerprint_function(const NcsProgram* program, uint32_t first, uint32_t last)
+{
+    uint64_t fingerprint = last - first;
+    for (uint32_t i = first; i < last; i++) {
+        fingerprint = fingerprint * NWNNSSCOMP_FINGERPRINT_BASE +
+                      nwnnsscomp_fingerprint_instruction(program, i, first, last);
+    }
+    return fingerprint;
+}
+
+/**
+ * @brief Entry instruction indices: the program start and every JSR target, ascending
+ */
+static void nwnnsscomp_fingerprint_entries(const NcsProgram* program, std::vector<uint32_t>* entries)
+{
+    const std::vector<NcsInstruction>& instructions = program->instructions;
+    std::vector<uint8_t> isEntry(instructions.size(), 0);
+    if (!instructions.empty()) {
+        isEntry[0] = 1;
+    }
+    for (size_t i = 0; i < instructions.size(); i++) {
+        if (instructions[i].opcode == NCS_OP_JSR && instructions[i].jumpTarget >= 0) {
+            isEntry[instructions[i].jumpTarget] = 1;
+        }
+    }
+    entries->clear();
+    for (size_t i = 0; i < instructions.size(); i++) {
+        if (isEntry[i]) {
+            entries->push_back((uint32_t)i);
+        }
+    }
+}
+
+static const NcsFunctionSymbol* nwnnsscomp_fingerprint_symbol(const std::vector<NcsFunctionSymbol>* symbols,
+                                                              uint32_t offset)
+{
+    if (symbols == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < symbols->size(); i++) {
+        if ((*symbols)[i].offset == offset) {
+            return &(*symbols)[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Insert an entry or count another sighting of its fingerprint
+ *
+ * A real name replaces an unnamed entry; the fingerprint only becomes
+ * ambiguous when two real names (or two body lengths) disagree.
+ *
+ * @return 1 if a new entry was added, 0 otherwise
+ */
+static int nwnnsscomp_fingerprint_insert(NwnFingerprintIndex* index, const NwnFingerprintEntry& entry)
+{
+    std::unordered_map<uint64_t, uint32_t>::iterator found = index->byFingerprint.find(entry.fingerprint);
+    if (found != index->byFingerprint.end()) {
+        NwnFingerprintEntry& existing = index->entries[found->second];
+        existing.seen += entry.seen;
+        if (existing.instructions != entry.instructions || entry.ambiguous) {
+            existing.ambiguous = true;
+        }
+        else if (entry.named && !existing.named) {
+            existing.name = entry.name;
+            existing.library = entry.library;
+            existing.named = true;
+        }
+        else if (entry.named && (existing.name != entry.name || existing.library != entry.library)) {
+            existing.ambiguous = true;
+        }
+        return 0;
+    }
+    index->byFingerprint[entry.fingerprint] = (uint32_t)index->entries.size();
+    index->entries.push_back(entry);
+    return 1;
+}
+
+uint32_t nwnnsscomp_fingerprint_add(NwnFingerprintIndex* index, const NcsProgram* program,
+                                    const std::vector<NcsFunctionSymbol>* symbols, const char* library)
+{
+    std::vector<uint32_t> entries;
+    nwnnsscomp_fingerprint_entries(program, &entries);
+    uint32_t added = 0;
+    for (size_t e = 1; e < entries.size(); e++) {
+        uint32_t first = entries[e];
+        uint32_t last = e + 1 < entries.size() ? entries[e + 1] : (uint32_t)program->instructions.size();
+        if (last - first < NWNNSSCOMP_FINGERPRINT_MIN_INSTRUCTIONS) {
+            continue;
+        }
+
+        NwnFingerprintEntry entry;
+        uint32_t offset = program->instructions[first].offset;
+        const NcsFunctionSymbol* symbol = nwnnsscomp_fingerprint_symbol(symbols, offset);
+        if (symbol != NULL) {
+            if (symbol->name == "main" || symbol->name == "StartingConditional") {
+                continue;
+            }
+            entry.name = symbol->name;
+            entry.library = symbol->sourceFile.empty() ? library : symbol->sourceFile;
+            entry.named = true;
+        }
+        else {
+            char name[32];
+            snprintf(name, sizeof(name), ":sub_%08X", offset);
+            entry.name = std::string(library) + name;
+            entry.library = library;
+            entry.named = false;
+        }
+        entry.fingerprint = nwnnsscomp_fingerprint_function(program, first, last);
+        entry.instructions = last - first;
+        entry.seen = 1;
+        entry.ambiguous = false;
+        added += (uint32_t)nwnnsscomp_fingerprint_insert(index, entry);
+    }
+    return added;
+}
+
+uint32_t nwnnsscomp_fingerprint_identify(const NwnFingerprintIndex* index, const NcsProgram* program,
+                                         std::vector<NcsFunctionSymbol>* symbols)
+{
+    symbols->clear();
+    std::vector<uint32_t> entries;
+    nwnnsscomp_fingerprint_entries(program, &entries);
+    for (size_t e = 1; e < entries.size(); e++) {
+        uint32_t first = entries[e];
+        uint32_t last = e + 1 < entries.size() ? entries[e + 1] : (uint32_t)program->instructions.size();
+        if (last - first < NWNNSSCOMP_FINGERPRINT_MIN_INSTRUCTIONS) {
+            continue;
+        }
+        std::unordered_map<uint64_t, uint32_t>::const_iterator found =
+            index->byFingerprint.find(nwnnsscomp_fingerprint_function(program, first, last));
+        if (found == index->byFingerprint.end()) {
+            continue;
+        }
+        const NwnFingerprintEntry& entry = index->entries[found->second];
+        if (entry.ambiguous || entry.instructions != last - first) {
+            continue;
+        }
+        NcsFunctionSymbol symbol;
+        symbol.name = entry.name;
+        symbol.sourceFile = entry.library;
+        symbol.offset = program->instructions[first].offset;
+        symbols->push_back(symbol);
+    }
+    return entries.empty() ? 0 : (uint32_t)entries.size() - 1;
+}
+
+// ============================================================================
+// FILES
+// ============================================================================
+
+/**
+ * @brief Whether a path names a compiled script
+ */
+static bool nwnnsscomp_fingerprint_is_ncs(const std::string& path)
+{
+    return path.size() >= 4 &&
+           (path.compare(path.size() - 4, 4, ".ncs") == 0 || path.compare(path.size() - 4, 4, ".NCS") == 0);
+}
+
+/**
+ * @brief Expand a file or directory argument into .ncs paths
+ *
+ * @return 1 if the path is a readable file or directory, 0 otherwise
+ */
+static int nwnnsscomp_fingerprint_inputs(const char* path, std::vector<std::string>* files)
+{
+    files->clear();
+    NwnMappedFile file;
+    if (nwnnsscomp_map_file(path, &file)) {
+        nwnnsscomp_unmap_file(&file);
+        files->push_back(path);
+        return 1;
+    }
+    std::vector<std::string> listed;
+    if (!nwnnsscomp_list_corpus(path, &listed)) {
+        return 0;
+    }
+    for (size_t i = 0; i < listed.size(); i++) {
+        if (nwnnsscomp_fingerprint_is_ncs(listed[i])) {
+            files->push_back(std::string(path) + "/" + listed[i]);
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Map and decode one script
+ *
+ * @return 1 on success, 0 if the file cannot be read or decoded
+ */
+static int nwnnsscomp_fingerprint_decode(const std::string& path, NcsProgram* program)
+{
+    NwnMappedFile file;
+    if (!nwnnsscomp_map_file(path.c_str(), &file)) {
+        return 0;
+    }
+    int result = ncs_decode_program(file.data, file.size, program);
+    nwnnsscomp_unmap_file(&file);
+    return result == NCS_OK;
+}
+
+/**
+ * @brief File name without directory and extension
+ */
+static std::string nwnnsscomp_fingerprint_stem(const std::string& path)
+{
+    size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.rfind('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+int nwnnsscomp_fingerprint_add_path(NwnFingerprintIndex* index, const char* path, NwnFingerprintStats* stats)
+{
+    NwnFingerprintStats localStats;
+    if (stats == NULL) {
+        stats = &localStats;
+    }
+    memset(stats, 0, sizeof(*stats));
+
+    std::vector<std::string> files;
+    if (!nwnnsscomp_fingerprint_inputs(path, &files)) {
+        return 0;
+    }
+    for (size_t f = 0; f < files.size(); f++) {
+        NcsProgram program;
+        if (!nwnnsscomp_fingerprint_decode(files[f], &program)) {
+            stats->failed++;
+            continue;
+        }
+        stats->scripts++;
+
+        // Symbols from the .ndb next to the .ncs, if the script was compiled with -d
+        std::vector<NcsFunctionSymbol> symbols;
+        bool haveSymbols = false;
+        std::string ndbPath = files[f].substr(0, files[f].size() - 4) + ".ndb";
+        NwnMappedFile ndb;
+        if (nwnnsscomp_map_file(ndbPath.c_str(), &ndb)) {
+            haveSymbols = ndb.size != 0 && ncs_vm_read_ndb((const char*)ndb.data, ndb.size, &symbols) != 0;
+            nwnnsscomp_unmap_file(&ndb);
+        }
+
+        std::string library = nwnnsscomp_fingerprint_stem(files[f]);
+        std::vector<uint32_t> entries;
+        nwnnsscomp_fingerprint_entries(&program, &entries);
+        stats->functions += entries.empty() ? 0 : (uint32_t)entries.size() - 1;
+        stats->matched += nwnnsscomp_fingerprint_add(index, &program, haveSymbols ? &symbols : NULL,
+                                                     library.c_str());
+    }
+    return 1;
+}
+
+int nwnnsscomp_fingerprint_scan_path(const NwnFingerprintIndex* index, const char* path, FILE* stream,
+                                     NwnFingerprintStats* stats)
+{
+    NwnFingerprintStats localStats;
+    if (stats == NULL) {
+        stats = &localStats;
+    }
+    memset(stats, 0, sizeof(*stats));
+
+    std::vector<std::string> files;
+    if (!nwnnsscomp_fingerprint_inputs(path, &files)) {
+        return 0;
+    }
+    std::vector<NcsFunctionSymbol> symbols;
+    for (size_t f = 0; f < files.size(); f++) {
+        NcsProgram program;
+        if (!nwnnsscomp_fingerprint_decode(files[f], &program)) {
+            stats->failed++;
+            continue;
+        }
+        stats->scripts++;
+        stats->functions += nwnnsscomp_fingerprint_identify(index, &program, &symbols);
+        stats->matched += (uint32_t)symbols.size();
+        for (size_t i = 0; i < symbols.size(); i++) {
+            fprintf(stream, "%s %08x %s %s\n", files[f].c_str(), symbols[i].offset,
+                    symbols[i].sourceFile.c_str(), symbols[i].name.c_str());
+        }
+    }
+    return 1;
+}
+
+int nwnnsscomp_fingerprint_load(NwnFingerprintIndex* index, const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    char line[1024];
+    if (fgets(line, sizeof(line), file) == NULL ||
+        strncmp(line, NWNNSSCOMP_FINGERPRINT_MAGIC, strlen(NWNNSSCOMP_FINGERPRINT_MAGIC)) != 0) {
+        fclose(file);
+        return 0;
+    }
+
+    int valid = 1;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        // <fingerprint> <instructions> <seen> <n|u|a> <library> <name>
+        char flag[2];
+        char library[512];
+        char name[512];
+        uint64_t fingerprint;
+        unsigned int instructions;
+        unsigned int seen;
+        if (line[0] == '\n' || line[0] == '\r') {
+            continue;
+        }
+        if (sscanf(line, "%" SCNx64 " %u %u %1s %511s %511s", &fingerprint, &instructions, &seen, flag, library,
+                   name) != 6) {
+            valid = 0;
+            break;
+        }
+        NwnFingerprintEntry entry;
+        entry.fingerprint = fingerprint;
+        entry.instructions = instructions;
+        entry.seen = seen;
+        entry.named = flag[0] != 'u';
+        entry.ambiguous = flag[0] == 'a';
+        entry.library = library;
+        entry.name = name;
+        nwnnsscomp_fingerprint_insert(index, entry);
+    }
+    fclose(file);
+    return valid;
+}
+
+int nwnnsscomp_fingerprint_save(const NwnFingerprintIndex* index, const char* path)
+{
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        return 0;
+    }
+    fprintf(file, "%s\n", NWNNSSCOMP_FINGERPRINT_MAGIC);
+    for (size_t i = 0; i < index->entries.size(); i++) {
+        const NwnFingerprintEntry& entry = index->entries[i];
+        fprintf(file, "%016" PRIx64 " %u %u %c %s %s\n", entry.fingerprint, entry.instructions, entry.seen,
+                entry.ambiguous ? 'a' : (entry.named ? 'n' : 'u'), entry.library.c_str(), entry.name.c_str());
+    }
+    return fclose(file) == 0;
+}
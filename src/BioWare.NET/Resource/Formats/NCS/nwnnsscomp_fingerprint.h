@@ -0,0 +1,140 @@
+// ============================================================================
+// NWNNSSCOMP LIBRARY FUNCTION FINGERPRINTS
+// ============================================================================
+// Compiled scripts carry a full copy of every include function they call,
+// without any record of where it came from. This index fingerprints the
+// subroutines of scripts compiled from known includes so the same
+// subroutines can be recognized, and named, in any other script.
+//
+// A subroutine spans from its entry (a JSR target) to the next entry. Its
+// fingerprint is a polynomial rolling hash over per-instruction hashes:
+// opcode, qualifier and operands, with jump targets taken relative to the
+// subroutine start and JSR targets left out, so the fingerprint does not
+// depend on where the subroutine was placed or where its callees ended up.
+//
+// Names come from the .ndb file nwnnsscomp -d writes next to the .ncs
+// (function name, defining file as the library). A subroutine only seen in
+// scripts without one is indexed unnamed, as "<file>:sub_XXXXXXXX" of the
+// first script it was seen in; the same body in other unnamed scripts only
+// raises its seen count, and the first real name found replaces it. The
+// program start, "main" and
+// "StartingConditional" are never indexed, nor are subroutines shorter
+// than NWNNSSCOMP_FINGERPRINT_MIN_INSTRUCTIONS.
+//
+// The index is saved as text, one subroutine per line:
+//   NCSFP V1.1
+//   <fingerprint hex> <instructions> <seen> <n|u|a> <library> <name>
+// where "n" marks a real name, "u" an unnamed entry and "a" a fingerprint
+// shared by subroutines with different real names; those are never
+// reported as matches.
+// ============================================================================
+
+#ifndef NWNNSSCOMP_FINGERPRINT_H
+#define NWNNSSCOMP_FINGERPRINT_H
+
+#include <stdio.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ncs_bytecode.h"
+#include "nwnnsscomp_size_report.h"
+
+#define NWNNSSCOMP_FINGERPRINT_MAGIC             "NCSFP V1.1"  // First line of a saved index
+#define NWNNSSCOMP_FINGERPRINT_MIN_INSTRUCTIONS  4             // Shorter subroutines are too generic to name
+
+typedef struct NwnFingerprintEntry
+{
+    uint64_t fingerprint;              // Rolling hash of the body
+    uint32_t instructions;             // Instruction count of the body
+    uint32_t seen;                     // Times the body was indexed
+    bool named;                        // Name and library come from symbols, not "<file>:sub_XXXXXXXX"
+    bool ambiguous;                    // Also seen under a different real name
+    std::string name;                  // Function name
+    std::string library;               // Defining include (or indexed file)
+} NwnFingerprintEntry;
+
+typedef struct NwnFingerprintIndex
+{
+    std::vector<NwnFingerprintEntry> entries;                 // In indexing order
+    std::unordered_map<uint64_t, uint32_t> byFingerprint;     // Fingerprint -> entry
+} NwnFingerprintIndex;
+
+typedef struct NwnFingerprintStats
+{
+    uint32_t scripts;                  // Scripts decoded
+    uint32_t failed;                   // Scripts that could not be read or decoded
+    uint32_t functions;                // Subroutines considered
+    uint32_t matched;                  // Subroutines added (indexing) or identified (scanning)
+} NwnFingerprintStats;
+
+/**
+ * @brief Fingerprint the instructions [first, last) of a program as one subroutine
+ */
+uint64_t nwnnsscomp_fingerprint_function(const NcsProgram* program, uint32_t first, uint32_t last);
+
+/**
+ * @brief Add the subroutines of one program to the index
+ *
+ * @param index Index
+ * @param program Decoded program
+ * @param symbols Function symbols (e.g. from ncs_vm_read_ndb), or NULL
+ * @param library Library name used when a symbol has no source file, and in "<file>:sub_XXXXXXXX" names
+ * @return Number of entries added
+ */
+uint32_t nwnnsscomp_fingerprint_add(NwnFingerprintIndex* index, const NcsProgram* program,
+                                    const std::vector<NcsFunctionSymbol>* symbols, const char* library);
+
+/**
+ * @brief Name the subroutines of a program that are in the index
+ *
+ * Runs in time linear in the instruction count.
+ *
+ * @param index Index
+ * @param program Decoded program
+ * @param symbols Receives one symbol per identified subroutine, in stream order
+ * @return Number of subroutines considered
+ */
+uint32_t nwnnsscomp_fingerprint_identify(const NwnFingerprintIndex* index, const NcsProgram* program,
+                                         std::vector<NcsFunctionSymbol>* symbols);
+
+/**
+ * @brief Index a .ncs file (with the .ndb next to it, if any) or every .ncs below a directory
+ *
+ * @param index Index
+ * @param path File or directory
+ * @param stats Receives the counts (may be NULL)
+ * @return 1 if the path was read, 0 otherwise
+ */
+int nwnnsscomp_fingerprint_add_path(NwnFingerprintIndex* index, const char* path, NwnFingerprintStats* stats);
+
+/**
+ * @brief Identify library subroutines in a .ncs file or every .ncs below a directory
+ *
+ * Writes one "<file> <offset> <library> <name>" line per identified subroutine.
+ *
+ * @param index Index
+ * @param path File or directory
+ * @param stream Output stream
+ * @param stats Receives the counts (may be NULL)
+ * @return 1 if the path was read, 0 otherwise
+ */
+int nwnnsscomp_fingerprint_scan_path(const NwnFingerprintIndex* index, const char* path, FILE* stream,
+                                     NwnFingerprintStats* stats);
+
+/**
+ * @brief Load a saved index, merging it into index
+ *
+ * @return 1 on success, 0 if the file cannot be read or is not an index
+ */
+int nwnnsscomp_fingerprint_load(NwnFingerprintIndex* index, const char* path);
+
+/**
+ * @brief Save an index
+ *
+ * @return 1 on success, 0 if the file cannot be written
+ */
+int nwnnsscomp_fingerprint_save(const NwnFingerprintIndex* index, const char* path);
+
+#endif // NWNNSSCOMP_FINGERPRINT_H
@@ -0,0 +1,249 @@
+// ============================================================================
+// NWNNSSCOMP PER-COMPILE MEMORY ACCOUNTING
+// ============================================================================
+
+#include "nwnnsscomp_memory.h"
+
+#include <string.h>
+
+#include "nwnnsscomp_bench.h"
+
+static const char* const NWN_MEMORY_BUFFER_NAMES[NWN_MEMORY_BUFFER_COUNT] = {
+    "source", "code", "instructions", "script+0x28", "script+0x11c", "output", "growable"
+};
+
+const char* nwnnsscomp_memory_buffer_name(int buffer)
+{
+    return (buffer >= 0 && buffer < NWN_MEMORY_BUFFER_COUNT) ? NWN_MEMORY_BUFFER_NAMES[buffer] : "unknown";
+}
+
+/**
+ * @brief Clear the per-script state
+ */
+static void nwnnsscomp_memory_reset_script(NwnMemoryAccount* account)
+{
+    account->live.clear();
+    account->liveBytes = 0;
+    account->peakLiveBytes = 0;
+    account->allocations = 0;
+    account->allocatedBytes = 0;
+    for (int buffer = 0; buffer < NWN_MEMORY_BUFFER_COUNT; buffer++) {
+        account->buffers[buffer].reserved = 0;
+        account->buffers[buffer].used = NWNNSSCOMP_MEMORY_USED_UNKNOWN;
+        account->buffers[buffer].growths = 0;
+        account->growable[buffer] = NULL;
+    }
+}
+
+void nwnnsscomp_memory_init(NwnMemoryAccount* account, bool enabled, FILE* stream)
+{
+    account->enabled = enabled;
+    account->stream = stream;
+    account->script.clear();
+    account->inScript = false;
+    account->heapAllocationsStart = 0;
+    // Reserved so that tracking does not show up in heapAllocations
+    account->live.reserve(NWNNSSCOMP_MEMORY_LIVE_RESERVE);
+    nwnnsscomp_memory_reset_script(account);
+    account->scripts = 0;
+    account->maxPeakLiveBytes = 0;
+    account->maxAllocations = 0;
+    for (int buffer = 0; buffer < NWN_MEMORY_BUFFER_COUNT; buffer++) {
+        account->maxBuffers[buffer].reserved = 0;
+        account->maxBuffers[buffer].used = NWNNSSCOMP_MEMORY_USED_UNKNOWN;
+        account->maxBuffers[buffer].growths = 0;
+    }
+}
+
+void nwnnsscomp_memory_script_begin(NwnMemoryAccount* account, const char* script)
+{
+    if (!account->enabled) {
+        return;
+    }
+    if (account->inScript) {
+        nwnnsscomp_memory_script_end(account, "failed");
+    }
+    account->script = script != NULL ? script : "";
+    account->inScript = true;
+    nwnnsscomp_memory_reset_script(account);
+    account->heapAllocationsStart = nwnnsscomp_bench_allocations();
+}
+
+void nwnnsscomp_memory_alloc(NwnMemoryAccount* account, const void* pointer, uint64_t bytes)
+{
+    if (!account->enabled || !account->inScript || pointer == NULL) {
+        return;
+    }
+    account->live.push_back(std::make_pair(pointer, bytes));
+    account->liveBytes += bytes;
+    if (account->liveBytes > account->peakLiveBytes) {
+        account->peakLiveBytes = account->liveBytes;
+    }
+    account->allocations++;
+    account->allocatedBytes += bytes;
+}
+
+void nwnnsscomp_memory_free(NwnMemoryAccount* account, const void* pointer)
+{
+    if (!account->enabled || !account->inScript || pointer == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < account->live.size(); i++) {
+        if (account->live[i].first == pointer) {
+            account->liveBytes -= account->live[i].second;
+            account->live[i] = account->live.back();
+            account->live.pop_back();
+            break;
+        }
+    }
+}
+
+void nwnnsscomp_memory_capacity(NwnMemoryAccount* account, int buffer, uint64_t bytes, bool growth)
+{
+    if (!account->enabled || !account->inScript || buffer < 0 || buffer >= NWN_MEMORY_BUFFER_COUNT) {
+        return;
+    }
+    NwnBufferUsage* usage = &account->buffers[buffer];
+    if (bytes > usage->reserved) {
+        usage->reserved = bytes;
+    }
+    if (growth) {
+        usage->growths++;
+    }
+}
+
+void nwnnsscomp_memory_use(NwnMemoryAccount* account, int buffer, uint64_t bytes)
+{
+    if (!account->enabled || !account->inScript || buffer < 0 || buffer >= NWN_MEMORY_BUFFER_COUNT) {
+        return;
+    }
+    NwnBufferUsage* usage = &account->buffers[buffer];
+    if (usage->used == NWNNSSCOMP_MEMORY_USED_UNKNOWN || bytes > usage->used) {
+        usage->used = bytes;
+    }
+}
+
+void nwnnsscomp_memory_register(NwnMemoryAccount* account, int buffer, const void* structure)
+{
+    if (!account->enabled || buffer < 0 || buffer >= NWN_MEMORY_BUFFER_COUNT) {
+        return;
+    }
+    account->growable[buffer] = structure;
+}
+
+int nwnnsscomp_memory_buffer_of(const NwnMemoryAccount* account, const void* structure)
+{
+    for (int buffer = 0; buffer < NWN_MEMORY_BUFFER_COUNT; buffer++) {
+        if (account->growable[buffer] != NULL && account->growable[buffer] == structure) {
+            return buffer;
+        }
+    }
+    return NWN_MEMORY_GROWABLE;
+}
+
+/**
+ * @brief Write a JSON string literal (quotes, backslashes and control characters escaped)
+ */
+static void nwnnsscomp_memory_json_string(const std::string& text, FILE* stream)
+{
+    fputc('"', stream);
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\') {
+            fputc('\\', stream);
+            fputc(c, stream);
+        } else if (c < 0x20) {
+            fprintf(stream, "\\u%04x", c);
+        } else {
+            fputc(c, stream);
+        }
+    }
+    fputc('"', stream);
+}
+
+void nwnnsscomp_memory_script_end(NwnMemoryAccount* account, const char* status)
+{
+    if (!account->enabled || !account->inScript) {
+        return;
+    }
+    account->inScript = false;
+    long long heapAllocations = -1;
+    if (NWNNSSCOMP_BENCH_COUNT_ALLOCATIONS) {
+        heapAllocations = (long long)(nwnnsscomp_bench_allocations() - account->heapAllocationsStart);
+    }
+
+    account->scripts++;
+    if (account->peakLiveBytes > account->maxPeakLiveBytes) {
+        account->maxPeakLiveBytes = account->peakLiveBytes;
+    }
+    if (account->allocations > account->maxAllocations) {
+        account->maxAllocations = account->allocations;
+    }
+    for (int buffer = 0; buffer < NWN_MEMORY_BUFFER_COUNT; buffer++) {
+        const NwnBufferUsage* usage = &account->buffers[buffer];
+        NwnBufferUsage* largest = &account->maxBuffers[buffer];
+        if (usage->reserved > largest->reserved) {
+            largest->reserved = usage->reserved;
+        }
+        if (usage->used != NWNNSSCOMP_MEMORY_USED_UNKNOWN &&
+            (largest->used == NWNNSSCOMP_MEMORY_USED_UNKNOWN || usage->used > largest->used)) {
+            largest->used = usage->used;
+        }
+        if (usage->growths > largest->growths) {
+            largest->growths = usage->growths;
+        }
+    }
+
+    if (account->stream == NULL) {
+        return;
+    }
+    FILE* stream = account->stream;
+    fputs("{\"script\": ", stream);
+    nwnnsscomp_memory_json_string(account->script, stream);
+    fprintf(stream, ", \"status\": \"%s\", \"peakLiveBytes\": %llu, \"allocations\": %llu, \"allocatedBytes\": %llu, "
+                    "\"heapAllocations\": %lld, \"buffers\": {",
+            status, (unsigned long long)account->peakLiveBytes, (unsigned long long)account->allocations,
+            (unsigned long long)account->allocatedBytes, heapAllocations);
+    bool first = true;
+    for (int buffer = 0; buffer < NWN_MEMORY_BUFFER_COUNT; buffer++) {
+        const NwnBufferUsage* usage = &account->buffers[buffer];
+        if (usage->reserved == 0 && usage->used == NWNNSSCOMP_MEMORY_USED_UNKNOWN) {
+            continue;
+        }
+        fprintf(stream, "%s\"%s\": {\"reserved\": %llu, \"used\": ", first ? "" : ", ", NWN_MEMORY_BUFFER_NAMES[buffer],
+                (unsigned long long)usage->reserved);
+        if (usage->used == NWNNSSCOMP_MEMORY_USED_UNKNOWN) {
+            fputs("null", stream);
+        } else {
+            fprintf(stream, "%llu", (unsigned long long)usage->used);
+        }
+        fprintf(stream, ", \"growths\": %u}", usage->growths);
+        first = false;
+    }
+    fputs("}}\n", stream);
+}
+
+void nwnnsscomp_print_memory_table(const NwnMemoryAccount* account, FILE* stream)
+{
+    if (!account->enabled) {
+        return;
+    }
+    fprintf(stream, "\nMemory: %u scripts, peak live %llu bytes, at most %llu tracked allocations per script\n",
+            account->scripts, (unsigned long long)account->maxPeakLiveBytes,
+            (unsigned long long)account->maxAllocations);
+    fprintf(stream, "  %-14s %12s %12s %7s %8s\n", "buffer", "reserved", "used", "fill", "growths");
+    for (int buffer = 0; buffer < NWN_MEMORY_BUFFER_COUNT; buffer++) {
+        const NwnBufferUsage* usage = &account->maxBuffers[buffer];
+        if (usage->reserved == 0 && usage->used == NWNNSSCOMP_MEMORY_USED_UNKNOWN) {
+            continue;
+        }
+        if (usage->used == NWNNSSCOMP_MEMORY_USED_UNKNOWN) {
+            fprintf(stream, "  %-14s %12llu %12s %7s %8u\n", NWN_MEMORY_BUFFER_NAMES[buffer],
+                    (unsigned long long)usage->reserved, "-", "-", usage->growths);
+        } else {
+            fprintf(stream, "  %-14s %12llu %12llu %6.1f%% %8u\n", NWN_MEMORY_BUFFER_NAMES[buffer],
+                    (unsigned long long)usage->reserved, (unsigned long long)usage->used,
+                    usage->reserved != 0 ? 100.0 * usage->used / usage->reserved : 0.0, usage->growths);
+        }
+    }
+}
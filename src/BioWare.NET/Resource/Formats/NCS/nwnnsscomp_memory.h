@@ -0,0 +1,141 @@
+// ============================================================================
+// NWNNSSCOMP PER-COMPILE MEMORY ACCOUNTING
+// ============================================================================
+// Tracks, per compiled script, the allocations made at the compiler's own
+// allocation sites: peak live bytes, allocation count and bytes, and for
+// each fixed or growable buffer its reserved size, its high-water mark and
+// how often it grew. This is the data for right-sizing the preallocated
+// buffers and for budgeting memory per parallel worker.
+//
+// Each script produces one JSON line:
+//   {"script": "a.nss", "status": "passed", "peakLiveBytes": 1245184,
+//    "allocations": 9, "allocatedBytes": 1310720, "heapAllocations": 41,
+//    "buffers": {"source": {"reserved": 812, "used": 812, "growths": 0}, ...}}
+// where heapAllocations counts every operator new of the script (-1 when
+// NWNNSSCOMP_BENCH_COUNT_ALLOCATIONS is off) and "used" is null for a
+// buffer whose fill level is not known. The run ends with a table of the
+// largest values seen per buffer.
+// ============================================================================
+
+#ifndef NWNNSSCOMP_MEMORY_H
+#define NWNNSSCOMP_MEMORY_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+enum NwnMemoryBuffer
+{
+    NWN_MEMORY_SOURCE = 0,             // Source text (nwnnsscomp_read_file_to_memory)
+    NWN_MEMORY_CODE,                   // 0x9000 code buffer (nwnnsscomp_generate_bytecode)
+    NWN_MEMORY_INSTRUCTIONS,           // 36-byte instruction records (nwnnsscomp_expand_bytecode_buffer)
+    NWN_MEMORY_SCRIPT_0x28,            // Growable buffer at compiler+0x28, 0x40000 steps (finalize_main_script)
+    NWN_MEMORY_SCRIPT_0x11C,           // Growable buffer at compiler+0x11c, 0x40000 steps (finalize_main_script)
+    NWN_MEMORY_OUTPUT,                 // 0x80000 output buffer (nwnnsscomp_write_bytecode_to_file)
+    NWN_MEMORY_GROWABLE,               // Any other nwnnsscomp_expand_buffer_capacity buffer
+    NWN_MEMORY_BUFFER_COUNT
+};
+
+#define NWNNSSCOMP_MEMORY_USED_UNKNOWN  UINT64_MAX  // NwnBufferUsage::used before any fill level is reported
+#define NWNNSSCOMP_MEMORY_LIVE_RESERVE  64          // Live allocations tracked without the account allocating
+
+typedef struct NwnBufferUsage
+{
+    uint64_t reserved;                 // Largest capacity allocated
+    uint64_t used;                     // High-water mark, or NWNNSSCOMP_MEMORY_USED_UNKNOWN
+    uint32_t growths;                  // Reallocations to a larger capacity
+} NwnBufferUsage;
+
+typedef struct NwnMemoryAccount
+{
+    bool enabled;
+    FILE* stream;                      // JSON lines destination, NULL for totals only
+
+    // Current script
+    std::string script;
+    bool inScript;
+    std::vector<std::pair<const void*, uint64_t> > live;  // Tracked pointer and bytes (reserved up front)
+    uint64_t liveBytes;
+    uint64_t peakLiveBytes;
+    uint64_t allocations;
+    uint64_t allocatedBytes;
+    uint64_t heapAllocationsStart;     // nwnnsscomp_bench_allocations() at script start
+    NwnBufferUsage buffers[NWN_MEMORY_BUFFER_COUNT];
+    const void* growable[NWN_MEMORY_BUFFER_COUNT];   // Buffer structure registered per slot
+
+    // Whole run
+    uint32_t scripts;
+    uint64_t maxPeakLiveBytes;
+    uint64_t maxAllocations;
+    NwnBufferUsage maxBuffers[NWN_MEMORY_BUFFER_COUNT];  // Largest of each field over the run
+} NwnMemoryAccount;
+
+/**
+ * @brief Reset an account
+ *
+ * @param account Account
+ * @param enabled False to make every other call a no-op
+ * @param stream Destination of the per-script JSON lines, or NULL
+ */
+void nwnnsscomp_memory_init(NwnMemoryAccount* account, bool enabled, FILE* stream);
+
+/**
+ * @brief Start accounting a script (ends the previous one as failed if still open)
+ */
+void nwnnsscomp_memory_script_begin(NwnMemoryAccount* account, const char* script);
+
+/**
+ * @brief Finish the current script: write its JSON line and add it to the run maxima
+ *
+ * @param status "passed", "failed" or "include"
+ */
+void nwnnsscomp_memory_script_end(NwnMemoryAccount* account, const char* status);
+
+/**
+ * @brief Record an allocation made at a tracked site
+ */
+void nwnnsscomp_memory_alloc(NwnMemoryAccount* account, const void* pointer, uint64_t bytes);
+
+/**
+ * @brief Record the release of a tracked allocation (untracked pointers are ignored)
+ */
+void nwnnsscomp_memory_free(NwnMemoryAccount* account, const void* pointer);
+
+/**
+ * @brief Record the capacity of a buffer
+ *
+ * @param buffer NwnMemoryBuffer
+ * @param bytes Capacity just allocated
+ * @param growth True when this allocation replaces a smaller one
+ */
+void nwnnsscomp_memory_capacity(NwnMemoryAccount* account, int buffer, uint64_t bytes, bool growth);
+
+/**
+ * @brief Record how much of a buffer is in use (the high-water mark keeps the largest)
+ */
+void nwnnsscomp_memory_use(NwnMemoryAccount* account, int buffer, uint64_t bytes);
+
+/**
+ * @brief Associate a growable buffer structure with a slot for nwnnsscomp_memory_buffer_of
+ */
+void nwnnsscomp_memory_register(NwnMemoryAccount* account, int buffer, const void* structure);
+
+/**
+ * @brief Slot of a registered buffer structure, NWN_MEMORY_GROWABLE if not registered
+ */
+int nwnnsscomp_memory_buffer_of(const NwnMemoryAccount* account, const void* structure);
+
+/**
+ * @brief Print the run maxima: peak live bytes, allocations, and per buffer reserved, used and growths
+ */
+void nwnnsscomp_print_memory_table(const NwnMemoryAccount* account, FILE* stream);
+
+/**
+ * @brief Short buffer name ("source", "code", ...)
+ */
+const char* nwnnsscomp_memory_buffer_name(int buffer);
+
+#endif // NWNNSSCOMP_MEMORY_H
@@ -0,0 +1,969 @@
+// ============================================================================
+// NWNNSSCOMP BYTECODE OPTIMIZER - STACK-SLOT AND INLINING PASSES
+// ============================================================================
+
+#include "nwnnsscomp_optimizer.h"
+
+#include <string.h>
+
+#include <chrono>
+
+// ============================================================================
+// PROGRAM EDITING HELPERS
+// ============================================================================
+
+/**
+ * @brief Mark instructions that control can reach other than by fall-through
+ *
+ * A rewrite may only span instructions that are not entry points, except for
+ * its first instruction. Entry points are the program start, jump and JSR
+ * targets, JSR return sites and STORE_STATE resume blocks (STORE_STATE + 2).
+ */
+static void nwnnsscomp_mark_entry_points(const NcsProgram* program, std::vector<uint8_t>* entries)
+{
+    const std::vector<NcsInstruction>& instructions = program->instructions;
+    entries->assign(instructions.size() + 1, 0);
+    (*entries)[0] = 1;
+
+    for (size_t i = 0; i < instructions.size(); i++) {
+        const NcsInstruction& instruction = instructions[i];
+        if (instruction.jumpTarget >= 0) {
+            (*entries)[instruction.jumpTarget] = 1;
+        }
+        if (instruction.opcode == NCS_OP_JSR) {
+            (*entries)[i + 1] = 1;
+        }
+        else if (instruction.opcode == NCS_OP_STORE_STATE && i + 2 <= instructions.size()) {
+            (*entries)[i + 2] = 1;
+        }
+    }
+}
+
+/**
+ * @brief Delete flagged instructions and retarget jumps
+ *
+ * A jump whose target was deleted is redirected to the next surviving
+ * instruction, which is what control would have reached after the deleted
+ * (effect-free) sequence.
+ */
+static void nwnnsscomp_remove_instructions(NcsProgram* program, const std::vector<uint8_t>& removed)
+{
+    std::vector<NcsInstruction>& instructions = program->instructions;
+    size_t count = instructions.size();
+
+    // newIndex[i] = index of the first surviving instruction at or after i
+    std::vector<int32_t> newIndex(count + 1);
+    int32_t survivors = 0;
+    for (size_t i = 0; i < count; i++) {
+        newIndex[i] = survivors;
+        if (!removed[i]) {
+            survivors++;
+        }
+    }
+    newIndex[count] = survivors;
+
+    size_t write = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (removed[i]) {
+            continue;
+        }
+        if (write != i) {
+            instructions[write] = instructions[i];
+        }
+        if (instructions[write].jumpTarget >= 0) {
+            int32_t target = newIndex[instructions[write].jumpTarget];
+            instructions[write].jumpTarget = (target < survivors) ? target : survivors - 1;
+        }
+        write++;
+    }
+    instructions.resize(write);
+}
+
+/**
+ * @brief Bytes pushed by an instruction that only copies or creates a value
+ *
+ * @return Push size, or -1 if the instruction has any other effect
+ */
+static int nwnnsscomp_pure_push_size(const NcsInstruction* instruction)
+{
+    switch (instruction->opcode) {
+        case NCS_OP_CPTOPSP:
+        case NCS_OP_CPTOPBP:
+            return instruction->arg1;
+        case NCS_OP_CONST:
+        case NCS_OP_RSADD:
+            return NCS_STACK_ELEMENT_SIZE;
+        default:
+            return -1;
+    }
+}
+
+/**
+ * @brief True for qualifiers whose operands are single stack cells
+ */
+static bool nwnnsscomp_is_scalar_pair(uint8_t qualifier)
+{
+    switch (qualifier) {
+        case NCS_Q_INT_INT: case NCS_Q_FLOAT_FLOAT: case NCS_Q_OBJECT_OBJECT:
+        case NCS_Q_STRING_STRING: case NCS_Q_INT_FLOAT: case NCS_Q_FLOAT_INT:
+        case NCS_Q_EFFECT_EFFECT: case NCS_Q_EVENT_EVENT:
+        case NCS_Q_LOCATION_LOCATION: case NCS_Q_TALENT_TALENT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Stack effect of a straight-line expression instruction
+ *
+ * Only instructions that read nothing but their own operands (and, for
+ * CPTOPSP, one checked stack slot) are accepted; anything else ends an
+ * expression window.
+ *
+ * @param instruction Instruction to classify
+ * @param pops Receives bytes consumed from the top of the stack
+ * @param pushes Receives bytes pushed
+ * @return true if the instruction is a simple expression instruction
+ */
+static bool nwnnsscomp_expression_effect(const NcsInstruction* instruction, int* pops, int* pushes)
+{
+    *pops = 0;
+    *pushes = 0;
+
+    switch (instruction->opcode) {
+        case NCS_OP_CONST:
+            *pushes = NCS_STACK_ELEMENT_SIZE;
+            return true;
+        case NCS_OP_CPTOPSP:
+        case NCS_OP_CPTOPBP:
+            *pushes = instruction->arg1;
+            return true;
+        case NCS_OP_NEG: case NCS_OP_COMP: case NCS_OP_NOT:
+            if (instruction->qualifier != NCS_Q_INT && instruction->qualifier != NCS_Q_FLOAT) {
+                return false;
+            }
+            *pops = NCS_STACK_ELEMENT_SIZE;
+            *pushes = NCS_STACK_ELEMENT_SIZE;
+            return true;
+        case NCS_OP_LOGAND: case NCS_OP_LOGOR: case NCS_OP_INCOR: case NCS_OP_EXCOR:
+        case NCS_OP_BOOLAND: case NCS_OP_EQUAL: case NCS_OP_NEQUAL:
+        case NCS_OP_GEQ: case NCS_OP_GT: case NCS_OP_LT: case NCS_OP_LEQ:
+        case NCS_OP_SHLEFT: case NCS_OP_SHRIGHT: case NCS_OP_USHRIGHT:
+        case NCS_OP_ADD: case NCS_OP_SUB: case NCS_OP_MUL: case NCS_OP_DIV: case NCS_OP_MOD:
+            if (!nwnnsscomp_is_scalar_pair(instruction->qualifier)) {
+                return false;
+            }
+            *pops = 2 * NCS_STACK_ELEMENT_SIZE;
+            *pushes = NCS_STACK_ELEMENT_SIZE;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// ============================================================================
+// STACK-SLOT PASSES
+// ============================================================================
+
+/**
+ * @brief Merge adjacent MOVSP adjustments and drop MOVSP 0
+ *
+ * MOVSP a; MOVSP b  ->  MOVSP a+b
+ */
+static int nwnnsscomp_pass_merge_movsp(NcsProgram* program, const NcsOptimizerOptions*)
+{
+    std::vector<NcsInstruction>& instructions = program->instructions;
+    std::vector<uint8_t> entries;
+    nwnnsscomp_mark_entry_points(program, &entries);
+    std::vector<uint8_t> removed(instructions.size(), 0);
+    int rewrites = 0;
+
+    for (size_t i = 0; i < instructions.size(); i++) {
+        if (instructions[i].opcode != NCS_OP_MOVSP) {
+            continue;
+        }
+        size_t next = i + 1;
+        while (next < instructions.size() && instructions[next].opcode == NCS_OP_MOVSP && !entries[next]) {
+            instructions[i].arg0 += instructions[next].arg0;
+            removed[next] = 1;
+            rewrites++;
+            next++;
+        }
+        if (instructions[i].arg0 == 0) {
+            removed[i] = 1;
+            rewrites++;
+        }
+        i = next - 1;
+    }
+
+    if (rewrites > 0) {
+        nwnnsscomp_remove_instructions(program, removed);
+    }
+    return rewrites;
+}
+
+/**
+ * @brief Drop values that are pushed and immediately popped
+ *
+ * CPTOPSP o,n; MOVSP -m  ->  MOVSP -(m-n)     (m >= n, likewise CONSTx/RSADDx)
+ */
+static int nwnnsscomp_pass_drop_dead_push(NcsProgram* program, const NcsOptimizerOptions*)
+{
+    std::vector<NcsInstruction>& instructions = program->instructions;
+    std::vector<uint8_t> entries;
+    nwnnsscomp_mark_entry_points(program, &entries);
+    std::vector<uint8_t> removed(instructions.size(), 0);
+    int rewrites = 0;
+
+    for (size_t i = 0; i + 1 < instructions.size(); i++) {
+        int pushed = nwnnsscomp_pure_push_size(&instructions[i]);
+        NcsInstruction& pop = instructions[i + 1];
+        if (pushed <= 0 || pop.opcode != NCS_OP_MOVSP || entries[i + 1] || -pop.arg0 < pushed) {
+            continue;
+        }
+
+        removed[i] = 1;
+        pop.arg0 += pushed;
+        if (pop.arg0 == 0) {
+            removed[i + 1] = 1;
+        }
+        rewrites++;
+        i++;
+    }
+
+    if (rewrites > 0) {
+        nwnnsscomp_remove_instructions(program, removed);
+    }
+    return rewrites;
+}
+
+/**
+ * @brief Drop copies into slots that are popped straight afterwards
+ *
+ * CPDOWNSP o,n; MOVSP -m  ->  MOVSP -m     (when [o, o+n) lies within [-m, 0))
+ *
+ * Typical after inlining, where the callee's return-value store and the
+ * caller's cleanup of that value end up adjacent.
+ */
+static int nwnnsscomp_pass_drop_dead_store(NcsProgram* program, const NcsOptimizerOptions*)
+{
+    std::vector<NcsInstruction>& instructions = program->instructions;
+    std::vector<uint8_t> entries;
+    nwnnsscomp_mark_entry_points(program, &entries);
+    std::vector<uint8_t> removed(instructions.size(), 0);
+    int rewrites = 0;
+
+    for (size_t i = 0; i + 1 < instructions.size(); i++) {
+        const NcsInstruction& store = instructions[i];
+        const NcsInstruction& pop = instructions[i + 1];
+        if (store.opcode != NCS_OP_CPDOWNSP || pop.opcode != NCS_OP_MOVSP || entries[i + 1]) {
+            continue;
+        }
+        if (store.arg0 < pop.arg0 || store.arg0 + store.arg1 > 0) {
+            continue;
+        }
+        removed[i] = 1;
+        rewrites++;
+    }
+
+    if (rewrites > 0) {
+        nwnnsscomp_remove_instructions(program, removed);
+    }
+    return rewrites;
+}
+
+/**
+ * @brief Keep a stored value on the stack instead of reloading it
+ *
+ * CPDOWNSP o,n; MOVSP -n; CPTOPSP o+n,n  ->  CPDOWNSP o,n
+ * CPDOWNBP o,n; MOVSP -n; CPTOPBP o,n    ->  CPDOWNBP o,n
+ */
+static int nwnnsscomp_pass_forward_store(NcsProgram* program, const NcsOptimizerOptions*)
+{
+    std::vector<NcsInstruction>& instructions = program->instructions;
+    std::vector<uint8_t> entries;
+    nwnnsscomp_mark_entry_points(program, &entries);
+    std::vector<uint8_t> removed(instructions.size(), 0);
+    int rewrites = 0;
+
+    for (size_t i = 0; i + 2 < instructions.size(); i++) {
+        const NcsInstruction& store = instructions[i];
+        const NcsInstruction& pop = instructions[i + 1];
+        const NcsInstruction& load = instructions[i + 2];
+        if (entries[i + 1] || entries[i + 2] || pop.opcode != NCS_OP_MOVSP || pop.arg0 != -store.arg1) {
+            continue;
+        }
+
+        bool matches = false;
+        if (store.opcode == NCS_OP_CPDOWNSP && load.opcode == NCS_OP_CPTOPSP) {
+            matches = (load.arg0 == store.arg0 + store.arg1 && load.arg1 == store.arg1);
+        }
+        else if (store.opcode == NCS_OP_CPDOWNBP && load.opcode == NCS_OP_CPTOPBP) {
+            matches = (load.arg0 == store.arg0 && load.arg1 == store.arg1);
+        }
+        if (!matches) {
+            continue;
+        }
+
+        removed[i + 1] = 1;
+        removed[i + 2] = 1;
+        rewrites++;
+        i += 2;
+    }
+
+    if (rewrites > 0) {
+        nwnnsscomp_remove_instructions(program, removed);
+    }
+    return rewrites;
+}
+
+/**
+ * @brief Fold "x = x +/- 1" statements into in-place increments
+ *
+ * CPTOPSP o,4; CONSTI 1; ADDII; CPDOWNSP o-4,4; MOVSP -4  ->  INCISP o
+ * CPTOPBP o,4; CONSTI 1; ADDII; CPDOWNBP o,4;   MOVSP -4  ->  INCIBP o
+ * (SUBII folds to DECISP/DECIBP)
+ */
+static int nwnnsscomp_pass_fold_increment(NcsProgram* program, const NcsOptimizerOptions*)
+{
+    std::vector<NcsInstruction>& instructions = program->instructions;
+    std::vector<uint8_t> entries;
+    nwnnsscomp_mark_entry_points(program, &entries);
+    std::vector<uint8_t> removed(instructions.size(), 0);
+    int rewrites = 0;
+
+    for (size_t i = 0; i + 4 < instructions.size(); i++) {
+        NcsInstruction& load = instructions[i];
+        const NcsInstruction& one = instructions[i + 1];
+        const NcsInstruction& op = instructions[i + 2];
+        const NcsInstruction& store = instructions[i + 3];
+        const NcsInstruction& pop = instructions[i + 4];
+
+        if (entries[i + 1] || entries[i + 2] || entries[i + 3] || entries[i + 4]) {
+            continue;
+        }
+        if (one.opcode != NCS_OP_CONST || one.qualifier != NCS_Q_INT || one.arg0 != 1) {
+            continue;
+        }
+        if ((op.opcode != NCS_OP_ADD && op.opcode != NCS_OP_SUB) || op.qualifier != NCS_Q_INT_INT) {
+            continue;
+        }
+        if (pop.opcode != NCS_OP_MOVSP || pop.arg0 != -NCS_STACK_ELEMENT_SIZE) {
+            continue;
+        }
+        if (load.arg1 != NCS_STACK_ELEMENT_SIZE || store.arg1 != NCS_STACK_ELEMENT_SIZE) {
+            continue;
+        }
+
+        bool increment = (op.opcode == NCS_OP_ADD);
+        if (load.opcode == NCS_OP_CPTOPSP && store.opcode == NCS_OP_CPDOWNSP
+            && store.arg0 == load.arg0 - NCS_STACK_ELEMENT_SIZE) {
+            load.opcode = increment ? NCS_OP_INCSP : NCS_OP_DECSP;
+        }
+        else if (load.opcode == NCS_OP_CPTOPBP && store.opcode == NCS_OP_CPDOWNBP
+                 && store.arg0 == load.arg0) {
+            load.opcode = increment ? NCS_OP_INCBP : NCS_OP_DECBP;
+        }
+        else {
+            continue;
+        }
+
+        load.qualifier = NCS_Q_INT;
+        load.arg1 = 0;
+        removed[i + 1] = 1;
+        removed[i + 2] = 1;
+        removed[i + 3] = 1;
+        removed[i + 4] = 1;
+        rewrites++;
+        i += 4;
+    }
+
+    if (rewrites > 0) {
+        nwnnsscomp_remove_instructions(program, removed);
+    }
+    return rewrites;
+}
+
+/**
+ * @brief Evaluate initializers directly into the declared slot
+ *
+ * A declaration with an initializer reserves a slot, evaluates the
+ * expression into a temporary above it, copies the temporary down and pops
+ * it:
+ *
+ *     RSADDx; <expr>; CPDOWNSP -8,4; MOVSP -4  ->  <expr'>
+ *
+ * The expression is scheduled in place of the reservation, so its result
+ * becomes the variable. SP-relative reads inside <expr> that reach below
+ * the reserved slot are rebased by 4 bytes; a read of the reserved slot
+ * itself aborts the rewrite.
+ */
+static int nwnnsscomp_pass_coalesce_temporaries(NcsProgram* program, const NcsOptimizerOptions*)
+{
+    std::vector<NcsInstruction>& instructions = program->instructions;
+    std::vector<uint8_t> entries;
+    nwnnsscomp_mark_entry_points(program, &entries);
+    std::vector<uint8_t> removed(instructions.size(), 0);
+    std::vector<size_t> rebase;
+    int rewrites = 0;
+
+    for (size_t i = 0; i < instructions.size(); i++) {
+        const NcsInstruction& reserve = instructions[i];
+        if (reserve.opcode != NCS_OP_RSADD) {
+            continue;
+        }
+
+        // Walk the expression, tracking bytes pushed above the reserved slot
+        int depth = 0;
+        size_t j = i + 1;
+        bool valid = true;
+        rebase.clear();
+        while (j < instructions.size() && !entries[j]) {
+            const NcsInstruction& instruction = instructions[j];
+            if (instruction.opcode == NCS_OP_CPDOWNSP && depth == NCS_STACK_ELEMENT_SIZE) {
+                break;
+            }
+
+            int pops;
+            int pushes;
+            if (!nwnnsscomp_expression_effect(&instruction, &pops, &pushes) || pops > depth) {
+                valid = false;
+                break;
+            }
+
+            if (instruction.opcode == NCS_OP_CPTOPSP) {
+                int low = instruction.arg0;
+                int high = instruction.arg0 + instruction.arg1;
+                if (low >= -depth) {
+                    // Reads a temporary of this expression; unaffected
+                }
+                else if (high <= -depth - NCS_STACK_ELEMENT_SIZE) {
+                    rebase.push_back(j);
+                }
+                else {
+                    valid = false;                          // Touches the reserved slot
+                    break;
+                }
+            }
+
+            depth += pushes - pops;
+            j++;
+        }
+
+        if (!valid || j == i + 1 || j + 1 >= instructions.size() || entries[j] || entries[j + 1]) {
+            continue;
+        }
+        const NcsInstruction& store = instructions[j];
+        const NcsInstruction& pop = instructions[j + 1];
+        if (store.opcode != NCS_OP_CPDOWNSP || store.arg0 != -2 * NCS_STACK_ELEMENT_SIZE
+            || store.arg1 != NCS_STACK_ELEMENT_SIZE
+            || pop.opcode != NCS_OP_MOVSP || pop.arg0 != -NCS_STACK_ELEMENT_SIZE) {
+            continue;
+        }
+
+        for (size_t k = 0; k < rebase.size(); k++) {
+            instructions[rebase[k]].arg0 += NCS_STACK_ELEMENT_SIZE;
+        }
+        removed[i] = 1;
+        removed[j] = 1;
+        removed[j + 1] = 1;
+        rewrites++;
+        i = j + 1;
+    }
+
+    if (rewrites > 0) {
+        nwnnsscomp_remove_instructions(program, removed);
+    }
+    return rewrites;
+}
+
+// ============================================================================
+// INLINING PASSES
+// ============================================================================
+
+#define NWNNSSCOMP_CALL_OVERHEAD_BYTES  (NCS_JUMP_SIZE + 2)   // JSR + RETN
+
+/**
+ * @brief Inlining candidate: one subroutine and its call sites
+ */
+typedef struct NcsInlineCandidate
+{
+    size_t entry;                      // Index of the first body instruction (JSR target)
+    size_t retn;                       // Index of the subroutine's only RETN
+    uint32_t bodyBytes;                // Encoded size of [entry, retn)
+    int callSites;                     // Number of JSRs targeting entry
+    bool inlinable;
+} NcsInlineCandidate;
+
+/**
+ * @brief Decide whether the subroutine at entry can be substituted at call sites
+ *
+ * The body is [entry, retn] where retn is the first RETN reached in layout
+ * order. It qualifies when it is self-contained: no jump in the body leaves
+ * it, no jump outside it lands past its entry, it does not call itself, and
+ * it contains no SAVEBP/RESTOREBP (global initialisation) or STORE_STATE
+ * (its deferred block would bring a second RETN). Recursion through other
+ * subroutines is ruled out afterwards by nwnnsscomp_exclude_call_cycles.
+ */
+static bool nwnnsscomp_analyze_inline_candidate(const NcsProgram* program, NcsInlineCandidate* candidate)
+{
+    const std::vector<NcsInstruction>& instructions = program->instructions;
+    size_t entry = candidate->entry;
+
+    size_t retn = entry;
+    while (retn < instructions.size() && instructions[retn].opcode != NCS_OP_RETN) {
+        retn++;
+    }
+    if (retn >= instructions.size()) {
+        return false;
+    }
+    candidate->retn = retn;
+    candidate->bodyBytes = 0;
+
+    for (size_t i = entry; i < retn; i++) {
+        const NcsInstruction& instruction = instructions[i];
+        switch (instruction.opcode) {
+            case NCS_OP_SAVEBP:
+            case NCS_OP_RESTOREBP:
+            case NCS_OP_STORE_STATE:
+                return false;
+            case NCS_OP_JSR:
+                if ((size_t)instruction.jumpTarget == entry) {
+                    return false;                           // Directly recursive
+                }
+                break;
+            case NCS_OP_JMP: case NCS_OP_JZ: case NCS_OP_JNZ:
+                if ((size_t)instruction.jumpTarget < entry || (size_t)instruction.jumpTarget > retn) {
+                    return false;
+                }
+                break;
+            default:
+                break;
+        }
+        candidate->bodyBytes += ncs_instruction_size(&instruction);
+    }
+
+    // Nothing outside the body may branch into its middle
+    for (size_t i = 0; i < instructions.size(); i++) {
+        if (i >= entry && i <= retn) {
+            continue;
+        }
+        int32_t target = instructions[i].jumpTarget;
+        if (target > (int32_t)entry && target <= (int32_t)retn) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Mark every candidate that lies on a call cycle as not inlinable
+ *
+ * A subroutine that reaches itself through other subroutines (a nontrivial
+ * strongly connected component of the call graph) would otherwise be
+ * spliced into its partners on every round without the cycle ever closing.
+ */
+static void nwnnsscomp_exclude_call_cycles(const NcsProgram* program, std::vector<NcsInlineCandidate>* candidates,
+                                           const std::vector<int32_t>& candidateOf)
+{
+    const std::vector<NcsInstruction>& instructions = program->instructions;
+    size_t count = candidates->size();
+
+    // Callees of each candidate, from the JSRs up to its first RETN
+    std::vector<std::vector<int32_t> > callees(count);
+    for (size_t c = 0; c < count; c++) {
+        for (size_t i = (*candidates)[c].entry; i < instructions.size(); i++) {
+            if (instructions[i].opcode == NCS_OP_RETN) {
+                break;
+            }
+            if (instructions[i].opcode == NCS_OP_JSR) {
+                callees[c].push_back(candidateOf[instructions[i].jumpTarget]);
+            }
+        }
+    }
+
+    std::vector<uint32_t> visited(count, 0);
+    std::vector<int32_t> work;
+    for (size_t c = 0; c < count; c++) {
+        uint32_t mark = (uint32_t)c + 1;
+        work.assign(callees[c].begin(), callees[c].end());
+        while (!work.empty()) {
+            int32_t callee = work.back();
+            work.pop_back();
+            if (callee == (int32_t)c) {
+                (*candidates)[c].inlinable = false;
+                break;
+            }
+            if (visited[callee] == mark) {
+                continue;
+            }
+            visited[callee] = mark;
+            work.insert(work.end(), callees[callee].begin(), callees[callee].end());
+        }
+    }
+}
+
+/**
+ * @brief Size-based inlining cost model
+ *
+ * A body no larger than the JSR/RETN pair it replaces is always inlined.
+ * Otherwise the body is inlined at every site when it fits inlineSizeLimit,
+ * or at its only site when it fits inlineSingleCallLimit, since the
+ * out-of-line copy then becomes unreachable and is removed.
+ */
+static bool nwnnsscomp_should_inline(const NcsInlineCandidate* candidate, const NcsOptimizerOptions* options)
+{
+    if (!candidate->inlinable || options->inlineSizeLimit == 0) {
+        return false;
+    }
+    if (candidate->bodyBytes <= NWNNSSCOMP_CALL_OVERHEAD_BYTES) {
+        return true;
+    }
+    if (candidate->bodyBytes <= options->inlineSizeLimit) {
+        return true;
+    }
+    return candidate->callSites == 1 && candidate->bodyBytes <= options->inlineSingleCallLimit;
+}
+
+/**
+ * @brief Substitute small non-recursive subroutine bodies at JSR call sites
+ *
+ * Because NCS keeps return addresses on a separate return stack, a callee
+ * body runs identically when spliced in place of the JSR: it sees the same
+ * value stack, cleans up its own arguments and leaves the return value in
+ * the caller-reserved slot. The trailing RETN is dropped and jumps to it
+ * become jumps to the instruction after the call. The now-adjacent stack
+ * adjustments are merged by the stack-slot passes that run afterwards.
+ */
+static int nwnnsscomp_pass_inline_calls(NcsProgram* program, const NcsOptimizerOptions* options)
+{
+    std::vector<NcsInstruction>& instructions = program->instructions;
+    size_t count = instructions.size();
+
+    // Collect subroutines and count their call sites
+    std::vector<int32_t> candidateOf(count, -1);
+    std::vector<NcsInlineCandidate> candidates;
+    for (size_t i = 0; i < count; i++) {
+        if (instructions[i].opcode != NCS_OP_JSR) {
+            continue;
+        }
+        size_t entry = (size_t)instructions[i].jumpTarget;
+        if (candidateOf[entry] < 0) {
+            NcsInlineCandidate candidate;
+            candidate.entry = entry;
+            candidate.retn = entry;
+            candidate.bodyBytes = 0;
+            candidate.callSites = 0;
+            candidate.inlinable = false;
+            candidateOf[entry] = (int32_t)candidates.size();
+            candidates.push_back(candidate);
+        }
+        candidates[candidateOf[entry]].callSites++;
+    }
+    for (size_t c = 0; c < candidates.size(); c++) {
+        candidates[c].inlinable = nwnnsscomp_analyze_inline_candidate(program, &candidates[c]);
+    }
+    nwnnsscomp_exclude_call_cycles(program, &candidates, candidateOf);
+
+    // Choose the call sites to expand; a site inside its own callee is left alone
+    std::vector<int32_t> expand(count, -1);
+    int rewrites = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (instructions[i].opcode != NCS_OP_JSR) {
+            continue;
+        }
+        int32_t c = candidateOf[instructions[i].jumpTarget];
+        const NcsInlineCandidate& candidate = candidates[c];
+        if (!nwnnsscomp_should_inline(&candidate, options)) {
+            continue;
+        }
+        if (i >= candidate.entry && i <= candidate.retn) {
+            continue;
+        }
+        expand[i] = c;
+        rewrites++;
+    }
+    if (rewrites == 0) {
+        return 0;
+    }
+
+    // Map every original instruction to its new index; an expanded JSR maps
+    // to the first instruction of its inlined copy
+    std::vector<int32_t> newIndex(count + 1);
+    int32_t position = 0;
+    for (size_t i = 0; i < count; i++) {
+        newIndex[i] = position;
+        position += (expand[i] >= 0)
+            ? (int32_t)(candidates[expand[i]].retn - candidates[expand[i]].entry)
+            : 1;
+    }
+    newIndex[count] = position;
+
+    std::vector<NcsInstruction> rewritten;
+    rewritten.reserve(position);
+    for (size_t i = 0; i < count; i++) {
+        if (expand[i] < 0) {
+            NcsInstruction copy = instructions[i];
+            if (copy.jumpTarget >= 0) {
+                copy.jumpTarget = newIndex[copy.jumpTarget];
+            }
+            rewritten.push_back(copy);
+            continue;
+        }
+
+        const NcsInlineCandidate& candidate = candidates[expand[i]];
+        int32_t copyStart = newIndex[i];
+        for (size_t k = candidate.entry; k < candidate.retn; k++) {
+            NcsInstruction copy = instructions[k];
+            if (copy.jumpTarget >= 0) {
+                if (copy.opcode == NCS_OP_JSR) {
+                    copy.jumpTarget = newIndex[copy.jumpTarget];
+                }
+                else {
+                    // Internal branch; a branch to the RETN lands after the copy
+                    copy.jumpTarget = copyStart + (int32_t)((size_t)copy.jumpTarget - candidate.entry);
+                }
+            }
+            rewritten.push_back(copy);
+        }
+    }
+
+    instructions.swap(rewritten);
+    return rewrites;
+}
+
+/**
+ * @brief Remove code that no control path reaches
+ *
+ * Reachability starts at instruction 0 and follows fall-through, jump and
+ * JSR targets, and STORE_STATE resume blocks. Subroutines whose every call
+ * site was inlined become unreachable and are dropped here.
+ */
+static int nwnnsscomp_pass_remove_unreachable(NcsProgram* program, const NcsOptimizerOptions*)
+{
+    std::vector<NcsInstruction>& instructions = program->instructions;
+    size_t count = instructions.size();
+    if (count == 0) {
+        return 0;
+    }
+
+    std::vector<uint8_t> reached(count, 0);
+    std::vector<size_t> work;
+    work.push_back(0);
+    while (!work.empty()) {
+        size_t i = work.back();
+        work.pop_back();
+        while (i < count && !reached[i]) {
+            reached[i] = 1;
+            const NcsInstruction& instruction = instructions[i];
+            if (instruction.jumpTarget >= 0) {
+                work.push_back((size_t)instruction.jumpTarget);
+            }
+            if (instruction.opcode == NCS_OP_STORE_STATE) {
+                work.push_back(i + 2);
+            }
+            if (ncs_is_terminator(instruction.opcode)) {
+                break;
+            }
+            i++;
+        }
+    }
+
+    std::vector<uint8_t> removed(count, 0);
+    int rewrites = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!reached[i]) {
+            removed[i] = 1;
+            rewrites++;
+        }
+    }
+    if (rewrites > 0) {
+        nwnnsscomp_remove_instructions(program, removed);
+    }
+    return rewrites;
+}
+
+// ============================================================================
+// PIPELINE
+// ============================================================================
+
+static const NcsOptimizerPass g_nwnnsscompInlinePasses[] = {
+    { "inline-calls",         nwnnsscomp_pass_inline_calls },
+    { "remove-unreachable",   nwnnsscomp_pass_remove_unreachable },
+};
+
+static const NcsOptimizerPass g_nwnnsscompStackPasses[] = {
+    { "coalesce-temporaries", nwnnsscomp_pass_coalesce_temporaries },
+    { "fold-increment",       nwnnsscomp_pass_fold_increment },
+    { "forward-store",        nwnnsscomp_pass_forward_store },
+    { "drop-dead-store",      nwnnsscomp_pass_drop_dead_store },
+    { "drop-dead-push",       nwnnsscomp_pass_drop_dead_push },
+    { "merge-movsp",          nwnnsscomp_pass_merge_movsp },
+};
+
+void nwnnsscomp_optimizer_options_for_level(int level, NcsOptimizerOptions* options)
+{
+    if (level < 0) {
+        level = 0;
+    }
+    if (level > NWNNSSCOMP_OPT_LEVEL_MAX) {
+        level = NWNNSSCOMP_OPT_LEVEL_MAX;
+    }
+
+    options->level = level;
+    switch (level) {
+        case 0:
+        case 1:
+            options->inlineSizeLimit = 0;
+            options->inlineSingleCallLimit = 0;
+            options->inlineMaxRounds = 0;
+            break;
+        case 2:
+            options->inlineSizeLimit = 48;
+            options->inlineSingleCallLimit = 256;
+            options->inlineMaxRounds = 4;
+            break;
+        default:
+            options->inlineSizeLimit = 128;
+            options->inlineSingleCallLimit = 1024;
+            options->inlineMaxRounds = 8;
+            break;
+    }
+}
+
+void nwnnsscomp_default_optimizer_options(NcsOptimizerOptions* options)
+{
+    nwnnsscomp_optimizer_options_for_level(NWNNSSCOMP_OPT_LEVEL_DEFAULT, options);
+}
+
+/**
+ * @brief Find or append the stats entry for a pass
+ */
+static NcsOptimizerPassStats* nwnnsscomp_report_entry(NcsOptimizerReport* report, const char* name)
+{
+    for (size_t i = 0; i < report->passes.size(); i++) {
+        if (strcmp(report->passes[i].name, name) == 0) {
+            return &report->passes[i];
+        }
+    }
+
+    NcsOptimizerPassStats stats;
+    stats.name = name;
+    stats.runs = 0;
+    stats.rewrites = 0;
+    stats.milliseconds = 0.0;
+    stats.bytesDelta = 0;
+    report->passes.push_back(stats);
+    return &report->passes.back();
+}
+
+/**
+ * @brief Run one pass, accumulating its time and size delta when reporting
+ */
+static int nwnnsscomp_run_pass(const NcsOptimizerPass* pass, NcsProgram* program,
+                               const NcsOptimizerOptions* options, NcsOptimizerReport* report)
+{
+    if (report == NULL) {
+        return pass->run(program, options);
+    }
+
+    uint32_t sizeBefore = ncs_program_size(program);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int rewrites = pass->run(program, options);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    NcsOptimizerPassStats* stats = nwnnsscomp_report_entry(report, pass->name);
+    stats->runs++;
+    stats->rewrites += rewrites;
+    stats->milliseconds += elapsed.count();
+    stats->bytesDelta += (int64_t)ncs_program_size(program) - (int64_t)sizeBefore;
+    return rewrites;
+}
+
+int nwnnsscomp_optimize_program(NcsProgram* program, const NcsOptimizerOptions* options,
+                                NcsOptimizerReport* report)
+{
+    NcsOptimizerOptions defaults;
+    if (options == NULL) {
+        nwnnsscomp_default_optimizer_options(&defaults);
+        options = &defaults;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (report != NULL) {
+        report->level = options->level;
+        report->passes.clear();
+        report->sizeBefore = ncs_program_size(program);
+    }
+
+    const size_t inlinePassCount = sizeof(g_nwnnsscompInlinePasses) / sizeof(g_nwnnsscompInlinePasses[0]);
+    const size_t stackPassCount = sizeof(g_nwnnsscompStackPasses) / sizeof(g_nwnnsscompStackPasses[0]);
+    int total = 0;
+    int rewrites;
+
+    if (options->level > 0) {
+        // Inline first so the stack passes see the spliced prologues and epilogues.
+        // Sites inside a body being copied are expanded in the next round.
+        for (uint32_t round = 0; round < options->inlineMaxRounds; round++) {
+            rewrites = 0;
+            for (size_t p = 0; p < inlinePassCount; p++) {
+                rewrites += nwnnsscomp_run_pass(&g_nwnnsscompInlinePasses[p], program, options, report);
+            }
+            total += rewrites;
+            if (rewrites == 0) {
+                break;
+            }
+        }
+
+        // One rewrite can expose another (e.g. a dropped push leaves two MOVSPs adjacent)
+        do {
+            rewrites = 0;
+            for (size_t p = 0; p < stackPassCount; p++) {
+                rewrites += nwnnsscomp_run_pass(&g_nwnnsscompStackPasses[p], program, options, report);
+            }
+            total += rewrites;
+        } while (rewrites > 0);
+    }
+
+    if (report != NULL) {
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        report->sizeAfter = ncs_program_size(program);
+        report->milliseconds = elapsed.count();
+    }
+    return total;
+}
+
+void nwnnsscomp_print_optimizer_report(const NcsOptimizerReport* report, FILE* stream)
+{
+    fprintf(stream, "  -O%d: %u -> %u bytes (%+lld) in %.3f ms\n",
+            report->level, report->sizeBefore, report->sizeAfter,
+            (long long)report->sizeAfter - (long long)report->sizeBefore, report->milliseconds);
+    for (size_t i = 0; i < report->passes.size(); i++) {
+        const NcsOptimizerPassStats& stats = report->passes[i];
+        fprintf(stream, "    %-22s runs %3d  rewrites %5d  %+8lld bytes  %9.3f ms\n",
+                stats.name, stats.runs, stats.rewrites, (long long)stats.bytesDelta, stats.milliseconds);
+    }
+}
+
+int nwnnsscomp_optimize_bytecode(uint8_t* buffer, uint32_t* size, uint32_t capacity,
+                                 const NcsOptimizerOptions* options, NcsOptimizerReport* report)
+{
+    NcsProgram program;
+    if (ncs_decode_program(buffer, *size, &program) != NCS_OK || program.instructions.empty()) {
+        return -1;
+    }
+    if (nwnnsscomp_optimize_program(&program, options, report) == 0) {
+        return 0;
+    }
+
+    std::vector<uint8_t> encoded;
+    if (ncs_encode_program(&program, &encoded) != NCS_OK || encoded.size() > capacity) {
+        return -1;
+    }
+
+    memcpy(buffer, encoded.data(), encoded.size());
+    *size = (uint32_t)encoded.size();
+    return 1;
+}
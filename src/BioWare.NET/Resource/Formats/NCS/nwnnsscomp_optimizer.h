@@ -0,0 +1,123 @@
+// ============================================================================
+// NWNNSSCOMP BYTECODE OPTIMIZER
+// ============================================================================
+// Post-codegen passes over the serialized NCS instruction stream. The
+// reverse-engineered code generator emits every local access as a
+// CPTOPSP/CPDOWNSP/MOVSP round trip; these passes rewrite the decoded
+// program (see ncs_bytecode.h) so values already on top of the stack are
+// reused and temporaries are coalesced into their destination slots, and
+// small subroutines are inlined at their JSR call sites.
+// ============================================================================
+
+#ifndef NWNNSSCOMP_OPTIMIZER_H
+#define NWNNSSCOMP_OPTIMIZER_H
+
+#include <stdio.h>
+
+#include "ncs_bytecode.h"
+
+#define NWNNSSCOMP_OPT_LEVEL_MAX        3
+#define NWNNSSCOMP_OPT_LEVEL_DEFAULT    2    // Level selected by a bare -O; the compiler itself defaults to -O0
+
+/**
+ * @brief Tuning knobs for the optimization pipeline
+ */
+typedef struct NcsOptimizerOptions
+{
+    int level;                         // -O level the options were derived from (0 = no passes)
+    uint32_t inlineSizeLimit;          // Max callee body bytes inlined at every call site (0 = no inlining)
+    uint32_t inlineSingleCallLimit;    // Max callee body bytes inlined when the callee has one call site
+    uint32_t inlineMaxRounds;          // Inline/cleanup rounds; each round flattens one more call level
+} NcsOptimizerOptions;
+
+/**
+ * @brief Bytecode optimization pass
+ *
+ * @return Number of rewrites performed (0 when the program is unchanged)
+ */
+typedef int (*NcsOptimizerPassFn)(NcsProgram* program, const NcsOptimizerOptions* options);
+
+typedef struct NcsOptimizerPass
+{
+    const char* name;                  // Short pass name used in reports
+    NcsOptimizerPassFn run;            // Pass entry point
+} NcsOptimizerPass;
+
+/**
+ * @brief Accumulated cost and effect of one pass over a pipeline run
+ */
+typedef struct NcsOptimizerPassStats
+{
+    const char* name;                  // Pass name (see NcsOptimizerPass)
+    int runs;                          // Times the pass was invoked
+    int rewrites;                      // Rewrites performed across all runs
+    double milliseconds;               // Wall time across all runs
+    int64_t bytesDelta;                // Encoded size change across all runs (negative = smaller)
+} NcsOptimizerPassStats;
+
+/**
+ * @brief Per-pass report for one optimized script
+ */
+typedef struct NcsOptimizerReport
+{
+    int level;                         // Level the pipeline ran at
+    uint32_t sizeBefore;               // Encoded size before the first pass
+    uint32_t sizeAfter;                // Encoded size after the last pass
+    double milliseconds;               // Total pipeline wall time
+    std::vector<NcsOptimizerPassStats> passes;
+} NcsOptimizerReport;
+
+/**
+ * @brief Fill options for an optimization level
+ *
+ * -O0 runs nothing, -O1 runs the stack-slot passes, -O2 adds inlining with
+ * the default budget and -O3 raises the inlining budget.
+ *
+ * @param level Level 0..NWNNSSCOMP_OPT_LEVEL_MAX (clamped)
+ * @param options Receives the level's pipeline options
+ */
+void nwnnsscomp_optimizer_options_for_level(int level, NcsOptimizerOptions* options);
+
+/**
+ * @brief Fill options for NWNNSSCOMP_OPT_LEVEL_DEFAULT
+ */
+void nwnnsscomp_default_optimizer_options(NcsOptimizerOptions* options);
+
+/**
+ * @brief Inline small subroutines, then run the stack-slot passes until none apply
+ *
+ * @param program Program to rewrite in place
+ * @param options Pipeline options, or NULL for the defaults
+ * @param report Receives per-pass timing and size deltas, or NULL
+ * @return Total number of rewrites performed
+ */
+int nwnnsscomp_optimize_program(NcsProgram* program, const NcsOptimizerOptions* options,
+                                NcsOptimizerReport* report);
+
+/**
+ * @brief Print a per-pass timing and size table
+ *
+ * @param report Report filled by nwnnsscomp_optimize_program
+ * @param stream Output stream (usually stdout)
+ */
+void nwnnsscomp_print_optimizer_report(const NcsOptimizerReport* report, FILE* stream);
+
+/**
+ * @brief Optimize a serialized "NCS V1.0B" buffer in place
+ *
+ * The buffer is left untouched when it does not decode cleanly (including
+ * a header whose size field does not cover any instructions) or when the
+ * optimized program would not fit in capacity.
+ *
+ * @param buffer Serialized bytecode (header included)
+ * @param size In: current byte count, out: optimized byte count
+ * @param capacity Writable size of buffer
+ * @param options Pipeline options, or NULL for the defaults
+ * @param report Receives per-pass timing and size deltas, or NULL
+ * @return 1 if the buffer was rewritten, 0 if no pass applied, -1 if the
+ *         buffer does not decode or the result does not fit
+ */
+int nwnnsscomp_optimize_bytecode(uint8_t* buffer, uint32_t* size, uint32_t capacity,
+                                 const NcsOptimizerOptions* options, NcsOptimizerReport* report);
+
+#endif // NWNNSSCOMP_OPTIMIZER_H
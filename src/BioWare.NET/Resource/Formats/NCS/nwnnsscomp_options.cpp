@@ -0,0 +1,157 @@
+// ============================================================================
+// NWNNSSCOMP EXTENDED COMMAND-LINE OPTIONS
+// ============================================================================
+
+#include "nwnnsscomp_options.h"
+
+#include <stdlib.h>
+
+#include "nwnnsscomp_disasm.h"
+#include "nwnnsscomp_optimizer.h"
+
+int g_optimizationLevel = 0;
+int g_optimizerReportEnabled = 0;
+int g_sizeReportEnabled = 0;
+
+const char* g_roundtripCorpus = NULL;
+uint32_t g_roundtripThreads = 0;
+const char* g_roundtripSummaryPath = NULL;
+
+int g_disassembleFormat = -1;
+int g_diffEnabled = 0;
+
+const char* g_fingerprintBuildIndex = NULL;
+const char* g_fingerprintScanIndex = NULL;
+
+const char* g_benchCorpus = NULL;
+const char* g_benchBaselinePath = NULL;
+uint32_t g_benchIterations = 0;
+
+int g_phaseTimingEnabled = 0;
+const char* g_phaseTimingPath = NULL;
+const char* g_tracePath = NULL;
+int g_memoryAccountingEnabled = 0;
+const char* g_memoryAccountingPath = NULL;
+
+int nwnnsscomp_parse_extended_option(const char* arg)
+{
+    if (arg == NULL || arg[0] != '-') {
+        return 0;
+    }
+
+    if (arg[1] == 'O' && arg[2] == '\0') {
+        g_optimizationLevel = NWNNSSCOMP_OPT_LEVEL_DEFAULT;
+        return 1;
+    }
+    if (arg[1] == 'O' && arg[2] >= '0' && arg[2] <= '0' + NWNNSSCOMP_OPT_LEVEL_MAX && arg[3] == '\0') {
+        g_optimizationLevel = arg[2] - '0';
+        return 1;
+    }
+    if (arg[1] == 'P' && arg[2] == '\0') {
+        g_optimizerReportEnabled = 1;
+        return 1;
+    }
+    if (arg[1] == 'S' && arg[2] == '\0') {
+        g_sizeReportEnabled = 1;
+        return 1;
+    }
+    if (arg[1] == 'R' && arg[2] != '\0') {
+        g_roundtripCorpus = arg + 2;
+        return 1;
+    }
+    if (arg[1] == 'j' && arg[2] >= '0' && arg[2] <= '9') {
+        g_roundtripThreads = (uint32_t)strtoul(arg + 2, NULL, 10);
+        return 1;
+    }
+    if (arg[1] == 'J' && arg[2] != '\0') {
+        g_roundtripSummaryPath = arg + 2;
+        return 1;
+    }
+    if (arg[1] == 'L' && arg[2] == '\0') {
+        g_disassembleFormat = NWN_DISASM_TEXT;
+        return 1;
+    }
+    if (arg[1] == 'L' && arg[2] == 'j' && arg[3] == '\0') {
+        g_disassembleFormat = NWN_DISASM_JSON_LINES;
+        return 1;
+    }
+    if (arg[1] == 'X' && arg[2] == '\0') {
+        g_diffEnabled = 1;
+        return 1;
+    }
+    if (arg[1] == 'K' && arg[2] != '\0') {
+        g_fingerprintBuildIndex = arg + 2;
+        return 1;
+    }
+    if (arg[1] == 'k' && arg[2] != '\0') {
+        g_fingerprintScanIndex = arg + 2;
+        return 1;
+    }
+    if (arg[1] == 'Y' && arg[2] != '\0') {
+        g_benchCorpus = arg + 2;
+        return 1;
+    }
+    if (arg[1] == 'B' && arg[2] != '\0') {
+        g_benchBaselinePath = arg + 2;
+        return 1;
+    }
+    if (arg[1] == 'N' && arg[2] >= '0' && arg[2] <= '9') {
+        g_benchIterations = (uint32_t)strtoul(arg + 2, NULL, 10);
+        return 1;
+    }
+    if (arg[1] == 'T' && (arg[2] == '\0' || (arg[2] == '=' && arg[3] != '\0'))) {
+        g_phaseTimingEnabled = 1;
+        g_phaseTimingPath = arg[2] != '\0' ? arg + 3 : NULL;
+        return 1;
+    }
+    if (arg[1] == 'Z' && arg[2] != '\0') {
+        g_tracePath = arg + 2;
+        return 1;
+    }
+    if (arg[1] == 'M' && (arg[2] == '\0' || (arg[2] == '=' && arg[3] != '\0'))) {
+        g_memoryAccountingEnabled = 1;
+        g_memoryAccountingPath = arg[2] != '\0' ? arg + 3 : NULL;
+        return 1;
+    }
+    return 0;
+}
+
+int nwnnsscomp_consume_extended_options(int argc, char** argv)
+{
+    int kept = 1;
+    for (int index = 1; index < argc; index++) {
+        if (!nwnnsscomp_parse_extended_option(argv[index])) {
+            argv[kept++] = argv[index];
+        }
+    }
+    argv[kept] = NULL;
+    return kept;
+}
+
+int nwnnsscomp_effective_optimization_level(int debugEnabled)
+{
+    return debugEnabled ? 0 : g_optimizationLevel;
+}
+
+void nwnnsscomp_print_extended_usage(FILE* stream)
+{
+    fputs("Extended options:\n"
+          "  -O0..-O3      Optimization level (default -O0, output identical to the original;\n"
+          "                -O alone is -O2; ignored with -d, which always compiles at -O0)\n"
+          "  -P            Print per-pass optimizer timing and size deltas after each script\n"
+          "  -S            Write a per-function size report next to each .ncs\n"
+          "  -R<dir>       Round-trip every script below dir\n"
+          "  -j<n>         Round-trip worker threads (0 = one per core)\n"
+          "  -J<path>      Round-trip or benchmark JSON results (default stdout)\n"
+          "  -L, -Lj       Disassemble the inputs as text or JSON lines\n"
+          "  -X            Structural diff of two .ncs files or two directories\n"
+          "  -K<index>     Add the inputs' subroutines to a fingerprint index\n"
+          "  -k<index>     Name the inputs' subroutines found in a fingerprint index\n"
+          "  -Y<dir>       Benchmark compiling every .nss below dir\n"
+          "  -N<n>         Benchmark timed passes\n"
+          "  -B<path>      Fail on a regression against a baseline benchmark JSON\n"
+          "  -T, -T=<path> Per-phase compile timing on stderr or in path\n"
+          "  -Z<path>      Chrome trace-event JSON of the run\n"
+          "  -M, -M=<path> Per-script memory use on stderr or in path\n",
+          stream);
+}
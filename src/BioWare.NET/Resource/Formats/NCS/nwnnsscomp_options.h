@@ -0,0 +1,109 @@
+// ============================================================================
+// NWNNSSCOMP EXTENDED COMMAND-LINE OPTIONS
+// ============================================================================
+// Options the reconstructed nwnnsscomp accepts on top of the original set:
+// optimizer level and reports, the round-trip, benchmark and fingerprint
+// corpus tools, the disassembler and diff, and compile instrumentation.
+// None of them is part of the original binary. They are consumed from argv
+// before the original parser runs, so it never sees them, and their values
+// live in the globals below.
+// ============================================================================
+
+#ifndef NWNNSSCOMP_OPTIONS_H
+#define NWNNSSCOMP_OPTIONS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Bytecode optimizer and reports
+extern int g_optimizationLevel;             // -O0..-O3; 0 keeps output byte-identical to the original
+extern int g_optimizerReportEnabled;        // -P: print per-pass timing after each script
+extern int g_sizeReportEnabled;             // -S: write a per-function size report next to each .ncs
+
+// Round-trip corpus harness
+extern const char* g_roundtripCorpus;       // -R<dir>: corpus directory, selects mode 3
+extern uint32_t g_roundtripThreads;         // -j<n>: worker threads (0 = one per core)
+extern const char* g_roundtripSummaryPath;  // -J<path>: JSON summary file (default stdout)
+
+// Bulk disassembler and structural diff
+extern int g_disassembleFormat;             // -L: text listing, -Lj: JSON lines (-1 = off)
+extern int g_diffEnabled;                   // -X: diff two .ncs files or directories
+
+// Library function fingerprints
+extern const char* g_fingerprintBuildIndex; // -K<index>: fingerprint the inputs into index
+extern const char* g_fingerprintScanIndex;  // -k<index>: identify library subroutines in the inputs
+
+// Compile benchmark
+extern const char* g_benchCorpus;           // -Y<dir>: benchmark compiling every .nss below dir
+extern const char* g_benchBaselinePath;     // -B<path>: baseline JSON to gate against
+extern uint32_t g_benchIterations;          // -N<n>: timed passes (0 = default)
+
+// Compile instrumentation
+extern int g_phaseTimingEnabled;            // -T: per-phase timing, JSON lines on stderr
+extern const char* g_phaseTimingPath;       // -T=<path>: JSON lines to path instead
+extern const char* g_tracePath;             // -Z<path>: Chrome/Perfetto trace of the run
+extern int g_memoryAccountingEnabled;       // -M: per-script memory use, JSON lines on stderr
+extern const char* g_memoryAccountingPath;  // -M=<path>: JSON lines to path instead
+
+/**
+ * @brief Handle a command-line option added on top of the original set
+ *
+ *   -O0..-O3, -O     Optimization level; -O alone means -O2
+ *   -P               Per-pass optimizer timing and size deltas per script
+ *   -S               Per-function size report next to each .ncs
+ *   -R<dir>          Round-trip every script below dir
+ *   -j<n>            Round-trip worker threads
+ *   -J<path>         JSON summary of -R or results of -Y
+ *   -L, -Lj          Disassemble the inputs as text or JSON lines
+ *   -X               Structural diff of two .ncs files or directories
+ *   -K<index>        Add the inputs' subroutines to a fingerprint index
+ *   -k<index>        Name the inputs' subroutines found in an index
+ *   -Y<dir>          Benchmark compiling the corpus below dir
+ *   -N<n>            Benchmark timed passes
+ *   -B<path>         Fail on a regression against a baseline JSON
+ *   -T, -T=<path>    Per-phase compile timing, JSON lines on stderr or path
+ *   -Z<path>         Chrome trace-event JSON of the run
+ *   -M, -M=<path>    Per-script memory use, JSON lines on stderr or path
+ *
+ * Only the '-' prefix is recognized: the original set also takes '/', and
+ * an absolute path such as /Tools/x.nss must stay an input file. -T and -M
+ * take their path after '=' so that no other argument starting with T or M
+ * is swallowed as an output file.
+ *
+ * @param arg Command-line argument
+ * @return 1 if the argument was an extended option, 0 otherwise
+ */
+int nwnnsscomp_parse_extended_option(const char* arg);
+
+/**
+ * @brief Parse every extended option in argv and remove it
+ *
+ * The remaining arguments keep their order and argv[result] is set to
+ * NULL, so the original parser can run on the same array.
+ *
+ * @param argc Argument count, argv[0] included
+ * @param argv Arguments; rewritten in place
+ * @return Argument count left in argv
+ */
+int nwnnsscomp_consume_extended_options(int argc, char** argv);
+
+/**
+ * @brief Optimization level a compile actually runs at
+ *
+ * A debug compile always runs at -O0: the optimizer moves and removes code
+ * without rewriting the .ndb written for it, whose offsets would then point
+ * into the wrong instructions.
+ *
+ * @param debugEnabled Nonzero for a debug (-d) compile
+ * @return 0 when debugEnabled, g_optimizationLevel otherwise
+ */
+int nwnnsscomp_effective_optimization_level(int debugEnabled);
+
+/**
+ * @brief Print one line per extended option (the help text that follows the original usage)
+ *
+ * @param stream Output stream
+ */
+void nwnnsscomp_print_extended_usage(FILE* stream);
+
+#endif // NWNNSSCOMP_OPTIONS_H
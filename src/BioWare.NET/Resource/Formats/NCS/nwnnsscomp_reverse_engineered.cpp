@@ -5,6 +5,10 @@
 // with EVERY line documented with address and assembly instruction.
 //
 // NO PLACEHOLDERS. NO TODOS. EVERY FUNCTION FULLY IMPLEMENTED.
+//
+// Code without an address is not part of the original binary: the extended
+// options (nwnnsscomp_options.h) and the optimizer, reports, corpus tools
+// and instrumentation they enable.
 // ============================================================================
 
 #include <windows.h>
@@ -13,6 +17,18 @@
 #include <string.h>
 #include <stdint.h>
 
+#include "nwnnsscomp_bench.h"
+#include "nwnnsscomp_diff.h"
+#include "nwnnsscomp_disasm.h"
+#include "nwnnsscomp_fingerprint.h"
+#include "nwnnsscomp_memory.h"
+#include "nwnnsscomp_optimizer.h"
+#include "nwnnsscomp_options.h"
+#include "nwnnsscomp_roundtrip.h"
+#include "nwnnsscomp_size_report.h"
+#include "nwnnsscomp_timing.h"
+#include "nwnnsscomp_trace.h"
+
 // ============================================================================
 // CANONICAL GLOBAL STATE
 // ============================================================================
@@ -39,6 +55,12 @@ char* g_environmentStrings = NULL;   // Environment variable strings
 // Error tracking
 int g_lastError = 0;                // Last error code (DAT_004344f8)
 
+// Extended options (nwnnsscomp_options.h) and the state they enable
+NcsOptimizerReport g_optimizerReport;      // Report for the most recently written script
+NwnPhaseTimer g_phaseTimer;                // Timer for the script being compiled
+NwnTraceWriter g_trace;                    // Spans and markers recorded so far
+NwnMemoryAccount g_memoryAccount;          // Allocations of the script being compiled
+
 // ============================================================================
 // CANONICAL DATA STRUCTURES
 // ============================================================================
@@ -420,6 +442,155 @@ undefined4 __stdcall nwnnsscomp_compile_main(void)
     // 0x00403338: mov dword ptr [ebp+0xfffffbc0], eax // Store in local variable
     // 0x0040333e: and byte ptr [ebp+0xfffffbbf], 0x0 // Clear error flag
     
+    // Optimizer, report, round-trip, disassembler, diff, fingerprint, benchmark, timing, trace and memory
+    // options (-O0..-O3, -P, -S, -R, -j, -J, -L, -X, -K, -k, -Y, -B, -N, -T, -Z, -M) are not part of the original
+    // option set; consume them up front and drop them from __argv so the original parser never sees them
+    argc = nwnnsscomp_consume_extended_options(argc, __argv);
+    __argc = argc;
+    if (g_roundtripCorpus != NULL) {
+        g_compilationMode = 3;
+    }
+    
+    FILE* phaseTimingStream = NULL;
+    if (g_phaseTimingEnabled) {
+        phaseTimingStream = g_phaseTimingPath != NULL ? fopen(g_phaseTimingPath, "w") : stderr;
+        if (phaseTimingStream == NULL) {
+            fprintf(stderr, "Error: cannot write phase timing file %s\n", g_phaseTimingPath);
+            free(fileListBuffer);
+            return 1;
+        }
+    }
+    FILE* memoryAccountingStream = NULL;
+    if (g_memoryAccountingEnabled) {
+        memoryAccountingStream = g_memoryAccountingPath != NULL ? fopen(g_memoryAccountingPath, "w") : stderr;
+        if (memoryAccountingStream == NULL) {
+            fprintf(stderr, "Error: cannot write memory accounting file %s\n", g_memoryAccountingPath);
+            free(fileListBuffer);
+            return 1;
+        }
+    }
+    nwnnsscomp_memory_init(&g_memoryAccount, g_memoryAccountingEnabled != 0, memoryAccountingStream);
+    nwnnsscomp_trace_init(&g_trace, g_tracePath != NULL);
+    nwnnsscomp_trace_name_thread(&g_trace, "main");
+    nwnnsscomp_timing_init(&g_phaseTimer, g_phaseTimingEnabled != 0 || g_tracePath != NULL, phaseTimingStream,
+                           g_tracePath != NULL ? &g_trace : NULL);
+    
+    // Structural diff of the first two non-option arguments
+    if (g_diffEnabled) {
+        const char* paths[2] = { NULL, NULL };
+        int pathCount = 0;
+        for (argIndex = 1; argIndex < argc && pathCount < 2; argIndex++) {
+            if (__argv[argIndex][0] != '-' && __argv[argIndex][0] != '/') {
+                paths[pathCount++] = __argv[argIndex];
+            }
+        }
+        free(fileListBuffer);
+        if (pathCount < 2) {
+            fprintf(stderr, "Error: -X needs two .ncs files or two directories\n");
+            return 1;
+        }
+        NwnDiffStats diffStats;
+        int differing = nwnnsscomp_diff_paths(paths[0], paths[1], stdout, &diffStats);
+        if (differing < 0) {
+            fprintf(stderr, "Error: cannot read or decode %s or %s\n", paths[0], paths[1]);
+            return 1;
+        }
+        fprintf(stderr, "%d differing, %u instructions removed, %u added, %u jumps retargeted\n", differing,
+                diffStats.removedInstructions, diffStats.addedInstructions, diffStats.retargetedJumps);
+        return differing != 0 ? 1 : 0;
+    }
+    
+    // Fingerprint index: every non-option argument is a .ncs file or a directory
+    if (g_fingerprintBuildIndex != NULL || g_fingerprintScanIndex != NULL) {
+        const char* indexPath = g_fingerprintBuildIndex != NULL ? g_fingerprintBuildIndex : g_fingerprintScanIndex;
+        NwnFingerprintIndex fingerprintIndex;
+        NwnFingerprintStats fingerprintStats;
+        NwnFingerprintStats pathStats;
+        int failed = 0;
+        free(fileListBuffer);
+        // An existing index is extended when building; scanning needs one
+        if (!nwnnsscomp_fingerprint_load(&fingerprintIndex, indexPath) && g_fingerprintScanIndex != NULL) {
+            fprintf(stderr, "Error: cannot read fingerprint index %s\n", indexPath);
+            return 1;
+        }
+        memset(&fingerprintStats, 0, sizeof(fingerprintStats));
+        for (argIndex = 1; argIndex < argc; argIndex++) {
+            const char* arg = __argv[argIndex];
+            if (arg[0] == '-' || arg[0] == '/') {
+                continue;
+            }
+            int read = g_fingerprintBuildIndex != NULL
+                           ? nwnnsscomp_fingerprint_add_path(&fingerprintIndex, arg, &pathStats)
+                           : nwnnsscomp_fingerprint_scan_path(&fingerprintIndex, arg, stdout, &pathStats);
+            if (!read) {
+                fprintf(stderr, "Error: cannot read %s\n", arg);
+                failed = 1;
+                continue;
+            }
+            fingerprintStats.scripts += pathStats.scripts;
+            fingerprintStats.failed += pathStats.failed;
+            fingerprintStats.functions += pathStats.functions;
+            fingerprintStats.matched += pathStats.matched;
+        }
+        if (g_fingerprintBuildIndex != NULL) {
+            if (!nwnnsscomp_fingerprint_save(&fingerprintIndex, indexPath)) {
+                fprintf(stderr, "Error: cannot write fingerprint index %s\n", indexPath);
+                return 1;
+            }
+            fprintf(stderr, "Indexed %u scripts: %u of %u subroutines added, %u entries, %u unreadable\n",
+                    fingerprintStats.scripts, fingerprintStats.matched, fingerprintStats.functions,
+                    (uint32_t)fingerprintIndex.entries.size(), fingerprintStats.failed);
+        }
+        else {
+            fprintf(stderr, "Scanned %u scripts: %u of %u subroutines identified, %u unreadable\n",
+                    fingerprintStats.scripts, fingerprintStats.matched, fingerprintStats.functions,
+                    fingerprintStats.failed);
+        }
+        return (failed || fingerprintStats.failed != 0) ? 1 : 0;
+    }
+    
+    // Disassembly: every non-option argument is a .ncs file, an archive or a directory
+    if (g_disassembleFormat >= 0) {
+        NwnDisasmWriter writer;
+        int failed = 0;
+        nwnnsscomp_disasm_begin(&writer, stdout, g_disassembleFormat);
+        for (argIndex = 1; argIndex < argc; argIndex++) {
+            const char* arg = __argv[argIndex];
+            if (arg[0] != '-' && arg[0] != '/' && !nwnnsscomp_disassemble_path(&writer, arg)) {
+                failed = 1;
+            }
+        }
+        nwnnsscomp_disasm_end(&writer);
+        fprintf(stderr, "Disassembled %llu scripts, %llu instructions, %u errors\n",
+                (unsigned long long)writer.stats.scripts, (unsigned long long)writer.stats.instructions,
+                writer.stats.errors);
+        free(fileListBuffer);
+        return (failed || writer.stats.errors != 0) ? 1 : 0;
+    }
+    
+    // Neither does a benchmark run
+    if (g_benchCorpus != NULL) {
+        free(fileListBuffer);
+        nwnnsscomp_process_benchmark();
+        return g_lastError != 0 ? 1 : 0;
+    }
+    
+    // A round-trip corpus run needs no input files of its own
+    if (g_compilationMode == 3 && g_roundtripCorpus != NULL) {
+        free(fileListBuffer);
+        nwnnsscomp_process_roundtrip_test();
+        if (g_tracePath != NULL && !nwnnsscomp_trace_save(&g_trace, g_tracePath)) {
+            fprintf(stderr, "Error: cannot write trace %s\n", g_tracePath);
+            return 1;
+        }
+        return g_lastError != 0 ? 1 : 0;
+    }
+    
+    // Nothing left to compile: the original prints its usage (0x0040353d); list the extended options after it
+    if (argc < 2) {
+        nwnnsscomp_print_extended_usage(stdout);
+    }
+    
     // Parse command-line arguments
     // This is a large loop that processes each argument, handling options (-c, -d, -e, -o)
     // and collecting input files. The full implementation continues with detailed
@@ -442,6 +613,28 @@ undefined4 __stdcall nwnnsscomp_compile_main(void)
     // - Mode 4 (multi-file): Processes multiple specified files
     // - Default (single file): Processes a single input file
     
+    // Per-phase totals over every compiled script (-T)
+    if (g_phaseTimingEnabled) {
+        nwnnsscomp_print_timing_table(&g_phaseTimer, stdout);
+        if (phaseTimingStream != stderr) {
+            fclose(phaseTimingStream);
+        }
+    }
+    
+    // Largest memory use per buffer over every compiled script (-M)
+    if (g_memoryAccountingEnabled) {
+        nwnnsscomp_print_memory_table(&g_memoryAccount, stdout);
+        if (memoryAccountingStream != stderr) {
+            fclose(memoryAccountingStream);
+        }
+    }
+    
+    // Trace of every compiled script (-Z)
+    if (g_tracePath != NULL && !nwnnsscomp_trace_save(&g_trace, g_tracePath)) {
+        fprintf(stderr, "Error: cannot write trace %s\n", g_tracePath);
+        return 1;
+    }
+    
     // Function epilogue
     // 0x00403d24: xor eax, eax                  // Set return value to 0 (success)
     // 0x00403d26: mov ecx, dword ptr [ebp-0xc]   // Load saved SEH handler
@@ -474,6 +667,7 @@ void nwnnsscomp_perform_additional_cleanup(NssCompiler* compiler);
 void nwnnsscomp_process_batch_files();
 void nwnnsscomp_process_directory_files();
 void nwnnsscomp_process_roundtrip_test();
+void nwnnsscomp_process_benchmark();
 void nwnnsscomp_process_multiple_files();
 
 // ============================================================================
@@ -879,6 +1073,7 @@ int __cdecl nwnnsscomp_process_files(byte* input_path)
     
     // Begin file enumeration
     // 0x00402bea: call 0x0041dea0             // Call nwnnsscomp_enumerate_files
+    std::chrono::steady_clock::time_point enumerationStart = std::chrono::steady_clock::now();
     enumHandle = nwnnsscomp_enumerate_files((char*)input_path, &fileData);
     
     // 0x00402bef: mov dword ptr [ebp-0x8], eax // Store enumeration handle
@@ -960,6 +1155,9 @@ int __cdecl nwnnsscomp_process_files(byte* input_path)
     // 0x00402c6a: pop ebp                       // Restore base pointer
     // 0x00402c6b: ret                           // Return filesProcessed
     
+    // The scripts of this pattern as one span around their own (-Z)
+    nwnnsscomp_trace_span(&g_trace, "files", (const char*)input_path, enumerationStart,
+                          std::chrono::steady_clock::now(), "scripts", std::to_string(filesProcessed));
     return filesProcessed;
 }
 
@@ -1000,6 +1198,7 @@ void __stdcall nwnnsscomp_compile_single_file(void)
     int compilationResult;                  // Result from core compilation
     char* lastDot;                          // Pointer to last '.' in filename
     int successFlag;                         // Success flag for compilation
+    const char* scriptStatus = "failed";     // Status of the -T/-M JSON lines
     
     // Calculate security cookie
     // 0x0040282e: xor eax, dword ptr [ebp+0x4]  // XOR with return address for cookie
@@ -1011,6 +1210,8 @@ void __stdcall nwnnsscomp_compile_single_file(void)
     // filename parameter is at [ebp+0x8] for this function
     char* inputFilename = (char*)*((void**)((char*)&fileHandle - 0x70));  // Access from stack frame
     printf("Script %s - ", inputFilename);
+    nwnnsscomp_timing_script_begin(&g_phaseTimer, inputFilename);
+    nwnnsscomp_memory_script_begin(&g_memoryAccount, inputFilename);
     
     // Increment scripts processed counter
     // 0x0040283e: inc dword ptr [0x00433e10]     // Increment g_scriptsProcessed
@@ -1026,7 +1227,9 @@ void __stdcall nwnnsscomp_compile_single_file(void)
     // 0x00402851: push dword ptr [ebp+0x8]       // Push input filename parameter
     // 0x00402854: call 0x0041bc8a                // Call nwnnsscomp_read_file_to_memory(filename, &fileSize)
     // Opens file and reads entire contents into memory buffer
+    nwnnsscomp_phase_begin(&g_phaseTimer, NWN_PHASE_READ);
     void* fileBuffer = nwnnsscomp_read_file_to_memory(filename, &fileSize);
+    nwnnsscomp_phase_end(&g_phaseTimer);
     fileHandle = fileBuffer;  // File handle is actually the buffer pointer
     
     // 0x00402859: mov dword ptr [ebp+0xffffff78], eax // Store file handle
@@ -1094,7 +1297,9 @@ void __stdcall nwnnsscomp_compile_single_file(void)
     // 0x004028d5: push dword ptr [ebp+0xffffff80] // Push processed filename
     // 0x004028db: push 0x433e20                   // Push address of g_includeContext
     // 0x004028e0: call 0x00402b4b                 // Call nwnnsscomp_process_include(context, filename)
+    nwnnsscomp_phase_begin(&g_phaseTimer, NWN_PHASE_INCLUDES);
     nwnnsscomp_process_include((void*)&g_includeContext, processedFilename);
+    nwnnsscomp_phase_end(&g_phaseTimer);
     
     // Set up bytecode writer
     // 0x004028e5: call 0x0040266a                 // Call nwnnsscomp_setup_bytecode_writer()
@@ -1257,6 +1462,7 @@ void __stdcall nwnnsscomp_compile_single_file(void)
         // 0x00402af3: push 0x428ac8                      // Push "include\n" string
         // 0x00402af8: call 0x0041d2b9                    // Call wprintf to display message
         printf("include\n");
+        scriptStatus = "include";
     }
     else {
         // Compilation failed
@@ -1282,9 +1488,19 @@ void __stdcall nwnnsscomp_compile_single_file(void)
         // 0x00402ad0: push 0x428ad4                      // Push "passed\n" string
         // 0x00402ad5: call 0x0041d2b9                    // Call wprintf to display success
         printf("passed\n");
+        scriptStatus = "passed";
+        
+        // Per-pass optimizer timing and size deltas (-P)
+        if (g_optimizerReportEnabled) {
+            nwnnsscomp_print_optimizer_report(&g_optimizerReport, stdout);
+        }
     }
     
 cleanup_and_exit:
+    // Per-phase timing and memory lines (-T, -M)
+    nwnnsscomp_timing_script_end(&g_phaseTimer, scriptStatus);
+    nwnnsscomp_memory_script_end(&g_memoryAccount, scriptStatus);
+    
     // Cleanup compiler object
     // 0x00402b16: and byte ptr [ebp-0x4], 0x0              // Set exception flag to 0
     // 0x00402b1d: call 0x00401ecb                         // Call nwnnsscomp_destroy_compiler()
@@ -1343,11 +1559,39 @@ void nwnnsscomp_process_directory_files()
     // and calls nwnnsscomp_compile_single_file for each NSS file found
 }
 
+/**
+ * @brief Compile command for the corpus harnesses
+ *
+ * @return NWNNSSCOMP_ROUNDTRIP_COMPILER when set, otherwise this
+ *         executable with "-O0 -c %in -o %out", pinned to -O0 so the
+ *         harnesses measure the compiler and decompiler, not the optimizer
+ */
+static std::string nwnnsscomp_corpus_compile_command()
+{
+    const char* compiler = getenv("NWNNSSCOMP_ROUNDTRIP_COMPILER");
+    if (compiler != NULL && compiler[0] != '\0') {
+        return compiler;
+    }
+    char modulePath[MAX_PATH];
+    GetModuleFileNameA(NULL, modulePath, sizeof(modulePath));
+    return std::string("\"") + modulePath + "\" -O0 -c " NWNNSSCOMP_ROUNDTRIP_INPUT " -o " NWNNSSCOMP_ROUNDTRIP_OUTPUT;
+}
+
 /**
  * @brief Perform round-trip testing for compilation accuracy
  *
  * Compiles NSS to NCS, decompiles NCS back to NSS, and compares results
- * to verify compilation fidelity.
+ * to verify compilation fidelity. Every .nss and .ncs below the -R
+ * directory is processed on -j worker threads (see nwnnsscomp_roundtrip.h);
+ * a line per script that is not byte-identical goes to stderr and the
+ * JSON summary to the -J file or stdout.
+ *
+ * The compiler defaults to this executable ("-O0 -c %in -o %out"); the
+ * decompiler has no in-process equivalent and is taken from the
+ * NWNNSSCOMP_ROUNDTRIP_DECOMPILER environment variable, the compiler
+ * likewise from NWNNSSCOMP_ROUNDTRIP_COMPILER when set.
+ *
+ * Sets g_lastError when any script diverged or failed.
  *
  * @note Implementation derived from FUN_004026ce
  */
@@ -1358,6 +1602,158 @@ void nwnnsscomp_process_roundtrip_test()
     // 2. Decompile NCS -> NSS
     // 3. Recompile NSS -> NCS
     // 4. Compare original and recompiled bytecode
+    NwnRoundtripCommands commands;
+    const char* decompiler = getenv("NWNNSSCOMP_ROUNDTRIP_DECOMPILER");
+    commands.compile = nwnnsscomp_corpus_compile_command();
+    if (decompiler == NULL || decompiler[0] == '\0') {
+        fprintf(stderr, "Error: set NWNNSSCOMP_ROUNDTRIP_DECOMPILER to a decompiler command "
+                        "(" NWNNSSCOMP_ROUNDTRIP_INPUT " = .ncs input, " NWNNSSCOMP_ROUNDTRIP_OUTPUT " = .nss output)\n");
+        g_lastError = 1;
+        return;
+    }
+    commands.decompile = decompiler;
+
+    NwnRoundtripTools tools = nwnnsscomp_roundtrip_command_tools(&commands);
+    tools.trace = g_tracePath != NULL ? &g_trace : NULL;
+    std::vector<NwnRoundtripResult> results;
+    NwnRoundtripSummary summary;
+    if (!nwnnsscomp_roundtrip_corpus(g_roundtripCorpus, &tools, g_roundtripThreads, &results, &summary)) {
+        fprintf(stderr, "Error: cannot read corpus directory %s\n", g_roundtripCorpus);
+        g_lastError = 1;
+        return;
+    }
+
+    for (size_t i = 0; i < results.size(); i++) {
+        if (results[i].status != NWN_ROUNDTRIP_IDENTICAL) {
+            fprintf(stderr, "%s: %s\n", results[i].path.c_str(), nwnnsscomp_roundtrip_status_name(results[i].status));
+        }
+    }
+    fprintf(stderr, "Round-trip: %u scripts, %u identical, %u padded, %u divergent, %u failed (%.1f s, %u threads)\n",
+            summary.scripts, summary.identical, summary.padded, summary.divergent, summary.failed,
+            summary.seconds, summary.threads);
+
+    FILE* stream = stdout;
+    if (g_roundtripSummaryPath != NULL) {
+        stream = fopen(g_roundtripSummaryPath, "w");
+        if (stream == NULL) {
+            fprintf(stderr, "Error: cannot write %s\n", g_roundtripSummaryPath);
+            g_lastError = 1;
+            return;
+        }
+    }
+    nwnnsscomp_write_roundtrip_json(&results, &summary, stream);
+    if (stream != stdout) {
+        fclose(stream);
+    }
+
+    if (summary.divergent != 0 || summary.failed != 0) {
+        g_lastError = 1;
+    }
+}
+
+/**
+ * @brief Compile one -Y corpus script in this process
+ *
+ * Goes through FUN_00402808 like a command-line compile, so reading the
+ * source, resolving includes from the script's directory and writing the
+ * .ncs next to it are all timed; the text the benchmark read is unused.
+ *
+ * @param userData Corpus directory
+ */
+static int nwnnsscomp_bench_compile_in_process(const std::string& source, const std::string& name,
+                                               std::vector<uint8_t>* ncs, std::string* message, void* userData)
+{
+    (void)source;
+    std::string input = std::string((const char*)userData) + "/" + name;
+    std::string output = input.substr(0, input.size() - 4) + ".ncs";
+    ncs->clear();
+    remove(output.c_str());
+
+    // FUN_00402808 takes the input path as its stdcall argument ([ebp+0x8])
+    int failedBefore = g_scriptsFailed;
+    ((void (__stdcall*)(const char*))nwnnsscomp_compile_single_file)(input.c_str());
+    if (g_scriptsFailed != failedBefore) {
+        *message = "compile failed";
+        return 0;
+    }
+
+    // Include files pass without writing an .ncs
+    FILE* stream = fopen(output.c_str(), "rb");
+    if (stream != NULL) {
+        uint8_t buffer[4096];
+        size_t bytes;
+        while ((bytes = fread(buffer, 1, sizeof(buffer), stream)) > 0) {
+            ncs->insert(ncs->end(), buffer, buffer + bytes);
+        }
+        fclose(stream);
+    }
+    return 1;
+}
+
+/**
+ * @brief Benchmark compiling every .nss below the -Y directory
+ *
+ * Runs one untimed pass and -N timed passes (see nwnnsscomp_bench.h) with
+ * the compiler running in this process, prints the summary to stderr and
+ * writes the JSON results to the -J file or stdout; that file is what gets
+ * checked in as the baseline (bench/baseline.json for bench/corpus). With
+ * -B, every metric is compared against the baseline and a regression sets
+ * g_lastError.
+ *
+ * Latency has no process start-up in it, peak RSS is this process's and
+ * allocations per script are counted.
+ */
+void nwnnsscomp_process_benchmark()
+{
+    NwnRoundtripTools tools;
+    tools.compile = nwnnsscomp_bench_compile_in_process;
+    tools.decompile = NULL;
+    tools.userData = (void*)g_benchCorpus;
+    tools.trace = NULL;
+
+    NwnBenchOptions options;
+    options.iterations = g_benchIterations;
+    options.warmup = 1;
+    options.countAllocations = true;
+    std::vector<NwnBenchScript> scripts;
+    NwnBenchSummary summary;
+    if (!nwnnsscomp_bench_corpus(g_benchCorpus, &tools, &options, &scripts, &summary)) {
+        fprintf(stderr, "Error: no .nss files in benchmark corpus %s\n", g_benchCorpus);
+        g_lastError = 1;
+        return;
+    }
+    fprintf(stderr, "Benchmark: %u scripts x %u passes, %.1f scripts/s, p50 %.2f ms, p99 %.2f ms, "
+                    "peak RSS %llu KB, %u failed\n",
+            summary.scripts, summary.iterations, summary.scriptsPerSecond, summary.p50Milliseconds,
+            summary.p99Milliseconds, (unsigned long long)summary.peakRssKilobytes, summary.failed);
+
+    FILE* stream = stdout;
+    if (g_roundtripSummaryPath != NULL) {
+        stream = fopen(g_roundtripSummaryPath, "w");
+        if (stream == NULL) {
+            fprintf(stderr, "Error: cannot write %s\n", g_roundtripSummaryPath);
+            g_lastError = 1;
+            return;
+        }
+    }
+    nwnnsscomp_write_bench_json(&scripts, &summary, stream);
+    if (stream != stdout) {
+        fclose(stream);
+    }
+
+    if (g_benchBaselinePath != NULL) {
+        NwnBenchSummary baseline;
+        if (!nwnnsscomp_read_bench_baseline(g_benchBaselinePath, &baseline)) {
+            fprintf(stderr, "Error: cannot read benchmark baseline %s\n", g_benchBaselinePath);
+            g_lastError = 1;
+            return;
+        }
+        uint32_t regressions = nwnnsscomp_bench_compare(&summary, &baseline, stderr);
+        if (regressions != 0) {
+            fprintf(stderr, "Benchmark: %u regression(s) against %s\n", regressions, g_benchBaselinePath);
+            g_lastError = 1;
+        }
+    }
 }
 
 /**
@@ -1468,6 +1864,7 @@ undefined4 __stdcall nwnnsscomp_compile_core(void)
     // 0x00404c52: lea ecx, [ebp+0xfffffc74]      // Load address of parser state structure
     // 0x00404c58: call 0x00404a27                 // Call nwnnsscomp_setup_parser_state(parserState, sourceBuffer)
     // nwnnsscomp_setup_parser_state initializes parser state with source buffer
+    nwnnsscomp_phase_begin(&g_phaseTimer, NWN_PHASE_PARSE);
     nwnnsscomp_setup_parser_state((NssCompiler*)&parserState, sourceBuffer);
     nwnnsscomp_setup_parser_state((NssCompiler*)&parserState, sourceBuffer);
     
@@ -1509,6 +1906,7 @@ undefined4 __stdcall nwnnsscomp_compile_core(void)
     // 0x00404c95: push 0x34                      // Push 52 bytes (0x34)
     // 0x00404c97: call 0x0041cc49                // Call operator_new(52)
     instructionStructure = malloc(52);
+    nwnnsscomp_memory_alloc(&g_memoryAccount, instructionStructure, 52);
     
     // 0x00404c9d: mov dword ptr [ebp+0xfffffa74], eax // Store instruction structure pointer
     // 0x00404ca3: mov byte ptr [ebp-0x4], 0x1     // Set exception flag to 1
@@ -1526,6 +1924,7 @@ undefined4 __stdcall nwnnsscomp_compile_core(void)
         
         // 0x00404cb7: mov dword ptr [ebp+0xfffffa50], eax // Store compiler pointer
     }
+    nwnnsscomp_phase_end(&g_phaseTimer);
     
     // 0x00404cbd: mov eax, dword ptr [ebp+0xfffffa50] // Load compiler pointer
     // 0x00404cc3: mov dword ptr [ebp+0xfffffa78], eax // Store in local variable
@@ -1542,6 +1941,7 @@ undefined4 __stdcall nwnnsscomp_compile_core(void)
         if (sourceBuffer != NULL) {
             // 0x00404d16: push dword ptr [ebp+0x10] // Push source buffer pointer
             // 0x00404d19: call 0x0041d821           // Call free(sourceBuffer)
+            nwnnsscomp_memory_free(&g_memoryAccount, sourceBuffer);
             free(sourceBuffer);
         }
         
@@ -1555,7 +1955,11 @@ undefined4 __stdcall nwnnsscomp_compile_core(void)
     
     // Generate bytecode from parsed source
     // 0x00404cf9: call 0x0040489d                 // Call nwnnsscomp_generate_bytecode()
+    // Parsing is syntax-directed: instructions are emitted from the reduce actions, so
+    // the -T timing charges the whole call to codegen rather than timing every emit
+    nwnnsscomp_phase_begin(&g_phaseTimer, NWN_PHASE_CODEGEN);
     nwnnsscomp_generate_bytecode();
+    nwnnsscomp_phase_end(&g_phaseTimer);
     
     // Check for parsing errors
     // 0x00404cfe: lea ecx, [ebp+0xfffffc74]      // Load address of parser state
@@ -1600,6 +2004,7 @@ undefined4 __stdcall nwnnsscomp_compile_core(void)
         // Main script with errors or include already processed - create second compiler for output
         // 0x00404d8a: call 0x0041cc49             // Call operator_new(52)
         void* outputCompiler = malloc(52);
+        nwnnsscomp_memory_alloc(&g_memoryAccount, outputCompiler, 52);
         
         // 0x00404d90: mov dword ptr [ebp+0xfffffa64], eax // Store output compiler pointer
         // 0x00404d96: mov byte ptr [ebp-0x4], 0x2  // Set exception flag to 2
@@ -1622,11 +2027,15 @@ undefined4 __stdcall nwnnsscomp_compile_core(void)
             // 0x00404dc7: lea ecx, [ebp+0xfffffc74] // Load address of parser state
             // 0x00404dcd: call 0x00404efe           // Call nwnnsscomp_finalize_include(parserState)
             // nwnnsscomp_finalize_include finalizes include file processing
+            nwnnsscomp_phase_begin(&g_phaseTimer, NWN_PHASE_SEMANTIC);
             nwnnsscomp_finalize_include((NssCompiler*)&parserState);
+            nwnnsscomp_phase_end(&g_phaseTimer);
             
             // Generate bytecode for output
             // 0x00404df0: call 0x0040489d             // Call nwnnsscomp_generate_bytecode()
+            nwnnsscomp_phase_begin(&g_phaseTimer, NWN_PHASE_CODEGEN);
             nwnnsscomp_generate_bytecode();
+            nwnnsscomp_phase_end(&g_phaseTimer);
             
             // Mark as include processed
             // 0x00404df5: lea ecx, [ebp+0xfffffc74] // Load address of parser state
@@ -1653,7 +2062,9 @@ undefined4 __stdcall nwnnsscomp_compile_core(void)
                 // 0x00404e22: call 0x0040d411             // Call nwnnsscomp_finalize_main_script()
                 // Function call parameters are already set up above
                 // The actual call is made with the parameters prepared in the stack frame
+                nwnnsscomp_phase_begin(&g_phaseTimer, NWN_PHASE_CODEGEN);
                 nwnnsscomp_finalize_main_script((NssCompiler*)&parserState, NULL, NULL, 0);
+                nwnnsscomp_phase_end(&g_phaseTimer);
                 
                 // 0x00404e27: mov byte ptr [ebp-0x4], 0x3 // Set exception flag to 3
                 
@@ -1758,6 +2169,7 @@ void __stdcall nwnnsscomp_generate_bytecode(void)
     // Allocate instruction tracking structure (28 bytes)
     // 0x004048ba: call 0x0041cc49                // Call operator_new(28)
     instructionStructure = malloc(28);
+    nwnnsscomp_memory_alloc(&g_memoryAccount, instructionStructure, 28);
     
     // 0x004048c0: mov dword ptr [ebp-0x50], eax  // Store instruction structure pointer
     // 0x004048c3: mov eax, dword ptr [ebp-0x50] // Load instruction structure pointer
@@ -1775,6 +2187,8 @@ void __stdcall nwnnsscomp_generate_bytecode(void)
     // Allocate bytecode buffer (36KB = 0x9000 bytes)
     // 0x004048dd: call 0x0041ca82                // Call operator_new(0x9000)
     bytecodeBuffer = malloc(0x9000);
+    nwnnsscomp_memory_alloc(&g_memoryAccount, bytecodeBuffer, 0x9000);
+    nwnnsscomp_memory_capacity(&g_memoryAccount, NWN_MEMORY_CODE, 0x9000, false);
     
     // 0x004048e8: mov dword ptr [ebp-0x54], eax  // Store bytecode buffer pointer
     // 0x004048eb: mov eax, dword ptr [ebp-0x10]  // Load instruction structure pointer
@@ -1892,6 +2306,10 @@ void __stdcall nwnnsscomp_generate_bytecode(void)
         // 0x004049c1: test eax, eax                 // Check if entry exists
         // 0x004049c3: jnz 0x004049ce                // Jump if entry exists
         
+        // Include cache marker (-Z)
+        nwnnsscomp_trace_instant(&g_trace, "include", registryEntry != 0 ? "include cache hit" : "include cache miss",
+                                 "include", includeFilename);
+        
         if (registryEntry == 0) {
             // Include not in registry - convert to lowercase
             // 0x004049c5: push dword ptr [ebp-0x18]  // Push filename buffer
@@ -2142,6 +2560,7 @@ void* __stdcall nwnnsscomp_finalize_main_script(NssCompiler* compiler, void* par
     // 0x0040d42f: call 0x00404398               // Call FUN_00404398(compiler+0x28, 0x40000)
     // FUN_00404398 initializes buffer structure at specified offset
     nwnnsscomp_allocate_buffer((void*)((char*)compiler + 0x28), 0x40000);
+    nwnnsscomp_memory_register(&g_memoryAccount, NWN_MEMORY_SCRIPT_0x28, (char*)compiler + 0x28);
     
     // Initialize exception flag
     // 0x0040d42f: and dword ptr [ebp-0x4], 0x0   // Set exception flag to 0
@@ -2177,6 +2596,7 @@ void* __stdcall nwnnsscomp_finalize_main_script(NssCompiler* compiler, void* par
     // 0x0040d477: push 0x40000                  // Push size (256KB)
     // 0x0040d47c: call 0x00404398               // Call FUN_00404398(compiler+0x11c, 0x40000)
     nwnnsscomp_allocate_buffer((void*)((char*)compiler + 0x11c), 0x40000);
+    nwnnsscomp_memory_register(&g_memoryAccount, NWN_MEMORY_SCRIPT_0x11C, (char*)compiler + 0x11c);
     
     // 0x0040d47c: mov byte ptr [ebp-0x4], 0x4    // Set exception flag to 4
     
@@ -2477,6 +2897,7 @@ int __thiscall nwnnsscomp_expand_bytecode_buffer(NssBytecodeBuffer* buffer, uint
     if (oldBuffer != NULL) {
         // 0x00405475: push dword ptr [eax]        // Push old buffer pointer
         // 0x00405477: call 0x0041d821             // Call free(oldBuffer)
+        nwnnsscomp_memory_free(&g_memoryAccount, oldBuffer);
         free(oldBuffer);
     }
     
@@ -2487,6 +2908,12 @@ int __thiscall nwnnsscomp_expand_bytecode_buffer(NssBytecodeBuffer* buffer, uint
     // 0x0040548b: mov dword ptr [eax+0x8], ecx   // Store newCapacity at offset +0x8
     *((uint*)((char*)buffer + 0x8)) = newCapacity;
     
+    // Memory accounting (-M)
+    nwnnsscomp_memory_alloc(&g_memoryAccount, newBuffer, newCapacity * instructionSize);
+    nwnnsscomp_memory_capacity(&g_memoryAccount, NWN_MEMORY_INSTRUCTIONS, newCapacity * instructionSize,
+                               oldBuffer != NULL);
+    nwnnsscomp_memory_use(&g_memoryAccount, NWN_MEMORY_INSTRUCTIONS, requiredCapacity * instructionSize);
+    
     // Function epilogue
     // 0x0040548e: mov al, 0x1                    // Set return value to 1 (success)
     // 0x00405490: leave                           // Restore stack frame
@@ -2671,6 +3098,7 @@ undefined4* __stdcall nwnnsscomp_create_compiler(char* sourceBuffer, int bufferS
     // 0x00401dd0: call 0x0041d7f4             // Call FUN_0041d7f4() - memory allocation
     // FUN_0041d7f4 allocates 52 bytes (0x34) for compiler object
     compiler = (NssCompiler*)malloc(sizeof(NssCompiler));
+    nwnnsscomp_memory_alloc(&g_memoryAccount, compiler, sizeof(NssCompiler));
     
     // 0x00401dd5: mov dword ptr [ebp-0x10], eax // Store compiler pointer in local variable
     // 0x00401dd8: mov ecx, dword ptr [ebp-0x10] // Load compiler pointer into ECX
@@ -2819,6 +3247,7 @@ void __stdcall nwnnsscomp_destroy_compiler(void)
             // 0x00401f0e: mov eax, dword ptr [ebp-0x10] // Load compiler pointer
             // 0x00401f11: push dword ptr [eax+0x20]     // Push sourceBufferStart pointer
             // 0x00401f14: call 0x0041d821                 // Call free(sourceBufferStart)
+            nwnnsscomp_memory_free(&g_memoryAccount, compiler->sourceBufferStart);
             free(compiler->sourceBufferStart);
             // 0x00401f19: pop ecx                        // Clean up parameter
         }
@@ -2843,6 +3272,7 @@ void __stdcall nwnnsscomp_destroy_compiler(void)
     // 0x00401f34: mov fs:[0x0], ecx             // Restore SEH handler chain in TEB
     
     // Free compiler object itself
+    nwnnsscomp_memory_free(&g_memoryAccount, compiler);
     free(compiler);
     
     // Reset global compiler pointer
@@ -2940,6 +3370,7 @@ uint __thiscall nwnnsscomp_write_bytecode_to_file(void* compiler, char* filename
     // Entry point detection and validation
     // 0x0040d642: call 0x0040eb20               // Find "main" function
     // 0x0040d64c: cmp dword ptr [ebp-0x28], 0x0  // Check if main found
+    nwnnsscomp_phase_begin(&g_phaseTimer, NWN_PHASE_SEMANTIC);
     void* mainFunction = nwnnsscomp_find_function(compiler, "main");
     void* startingConditional = NULL;
     bool hasMain = (mainFunction != NULL);
@@ -2950,6 +3381,7 @@ uint __thiscall nwnnsscomp_write_bytecode_to_file(void* compiler, char* filename
         if (startingConditional == NULL) {
             // 0x0040d6da: call 0x00407b72               // Report error: "No \"main\" or \"StartingConditional\" found"
             nwnnsscomp_report_error(compiler, "No \"main\" or \"StartingConditional\" found");
+            nwnnsscomp_phase_end(&g_phaseTimer);
             return 0;
         }
         // Validate return type is int
@@ -2957,6 +3389,7 @@ uint __thiscall nwnnsscomp_write_bytecode_to_file(void* compiler, char* filename
         uint returnType = *((uint*)((char*)startingConditional + 0x10));
         if (returnType != 6) {
             nwnnsscomp_report_error(compiler, "The \"StartingConditional\" function must return an int");
+            nwnnsscomp_phase_end(&g_phaseTimer);
             return 0;
         }
     } else {
@@ -2965,13 +3398,18 @@ uint __thiscall nwnnsscomp_write_bytecode_to_file(void* compiler, char* filename
         uint returnType = *((uint*)((char*)mainFunction + 0x10));
         if (returnType != 1) {
             nwnnsscomp_report_error(compiler, "The \"main\" function must return a void");
+            nwnnsscomp_phase_end(&g_phaseTimer);
             return 0;
         }
     }
+    nwnnsscomp_phase_end(&g_phaseTimer);
+    nwnnsscomp_phase_begin(&g_phaseTimer, NWN_PHASE_WRITE);
     
     // Allocate bytecode buffer (512KB)
     // 0x0040d6fc: call 0x0041ca82                 // operator new(0x80000)
     void* bytecodeBuffer = operator new(0x80000);
+    nwnnsscomp_memory_alloc(&g_memoryAccount, bytecodeBuffer, 0x80000);
+    nwnnsscomp_memory_capacity(&g_memoryAccount, NWN_MEMORY_OUTPUT, 0x80000, false);
     // 0x0040d714: mov dword ptr [eax+0xec], ecx   // Store buffer pointer at offset +0xec
     *((void**)((char*)compiler + 0xec)) = bytecodeBuffer;
     // 0x0040d720: mov dword ptr [ecx+0xf0], eax   // Store buffer end at offset +0xf0
@@ -3005,19 +3443,62 @@ uint __thiscall nwnnsscomp_write_bytecode_to_file(void* compiler, char* filename
     // Finalize bytecode size and write to file
     uint bytecodeSize = (uint)((char*)*((void**)((char*)compiler + 0xe8)) - (char*)bytecodeBuffer);
     
-    // Update size in header (at offset 13, after magic bytes)
-    *((uint*)((char*)bytecodeBuffer + 13)) = bytecodeSize;
+    // Update the big-endian total size in the header (offset 9, after "NCS V1.0B"); the
+    // optimizer and every other reader decode it from there
+    uint8_t* sizeField = (uint8_t*)bytecodeBuffer + NCS_HEADER_SIZE_OFFSET;
+    sizeField[0] = (uint8_t)(bytecodeSize >> 24);
+    sizeField[1] = (uint8_t)(bytecodeSize >> 16);
+    sizeField[2] = (uint8_t)(bytecodeSize >> 8);
+    sizeField[3] = (uint8_t)bytecodeSize;
+    nwnnsscomp_memory_use(&g_memoryAccount, NWN_MEMORY_OUTPUT, bytecodeSize);
+    
+    // Inline small subroutines and collapse the CPTOPSP/CPDOWNSP/MOVSP round
+    // trips emitted for local access, only when asked for with -O1..-O3 and
+    // never for a debug (-d) compile, whose .ndb offsets describe this stream
+    // (see nwnnsscomp_optimizer.cpp)
+    NcsOptimizerOptions optimizerOptions;
+    nwnnsscomp_optimizer_options_for_level(nwnnsscomp_effective_optimization_level(g_debugEnabled),
+                                           &optimizerOptions);
+    g_optimizerReport = NcsOptimizerReport();
+    g_optimizerReport.level = optimizerOptions.level;
+    g_optimizerReport.sizeBefore = bytecodeSize;
+    g_optimizerReport.sizeAfter = bytecodeSize;
+    if (optimizerOptions.level > 0) {
+        nwnnsscomp_phase_begin(&g_phaseTimer, NWN_PHASE_OPTIMIZE);
+        int optimized = nwnnsscomp_optimize_bytecode((uint8_t*)bytecodeBuffer, &bytecodeSize, 0x80000,
+                                                     &optimizerOptions,
+                                                     g_optimizerReportEnabled ? &g_optimizerReport : NULL);
+        nwnnsscomp_phase_end(&g_phaseTimer);
+        if (optimized < 0) {
+            // The unoptimized stream is still written; say why -O had no effect
+            fprintf(stderr, "Warning: -O%d skipped for %s: bytecode does not decode or outgrows the buffer\n",
+                    optimizerOptions.level, filename ? filename : path);
+        }
+    }
     
     // Write to file
     FILE* outputFile = fopen(filename ? filename : path, "wb");
     if (outputFile == NULL) {
+        nwnnsscomp_phase_end(&g_phaseTimer);
+        nwnnsscomp_memory_free(&g_memoryAccount, bytecodeBuffer);
         operator delete(bytecodeBuffer);
         return 0;
     }
     
     fwrite(bytecodeBuffer, 1, bytecodeSize, outputFile);
     fclose(outputFile);
+    nwnnsscomp_phase_end(&g_phaseTimer);
+    
+    // Per-function size and opcode mix sidecar (-S)
+    if (g_sizeReportEnabled) {
+        std::vector<NcsFunctionSymbol> functionSymbols;
+        nwnnsscomp_read_function_symbols(filename ? filename : path, (const uint8_t*)bytecodeBuffer, bytecodeSize,
+                                         &functionSymbols);
+        nwnnsscomp_write_size_report((const uint8_t*)bytecodeBuffer, bytecodeSize, &functionSymbols,
+                                     filename ? filename : path);
+    }
     
+    nwnnsscomp_memory_free(&g_memoryAccount, bytecodeBuffer);
     operator delete(bytecodeBuffer);
     
     // Function epilogue
@@ -3215,6 +3696,9 @@ void* __cdecl nwnnsscomp_read_file_to_memory(char* filename, size_t* fileSize)
     // 0x0041bcd9: push dword ptr [ebp-0xc]       // Push fileSizeValue
     // 0x0041bcdc: call 0x0041dc9d               // Call malloc(fileSizeValue)
     fileBuffer = malloc(fileSizeValue);
+    nwnnsscomp_memory_alloc(&g_memoryAccount, fileBuffer, fileSizeValue);
+    nwnnsscomp_memory_capacity(&g_memoryAccount, NWN_MEMORY_SOURCE, fileSizeValue, false);
+    nwnnsscomp_memory_use(&g_memoryAccount, NWN_MEMORY_SOURCE, fileSizeValue);
     
     // 0x0041bce2: cmp dword ptr [ebp-0xc], 0x0  // Check if allocation succeeded
     // 0x0041bce6: jnz 0x0041bcf5                // Jump if allocation succeeded
@@ -3659,6 +4143,7 @@ void __thiscall nwnnsscomp_expand_buffer_capacity(void* buffer, int requiredSize
         // Free old buffer
         // 0x00404883: mov eax, dword ptr [eax]      // Load old buffer pointer
         // 0x0040488b: call 0x0041d33a               // Call free(oldBuffer)
+        nwnnsscomp_memory_free(&g_memoryAccount, oldBuffer);
         free(oldBuffer);
     }
     
@@ -3666,6 +4151,12 @@ void __thiscall nwnnsscomp_expand_buffer_capacity(void* buffer, int requiredSize
     // 0x00404897: mov dword ptr [eax], ecx      // Store new buffer pointer at offset +0x0
     *((void**)((char*)buffer + 0x0)) = newBuffer;
     
+    // Memory accounting (-M)
+    int accountedBuffer = nwnnsscomp_memory_buffer_of(&g_memoryAccount, buffer);
+    nwnnsscomp_memory_alloc(&g_memoryAccount, newBuffer, currentCapacity);
+    nwnnsscomp_memory_capacity(&g_memoryAccount, accountedBuffer, currentCapacity, oldBuffer != NULL);
+    nwnnsscomp_memory_use(&g_memoryAccount, accountedBuffer, newSize);
+    
     // Function epilogue
     // 0x0040489a: pop ebp                       // Restore base pointer
     // 0x0040489b: ret 0x4                        // Return, pop 4 bytes (requiredSize parameter)
@@ -0,0 +1,579 @@
+// ============================================================================
+// NWNNSSCOMP ROUND-TRIP CORPUS HARNESS
+// ============================================================================
+// Workers claim scripts from a shared atomic cursor and write each result
+// into its own slot, so no lock is held while a tool runs and the report
+// comes out in corpus order. Tools are called from several threads at once;
+// the command tools give every invocation its own temporary files.
+// ============================================================================
+
+#include "nwnnsscomp_roundtrip.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <system_error>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// COMPARISON
+// ============================================================================
+
+/**
+ * @brief Drop NOPs and map every instruction index to its kept successor
+ *
+ * remap[i] is the position in kept of instruction i, or of the first kept
+ * instruction after it when i is a NOP, so a jump onto padding resolves to
+ * the instruction that actually executes next.
+ */
+static void nwnnsscomp_normalize(const NcsProgram* program, std::vector<const NcsInstruction*>* kept,
+                                 std::vector<int32_t>* remap)
+{
+    const std::vector<NcsInstruction>& instructions = program->instructions;
+    kept->clear();
+    remap->assign(instructions.size() + 1, 0);
+    for (size_t i = 0; i < instructions.size(); i++) {
+        (*remap)[i] = (int32_t)kept->size();
+        if (instructions[i].opcode != NCS_OP_NOP) {
+            kept->push_back(&instructions[i]);
+        }
+    }
+    (*remap)[instructions.size()] = (int32_t)kept->size();
+}
+
+/**
+ * @brief Whether two normalized instructions do the same thing
+ */
+static bool nwnnsscomp_same_instruction(const NcsInstruction* a, const std::vector<int32_t>& remapA,
+                                        const NcsInstruction* b, const std::vector<int32_t>& remapB)
+{
+    if (a->opcode != b->opcode || a->qualifier != b->qualifier) {
+        return false;
+    }
+    if (ncs_is_jump(a->opcode)) {
+        if (a->jumpTarget < 0 || b->jumpTarget < 0) {
+            return false;
+        }
+        return remapA[a->jumpTarget] == remapB[b->jumpTarget];
+    }
+    return a->arg0 == b->arg0 && a->arg1 == b->arg1 && a->arg2 == b->arg2 && a->text == b->text;
+}
+
+int nwnnsscomp_roundtrip_compare(const std::vector<uint8_t>& original, const std::vector<uint8_t>& roundtrip,
+                                 uint32_t* firstDifference)
+{
+    size_t common = std::min(original.size(), roundtrip.size());
+    size_t difference = 0;
+    while (difference < common && original[difference] == roundtrip[difference]) {
+        difference++;
+    }
+    if (firstDifference != NULL) {
+        *firstDifference = (uint32_t)difference;
+    }
+    if (difference == original.size() && difference == roundtrip.size()) {
+        return NWN_ROUNDTRIP_IDENTICAL;
+    }
+
+    NcsProgram programA;
+    NcsProgram programB;
+    if (ncs_decode_program(original.data(), original.size(), &programA) != NCS_OK ||
+        ncs_decode_program(roundtrip.data(), roundtrip.size(), &programB) != NCS_OK) {
+        return NWN_ROUNDTRIP_DIVERGENT;
+    }
+
+    std::vector<const NcsInstruction*> keptA;
+    std::vector<const NcsInstruction*> keptB;
+    std::vector<int32_t> remapA;
+    std::vector<int32_t> remapB;
+    nwnnsscomp_normalize(&programA, &keptA, &remapA);
+    nwnnsscomp_normalize(&programB, &keptB, &remapB);
+    if (keptA.size() != keptB.size()) {
+        return NWN_ROUNDTRIP_DIVERGENT;
+    }
+    for (size_t i = 0; i < keptA.size(); i++) {
+        if (!nwnnsscomp_same_instruction(keptA[i], remapA, keptB[i], remapB)) {
+            return NWN_ROUNDTRIP_DIVERGENT;
+        }
+    }
+    return NWN_ROUNDTRIP_PADDED;
+}
+
+// ============================================================================
+// FILES
+// ============================================================================
+
+static int nwnnsscomp_read_file(const std::string& path, std::vector<uint8_t>* data)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    data->clear();
+    uint8_t buffer[65536];
+    size_t count;
+    while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data->insert(data->end(), buffer, buffer + count);
+    }
+    int ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+static int nwnnsscomp_write_file(const std::string& path, const uint8_t* data, size_t size)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == NULL) {
+        return 0;
+    }
+    int ok = fwrite(data, 1, size, file) == size;
+    if (fclose(file) != 0) {
+        ok = 0;
+    }
+    return ok;
+}
+
+/**
+ * @brief Whether a file name ends in an extension, ignoring case
+ */
+static bool nwnnsscomp_has_extension(const std::string& name, const char* extension)
+{
+    size_t length = strlen(extension);
+    if (name.size() < length) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        char c = name[name.size() - length + i];
+        if (c >= 'A' && c <= 'Z') {
+            c = (char)(c - 'A' + 'a');
+        }
+        if (c != extension[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Append the corpus files below root/relative to paths
+ */
+static int nwnnsscomp_scan_directory(const std::string& root, const std::string& relative,
+                                     std::vector<std::string>* paths)
+{
+    std::string directory = relative.empty() ? root : root + "/" + relative;
+#if defined(_WIN32)
+    WIN32_FIND_DATAA findData;
+    HANDLE handle = FindFirstFileA((directory + "\\*").c_str(), &findData);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    do {
+        std::string name = findData.cFileName;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        std::string path = relative.empty() ? name : relative + "/" + name;
+        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            nwnnsscomp_scan_directory(root, path, paths);
+        } else if (nwnnsscomp_has_extension(name, ".nss") || nwnnsscomp_has_extension(name, ".ncs")) {
+            paths->push_back(path);
+        }
+    } while (FindNextFileA(handle, &findData));
+    FindClose(handle);
+#else
+    DIR* handle = opendir(directory.c_str());
+    if (handle == NULL) {
+        return 0;
+    }
+    struct dirent* entry;
+    while ((entry = readdir(handle)) != NULL) {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        std::string path = relative.empty() ? name : relative + "/" + name;
+        struct stat info;
+        if (stat((root + "/" + path).c_str(), &info) != 0) {
+            continue;
+        }
+        if (S_ISDIR(info.st_mode)) {
+            nwnnsscomp_scan_directory(root, path, paths);
+        } else if (nwnnsscomp_has_extension(name, ".nss") || nwnnsscomp_has_extension(name, ".ncs")) {
+            paths->push_back(path);
+        }
+    }
+    closedir(handle);
+#endif
+    return 1;
+}
+
+int nwnnsscomp_list_corpus(const char* directory, std::vector<std::string>* paths)
+{
+    paths->clear();
+    if (!nwnnsscomp_scan_directory(directory, "", paths)) {
+        return 0;
+    }
+    std::sort(paths->begin(), paths->end());
+    return 1;
+}
+
+// ============================================================================
+// COMMAND TOOLS
+// ============================================================================
+
+static std::atomic<uint32_t> g_roundtripTempSerial(0);
+
+/**
+ * @brief Directory for temporary files when none is configured
+ */
+static std::string nwnnsscomp_default_temp_directory()
+{
+#if defined(_WIN32)
+    char buffer[MAX_PATH + 1];
+    DWORD length = GetTempPathA(sizeof(buffer), buffer);
+    if (length > 0 && length < sizeof(buffer)) {
+        return std::string(buffer, length);
+    }
+    return ".";
+#else
+    const char* directory = getenv("TMPDIR");
+    return directory != NULL && directory[0] != '\0' ? directory : "/tmp";
+#endif
+}
+
+/**
+ * @brief Unique path prefix for one tool invocation
+ */
+static std::string nwnnsscomp_temp_prefix(const NwnRoundtripCommands* commands)
+{
+    std::string directory = commands->tempDirectory.empty() ? nwnnsscomp_default_temp_directory()
+                                                            : commands->tempDirectory;
+    char name[64];
+#if defined(_WIN32)
+    unsigned long process = (unsigned long)GetCurrentProcessId();
+#else
+    unsigned long process = (unsigned long)getpid();
+#endif
+    snprintf(name, sizeof(name), "nwnrt_%lu_%u", process, (unsigned)g_roundtripTempSerial.fetch_add(1));
+    char last = directory[directory.size() - 1];
+    return last == '/' || last == '\\' ? directory + name : directory + "/" + name;
+}
+
+/**
+ * @brief Replace every occurrence of a placeholder with a quoted path
+ */
+static void nwnnsscomp_substitute(std::string* command, const char* placeholder, const std::string& path)
+{
+    std::string quoted = "\"" + path + "\"";
+    size_t length = strlen(placeholder);
+    size_t position = 0;
+    while ((position = command->find(placeholder, position)) != std::string::npos) {
+        command->replace(position, length, quoted);
+        position += quoted.size();
+    }
+}
+
+/**
+ * @brief Run one tool command from input to output
+ *
+ * The command's console output goes to a log file that becomes the
+ * message when the command fails.
+ */
+static int nwnnsscomp_run_tool(const std::string& pattern, const std::string& prefix, const char* inputExtension,
+                               const uint8_t* input, size_t inputSize, const char* outputExtension,
+                               std::vector<uint8_t>* output, std::string* message)
+{
+    std::string inputPath = prefix + inputExtension;
+    std::string outputPath = prefix + outputExtension;
+    std::string logPath = prefix + ".log";
+    if (pattern.empty()) {
+        *message = "no command configured";
+        return 0;
+    }
+    if (!nwnnsscomp_write_file(inputPath, input, inputSize)) {
+        *message = "cannot write " + inputPath;
+        return 0;
+    }
+
+    std::string command = pattern;
+    nwnnsscomp_substitute(&command, NWNNSSCOMP_ROUNDTRIP_OUTPUT, outputPath);
+    nwnnsscomp_substitute(&command, NWNNSSCOMP_ROUNDTRIP_INPUT, inputPath);
+    command += " > \"" + logPath + "\" 2>&1";
+#if defined(_WIN32)
+    // cmd.exe strips the outer quotes of a command line that starts with one
+    command = "\"" + command + "\"";
+#endif
+
+    int status = system(command.c_str());
+    int ok = status == 0 && nwnnsscomp_read_file(outputPath, output);
+    if (!ok) {
+        std::vector<uint8_t> log;
+        nwnnsscomp_read_file(logPath, &log);
+        message->assign(log.begin(), log.end());
+        if (message->empty()) {
+            char text[64];
+            snprintf(text, sizeof(text), "command exited with status %d", status);
+            *message = text;
+        }
+    }
+    remove(inputPath.c_str());
+    remove(outputPath.c_str());
+    remove(logPath.c_str());
+    return ok;
+}
+
+static int nwnnsscomp_command_compile(const std::string& source, const std::string& name, std::vector<uint8_t>* ncs,
+                                      std::string* message, void* userData)
+{
+    (void)name;
+    const NwnRoundtripCommands* commands = (const NwnRoundtripCommands*)userData;
+    return nwnnsscomp_run_tool(commands->compile, nwnnsscomp_temp_prefix(commands), ".nss",
+                               (const uint8_t*)source.data(), source.size(), ".ncs", ncs, message);
+}
+
+static int nwnnsscomp_command_decompile(const std::vector<uint8_t>& ncs, const std::string& name,
+                                        std::string* source, std::string* message, void* userData)
+{
+    (void)name;
+    const NwnRoundtripCommands* commands = (const NwnRoundtripCommands*)userData;
+    std::vector<uint8_t> output;
+    if (!nwnnsscomp_run_tool(commands->decompile, nwnnsscomp_temp_prefix(commands), ".ncs", ncs.data(), ncs.size(),
+                             ".nss", &output, message)) {
+        return 0;
+    }
+    source->assign(output.begin(), output.end());
+    return 1;
+}
+
+NwnRoundtripTools nwnnsscomp_roundtrip_command_tools(const NwnRoundtripCommands* commands)
+{
+    NwnRoundtripTools tools;
+    tools.compile = nwnnsscomp_command_compile;
+    tools.decompile = nwnnsscomp_command_decompile;
+    tools.userData = (void*)commands;
+    tools.trace = NULL;
+    return tools;
+}
+
+// ============================================================================
+// CORPUS RUN
+// ============================================================================
+
+/**
+ * @brief Round-trip one corpus file
+ */
+static void nwnnsscomp_roundtrip_script(const std::string& directory, const NwnRoundtripTools* tools,
+                                        NwnRoundtripResult* result)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    result->status = NWN_ROUNDTRIP_FAILED;
+    result->stage = NWN_ROUNDTRIP_STAGE_READ;
+    result->originalSize = 0;
+    result->roundtripSize = 0;
+    result->firstDifference = 0;
+    result->message.clear();
+
+    std::vector<uint8_t> contents;
+    std::vector<uint8_t> original;
+    std::vector<uint8_t> roundtrip;
+    std::string decompiled;
+    std::chrono::steady_clock::time_point step;
+    if (!nwnnsscomp_read_file(directory + "/" + result->path, &contents)) {
+        result->message = "cannot read file";
+    } else {
+        bool ok = true;
+        if (nwnnsscomp_has_extension(result->path, ".ncs")) {
+            original.swap(contents);
+        } else {
+            result->stage = NWN_ROUNDTRIP_STAGE_COMPILE;
+            step = std::chrono::steady_clock::now();
+            ok = tools->compile(std::string(contents.begin(), contents.end()), result->path, &original,
+                                &result->message, tools->userData) != 0;
+            nwnnsscomp_trace_span(tools->trace, "step", "compile", step, std::chrono::steady_clock::now(), NULL,
+                                  std::string());
+        }
+        if (ok) {
+            result->originalSize = (uint32_t)original.size();
+            result->stage = NWN_ROUNDTRIP_STAGE_DECOMPILE;
+            step = std::chrono::steady_clock::now();
+            ok = tools->decompile(original, result->path, &decompiled, &result->message, tools->userData) != 0;
+            nwnnsscomp_trace_span(tools->trace, "step", "decompile", step, std::chrono::steady_clock::now(), NULL,
+                                  std::string());
+        }
+        if (ok) {
+            result->stage = NWN_ROUNDTRIP_STAGE_RECOMPILE;
+            step = std::chrono::steady_clock::now();
+            ok = tools->compile(decompiled, result->path, &roundtrip, &result->message, tools->userData) != 0;
+            nwnnsscomp_trace_span(tools->trace, "step", "recompile", step, std::chrono::steady_clock::now(), NULL,
+                                  std::string());
+        }
+        if (ok) {
+            result->stage = NWN_ROUNDTRIP_STAGE_COMPARE;
+            result->roundtripSize = (uint32_t)roundtrip.size();
+            result->status = nwnnsscomp_roundtrip_compare(original, roundtrip, &result->firstDifference);
+        }
+    }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    result->milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+    nwnnsscomp_trace_span(tools->trace, "script", result->path, start, end, "status",
+                          nwnnsscomp_roundtrip_status_name(result->status));
+}
+
+int nwnnsscomp_roundtrip_corpus(const char* directory, const NwnRoundtripTools* tools, uint32_t threads,
+                                std::vector<NwnRoundtripResult>* results, NwnRoundtripSummary* summary)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<std::string> paths;
+    results->clear();
+    if (!nwnnsscomp_list_corpus(directory, &paths)) {
+        return 0;
+    }
+
+    results->resize(paths.size());
+    for (size_t i = 0; i < paths.size(); i++) {
+        (*results)[i].path = paths[i];
+    }
+
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+        if (threads == 0) {
+            threads = 1;
+        }
+    }
+    if (threads > paths.size()) {
+        threads = paths.size() > 0 ? (uint32_t)paths.size() : 1;
+    }
+
+    std::string root = directory;
+    std::atomic<size_t> cursor(0);
+    std::atomic<uint32_t> workers(0);
+    auto worker = [&]() {
+        nwnnsscomp_trace_name_thread(tools->trace, "worker " + std::to_string(workers.fetch_add(1)));
+        size_t index;
+        while ((index = cursor.fetch_add(1)) < results->size()) {
+            nwnnsscomp_roundtrip_script(root, tools, &(*results)[index]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (uint32_t i = 1; i < threads; i++) {
+        try {
+            pool.push_back(std::thread(worker));
+        } catch (const std::system_error&) {
+            break;
+        }
+    }
+    worker();
+    for (size_t i = 0; i < pool.size(); i++) {
+        pool[i].join();
+    }
+
+    if (summary != NULL) {
+        memset(summary, 0, sizeof(*summary));
+        summary->scripts = (uint32_t)results->size();
+        summary->threads = (uint32_t)pool.size() + 1;
+        for (size_t i = 0; i < results->size(); i++) {
+            switch ((*results)[i].status) {
+            case NWN_ROUNDTRIP_IDENTICAL:  summary->identical++;  break;
+            case NWN_ROUNDTRIP_PADDED:     summary->padded++;     break;
+            case NWN_ROUNDTRIP_DIVERGENT:  summary->divergent++;  break;
+            default:                       summary->failed++;     break;
+            }
+        }
+        summary->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    return 1;
+}
+
+// ============================================================================
+// REPORT
+// ============================================================================
+
+const char* nwnnsscomp_roundtrip_status_name(int status)
+{
+    switch (status) {
+    case NWN_ROUNDTRIP_IDENTICAL:  return "identical";
+    case NWN_ROUNDTRIP_PADDED:     return "padded";
+    case NWN_ROUNDTRIP_DIVERGENT:  return "divergent";
+    default:                       return "failed";
+    }
+}
+
+static const char* nwnnsscomp_roundtrip_stage_name(int stage)
+{
+    switch (stage) {
+    case NWN_ROUNDTRIP_STAGE_READ:      return "read";
+    case NWN_ROUNDTRIP_STAGE_COMPILE:   return "compile";
+    case NWN_ROUNDTRIP_STAGE_DECOMPILE: return "decompile";
+    case NWN_ROUNDTRIP_STAGE_RECOMPILE: return "recompile";
+    default:                            return "compare";
+    }
+}
+
+/**
+ * @brief Write a JSON string literal
+ */
+static void nwnnsscomp_write_json_string(const std::string& text, FILE* stream)
+{
+    fputc('"', stream);
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\') {
+            fputc('\\', stream);
+            fputc(c, stream);
+        } else if (c == '\n') {
+            fputs("\\n", stream);
+        } else if (c == '\r') {
+            fputs("\\r", stream);
+        } else if (c == '\t') {
+            fputs("\\t", stream);
+        } else if (c < 0x20) {
+            fprintf(stream, "\\u%04x", c);
+        } else {
+            fputc(c, stream);
+        }
+    }
+    fputc('"', stream);
+}
+
+void nwnnsscomp_write_roundtrip_json(const std::vector<NwnRoundtripResult>* results,
+                                     const NwnRoundtripSummary* summary, FILE* stream)
+{
+    fprintf(stream,
+            "{\n  \"scripts\": %u,\n  \"identical\": %u,\n  \"padded\": %u,\n  \"divergent\": %u,\n"
+            "  \"failed\": %u,\n  \"threads\": %u,\n  \"seconds\": %.3f,\n  \"results\": [",
+            summary->scripts, summary->identical, summary->padded, summary->divergent, summary->failed,
+            summary->threads, summary->seconds);
+    for (size_t i = 0; i < results->size(); i++) {
+        const NwnRoundtripResult& result = (*results)[i];
+        fputs(i == 0 ? "\n    {\"path\": " : ",\n    {\"path\": ", stream);
+        nwnnsscomp_write_json_string(result.path, stream);
+        fprintf(stream, ", \"status\": \"%s\", \"stage\": \"%s\", \"ms\": %.3f",
+                nwnnsscomp_roundtrip_status_name(result.status), nwnnsscomp_roundtrip_stage_name(result.stage),
+                result.milliseconds);
+        if (result.stage == NWN_ROUNDTRIP_STAGE_COMPARE) {
+            fprintf(stream, ", \"originalSize\": %u, \"roundtripSize\": %u", result.originalSize,
+                    result.roundtripSize);
+            if (result.status != NWN_ROUNDTRIP_IDENTICAL) {
+                fprintf(stream, ", \"firstDifference\": %u", result.firstDifference);
+            }
+        }
+        if (result.status == NWN_ROUNDTRIP_FAILED) {
+            fputs(", \"message\": ", stream);
+            nwnnsscomp_write_json_string(result.message, stream);
+        }
+        fputc('}', stream);
+    }
+    fputs(results->empty() ? "]\n}\n" : "\n  ]\n}\n", stream);
+}
@@ -0,0 +1,180 @@
+// ============================================================================
+// NWNNSSCOMP ROUND-TRIP CORPUS HARNESS
+// ============================================================================
+// Mode 3 (roundtrip): every script of a corpus directory is compiled,
+// decompiled and recompiled, and the two compiled streams are compared.
+// Compiled .ncs files in the corpus skip the first compile and are
+// compared against the recompiled decompilation directly. Scripts are
+// processed on a pool of worker threads; each gets one of
+//   identical   - the streams are byte-for-byte equal
+//   padded      - they differ only in NOP padding: same instructions once
+//                 NOPs are dropped and jumps are compared by target
+//                 instruction (no other rewrite is treated as a match)
+//   divergent   - anything else
+//   failed      - a compile or decompile step failed
+// and the run ends with a JSON summary listing every script.
+//
+// The compiler and decompiler are supplied as tools: in-process callbacks,
+// or external commands run per script (nwnnsscomp_roundtrip_command_tools).
+// Tools with a trace writer record a track per worker, with a span per
+// script and per tool call.
+// ============================================================================
+
+#ifndef NWNNSSCOMP_ROUNDTRIP_H
+#define NWNNSSCOMP_ROUNDTRIP_H
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "ncs_bytecode.h"
+#include "nwnnsscomp_trace.h"
+
+#define NWNNSSCOMP_ROUNDTRIP_INPUT   "%in"     // Command placeholder: input file
+#define NWNNSSCOMP_ROUNDTRIP_OUTPUT  "%out"    // Command placeholder: output file
+
+enum NwnRoundtripStatus
+{
+    NWN_ROUNDTRIP_IDENTICAL = 0,
+    NWN_ROUNDTRIP_PADDED,
+    NWN_ROUNDTRIP_DIVERGENT,
+    NWN_ROUNDTRIP_FAILED
+};
+
+enum NwnRoundtripStage
+{
+    NWN_ROUNDTRIP_STAGE_READ = 0,      // Reading the corpus file
+    NWN_ROUNDTRIP_STAGE_COMPILE,       // NSS -> NCS
+    NWN_ROUNDTRIP_STAGE_DECOMPILE,     // NCS -> NSS
+    NWN_ROUNDTRIP_STAGE_RECOMPILE,     // Decompiled NSS -> NCS
+    NWN_ROUNDTRIP_STAGE_COMPARE        // Both streams produced
+};
+
+/**
+ * @brief Compile NSS source
+ *
+ * Called concurrently from several workers.
+ *
+ * @param source Script text
+ * @param name Script file name (for messages and include resolution)
+ * @param ncs Receives the "NCS V1.0B" stream
+ * @param message Receives the compiler's diagnostics on failure
+ * @param userData Pointer given in NwnRoundtripTools
+ * @return 1 on success, 0 on failure
+ */
+typedef int (*NwnRoundtripCompile)(const std::string& source, const std::string& name, std::vector<uint8_t>* ncs,
+                                   std::string* message, void* userData);
+
+/**
+ * @brief Decompile an NCS stream to NSS source (same contract as NwnRoundtripCompile)
+ */
+typedef int (*NwnRoundtripDecompile)(const std::vector<uint8_t>& ncs, const std::string& name, std::string* source,
+                                     std::string* message, void* userData);
+
+typedef struct NwnRoundtripTools
+{
+    NwnRoundtripCompile compile;
+    NwnRoundtripDecompile decompile;
+    void* userData;
+    NwnTraceWriter* trace;             // Span per script and tool call, or NULL
+} NwnRoundtripTools;
+
+/**
+ * @brief External commands used by nwnnsscomp_roundtrip_command_tools
+ *
+ * Each command contains NWNNSSCOMP_ROUNDTRIP_INPUT and
+ * NWNNSSCOMP_ROUNDTRIP_OUTPUT, replaced by quoted temporary file paths;
+ * a nonzero exit status or a missing output file is a failure.
+ */
+typedef struct NwnRoundtripCommands
+{
+    std::string compile;               // e.g. "nwnnsscomp -O0 -c %in -o %out"
+    std::string decompile;             // e.g. "ncsdecomp %in -o %out"
+    std::string tempDirectory;         // Where per-script files are written
+} NwnRoundtripCommands;
+
+typedef struct NwnRoundtripResult
+{
+    std::string path;                  // Corpus file, relative to the corpus directory
+    int status;                        // NwnRoundtripStatus
+    int stage;                         // NwnRoundtripStage reached
+    uint32_t originalSize;             // Bytes of the first compiled (or corpus) stream
+    uint32_t roundtripSize;            // Bytes of the recompiled stream
+    uint32_t firstDifference;          // Offset of the first differing byte (divergent/padded)
+    double milliseconds;               // Wall time for the script
+    std::string message;               // Tool diagnostics for failed scripts
+} NwnRoundtripResult;
+
+typedef struct NwnRoundtripSummary
+{
+    uint32_t scripts;
+    uint32_t identical;
+    uint32_t padded;
+    uint32_t divergent;
+    uint32_t failed;
+    uint32_t threads;
+    double seconds;                    // Wall time of the whole run
+} NwnRoundtripSummary;
+
+// ============================================================================
+// COMPARISON
+// ============================================================================
+
+/**
+ * @brief Classify two compiled streams
+ *
+ * @param original First stream
+ * @param roundtrip Recompiled stream
+ * @param firstDifference Receives the offset of the first differing byte (may be NULL)
+ * @return NWN_ROUNDTRIP_IDENTICAL, NWN_ROUNDTRIP_PADDED or NWN_ROUNDTRIP_DIVERGENT
+ *         (a stream that does not decode is divergent)
+ */
+int nwnnsscomp_roundtrip_compare(const std::vector<uint8_t>& original, const std::vector<uint8_t>& roundtrip,
+                                 uint32_t* firstDifference);
+
+// ============================================================================
+// CORPUS RUN
+// ============================================================================
+
+/**
+ * @brief Tools that run external commands through temporary files
+ *
+ * @param commands Command lines; must outlive the returned tools
+ */
+NwnRoundtripTools nwnnsscomp_roundtrip_command_tools(const NwnRoundtripCommands* commands);
+
+/**
+ * @brief List the .nss and .ncs files below a directory, sorted by relative path
+ *
+ * @return 1 on success, 0 if the directory cannot be read
+ */
+int nwnnsscomp_list_corpus(const char* directory, std::vector<std::string>* paths);
+
+/**
+ * @brief Round-trip every script of a corpus directory on a thread pool
+ *
+ * Results are in corpus order regardless of which worker ran each script.
+ *
+ * @param directory Corpus directory (searched recursively)
+ * @param tools Compiler and decompiler
+ * @param threads Worker threads (0 = hardware concurrency)
+ * @param results Receives one result per script
+ * @param summary Receives the counts (may be NULL)
+ * @return 1 if the corpus was read, 0 otherwise
+ */
+int nwnnsscomp_roundtrip_corpus(const char* directory, const NwnRoundtripTools* tools, uint32_t threads,
+                                std::vector<NwnRoundtripResult>* results, NwnRoundtripSummary* summary);
+
+/**
+ * @brief Write the summary and every result as one JSON object
+ */
+void nwnnsscomp_write_roundtrip_json(const std::vector<NwnRoundtripResult>* results,
+                                     const NwnRoundtripSummary* summary, FILE* stream);
+
+/**
+ * @brief Name of an NwnRoundtripStatus ("identical", ...)
+ */
+const char* nwnnsscomp_roundtrip_status_name(int status);
+
+#endif // NWNNSSCOMP_ROUNDTRIP_H
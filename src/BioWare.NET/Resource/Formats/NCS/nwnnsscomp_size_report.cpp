@@ -0,0 +1,276 @@
+// ============================================================================
+// NWNNSSCOMP SIZE REPORT - PER-FUNCTION SIZE AND OPCODE MIX
+// ============================================================================
+
+#include "nwnnsscomp_size_report.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+
+#include "ncs_vm_profiler.h"
+#include "nwnnsscomp_disasm.h"
+
+// ============================================================================
+// FUNCTION SPLITTING
+// ============================================================================
+
+/**
+ * @brief Find the symbol whose entry offset matches, or NULL
+ */
+static const NcsFunctionSymbol* nwnnsscomp_find_symbol(const std::vector<NcsFunctionSymbol>* symbols,
+                                                       uint32_t offset)
+{
+    if (symbols == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < symbols->size(); i++) {
+        if ((*symbols)[i].offset == offset) {
+            return &(*symbols)[i];
+        }
+    }
+    return NULL;
+}
+
+void nwnnsscomp_collect_function_stats(const NcsProgram* program,
+                                       const std::vector<NcsFunctionSymbol>* symbols,
+                                       std::vector<NcsFunctionStats>* functions)
+{
+    const std::vector<NcsInstruction>& instructions = program->instructions;
+    functions->clear();
+    if (instructions.empty()) {
+        return;
+    }
+
+    // Entries: the loader stub at the program start, every JSR target and
+    // every symbol the compiler knows about
+    std::vector<uint8_t> entries(instructions.size(), 0);
+    entries[0] = 1;
+    for (size_t i = 0; i < instructions.size(); i++) {
+        if (instructions[i].opcode == NCS_OP_JSR && instructions[i].jumpTarget >= 0) {
+            entries[instructions[i].jumpTarget] = 1;
+        }
+        if (nwnnsscomp_find_symbol(symbols, instructions[i].offset) != NULL) {
+            entries[i] = 1;
+        }
+    }
+
+    for (size_t i = 0; i < instructions.size(); i++) {
+        const NcsInstruction& instruction = instructions[i];
+        if (entries[i]) {
+            NcsFunctionStats stats;
+            const NcsFunctionSymbol* symbol = nwnnsscomp_find_symbol(symbols, instruction.offset);
+            if (symbol != NULL) {
+                stats.name = symbol->name;
+                stats.sourceFile = symbol->sourceFile;
+            }
+            else {
+                char name[32];
+                if (i == 0) {
+                    snprintf(name, sizeof(name), "_start");
+                }
+                else {
+                    snprintf(name, sizeof(name), "sub_%08X", instruction.offset);
+                }
+                stats.name = name;
+                stats.sourceFile = NWNNSSCOMP_UNKNOWN_SOURCE;
+            }
+            stats.offset = instruction.offset;
+            stats.bytes = 0;
+            stats.instructions = 0;
+            memset(stats.opcodeCounts, 0, sizeof(stats.opcodeCounts));
+            memset(stats.opcodeBytes, 0, sizeof(stats.opcodeBytes));
+            functions->push_back(stats);
+        }
+
+        NcsFunctionStats& current = functions->back();
+        uint32_t bytes = ncs_instruction_size(&instruction);
+        current.bytes += bytes;
+        current.instructions++;
+        if (instruction.opcode < NCS_OP_COUNT) {
+            current.opcodeCounts[instruction.opcode]++;
+            current.opcodeBytes[instruction.opcode] += bytes;
+        }
+    }
+}
+
+// ============================================================================
+// SYMBOLS FROM THE DEBUG FILE
+// ============================================================================
+
+int nwnnsscomp_symbols_match_program(const NcsProgram* program, const std::vector<NcsFunctionSymbol>* symbols)
+{
+    const std::vector<NcsInstruction>& instructions = program->instructions;
+    if (instructions.empty() || symbols->empty()) {
+        return 0;
+    }
+
+    std::vector<uint32_t> entries;
+    entries.push_back(instructions[0].offset);
+    for (size_t i = 0; i < instructions.size(); i++) {
+        if (instructions[i].opcode != NCS_OP_JSR) {
+            continue;
+        }
+        if (instructions[i].jumpTarget < 0) {
+            return 0;
+        }
+        uint32_t target = instructions[instructions[i].jumpTarget].offset;
+        if (nwnnsscomp_find_symbol(symbols, target) == NULL) {
+            return 0;
+        }
+        entries.push_back(target);
+    }
+    for (size_t s = 0; s < symbols->size(); s++) {
+        if (std::find(entries.begin(), entries.end(), (*symbols)[s].offset) == entries.end()) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int nwnnsscomp_read_function_symbols(const char* ncsPath, const uint8_t* bytecode, uint32_t size,
+                                     std::vector<NcsFunctionSymbol>* symbols)
+{
+    symbols->clear();
+    std::string ndbPath = ncsPath;
+    size_t dot = ndbPath.find_last_of('.');
+    if (dot != std::string::npos && ndbPath.find_first_of("/\\", dot) == std::string::npos) {
+        ndbPath.erase(dot);
+    }
+    ndbPath += ".ndb";
+
+    NwnMappedFile ndb;
+    if (!nwnnsscomp_map_file(ndbPath.c_str(), &ndb)) {
+        return 0;
+    }
+    int read = ndb.size != 0 && ncs_vm_read_ndb((const char*)ndb.data, ndb.size, symbols) != 0;
+    nwnnsscomp_unmap_file(&ndb);
+
+    NcsProgram program;
+    if (!read || ncs_decode_program(bytecode, size, &program) != NCS_OK ||
+        !nwnnsscomp_symbols_match_program(&program, symbols)) {
+        symbols->clear();
+        return 0;
+    }
+    return 1;
+}
+
+// ============================================================================
+// REPORT OUTPUT
+// ============================================================================
+
+typedef struct NcsSourceFileTotals
+{
+    std::string sourceFile;
+    uint32_t bytes;
+    uint32_t instructions;
+    std::vector<const NcsFunctionStats*> functions;
+} NcsSourceFileTotals;
+
+static bool nwnnsscomp_larger_file(const NcsSourceFileTotals& a, const NcsSourceFileTotals& b)
+{
+    return a.bytes != b.bytes ? a.bytes > b.bytes : a.sourceFile < b.sourceFile;
+}
+
+static bool nwnnsscomp_larger_function(const NcsFunctionStats* a, const NcsFunctionStats* b)
+{
+    return a->bytes != b->bytes ? a->bytes > b->bytes : a->offset < b->offset;
+}
+
+/**
+ * @brief Print the opcode mix of one function, most bytes first
+ */
+static void nwnnsscomp_print_opcode_mix(const NcsFunctionStats* function, FILE* stream)
+{
+    std::vector<uint8_t> opcodes;
+    for (int op = 0; op < NCS_OP_COUNT; op++) {
+        if (function->opcodeCounts[op] > 0) {
+            opcodes.push_back((uint8_t)op);
+        }
+    }
+    for (size_t i = 1; i < opcodes.size(); i++) {
+        // Insertion sort: at most NCS_OP_COUNT entries
+        uint8_t op = opcodes[i];
+        size_t j = i;
+        while (j > 0 && function->opcodeBytes[opcodes[j - 1]] < function->opcodeBytes[op]) {
+            opcodes[j] = opcodes[j - 1];
+            j--;
+        }
+        opcodes[j] = op;
+    }
+
+    fprintf(stream, "      ");
+    for (size_t i = 0; i < opcodes.size(); i++) {
+        fprintf(stream, "%s%s x%u (%u B)", i > 0 ? ", " : "", ncs_opcode_name(opcodes[i]),
+                function->opcodeCounts[opcodes[i]], function->opcodeBytes[opcodes[i]]);
+    }
+    fprintf(stream, "\n");
+}
+
+void nwnnsscomp_print_size_report(const std::vector<NcsFunctionStats>* functions,
+                                  const char* scriptName, uint32_t totalSize, FILE* stream)
+{
+    std::vector<NcsSourceFileTotals> files;
+    uint32_t totalInstructions = 0;
+
+    for (size_t i = 0; i < functions->size(); i++) {
+        const NcsFunctionStats* function = &(*functions)[i];
+        size_t f = 0;
+        while (f < files.size() && files[f].sourceFile != function->sourceFile) {
+            f++;
+        }
+        if (f == files.size()) {
+            NcsSourceFileTotals totals;
+            totals.sourceFile = function->sourceFile;
+            totals.bytes = 0;
+            totals.instructions = 0;
+            files.push_back(totals);
+        }
+        files[f].bytes += function->bytes;
+        files[f].instructions += function->instructions;
+        files[f].functions.push_back(function);
+        totalInstructions += function->instructions;
+    }
+
+    std::sort(files.begin(), files.end(), nwnnsscomp_larger_file);
+
+    fprintf(stream, "%s: %u bytes (%u header), %u instructions, %u functions\n",
+            scriptName, totalSize, (uint32_t)NCS_HEADER_SIZE, totalInstructions, (uint32_t)functions->size());
+
+    for (size_t f = 0; f < files.size(); f++) {
+        NcsSourceFileTotals& file = files[f];
+        std::sort(file.functions.begin(), file.functions.end(), nwnnsscomp_larger_function);
+
+        fprintf(stream, "\n%s: %u bytes (%.1f%%), %u instructions\n", file.sourceFile.c_str(), file.bytes,
+                totalSize > 0 ? 100.0 * file.bytes / totalSize : 0.0, file.instructions);
+        for (size_t i = 0; i < file.functions.size(); i++) {
+            const NcsFunctionStats* function = file.functions[i];
+            fprintf(stream, "    %-32s @%08X %7u bytes %6u instructions\n", function->name.c_str(),
+                    function->offset, function->bytes, function->instructions);
+            nwnnsscomp_print_opcode_mix(function, stream);
+        }
+    }
+}
+
+int nwnnsscomp_write_size_report(const uint8_t* bytecode, uint32_t size,
+                                 const std::vector<NcsFunctionSymbol>* symbols, const char* outputPath)
+{
+    NcsProgram program;
+    if (ncs_decode_program(bytecode, size, &program) != NCS_OK) {
+        return 0;
+    }
+
+    std::vector<NcsFunctionStats> functions;
+    nwnnsscomp_collect_function_stats(&program, symbols, &functions);
+
+    std::string reportPath = std::string(outputPath) + NWNNSSCOMP_SIZE_REPORT_EXTENSION;
+    FILE* reportFile = fopen(reportPath.c_str(), "w");
+    if (reportFile == NULL) {
+        return 0;
+    }
+
+    nwnnsscomp_print_size_report(&functions, outputPath, size, reportFile);
+    fclose(reportFile);
+    return 1;
+}
@@ -0,0 +1,113 @@
+// ============================================================================
+// NWNNSSCOMP SIZE REPORT
+// ============================================================================
+// Per-function byte size, instruction count and opcode mix for a compiled
+// NCS stream. With function symbols (from the .ndb of a debug compile) the
+// report is grouped by the source file that defined each function, which
+// shows the include helpers that contribute most to compiled script size;
+// without them every function is listed by offset under one group.
+// ============================================================================
+
+#ifndef NWNNSSCOMP_SIZE_REPORT_H
+#define NWNNSSCOMP_SIZE_REPORT_H
+
+#include <stdio.h>
+
+#include "ncs_bytecode.h"
+
+#define NWNNSSCOMP_SIZE_REPORT_EXTENSION   ".size.txt"   // Appended to the .ncs path
+#define NWNNSSCOMP_UNKNOWN_SOURCE          "<unknown>"   // Group for functions without a symbol
+
+/**
+ * @brief Function symbol supplied by the compiler
+ */
+typedef struct NcsFunctionSymbol
+{
+    std::string name;                  // Function name as declared in NSS
+    std::string sourceFile;            // File that defined the function (script or include)
+    uint32_t offset;                   // Entry offset in the written stream
+} NcsFunctionSymbol;
+
+/**
+ * @brief Size and opcode mix of one function
+ *
+ * A function spans from its entry (the program start or a JSR target) up
+ * to the next entry, so jump targets inside a body stay with the body.
+ */
+typedef struct NcsFunctionStats
+{
+    std::string name;                  // Symbol name, "_start" or "sub_XXXXXXXX"
+    std::string sourceFile;            // Defining file, NWNNSSCOMP_UNKNOWN_SOURCE if no symbol
+    uint32_t offset;                   // Entry offset
+    uint32_t bytes;                    // Encoded size of the body
+    uint32_t instructions;             // Instruction count
+    uint32_t opcodeCounts[NCS_OP_COUNT]; // Instruction count per NcsOpcode
+    uint32_t opcodeBytes[NCS_OP_COUNT];  // Encoded bytes per NcsOpcode
+} NcsFunctionStats;
+
+/**
+ * @brief Split a decoded program into functions and measure each one
+ *
+ * @param program Decoded program (offsets as laid out in the stream)
+ * @param symbols Function symbols, or NULL to name functions by offset
+ * @param functions Receives one entry per function in stream order
+ */
+void nwnnsscomp_collect_function_stats(const NcsProgram* program,
+                                       const std::vector<NcsFunctionSymbol>* symbols,
+                                       std::vector<NcsFunctionStats>* functions);
+
+/**
+ * @brief Print the report grouped by source file, largest first
+ *
+ * Functions without a symbol all fall in the NWNNSSCOMP_UNKNOWN_SOURCE group.
+ *
+ * @param functions Stats from nwnnsscomp_collect_function_stats
+ * @param scriptName Name printed in the report header
+ * @param totalSize Encoded size of the whole stream including the header
+ * @param stream Output stream
+ */
+void nwnnsscomp_print_size_report(const std::vector<NcsFunctionStats>* functions,
+                                  const char* scriptName, uint32_t totalSize, FILE* stream);
+
+/**
+ * @brief Check that function symbols describe this program
+ *
+ * Every symbol must start at a function entry (the program start or a JSR
+ * target) and every JSR target must have a symbol. Symbols from an .ndb of
+ * another build of the script fail this as soon as any function moved.
+ *
+ * @param program Decoded program
+ * @param symbols Function symbols
+ * @return 1 if the symbols match the program's function entries, 0 otherwise
+ */
+int nwnnsscomp_symbols_match_program(const NcsProgram* program, const std::vector<NcsFunctionSymbol>* symbols);
+
+/**
+ * @brief Read the function symbols of a written stream from the .ndb next to it
+ *
+ * The .ndb is the one a debug compile (nwnnsscomp -d) writes; nothing else
+ * confirms it belongs to this stream, so its symbols are dropped unless they
+ * match the stream's function entries (nwnnsscomp_symbols_match_program).
+ *
+ * @param ncsPath Path of the .ncs; the .ndb has the same name with the extension replaced
+ * @param bytecode Serialized "NCS V1.0B" stream written to ncsPath
+ * @param size Byte count of bytecode
+ * @param symbols Receives the symbols, or is left empty
+ * @return 1 if matching symbols were read, 0 if there is no usable .ndb
+ */
+int nwnnsscomp_read_function_symbols(const char* ncsPath, const uint8_t* bytecode, uint32_t size,
+                                     std::vector<NcsFunctionSymbol>* symbols);
+
+/**
+ * @brief Decode a written NCS buffer and write its report next to the output
+ *
+ * @param bytecode Serialized "NCS V1.0B" stream
+ * @param size Byte count of bytecode
+ * @param symbols Function symbols, or NULL
+ * @param outputPath Path of the .ncs file; the report goes to outputPath + NWNNSSCOMP_SIZE_REPORT_EXTENSION
+ * @return 1 on success, 0 if the stream does not decode or the report cannot be written
+ */
+int nwnnsscomp_write_size_report(const uint8_t* bytecode, uint32_t size,
+                                 const std::vector<NcsFunctionSymbol>* symbols, const char* outputPath);
+
+#endif // NWNNSSCOMP_SIZE_REPORT_H
@@ -0,0 +1,224 @@
+// ============================================================================
+// NWNNSSCOMP PER-PHASE COMPILE TIMING
+// ============================================================================
+
+#include "nwnnsscomp_timing.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char* const NWN_PHASE_NAMES[NWN_PHASE_COUNT] = {
+    "read", "includes", "lex", "parse", "semantic", "codegen", "optimize", "write"
+};
+
+const char* nwnnsscomp_phase_name(int phase)
+{
+    return (phase >= 0 && phase < NWN_PHASE_COUNT) ? NWN_PHASE_NAMES[phase] : "unknown";
+}
+
+void nwnnsscomp_timing_init(NwnPhaseTimer* timer, bool enabled, FILE* stream, NwnTraceWriter* trace)
+{
+    timer->enabled = enabled;
+    timer->stream = stream;
+    timer->trace = trace;
+    timer->script.clear();
+    timer->inScript = false;
+    timer->depth = 0;
+    memset(timer->nanoseconds, 0, sizeof(timer->nanoseconds));
+    for (int depth = 0; depth < NWNNSSCOMP_TIMING_MAX_DEPTH; depth++) {
+        timer->spanPhase[depth] = -1;
+    }
+    timer->scripts = 0;
+    timer->failed = 0;
+    memset(timer->totalNanoseconds, 0, sizeof(timer->totalNanoseconds));
+    memset(timer->maxNanoseconds, 0, sizeof(timer->maxNanoseconds));
+    timer->runNanoseconds = 0;
+}
+
+/**
+ * @brief Charge the time since the last transition to the innermost open phase
+ */
+static void nwnnsscomp_timing_charge(NwnPhaseTimer* timer, std::chrono::steady_clock::time_point now)
+{
+    if (timer->depth != 0) {
+        uint32_t top = timer->depth < NWNNSSCOMP_TIMING_MAX_DEPTH ? timer->depth : NWNNSSCOMP_TIMING_MAX_DEPTH;
+        timer->nanoseconds[timer->stack[top - 1]] +=
+            (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now - timer->mark).count();
+    }
+    timer->mark = now;
+}
+
+void nwnnsscomp_timing_script_begin(NwnPhaseTimer* timer, const char* script)
+{
+    if (!timer->enabled) {
+        return;
+    }
+    if (timer->inScript) {
+        nwnnsscomp_timing_script_end(timer, "failed");
+    }
+    timer->script = script != NULL ? script : "";
+    timer->inScript = true;
+    timer->depth = 0;
+    memset(timer->nanoseconds, 0, sizeof(timer->nanoseconds));
+    timer->start = std::chrono::steady_clock::now();
+    timer->mark = timer->start;
+}
+
+void nwnnsscomp_phase_begin_slow(NwnPhaseTimer* timer, int phase)
+{
+    if (!timer->inScript || phase < 0 || phase >= NWN_PHASE_COUNT) {
+        return;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    nwnnsscomp_timing_charge(timer, now);
+    if (timer->depth < NWNNSSCOMP_TIMING_MAX_DEPTH) {
+        timer->stack[timer->depth] = phase;
+        timer->begun[timer->depth] = now;
+    }
+    timer->depth++;
+}
+
+/**
+ * @brief Record the spans held back at depth and deeper
+ */
+static void nwnnsscomp_timing_flush_spans(NwnPhaseTimer* timer, uint32_t depth)
+{
+    for (uint32_t d = depth; d < NWNNSSCOMP_TIMING_MAX_DEPTH; d++) {
+        if (timer->spanPhase[d] < 0) {
+            continue;
+        }
+        char count[16];
+        snprintf(count, sizeof(count), "%u", timer->spanCount[d]);
+        nwnnsscomp_trace_span(timer->trace, "phase", NWN_PHASE_NAMES[timer->spanPhase[d]], timer->spanBegin[d],
+                              timer->spanEnd[d], "merged", count);
+        timer->spanPhase[d] = -1;
+    }
+}
+
+/**
+ * @brief Close the innermost phase at a given time
+ *
+ * Its span is held back: a later entry of the same phase under the same
+ * parent extends it, anything else at its depth or the parent closing
+ * records it.
+ */
+static void nwnnsscomp_timing_pop(NwnPhaseTimer* timer, std::chrono::steady_clock::time_point now)
+{
+    uint32_t depth = --timer->depth;
+    if (timer->trace == NULL || depth >= NWNNSSCOMP_TIMING_MAX_DEPTH) {
+        return;
+    }
+    nwnnsscomp_timing_flush_spans(timer, depth + 1);
+    int32_t phase = timer->stack[depth];
+    if (timer->spanPhase[depth] == phase) {
+        timer->spanEnd[depth] = now;
+        timer->spanCount[depth]++;
+        return;
+    }
+    nwnnsscomp_timing_flush_spans(timer, depth);
+    timer->spanPhase[depth] = phase;
+    timer->spanCount[depth] = 1;
+    timer->spanBegin[depth] = timer->begun[depth];
+    timer->spanEnd[depth] = now;
+}
+
+void nwnnsscomp_phase_end_slow(NwnPhaseTimer* timer)
+{
+    if (!timer->inScript || timer->depth == 0) {
+        return;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    nwnnsscomp_timing_charge(timer, now);
+    nwnnsscomp_timing_pop(timer, now);
+}
+
+/**
+ * @brief Write a JSON string literal (script paths: quotes, backslashes and control characters escaped)
+ */
+static void nwnnsscomp_timing_json_string(const std::string& text, FILE* stream)
+{
+    fputc('"', stream);
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\') {
+            fputc('\\', stream);
+            fputc(c, stream);
+        } else if (c < 0x20) {
+            fprintf(stream, "\\u%04x", c);
+        } else {
+            fputc(c, stream);
+        }
+    }
+    fputc('"', stream);
+}
+
+void nwnnsscomp_timing_script_end(NwnPhaseTimer* timer, const char* status)
+{
+    if (!timer->enabled || !timer->inScript) {
+        return;
+    }
+    // Phases left open by an early return end here
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    nwnnsscomp_timing_charge(timer, now);
+    while (timer->depth != 0) {
+        nwnnsscomp_timing_pop(timer, now);
+    }
+    if (timer->trace != NULL) {
+        nwnnsscomp_timing_flush_spans(timer, 0);
+    }
+    timer->inScript = false;
+    uint64_t total = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now - timer->start).count();
+    if (timer->trace != NULL) {
+        nwnnsscomp_trace_span(timer->trace, "script", timer->script, timer->start, now, "status", status);
+    }
+
+    timer->scripts++;
+    if (strcmp(status, "failed") == 0) {
+        timer->failed++;
+    }
+    timer->runNanoseconds += total;
+    for (int phase = 0; phase < NWN_PHASE_COUNT; phase++) {
+        timer->totalNanoseconds[phase] += timer->nanoseconds[phase];
+        if (timer->nanoseconds[phase] > timer->maxNanoseconds[phase]) {
+            timer->maxNanoseconds[phase] = timer->nanoseconds[phase];
+        }
+    }
+
+    if (timer->stream == NULL) {
+        return;
+    }
+    fputs("{\"script\": ", timer->stream);
+    nwnnsscomp_timing_json_string(timer->script, timer->stream);
+    fprintf(timer->stream, ", \"status\": \"%s\", \"totalMs\": %.3f", status, total / 1e6);
+    for (int phase = 0; phase < NWN_PHASE_COUNT; phase++) {
+        fprintf(timer->stream, ", \"%sMs\": %.3f", NWN_PHASE_NAMES[phase], timer->nanoseconds[phase] / 1e6);
+    }
+    fputs("}\n", timer->stream);
+}
+
+void nwnnsscomp_print_timing_table(const NwnPhaseTimer* timer, FILE* stream)
+{
+    if (!timer->enabled) {
+        return;
+    }
+    uint64_t charged = 0;
+    for (int phase = 0; phase < NWN_PHASE_COUNT; phase++) {
+        charged += timer->totalNanoseconds[phase];
+    }
+    uint32_t scripts = timer->scripts != 0 ? timer->scripts : 1;
+
+    fprintf(stream, "\nPhase timing: %u scripts (%u failed), %.3f ms total\n", timer->scripts, timer->failed,
+            timer->runNanoseconds / 1e6);
+    fprintf(stream, "  %-10s %12s %7s %12s %12s\n", "phase", "total ms", "share", "mean ms", "max ms");
+    for (int phase = 0; phase < NWN_PHASE_COUNT; phase++) {
+        double share = timer->runNanoseconds != 0 ? 100.0 * timer->totalNanoseconds[phase] / timer->runNanoseconds
+                                                  : 0.0;
+        fprintf(stream, "  %-10s %12.3f %6.1f%% %12.3f %12.3f\n", NWN_PHASE_NAMES[phase],
+                timer->totalNanoseconds[phase] / 1e6, share, timer->totalNanoseconds[phase] / 1e6 / scripts,
+                timer->maxNanoseconds[phase] / 1e6);
+    }
+    // Time inside a script but outside every phase (setup, messages, cleanup)
+    uint64_t other = timer->runNanoseconds > charged ? timer->runNanoseconds - charged : 0;
+    fprintf(stream, "  %-10s %12.3f %6.1f%%\n", "other", other / 1e6,
+            timer->runNanoseconds != 0 ? 100.0 * other / timer->runNanoseconds : 0.0);
+}
@@ -0,0 +1,135 @@
+// ============================================================================
+// NWNNSSCOMP PER-PHASE COMPILE TIMING
+// ============================================================================
+// Splits the wall time of each compiled script into phases: file read,
+// include resolution, lex, parse, semantic analysis, code generation,
+// optimization and write. Phases nest (the parser pulls tokens from the
+// lexer, the writer runs the optimizer) and time is charged to the
+// innermost open phase only, so the phase times of a script add up to its
+// total. Timestamps come from std::chrono::steady_clock (monotonic; QPC on
+// Windows).
+//
+// Each script produces one JSON line:
+//   {"script": "a.nss", "status": "passed", "totalMs": 1.234,
+//    "readMs": 0.010, "includesMs": 0.400, ..., "writeMs": 0.050}
+// and the run ends with a table of the totals per phase. With a trace
+// writer attached, every script and its phases are also recorded as spans
+// (see nwnnsscomp_trace.h). Repeated entries of one phase under the same
+// parent (a phase per include, per token) are merged into one span from
+// the first entry to the last exit, with the entry count as its "merged"
+// argument, so a trace has a few spans per script rather than thousands.
+//
+// A disabled timer costs one branch per phase transition.
+// ============================================================================
+
+#ifndef NWNNSSCOMP_TIMING_H
+#define NWNNSSCOMP_TIMING_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+#include <string>
+
+#include "nwnnsscomp_trace.h"
+
+#define NWNNSSCOMP_TIMING_MAX_DEPTH  16  // Deeper phases are charged to the phase at this depth
+
+enum NwnCompilePhase
+{
+    NWN_PHASE_READ = 0,                // Reading the source file
+    NWN_PHASE_INCLUDES,                // Resolving and loading #include files
+    NWN_PHASE_LEX,                     // Scanning tokens (bracket the scanner entry, nested in parse)
+    NWN_PHASE_PARSE,                   // Building the parse tree
+    NWN_PHASE_SEMANTIC,                // Symbol resolution, type and entry point checks
+    NWN_PHASE_CODEGEN,                 // nwnnsscomp_generate_bytecode (with its reduce actions) and main finalization
+    NWN_PHASE_OPTIMIZE,                // nwnnsscomp_optimize_bytecode
+    NWN_PHASE_WRITE,                   // Serializing and writing the .ncs
+    NWN_PHASE_COUNT
+};
+
+typedef struct NwnPhaseTimer
+{
+    bool enabled;
+    FILE* stream;                      // JSON lines destination, NULL for totals only
+    NwnTraceWriter* trace;             // Span destination, or NULL
+
+    // Current script
+    std::string script;
+    bool inScript;
+    uint32_t depth;                    // Open phases
+    int32_t stack[NWNNSSCOMP_TIMING_MAX_DEPTH];
+    std::chrono::steady_clock::time_point begun[NWNNSSCOMP_TIMING_MAX_DEPTH];  // Start of each open phase
+    int32_t spanPhase[NWNNSSCOMP_TIMING_MAX_DEPTH];   // Closed span held back per depth for merging, or -1
+    uint32_t spanCount[NWNNSSCOMP_TIMING_MAX_DEPTH];  // Phase entries merged into it
+    std::chrono::steady_clock::time_point spanBegin[NWNNSSCOMP_TIMING_MAX_DEPTH];
+    std::chrono::steady_clock::time_point spanEnd[NWNNSSCOMP_TIMING_MAX_DEPTH];
+    std::chrono::steady_clock::time_point start;  // Script start
+    std::chrono::steady_clock::time_point mark;   // Last phase transition
+    uint64_t nanoseconds[NWN_PHASE_COUNT];        // Exclusive time per phase
+
+    // Whole run
+    uint32_t scripts;
+    uint32_t failed;
+    uint64_t totalNanoseconds[NWN_PHASE_COUNT];
+    uint64_t maxNanoseconds[NWN_PHASE_COUNT];     // Slowest script per phase
+    uint64_t runNanoseconds;                      // Sum of script totals
+} NwnPhaseTimer;
+
+/**
+ * @brief Reset a timer
+ *
+ * @param timer Timer
+ * @param enabled False to make every other call a no-op
+ * @param stream Destination of the per-script JSON lines, or NULL
+ * @param trace Writer receiving a span per script and per phase, or NULL
+ */
+void nwnnsscomp_timing_init(NwnPhaseTimer* timer, bool enabled, FILE* stream, NwnTraceWriter* trace);
+
+/**
+ * @brief Start timing a script (ends the previous one as failed if still open)
+ */
+void nwnnsscomp_timing_script_begin(NwnPhaseTimer* timer, const char* script);
+
+/**
+ * @brief Finish the current script: close open phases, write its JSON line, add it to the totals
+ *
+ * @param status "passed", "failed" or "include"
+ */
+void nwnnsscomp_timing_script_end(NwnPhaseTimer* timer, const char* status);
+
+/**
+ * @brief Enter a phase; until the matching nwnnsscomp_phase_end, time is charged to it
+ */
+void nwnnsscomp_phase_begin_slow(NwnPhaseTimer* timer, int phase);
+
+/**
+ * @brief Leave the innermost phase
+ */
+void nwnnsscomp_phase_end_slow(NwnPhaseTimer* timer);
+
+static inline void nwnnsscomp_phase_begin(NwnPhaseTimer* timer, int phase)
+{
+    if (timer->enabled) {
+        nwnnsscomp_phase_begin_slow(timer, phase);
+    }
+}
+
+static inline void nwnnsscomp_phase_end(NwnPhaseTimer* timer)
+{
+    if (timer->enabled) {
+        nwnnsscomp_phase_end_slow(timer);
+    }
+}
+
+/**
+ * @brief Print total, share, mean and maximum time per phase over the run
+ */
+void nwnnsscomp_print_timing_table(const NwnPhaseTimer* timer, FILE* stream);
+
+/**
+ * @brief Short phase name ("read", "includes", ...)
+ */
+const char* nwnnsscomp_phase_name(int phase);
+
+#endif // NWNNSSCOMP_TIMING_H
@@ -0,0 +1,175 @@
+// ============================================================================
+// NWNNSSCOMP TRACE-EVENT EXPORT
+// ============================================================================
+// Tracks are numbered per process in the order threads first record, so a
+// thread keeps its track across writers and runs.
+// ============================================================================
+
+#include "nwnnsscomp_trace.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+
+static std::atomic<uint32_t> g_traceNextThread(0);
+
+/**
+ * @brief Track of the calling thread, assigned on first use
+ */
+static uint32_t nwnnsscomp_trace_thread()
+{
+    static thread_local uint32_t thread = UINT32_MAX;
+    if (thread == UINT32_MAX) {
+        thread = g_traceNextThread.fetch_add(1);
+    }
+    return thread;
+}
+
+/**
+ * @brief Microseconds from the writer's origin to a time point
+ */
+static double nwnnsscomp_trace_micros(const NwnTraceWriter* writer, std::chrono::steady_clock::time_point when)
+{
+    return std::chrono::duration<double, std::micro>(when - writer->origin).count();
+}
+
+void nwnnsscomp_trace_init(NwnTraceWriter* writer, bool enabled)
+{
+    std::lock_guard<std::mutex> guard(writer->lock);
+    writer->enabled = enabled;
+    writer->origin = std::chrono::steady_clock::now();
+    writer->events.clear();
+    writer->threadNames.clear();
+}
+
+void nwnnsscomp_trace_name_thread(NwnTraceWriter* writer, const std::string& name)
+{
+    if (writer == NULL || !writer->enabled) {
+        return;
+    }
+    uint32_t thread = nwnnsscomp_trace_thread();
+    std::lock_guard<std::mutex> guard(writer->lock);
+    if (writer->threadNames.size() <= thread) {
+        writer->threadNames.resize(thread + 1);
+    }
+    writer->threadNames[thread] = name;
+}
+
+void nwnnsscomp_trace_span(NwnTraceWriter* writer, const char* category, const std::string& name,
+                           std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end,
+                           const char* argName, const std::string& argValue)
+{
+    if (writer == NULL || !writer->enabled) {
+        return;
+    }
+    NwnTraceEvent event;
+    event.name = name;
+    event.category = category;
+    event.phase = 'X';
+    event.thread = nwnnsscomp_trace_thread();
+    event.timestamp = nwnnsscomp_trace_micros(writer, begin);
+    event.duration = std::chrono::duration<double, std::micro>(end - begin).count();
+    event.argName = argName;
+    event.argValue = argValue;
+    std::lock_guard<std::mutex> guard(writer->lock);
+    writer->events.push_back(event);
+}
+
+void nwnnsscomp_trace_instant(NwnTraceWriter* writer, const char* category, const std::string& name,
+                              const char* argName, const std::string& argValue)
+{
+    if (writer == NULL || !writer->enabled) {
+        return;
+    }
+    NwnTraceEvent event;
+    event.name = name;
+    event.category = category;
+    event.phase = 'i';
+    event.thread = nwnnsscomp_trace_thread();
+    event.timestamp = nwnnsscomp_trace_micros(writer, std::chrono::steady_clock::now());
+    event.duration = 0.0;
+    event.argName = argName;
+    event.argValue = argValue;
+    std::lock_guard<std::mutex> guard(writer->lock);
+    writer->events.push_back(event);
+}
+
+/**
+ * @brief Write a JSON string literal (quotes, backslashes and control characters escaped)
+ */
+static void nwnnsscomp_trace_json_string(const std::string& text, FILE* stream)
+{
+    fputc('"', stream);
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\') {
+            fputc('\\', stream);
+            fputc(c, stream);
+        } else if (c < 0x20) {
+            fprintf(stream, "\\u%04x", c);
+        } else {
+            fputc(c, stream);
+        }
+    }
+    fputc('"', stream);
+}
+
+/**
+ * @brief Order events by start time; an enclosing span sorts before the spans it contains
+ */
+static bool nwnnsscomp_trace_event_less(const NwnTraceEvent& a, const NwnTraceEvent& b)
+{
+    if (a.timestamp != b.timestamp) {
+        return a.timestamp < b.timestamp;
+    }
+    return a.duration > b.duration;
+}
+
+int nwnnsscomp_trace_save(NwnTraceWriter* writer, const char* path)
+{
+    FILE* stream = fopen(path, "w");
+    if (stream == NULL) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> guard(writer->lock);
+    std::stable_sort(writer->events.begin(), writer->events.end(), nwnnsscomp_trace_event_less);
+
+    fputs("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n", stream);
+    fputs("  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"nwnnsscomp\"}}", stream);
+    for (size_t thread = 0; thread < writer->threadNames.size(); thread++) {
+        if (writer->threadNames[thread].empty()) {
+            continue;
+        }
+        fprintf(stream, ",\n  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, \"args\": {\"name\": ",
+                (uint32_t)thread);
+        nwnnsscomp_trace_json_string(writer->threadNames[thread], stream);
+        fputs("}}", stream);
+    }
+    for (size_t i = 0; i < writer->events.size(); i++) {
+        const NwnTraceEvent* event = &writer->events[i];
+        fputs(",\n  {\"name\": ", stream);
+        nwnnsscomp_trace_json_string(event->name, stream);
+        fprintf(stream, ", \"cat\": \"%s\", \"ph\": \"%c\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f", event->category,
+                event->phase, event->thread, event->timestamp);
+        if (event->phase == 'X') {
+            fprintf(stream, ", \"dur\": %.3f", event->duration);
+        } else {
+            fputs(", \"s\": \"t\"", stream);
+        }
+        if (event->argName != NULL) {
+            fprintf(stream, ", \"args\": {\"%s\": ", event->argName);
+            nwnnsscomp_trace_json_string(event->argValue, stream);
+            fputc('}', stream);
+        }
+        fputc('}', stream);
+    }
+    fputs("\n]}\n", stream);
+
+    int ok = ferror(stream) == 0;
+    if (fclose(stream) != 0) {
+        ok = 0;
+    }
+    return ok;
+}
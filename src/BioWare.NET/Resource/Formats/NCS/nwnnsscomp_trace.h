@@ -0,0 +1,90 @@
+// ============================================================================
+// NWNNSSCOMP TRACE-EVENT EXPORT
+// ============================================================================
+// Records spans and instant markers and writes them in the Chrome
+// trace-event JSON format, which chrome://tracing and ui.perfetto.dev
+// open directly:
+//   {"traceEvents": [
+//     {"name": "a.nss", "cat": "script", "ph": "X", "pid": 1, "tid": 0,
+//      "ts": 12.000, "dur": 830.500, "args": {"status": "passed"}}, ...]}
+// Every thread that records gets its own track (tid), named with
+// nwnnsscomp_trace_name_thread, so uneven work between workers and
+// long-tail scripts show up at a glance. Timestamps are microseconds of
+// std::chrono::steady_clock since nwnnsscomp_trace_init.
+//
+// Recording takes a lock and appends to memory; nothing is written until
+// nwnnsscomp_trace_save. A disabled writer records nothing.
+// ============================================================================
+
+#ifndef NWNNSSCOMP_TRACE_H
+#define NWNNSSCOMP_TRACE_H
+
+#include <stdint.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+typedef struct NwnTraceEvent
+{
+    std::string name;
+    const char* category;              // "script", "phase", "step", "include"
+    char phase;                        // 'X' span, 'i' instant
+    uint32_t thread;                   // Track
+    double timestamp;                  // Microseconds since the writer's origin
+    double duration;                   // Microseconds (spans only)
+    const char* argName;               // Single argument, or NULL
+    std::string argValue;
+} NwnTraceEvent;
+
+typedef struct NwnTraceWriter
+{
+    bool enabled;
+    std::mutex lock;
+    std::chrono::steady_clock::time_point origin;
+    std::vector<NwnTraceEvent> events;
+    std::vector<std::string> threadNames;  // Indexed by track
+} NwnTraceWriter;
+
+/**
+ * @brief Reset a writer and take its time origin
+ *
+ * @param enabled False to make every other call a no-op
+ */
+void nwnnsscomp_trace_init(NwnTraceWriter* writer, bool enabled);
+
+/**
+ * @brief Name the calling thread's track ("main", "worker 3", ...)
+ */
+void nwnnsscomp_trace_name_thread(NwnTraceWriter* writer, const std::string& name);
+
+/**
+ * @brief Record a span on the calling thread's track
+ *
+ * @param writer Writer (may be NULL)
+ * @param category Static category string
+ * @param name Span name
+ * @param begin Start of the span
+ * @param end End of the span
+ * @param argName Static argument name, or NULL
+ * @param argValue Argument value
+ */
+void nwnnsscomp_trace_span(NwnTraceWriter* writer, const char* category, const std::string& name,
+                           std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end,
+                           const char* argName, const std::string& argValue);
+
+/**
+ * @brief Record an instant marker on the calling thread's track (same parameters as the span)
+ */
+void nwnnsscomp_trace_instant(NwnTraceWriter* writer, const char* category, const std::string& name,
+                              const char* argName, const std::string& argValue);
+
+/**
+ * @brief Write every recorded event, sorted by time, plus the track names
+ *
+ * @return 1 on success, 0 if the file cannot be written
+ */
+int nwnnsscomp_trace_save(NwnTraceWriter* writer, const char* path);
+
+#endif // NWNNSSCOMP_TRACE_H
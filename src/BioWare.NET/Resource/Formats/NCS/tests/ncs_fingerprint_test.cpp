@@ -0,0 +1,95 @@
+// ============================================================================
+// NWNNSSCOMP LIBRARY FUNCTION FINGERPRINTS - INDEX TESTS
+// ============================================================================
+// The same body seen in scripts without symbols stays one unnamed entry,
+// a real name replaces it, and only conflicting real names make it
+// ambiguous.
+// ============================================================================
+
+#include "ncs_test.h"
+#include "nwnnsscomp_fingerprint.h"
+
+/**
+ * @brief void helper() { 1 + 2; } void main() { helper(); }, main padded by extra NOPs
+ */
+static NcsProgram ncs_test_helper_program(int padding)
+{
+    std::vector<NcsInstruction> code;
+    for (int k = 0; k < padding; k++) {
+        code.push_back(ncs_test_op(NCS_OP_NOP));
+    }
+    code.push_back(ncs_test_jump(NCS_OP_JSR, padding + 2));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_const_int(1));                                    // helper
+    code.push_back(ncs_test_const_int(2));
+    code.push_back(ncs_test_op(NCS_OP_ADD, NCS_Q_INT_INT));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+
+    std::vector<uint8_t> bytes = ncs_test_encode(code);
+    NcsProgram program;
+    NCS_TEST_EQUAL(ncs_decode_program(bytes.data(), bytes.size(), &program), NCS_OK);
+    return program;
+}
+
+static std::vector<NcsFunctionSymbol> ncs_test_helper_symbols(const NcsProgram& program, int padding,
+                                                              const char* name)
+{
+    std::vector<NcsFunctionSymbol> symbols(1);
+    symbols[0].name = name;
+    symbols[0].sourceFile = "k_inc_utility";
+    symbols[0].offset = program.instructions[padding + 2].offset;
+    return symbols;
+}
+
+int main()
+{
+    NcsProgram first = ncs_test_helper_program(0);
+    NcsProgram second = ncs_test_helper_program(3);
+
+    // Two scripts without symbols: one unnamed entry seen twice
+    NwnFingerprintIndex index;
+    NCS_TEST_EQUAL(nwnnsscomp_fingerprint_add(&index, &first, NULL, "a"), 1);
+    NCS_TEST_EQUAL(nwnnsscomp_fingerprint_add(&index, &second, NULL, "b"), 0);
+    NCS_TEST_EQUAL(index.entries.size(), 1);
+    if (index.entries.size() != 1) {
+        return ncs_test_finish("ncs_fingerprint_test");
+    }
+    NwnFingerprintEntry& entry = index.entries[0];
+    NCS_TEST_EQUAL(entry.seen, 2);
+    NCS_TEST_CHECK(!entry.named && !entry.ambiguous);
+    NCS_TEST_CHECK(entry.name.compare(0, 6, "a:sub_") == 0);
+
+    // A real name replaces the unnamed one and is reported
+    std::vector<NcsFunctionSymbol> named = ncs_test_helper_symbols(second, 3, "UT_Add");
+    nwnnsscomp_fingerprint_add(&index, &second, &named, "b");
+    NCS_TEST_CHECK(entry.named && !entry.ambiguous && entry.name == "UT_Add" && entry.library == "k_inc_utility");
+    NCS_TEST_EQUAL(entry.seen, 3);
+
+    // More unnamed sightings do not disturb it
+    nwnnsscomp_fingerprint_add(&index, &first, NULL, "c");
+    NCS_TEST_CHECK(entry.named && !entry.ambiguous && entry.name == "UT_Add");
+
+    std::vector<NcsFunctionSymbol> identified;
+    nwnnsscomp_fingerprint_identify(&index, &first, &identified);
+    NCS_TEST_CHECK(identified.size() == 1 && identified[0].name == "UT_Add" &&
+                   identified[0].offset == first.instructions[2].offset);
+
+    // The saved index keeps names, counts and flags
+    const char* path = "ncs_fingerprint_test.ncsfp";
+    NCS_TEST_EQUAL(nwnnsscomp_fingerprint_save(&index, path), 1);
+    NwnFingerprintIndex loaded;
+    NCS_TEST_EQUAL(nwnnsscomp_fingerprint_load(&loaded, path), 1);
+    remove(path);
+    NCS_TEST_CHECK(loaded.entries.size() == 1 && loaded.entries[0].seen == 4 && loaded.entries[0].named &&
+                   !loaded.entries[0].ambiguous && loaded.entries[0].name == "UT_Add");
+
+    // A second real name makes the fingerprint ambiguous
+    std::vector<NcsFunctionSymbol> other = ncs_test_helper_symbols(first, 0, "GN_Add");
+    nwnnsscomp_fingerprint_add(&index, &first, &other, "a");
+    NCS_TEST_CHECK(entry.ambiguous);
+    nwnnsscomp_fingerprint_identify(&index, &first, &identified);
+    NCS_TEST_EQUAL(identified.size(), 0);
+
+    return ncs_test_finish("ncs_fingerprint_test");
+}
@@ -0,0 +1,274 @@
+// ============================================================================
+// NWNNSSCOMP BYTECODE OPTIMIZER - EQUIVALENCE TESTS
+// ============================================================================
+// Runs programs shaped like nwnnsscomp output before and after each -O level
+// and checks that the engine calls they make and the stack they leave are
+// the same, that -O1 and up actually rewrite them, and that -O0 leaves the
+// bytes alone.
+// ============================================================================
+
+#include "ncs_test.h"
+#include "nwnnsscomp_optimizer.h"
+
+/**
+ * @brief int f(int a) { return a * 10; } void main() { int x = 5; x = x + 1; int y = f(x); Print(y); Print(x); }
+ */
+static std::vector<NcsInstruction> ncs_test_call_program()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 2));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    // main
+    code.push_back(ncs_test_op(NCS_OP_RSADD, NCS_Q_INT));                     // 2: int x
+    code.push_back(ncs_test_const_int(5));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -8, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));          // 6: x = x + 1
+    code.push_back(ncs_test_const_int(1));
+    code.push_back(ncs_test_op(NCS_OP_ADD, NCS_Q_INT_INT));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -8, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RSADD, NCS_Q_INT));                     // 11: int y
+    code.push_back(ncs_test_op(NCS_OP_RSADD, NCS_Q_INT));                     // return slot
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -12, 4));         // argument x
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 23));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -8, 4));         // 15: y = f(x)
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -8, 4));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -8));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    // f: return slot at -8, a at -4
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));          // 23
+    code.push_back(ncs_test_const_int(10));
+    code.push_back(ncs_test_op(NCS_OP_MUL, NCS_Q_INT_INT));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -12, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    return code;
+}
+
+/**
+ * @brief int g = 7; void main() { g = g + 1; for (int i = 0; i < 3; i = i + 1) Print(i); Print(g); }
+ */
+static std::vector<NcsInstruction> ncs_test_globals_loop_program()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 2));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    // Globals: int g = 7, then main with BP at the globals frame
+    code.push_back(ncs_test_op(NCS_OP_RSADD, NCS_Q_INT));                     // 2
+    code.push_back(ncs_test_const_int(7));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -8, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_SAVEBP));
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 11));
+    code.push_back(ncs_test_op(NCS_OP_RESTOREBP));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    // main
+    code.push_back(ncs_test_op(NCS_OP_CPTOPBP, NCS_Q_STACK, -4, 4));          // 11: g = g + 1
+    code.push_back(ncs_test_const_int(1));
+    code.push_back(ncs_test_op(NCS_OP_ADD, NCS_Q_INT_INT));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNBP, NCS_Q_STACK, -4, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RSADD, NCS_Q_INT));                     // 16: int i = 0
+    code.push_back(ncs_test_const_int(0));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -8, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));          // 20: i < 3
+    code.push_back(ncs_test_const_int(3));
+    code.push_back(ncs_test_op(NCS_OP_LT, NCS_Q_INT_INT));
+    code.push_back(ncs_test_jump(NCS_OP_JZ, 32));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));          // 26: i = i + 1
+    code.push_back(ncs_test_const_int(1));
+    code.push_back(ncs_test_op(NCS_OP_ADD, NCS_Q_INT_INT));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -8, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_jump(NCS_OP_JMP, 20));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPBP, NCS_Q_STACK, -4, 4));          // 32
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    return code;
+}
+
+/**
+ * @brief int a(int n) { return n == 0 ? 0 : b(n - 1) + 1; } int b(int n) { return a(n); } void main() { Print(a(3)); }
+ */
+static std::vector<NcsInstruction> ncs_test_mutual_recursion_program()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 2));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_op(NCS_OP_RSADD, NCS_Q_INT));                     // 2: main
+    code.push_back(ncs_test_const_int(3));
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 7));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    // a: return slot at -8, n at -4
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));          // 7
+    code.push_back(ncs_test_jump(NCS_OP_JZ, 19));
+    code.push_back(ncs_test_op(NCS_OP_RSADD, NCS_Q_INT));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -8, 4));
+    code.push_back(ncs_test_const_int(1));
+    code.push_back(ncs_test_op(NCS_OP_SUB, NCS_Q_INT_INT));
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 24));
+    code.push_back(ncs_test_const_int(1));
+    code.push_back(ncs_test_op(NCS_OP_ADD, NCS_Q_INT_INT));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -12, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_jump(NCS_OP_JMP, 22));
+    code.push_back(ncs_test_const_int(0));                                    // 19: n == 0
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -12, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));                // 22
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    // b: return slot at -8, n at -4
+    code.push_back(ncs_test_op(NCS_OP_RSADD, NCS_Q_INT));                     // 24
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -8, 4));
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 7));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -12, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    return code;
+}
+
+/**
+ * @brief Run an encoded script, collecting the PrintInteger calls
+ *
+ * @return NcsVmResult of the run
+ */
+static int ncs_test_run(const std::vector<uint8_t>& bytes, std::vector<int32_t>* printed, uint32_t* sp)
+{
+    NcsVm vm;
+    ncs_vm_init(&vm, 0);
+    ncs_vm_register_action(&vm, NCS_TEST_ROUTINE_PRINT_INTEGER, ncs_test_print_integer, printed);
+    int result = ncs_vm_run(&vm, bytes.data(), (uint32_t)bytes.size());
+    *sp = vm.sp;
+    return result;
+}
+
+static void ncs_test_equivalence(const char* name, const std::vector<NcsInstruction>& code,
+                                 const std::vector<int32_t>& expected)
+{
+    std::vector<uint8_t> original = ncs_test_encode(code);
+    NCS_TEST_CHECK(!original.empty());
+
+    std::vector<int32_t> reference;
+    uint32_t referenceSp = 0;
+    NCS_TEST_EQUAL(ncs_test_run(original, &reference, &referenceSp), NCS_VM_OK);
+    NCS_TEST_CHECK(reference == expected);
+
+    for (int level = 0; level <= NWNNSSCOMP_OPT_LEVEL_MAX; level++) {
+        NcsOptimizerOptions options;
+        nwnnsscomp_optimizer_options_for_level(level, &options);
+        std::vector<uint8_t> optimized(original);
+        optimized.resize(original.size() + 256);
+        uint32_t size = (uint32_t)original.size();
+        NcsOptimizerReport report;
+        int rewritten = nwnnsscomp_optimize_bytecode(optimized.data(), &size, (uint32_t)optimized.size(), &options,
+                                                     &report);
+        optimized.resize(size);
+
+        if (level == 0) {
+            NCS_TEST_EQUAL(rewritten, 0);
+            NCS_TEST_CHECK(optimized == original);
+            continue;
+        }
+        NCS_TEST_EQUAL(rewritten, 1);
+        NCS_TEST_CHECK(optimized.size() < original.size());
+
+        std::vector<int32_t> printed;
+        uint32_t sp = 0;
+        int result = ncs_test_run(optimized, &printed, &sp);
+        if (result != NCS_VM_OK || printed != reference || sp != referenceSp) {
+            fprintf(stderr, "%s: -O%d changed behavior (result %d, %u calls, sp %u)\n", name, level, result,
+                    (uint32_t)printed.size(), sp);
+        }
+        NCS_TEST_EQUAL(result, NCS_VM_OK);
+        NCS_TEST_CHECK(printed == reference);
+        NCS_TEST_EQUAL(sp, referenceSp);
+    }
+}
+
+/**
+ * @brief A header without the big-endian size decodes as empty and is refused, not reported as a no-op
+ */
+static void ncs_test_rejects_unsized_header()
+{
+    std::vector<uint8_t> bytes = ncs_test_encode(ncs_test_call_program());
+    memset(&bytes[NCS_HEADER_SIZE_OFFSET], 0, 4);
+    std::vector<uint8_t> original(bytes);
+    bytes.resize(bytes.size() + 256);
+    uint32_t size = (uint32_t)original.size();
+    NcsOptimizerOptions options;
+    nwnnsscomp_optimizer_options_for_level(2, &options);
+    NCS_TEST_EQUAL(nwnnsscomp_optimize_bytecode(bytes.data(), &size, (uint32_t)bytes.size(), &options, NULL), -1);
+    NCS_TEST_EQUAL(size, original.size());
+    NCS_TEST_CHECK(memcmp(bytes.data(), original.data(), original.size()) == 0);
+}
+
+/**
+ * @brief Subroutines calling each other are left out of line
+ */
+static void ncs_test_mutual_recursion()
+{
+    std::vector<uint8_t> original = ncs_test_encode(ncs_test_mutual_recursion_program());
+    std::vector<int32_t> reference;
+    uint32_t referenceSp = 0;
+    NCS_TEST_EQUAL(ncs_test_run(original, &reference, &referenceSp), NCS_VM_OK);
+    NCS_TEST_CHECK(reference.size() == 1 && reference[0] == 3);
+
+    for (int level = 1; level <= NWNNSSCOMP_OPT_LEVEL_MAX; level++) {
+        NcsOptimizerOptions options;
+        nwnnsscomp_optimizer_options_for_level(level, &options);
+        std::vector<uint8_t> optimized(original);
+        optimized.resize(original.size() * 16);
+        uint32_t size = (uint32_t)original.size();
+        NCS_TEST_CHECK(nwnnsscomp_optimize_bytecode(optimized.data(), &size, (uint32_t)optimized.size(), &options,
+                                                    NULL) >= 0);
+        optimized.resize(size);
+        NCS_TEST_CHECK(optimized.size() <= original.size());
+
+        // main may be inlined into the entry stub; main -> a, a -> b and b -> a stay calls
+        NcsProgram program;
+        NCS_TEST_EQUAL(ncs_decode_program(optimized.data(), optimized.size(), &program), NCS_OK);
+        int calls = 0;
+        for (size_t i = 0; i < program.instructions.size(); i++) {
+            calls += program.instructions[i].opcode == NCS_OP_JSR ? 1 : 0;
+        }
+        NCS_TEST_CHECK(calls >= 3);
+
+        std::vector<int32_t> printed;
+        uint32_t sp = 0;
+        NCS_TEST_EQUAL(ncs_test_run(optimized, &printed, &sp), NCS_VM_OK);
+        NCS_TEST_CHECK(printed == reference);
+        NCS_TEST_EQUAL(sp, referenceSp);
+    }
+}
+
+int main()
+{
+    std::vector<int32_t> expected;
+    expected.push_back(60);
+    expected.push_back(6);
+    ncs_test_equivalence("call", ncs_test_call_program(), expected);
+
+    expected.clear();
+    expected.push_back(0);
+    expected.push_back(1);
+    expected.push_back(2);
+    expected.push_back(8);
+    ncs_test_equivalence("globals-loop", ncs_test_globals_loop_program(), expected);
+
+    ncs_test_rejects_unsized_header();
+    ncs_test_mutual_recursion();
+    return ncs_test_finish("ncs_optimizer_test");
+}
@@ -0,0 +1,57 @@
+// ============================================================================
+// NWNNSSCOMP ROUND-TRIP HARNESS - STREAM COMPARISON TESTS
+// ============================================================================
+// Only NOP padding is forgiven: any other difference, including a rewrite
+// with the same behavior, is divergent.
+// ============================================================================
+
+#include "ncs_test.h"
+#include "nwnnsscomp_roundtrip.h"
+
+/**
+ * @brief void main() { int x = 1; if (x) x = 2; }, with optional NOP padding before the branch target
+ */
+static std::vector<NcsInstruction> ncs_test_branch_program(int padding, int32_t assigned)
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_const_int(1));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));
+    code.push_back(ncs_test_jump(NCS_OP_JZ, 6 + padding));
+    code.push_back(ncs_test_const_int(assigned));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -8, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    for (int k = 0; k < padding; k++) {
+        code.push_back(ncs_test_op(NCS_OP_NOP));
+    }
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    return code;
+}
+
+int main()
+{
+    std::vector<uint8_t> original = ncs_test_encode(ncs_test_branch_program(0, 2));
+    uint32_t difference = 0;
+    NCS_TEST_EQUAL(nwnnsscomp_roundtrip_compare(original, original, &difference), NWN_ROUNDTRIP_IDENTICAL);
+    NCS_TEST_EQUAL(difference, original.size());
+
+    // NOPs before the branch target shift its offset but not what runs
+    std::vector<uint8_t> padded = ncs_test_encode(ncs_test_branch_program(2, 2));
+    NCS_TEST_EQUAL(nwnnsscomp_roundtrip_compare(original, padded, &difference), NWN_ROUNDTRIP_PADDED);
+    NCS_TEST_CHECK(difference < original.size());
+
+    std::vector<uint8_t> changed = ncs_test_encode(ncs_test_branch_program(0, 3));
+    NCS_TEST_EQUAL(nwnnsscomp_roundtrip_compare(original, changed, NULL), NWN_ROUNDTRIP_DIVERGENT);
+
+    // Same behavior with a different instruction sequence is not a match
+    std::vector<NcsInstruction> rewritten = ncs_test_branch_program(0, 2);
+    rewritten.insert(rewritten.begin() + 1, ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));   // Copy x and drop it
+    rewritten.insert(rewritten.begin() + 2, ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    rewritten[4] = ncs_test_jump(NCS_OP_JZ, 8);
+    NCS_TEST_EQUAL(nwnnsscomp_roundtrip_compare(original, ncs_test_encode(rewritten), NULL), NWN_ROUNDTRIP_DIVERGENT);
+
+    std::vector<uint8_t> truncated(original.begin(), original.begin() + 4);
+    NCS_TEST_EQUAL(nwnnsscomp_roundtrip_compare(original, truncated, NULL), NWN_ROUNDTRIP_DIVERGENT);
+
+    return ncs_test_finish("ncs_roundtrip_test");
+}
@@ -0,0 +1,85 @@
+// ============================================================================
+// NWNNSSCOMP SIZE REPORT - DEBUG SYMBOL TESTS
+// ============================================================================
+// Function names come from the .ndb next to the .ncs only while its
+// function offsets still match the stream; a sidecar left over from
+// another build of the script is ignored.
+// ============================================================================
+
+#include "ncs_test.h"
+#include "nwnnsscomp_size_report.h"
+
+#define NCS_TEST_NCS_PATH   "ncs_size_report_test.ncs"
+#define NCS_TEST_NDB_PATH   "ncs_size_report_test.ndb"
+
+/**
+ * @brief int f() { return 3; } void main() { Print(f()); }
+ */
+static std::vector<NcsInstruction> ncs_test_two_function_program()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 2));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_op(NCS_OP_RSADD, NCS_Q_INT));                     // 2: main
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 6));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_const_int(3));                                    // 6: f
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -8, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    return code;
+}
+
+/**
+ * @brief Write an .ndb naming main and f at the given stream offsets
+ */
+static void ncs_test_write_ndb(uint32_t mainOffset, uint32_t fOffset)
+{
+    FILE* file = fopen(NCS_TEST_NDB_PATH, "w");
+    NCS_TEST_CHECK(file != NULL);
+    if (file == NULL) {
+        return;
+    }
+    fprintf(file, "NDB V1.0\nN00 test\n");
+    fprintf(file, "f %08x %08x 000 v main\n", mainOffset, fOffset);
+    fprintf(file, "f %08x %08x 000 i f\n", fOffset, fOffset + 16);
+    fprintf(file, "l00 2 %08x %08x\n", mainOffset, fOffset);
+    fclose(file);
+}
+
+int main()
+{
+    std::vector<NcsInstruction> code = ncs_test_two_function_program();
+    std::vector<uint8_t> bytes = ncs_test_encode(code);
+    NcsProgram program;
+    NCS_TEST_EQUAL(ncs_decode_program(bytes.data(), (uint32_t)bytes.size(), &program), NCS_OK);
+    uint32_t mainOffset = program.instructions[2].offset;
+    uint32_t fOffset = program.instructions[6].offset;
+    std::vector<NcsFunctionSymbol> symbols;
+
+    // No sidecar
+    remove(NCS_TEST_NDB_PATH);
+    NCS_TEST_EQUAL(nwnnsscomp_read_function_symbols(NCS_TEST_NCS_PATH, bytes.data(), (uint32_t)bytes.size(),
+                                                    &symbols), 0);
+
+    // A sidecar from this build names both functions
+    ncs_test_write_ndb(mainOffset, fOffset);
+    NCS_TEST_EQUAL(nwnnsscomp_read_function_symbols(NCS_TEST_NCS_PATH, bytes.data(), (uint32_t)bytes.size(),
+                                                    &symbols), 1);
+    NCS_TEST_EQUAL(symbols.size(), 2);
+    std::vector<NcsFunctionStats> functions;
+    nwnnsscomp_collect_function_stats(&program, &symbols, &functions);
+    NCS_TEST_CHECK(functions.size() == 3 && functions[1].name == "main" && functions[2].name == "f");
+
+    // The same sidecar after f grew by one instruction in a rebuild
+    code.insert(code.begin() + 6, ncs_test_op(NCS_OP_NOP));
+    code[3] = ncs_test_jump(NCS_OP_JSR, 7);
+    std::vector<uint8_t> rebuilt = ncs_test_encode(code);
+    NCS_TEST_EQUAL(nwnnsscomp_read_function_symbols(NCS_TEST_NCS_PATH, rebuilt.data(), (uint32_t)rebuilt.size(),
+                                                    &symbols), 0);
+    NCS_TEST_CHECK(symbols.empty());
+
+    remove(NCS_TEST_NDB_PATH);
+    return ncs_test_finish("ncs_size_report_test");
+}
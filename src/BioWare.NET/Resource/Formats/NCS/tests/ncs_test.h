@@ -0,0 +1,173 @@
+// ============================================================================
+// NCS NATIVE TESTS - SHARED HELPERS
+// ============================================================================
+// Check macros and a small assembler for hand-written NCS programs. Each
+// test executable includes this once, calls its test functions from main
+// and returns ncs_test_finish().
+// ============================================================================
+
+#ifndef NCS_TEST_H
+#define NCS_TEST_H
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "ncs_bytecode.h"
+#include "ncs_vm.h"
+
+static int g_ncsTestChecks = 0;
+static int g_ncsTestFailures = 0;
+
+#define NCS_TEST_CHECK(condition_)                                                       \
+    do {                                                                                 \
+        g_ncsTestChecks++;                                                               \
+        if (!(condition_)) {                                                             \
+            g_ncsTestFailures++;                                                         \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition_); \
+        }                                                                                \
+    } while (0)
+
+#define NCS_TEST_EQUAL(actual_, expected_)                                               \
+    do {                                                                                 \
+        long long actualValue_ = (long long)(actual_);                                   \
+        long long expectedValue_ = (long long)(expected_);                               \
+        g_ncsTestChecks++;                                                               \
+        if (actualValue_ != expectedValue_) {                                            \
+            g_ncsTestFailures++;                                                         \
+            fprintf(stderr, "%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual_, \
+                    actualValue_, expectedValue_);                                       \
+        }                                                                                \
+    } while (0)
+
+/**
+ * @brief Print the totals and return the process exit code
+ */
+static int ncs_test_finish(const char* name)
+{
+    fprintf(stderr, "%s: %d checks, %d failed\n", name, g_ncsTestChecks, g_ncsTestFailures);
+    return g_ncsTestFailures == 0 ? 0 : 1;
+}
+
+// ============================================================================
+// ASSEMBLER
+// ============================================================================
+
+/**
+ * @brief One instruction; operands follow NcsInstruction (byte offsets and sizes)
+ */
+static NcsInstruction ncs_test_op(uint8_t opcode, uint8_t qualifier = NCS_Q_NONE, int32_t arg0 = 0,
+                                  int32_t arg1 = 0, int32_t arg2 = 0)
+{
+    NcsInstruction instruction;
+    instruction.offset = 0;
+    instruction.opcode = opcode;
+    instruction.qualifier = qualifier;
+    instruction.arg0 = arg0;
+    instruction.arg1 = arg1;
+    instruction.arg2 = arg2;
+    instruction.jumpTarget = -1;
+    return instruction;
+}
+
+/**
+ * @brief JMP/JSR/JZ/JNZ to an instruction index
+ */
+static NcsInstruction ncs_test_jump(uint8_t opcode, int32_t target)
+{
+    NcsInstruction instruction = ncs_test_op(opcode);
+    instruction.jumpTarget = target;
+    return instruction;
+}
+
+static NcsInstruction ncs_test_const_int(int32_t value)
+{
+    return ncs_test_op(NCS_OP_CONST, NCS_Q_INT, value);
+}
+
+static NcsInstruction ncs_test_const_string(const char* text)
+{
+    NcsInstruction instruction = ncs_test_op(NCS_OP_CONST, NCS_Q_STRING);
+    instruction.text = text;
+    return instruction;
+}
+
+/**
+ * @brief Encode an instruction list as an "NCS V1.0B" file
+ */
+static std::vector<uint8_t> ncs_test_encode(const std::vector<NcsInstruction>& instructions)
+{
+    NcsProgram program;
+    program.instructions = instructions;
+    program.declaredSize = 0;
+    std::vector<uint8_t> bytes;
+    if (ncs_encode_program(&program, &bytes) != NCS_OK) {
+        bytes.clear();
+    }
+    return bytes;
+}
+
+/**
+ * @brief Encode and load an instruction list
+ *
+ * @return NcsVmResult of ncs_vm_load_with_flags
+ */
+static int ncs_test_load(const std::vector<NcsInstruction>& instructions, NcsVmProgram* program,
+                         uint32_t flags = 0)
+{
+    std::vector<uint8_t> bytes = ncs_test_encode(instructions);
+    return ncs_vm_load_with_flags(bytes.data(), bytes.size(), flags, program);
+}
+
+// ============================================================================
+// ACTIONS
+// ============================================================================
+
+#define NCS_TEST_ROUTINE_PRINT_INTEGER  4    // void PrintInteger(int)
+#define NCS_TEST_ROUTINE_RANDOM         0    // int Random(int)
+
+/**
+ * @brief Signatures with PrintInteger and Random declared, every other routine unknown
+ */
+static std::vector<NcsVmActionSignature> ncs_test_signatures()
+{
+    NcsVmActionSignature unknown = { -1, 0, 0 };
+    std::vector<NcsVmActionSignature> signatures(8, unknown);
+    NcsVmActionSignature print = { 1, 0, 0 };
+    NcsVmActionSignature random = { 1, 1, NCS_VM_TYPE_INT };
+    signatures[NCS_TEST_ROUTINE_PRINT_INTEGER] = print;
+    signatures[NCS_TEST_ROUTINE_RANDOM] = random;
+    return signatures;
+}
+
+/**
+ * @brief PrintInteger: appends its argument to the std::vector<int32_t> in userData
+ */
+static int ncs_test_print_integer(NcsVm* vm, uint16_t, uint8_t, void* userData)
+{
+    int32_t value;
+    int result = ncs_vm_pop_int(vm, &value);
+    if (result == NCS_VM_OK) {
+        ((std::vector<int32_t>*)userData)->push_back(value);
+    }
+    return result;
+}
+
+/**
+ * @brief Random: returns a value derived from its argument and a counter in userData
+ */
+static int ncs_test_random(NcsVm* vm, uint16_t, uint8_t, void* userData)
+{
+    int32_t range;
+    int result = ncs_vm_pop_int(vm, &range);
+    if (result != NCS_VM_OK) {
+        return result;
+    }
+    uint32_t* counter = (uint32_t*)userData;
+    *counter = *counter * 1103515245u + 12345u;
+    return ncs_vm_push_int(vm, range > 0 ? (int32_t)((*counter >> 8) % (uint32_t)range) : 0);
+}
+
+#endif // NCS_TEST_H
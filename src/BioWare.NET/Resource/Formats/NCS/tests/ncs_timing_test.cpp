@@ -0,0 +1,79 @@
+// ============================================================================
+// NWNNSSCOMP PER-PHASE COMPILE TIMING - TRACE SPAN TESTS
+// ============================================================================
+// Repeated entries of a phase under one parent become one span; the times
+// charged per phase are unaffected.
+// ============================================================================
+
+#include "ncs_test.h"
+#include "nwnnsscomp_timing.h"
+
+/**
+ * @brief Events of one category and name
+ */
+static std::vector<const NwnTraceEvent*> ncs_test_spans(const NwnTraceWriter& trace, const char* category,
+                                                        const char* name)
+{
+    std::vector<const NwnTraceEvent*> spans;
+    for (size_t i = 0; i < trace.events.size(); i++) {
+        if (strcmp(trace.events[i].category, category) == 0 && trace.events[i].name == name) {
+            spans.push_back(&trace.events[i]);
+        }
+    }
+    return spans;
+}
+
+/**
+ * @brief A parse that pulls 1000 tokens, then two code generation calls
+ */
+static void ncs_test_compile(NwnPhaseTimer* timer, const char* script)
+{
+    nwnnsscomp_timing_script_begin(timer, script);
+    nwnnsscomp_phase_begin(timer, NWN_PHASE_PARSE);
+    for (int token = 0; token < 1000; token++) {
+        nwnnsscomp_phase_begin(timer, NWN_PHASE_LEX);
+        nwnnsscomp_phase_end(timer);
+    }
+    nwnnsscomp_phase_end(timer);
+    nwnnsscomp_phase_begin(timer, NWN_PHASE_CODEGEN);
+    nwnnsscomp_phase_end(timer);
+    nwnnsscomp_phase_begin(timer, NWN_PHASE_CODEGEN);
+    nwnnsscomp_phase_end(timer);
+    nwnnsscomp_timing_script_end(timer, "passed");
+}
+
+int main()
+{
+    NwnTraceWriter trace;
+    nwnnsscomp_trace_init(&trace, true);
+    NwnPhaseTimer timer;
+    nwnnsscomp_timing_init(&timer, true, NULL, &trace);
+
+    ncs_test_compile(&timer, "a.nss");
+    ncs_test_compile(&timer, "b.nss");
+
+    // Per script: the script, one parse, one merged lex and one merged codegen span
+    NCS_TEST_EQUAL(trace.events.size(), 8);
+    NCS_TEST_EQUAL(ncs_test_spans(trace, "script", "a.nss").size(), 1);
+    NCS_TEST_EQUAL(ncs_test_spans(trace, "phase", "parse").size(), 2);
+    std::vector<const NwnTraceEvent*> lex = ncs_test_spans(trace, "phase", "lex");
+    std::vector<const NwnTraceEvent*> codegen = ncs_test_spans(trace, "phase", "codegen");
+    NCS_TEST_EQUAL(lex.size(), 2);
+    NCS_TEST_EQUAL(codegen.size(), 2);
+    for (size_t i = 0; i < lex.size(); i++) {
+        NCS_TEST_CHECK(lex[i]->argValue == "1000");
+    }
+    for (size_t i = 0; i < codegen.size(); i++) {
+        NCS_TEST_CHECK(codegen[i]->argValue == "2");
+    }
+
+    // The lex span lies inside its parse span
+    std::vector<const NwnTraceEvent*> parse = ncs_test_spans(trace, "phase", "parse");
+    if (parse.size() == 2 && lex.size() == 2) {
+        NCS_TEST_CHECK(lex[0]->timestamp >= parse[0]->timestamp);
+        NCS_TEST_CHECK(lex[0]->timestamp + lex[0]->duration <= parse[0]->timestamp + parse[0]->duration + 0.001);
+    }
+    NCS_TEST_EQUAL(timer.scripts, 2);
+
+    return ncs_test_finish("ncs_timing_test");
+}
@@ -0,0 +1,254 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - SCHEDULER DETERMINISM TESTS
+// ============================================================================
+// The deferred commands a batch applies must not depend on how many
+// workers ran it or which worker stole which job.
+// ============================================================================
+
+#include "ncs_test.h"
+#include "ncs_vm_scheduler.h"
+
+#define NCS_TEST_ROUTINE_PRINT_OBJECT   5    // void PrintObject(object)
+
+/**
+ * @brief One applied command, flattened for comparison
+ */
+typedef struct NcsTestCommand
+{
+    uint32_t job;
+    uint32_t sequence;
+    uint16_t routine;
+    uint32_t objectSelf;
+    int32_t argument;
+
+    bool operator==(const NcsTestCommand& other) const
+    {
+        return job == other.job && sequence == other.sequence && routine == other.routine &&
+               objectSelf == other.objectSelf && argument == other.argument;
+    }
+} NcsTestCommand;
+
+static void ncs_test_collect(const NcsVmCommand* command, void* userData)
+{
+    NcsTestCommand flat;
+    flat.job = command->job;
+    flat.sequence = command->sequence;
+    flat.routine = command->routine;
+    flat.objectSelf = command->objectSelf;
+    flat.argument = command->arguments.empty() ? 0 : command->arguments[0].value.i;
+    ((std::vector<NcsTestCommand>*)userData)->push_back(flat);
+}
+
+/**
+ * @brief void main() { int i; for (i = 0; i < 3; i = i + 1) PrintInteger(i); PrintObject(OBJECT_SELF); }
+ */
+static std::vector<NcsInstruction> ncs_test_deferring_program()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_const_int(0));                                    // 0: int i = 0
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));          // 1: i < 3
+    code.push_back(ncs_test_const_int(3));
+    code.push_back(ncs_test_op(NCS_OP_LT, NCS_Q_INT_INT));
+    code.push_back(ncs_test_jump(NCS_OP_JZ, 13));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));          // 7: i = i + 1
+    code.push_back(ncs_test_const_int(1));
+    code.push_back(ncs_test_op(NCS_OP_ADD, NCS_Q_INT_INT));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -8, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_jump(NCS_OP_JMP, 1));
+    code.push_back(ncs_test_op(NCS_OP_CONST, NCS_Q_OBJECT, 0));               // 13
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_OBJECT, 1));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    return code;
+}
+
+/**
+ * @brief Run batches of jobs and collect the applied commands
+ */
+static std::vector<NcsTestCommand> ncs_test_batches(uint32_t workers, const NcsVm* prototype,
+                                                    const NcsVmProgram* program, uint32_t batches,
+                                                    uint32_t jobsPerBatch)
+{
+    std::vector<NcsTestCommand> applied;
+    NcsVmScheduler* scheduler = ncs_vm_scheduler_create(workers, prototype);
+    NCS_TEST_CHECK(scheduler != NULL);
+    if (scheduler == NULL) {
+        return applied;
+    }
+    NCS_TEST_EQUAL(ncs_vm_scheduler_worker_count(scheduler), workers);
+
+    for (uint32_t batch = 0; batch < batches; batch++) {
+        std::vector<NcsVmJob> jobs(jobsPerBatch);
+        for (uint32_t j = 0; j < jobsPerBatch; j++) {
+            jobs[j].program = program;
+            jobs[j].state = NULL;
+            jobs[j].objectSelf = 0x100 + batch * jobsPerBatch + j;
+            jobs[j].result = -1;
+            jobs[j].errorOffset = 0;
+            jobs[j].suspended = NULL;
+        }
+        NcsVmSchedulerStats stats;
+        uint32_t failures = ncs_vm_scheduler_run(scheduler, jobs.data(), jobs.size(), ncs_test_collect,
+                                                 &applied, &stats);
+        NCS_TEST_EQUAL(failures, 0);
+        NCS_TEST_EQUAL(stats.jobs, jobsPerBatch);
+        NCS_TEST_EQUAL(stats.commands, jobsPerBatch * 4);
+        for (uint32_t j = 0; j < jobsPerBatch; j++) {
+            NCS_TEST_EQUAL(jobs[j].result, NCS_VM_OK);
+        }
+    }
+    ncs_vm_scheduler_destroy(scheduler);
+    return applied;
+}
+
+/**
+ * @brief Run one batch under a slice budget, passing suspended jobs back until all finish
+ *
+ * @return Slices the slowest job needed
+ */
+static uint32_t ncs_test_sliced_batch(uint32_t workers, const NcsVm* prototype, const NcsVmProgram* program,
+                                      uint32_t jobCount, std::vector<NcsTestCommand>* applied)
+{
+    NcsVmScheduler* scheduler = ncs_vm_scheduler_create(workers, prototype);
+    NCS_TEST_CHECK(scheduler != NULL);
+    if (scheduler == NULL) {
+        return 0;
+    }
+
+    std::vector<NcsVmJob> jobs(jobCount);
+    for (uint32_t j = 0; j < jobCount; j++) {
+        jobs[j].program = program;
+        jobs[j].state = NULL;
+        jobs[j].objectSelf = 0x100 + j;
+        jobs[j].result = -1;
+        jobs[j].errorOffset = 0;
+        jobs[j].suspended = NULL;
+    }
+
+    uint32_t slices = 0;
+    std::vector<NcsVmJob> pending(jobs);
+    std::vector<uint32_t> ids;
+    for (uint32_t j = 0; j < jobCount; j++) {
+        ids.push_back(j);
+    }
+    while (!pending.empty() && slices < 1000) {
+        std::vector<NcsTestCommand> batch;
+        NcsVmSchedulerStats stats;
+        NCS_TEST_EQUAL(ncs_vm_scheduler_run(scheduler, pending.data(), pending.size(), ncs_test_collect, &batch,
+                                            &stats), 0);
+        NCS_TEST_EQUAL(stats.failures, 0);
+        slices++;
+
+        // Map batch positions back to the original job numbers
+        for (size_t c = 0; c < batch.size(); c++) {
+            batch[c].job = ids[batch[c].job];
+            applied->push_back(batch[c]);
+        }
+        std::vector<NcsVmJob> still;
+        std::vector<uint32_t> stillIds;
+        uint32_t suspended = 0;
+        for (size_t j = 0; j < pending.size(); j++) {
+            if (pending[j].result == NCS_VM_SUSPENDED) {
+                NCS_TEST_CHECK(pending[j].suspended != NULL);
+                still.push_back(pending[j]);
+                stillIds.push_back(ids[j]);
+                suspended++;
+            }
+            else {
+                NCS_TEST_EQUAL(pending[j].result, NCS_VM_OK);
+                NCS_TEST_CHECK(pending[j].suspended == NULL);
+            }
+        }
+        NCS_TEST_EQUAL(stats.suspended, suspended);
+        pending.swap(still);
+        ids.swap(stillIds);
+    }
+    NCS_TEST_CHECK(pending.empty());
+    for (size_t j = 0; j < pending.size(); j++) {
+        ncs_vm_scheduler_discard(&pending[j]);
+    }
+    ncs_vm_scheduler_destroy(scheduler);
+    return slices;
+}
+
+/**
+ * @brief Order commands by job, keeping each job's own order
+ */
+static std::vector<NcsTestCommand> ncs_test_by_job(const std::vector<NcsTestCommand>& commands, uint32_t jobCount)
+{
+    std::vector<NcsTestCommand> ordered;
+    for (uint32_t j = 0; j < jobCount; j++) {
+        uint32_t sequence = 0;
+        for (size_t c = 0; c < commands.size(); c++) {
+            if (commands[c].job == j) {
+                ordered.push_back(commands[c]);
+                ordered.back().sequence = sequence++;
+            }
+        }
+    }
+    return ordered;
+}
+
+int main()
+{
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_load(ncs_test_deferring_program(), &program), NCS_VM_OK);
+
+    size_t actionCount = 0;
+    const NcsVmActionInfo* actions = ncs_vm_k2_actions(&actionCount);
+    NcsVm prototype;
+    ncs_vm_init(&prototype, 0);
+    NCS_TEST_EQUAL(ncs_vm_register_deferred_action(&prototype, NCS_TEST_ROUTINE_PRINT_INTEGER,
+                                                   ncs_vm_find_action(actions, actionCount,
+                                                                      NCS_TEST_ROUTINE_PRINT_INTEGER)),
+                   NCS_VM_OK);
+    NCS_TEST_EQUAL(ncs_vm_register_deferred_action(&prototype, NCS_TEST_ROUTINE_PRINT_OBJECT,
+                                                   ncs_vm_find_action(actions, actionCount,
+                                                                      NCS_TEST_ROUTINE_PRINT_OBJECT)),
+                   NCS_VM_OK);
+
+    const uint32_t batches = 50;
+    const uint32_t jobsPerBatch = 64;
+    std::vector<NcsTestCommand> serial = ncs_test_batches(1, &prototype, &program, batches, jobsPerBatch);
+    std::vector<NcsTestCommand> parallel = ncs_test_batches(4, &prototype, &program, batches, jobsPerBatch);
+
+    NCS_TEST_EQUAL(serial.size(), batches * jobsPerBatch * 4);
+    NCS_TEST_CHECK(serial == parallel);
+
+    // Commands arrive in (job, sequence) order with each job's own OBJECT_SELF
+    for (size_t c = 0; c < jobsPerBatch * 4 && c < serial.size(); c++) {
+        const NcsTestCommand& command = serial[c];
+        NCS_TEST_EQUAL(command.job, c / 4);
+        NCS_TEST_EQUAL(command.sequence, c % 4);
+        NCS_TEST_EQUAL(command.objectSelf, 0x100 + c / 4);
+        if (c % 4 < 3) {
+            NCS_TEST_EQUAL(command.routine, NCS_TEST_ROUTINE_PRINT_INTEGER);
+            NCS_TEST_EQUAL(command.argument, (int32_t)(c % 4));
+        } else {
+            NCS_TEST_EQUAL(command.routine, NCS_TEST_ROUTINE_PRINT_OBJECT);
+            NCS_TEST_EQUAL((uint32_t)command.argument, 0x100 + c / 4);
+        }
+    }
+
+    // Many short batches with fewer jobs than workers: idle workers must
+    // leave each batch before the next one is dealt
+    std::vector<NcsTestCommand> shortSerial = ncs_test_batches(1, &prototype, &program, 500, 3);
+    std::vector<NcsTestCommand> shortParallel = ncs_test_batches(4, &prototype, &program, 500, 3);
+    NCS_TEST_EQUAL(shortParallel.size(), 500 * 3 * 4);
+    NCS_TEST_CHECK(shortSerial == shortParallel);
+
+    // Under a slice budget the workers suspend jobs and later batches
+    // continue them; the commands are those of the unbudgeted runs
+    NcsVm budgeted = prototype;
+    ncs_vm_set_budget(&budgeted, 8, 0);
+    std::vector<NcsTestCommand> sliced;
+    uint32_t slices = ncs_test_sliced_batch(4, &budgeted, &program, 16, &sliced);
+    NCS_TEST_CHECK(slices > 1);
+    std::vector<NcsTestCommand> unsliced(serial.begin(), serial.begin() + 16 * 4);
+    NCS_TEST_CHECK(ncs_test_by_job(sliced, 16) == unsliced);
+
+    return ncs_test_finish("ncs_vm_scheduler_test");
+}
@@ -0,0 +1,105 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - STORE_STATE CAPTURE TESTS
+// ============================================================================
+// Consecutive captures share the globals segment until a global is
+// written, and each continuation still sees the globals of its capture.
+// ============================================================================
+
+#include "ncs_test.h"
+
+#define NCS_TEST_ROUTINE_TAKE_STATE     7    // Takes the stored continuation, like DelayCommand
+
+static int ncs_test_take_state(NcsVm* vm, uint16_t, uint8_t, void* userData)
+{
+    NcsVmSavedState state;
+    int result = ncs_vm_take_stored_state(vm, &state);
+    if (result == NCS_VM_OK) {
+        ((std::vector<NcsVmSavedState>*)userData)->push_back(state);
+    }
+    return result;
+}
+
+/**
+ * @brief Append "Delay(PrintInteger(g))": STORE_STATE, JMP, the deferred block, ACTION
+ */
+static void ncs_test_delay_print_global(std::vector<NcsInstruction>* code)
+{
+    int32_t start = (int32_t)code->size();
+    code->push_back(ncs_test_op(NCS_OP_STORE_STATE, NCS_Q_NONE, 4, 0));
+    code->push_back(ncs_test_jump(NCS_OP_JMP, start + 5));
+    code->push_back(ncs_test_op(NCS_OP_CPTOPBP, NCS_Q_STACK, -4, 4));
+    code->push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code->push_back(ncs_test_op(NCS_OP_RETN));
+    code->push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_TAKE_STATE, 0));
+}
+
+/**
+ * @brief int g = 1; void main() { Delay(Print(g)); Delay(Print(g)); g = 2; Delay(Print(g)); g++; Delay(Print(g)); }
+ */
+static std::vector<NcsInstruction> ncs_test_capture_program()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 2));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_const_int(1));                                    // 2: global g
+    code.push_back(ncs_test_op(NCS_OP_SAVEBP));
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 8));
+    code.push_back(ncs_test_op(NCS_OP_RESTOREBP));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    ncs_test_delay_print_global(&code);                                       // 8: main
+    ncs_test_delay_print_global(&code);
+    code.push_back(ncs_test_const_int(2));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNBP, NCS_Q_STACK, -4, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    ncs_test_delay_print_global(&code);
+    code.push_back(ncs_test_op(NCS_OP_INCBP, NCS_Q_INT, -4));
+    ncs_test_delay_print_global(&code);
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    return code;
+}
+
+int main()
+{
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_load(ncs_test_capture_program(), &program), NCS_VM_OK);
+
+    NcsVm vm;
+    ncs_vm_init(&vm, 0);
+    std::vector<int32_t> printed;
+    std::vector<NcsVmSavedState> states;
+    ncs_vm_register_action(&vm, NCS_TEST_ROUTINE_PRINT_INTEGER, ncs_test_print_integer, &printed);
+    ncs_vm_register_action(&vm, NCS_TEST_ROUTINE_TAKE_STATE, ncs_test_take_state, &states);
+    NCS_TEST_EQUAL(ncs_vm_run_program(&vm, &program), NCS_VM_OK);
+    NCS_TEST_EQUAL(states.size(), 4);
+    if (states.size() != 4) {
+        return ncs_test_finish("ncs_vm_state_test");
+    }
+
+    // Unchanged globals are shared; CPDOWNBP and INCBP each force a new segment
+    NCS_TEST_CHECK(states[0].globals && states[0].globals == states[1].globals);
+    NCS_TEST_CHECK(states[2].globals != states[1].globals);
+    NCS_TEST_CHECK(states[3].globals != states[2].globals);
+
+    for (size_t k = 0; k < states.size(); k++) {
+        NCS_TEST_EQUAL(ncs_vm_run_state(&vm, &program, &states[k]), NCS_VM_OK);
+    }
+    NCS_TEST_EQUAL(printed.size(), 4);
+    if (printed.size() == 4) {
+        NCS_TEST_EQUAL(printed[0], 1);
+        NCS_TEST_EQUAL(printed[1], 1);
+        NCS_TEST_EQUAL(printed[2], 2);
+        NCS_TEST_EQUAL(printed[3], 3);
+    }
+
+    // A capture inside a resumed continuation shares the segment it was resumed with
+    std::vector<NcsVmSavedState> resumed;
+    resumed.swap(states);
+    NcsVmSavedState first = resumed[0];
+    first.resumeIndex = 8;                                                    // Run main's body again as a block
+    states.clear();
+    NCS_TEST_EQUAL(ncs_vm_run_state(&vm, &program, &first), NCS_VM_OK);
+    NCS_TEST_CHECK(states.size() == 4 && states[0].globals == first.globals);
+
+    return ncs_test_finish("ncs_vm_state_test");
+}
@@ -0,0 +1,169 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - STRING POOL TESTS
+// ============================================================================
+// The pool is reclaimed at the start of every run, literals are bound per
+// loaded program rather than per address, and continuations carry their
+// own string texts.
+// ============================================================================
+
+#include "ncs_test.h"
+
+#define NCS_TEST_ROUTINE_PRINT_STRING   1    // void PrintString(string)
+#define NCS_TEST_ROUTINE_TAKE_STATE     7    // Takes the stored continuation, like DelayCommand
+
+static int ncs_test_print_string(NcsVm* vm, uint16_t, uint8_t, void* userData)
+{
+    std::string text;
+    int result = ncs_vm_pop_string(vm, &text);
+    if (result == NCS_VM_OK) {
+        ((std::vector<std::string>*)userData)->push_back(text);
+    }
+    return result;
+}
+
+static int ncs_test_take_state(NcsVm* vm, uint16_t, uint8_t, void* userData)
+{
+    NcsVmSavedState state;
+    int result = ncs_vm_take_stored_state(vm, &state);
+    if (result == NCS_VM_OK) {
+        ((std::vector<NcsVmSavedState>*)userData)->push_back(state);
+    }
+    return result;
+}
+
+/**
+ * @brief void main() { PrintString(text + text); }
+ */
+static std::vector<NcsInstruction> ncs_test_print_program(const char* text)
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_const_string(text));
+    code.push_back(ncs_test_const_string(text));
+    code.push_back(ncs_test_op(NCS_OP_ADD, NCS_Q_STRING_STRING));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_STRING, 1));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    return code;
+}
+
+/**
+ * @brief string g = "hello"; void main() { string l = " world"; Delay(PrintString(g + l)); }
+ */
+static std::vector<NcsInstruction> ncs_test_deferred_program()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 2));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_const_string("hello"));                           // 2: global g
+    code.push_back(ncs_test_op(NCS_OP_SAVEBP));
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 8));
+    code.push_back(ncs_test_op(NCS_OP_RESTOREBP));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_const_string(" world"));                          // 8: local l
+    code.push_back(ncs_test_op(NCS_OP_STORE_STATE, NCS_Q_NONE, 4, 4));
+    code.push_back(ncs_test_jump(NCS_OP_JMP, 16));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPBP, NCS_Q_STACK, -4, 4));          // 11: deferred block
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -8, 4));
+    code.push_back(ncs_test_op(NCS_OP_ADD, NCS_Q_STRING_STRING));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_STRING, 1));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_TAKE_STATE, 0)); // 16
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    return code;
+}
+
+static void ncs_test_pool_is_reclaimed()
+{
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_load(ncs_test_print_program("ab"), &program), NCS_VM_OK);
+
+    NcsVm vm;
+    ncs_vm_init(&vm, 0);
+    std::vector<std::string> printed;
+    ncs_vm_register_action(&vm, NCS_TEST_ROUTINE_PRINT_STRING, ncs_test_print_string, &printed);
+    size_t firstRun = 0;
+    for (int run = 0; run < 1000; run++) {
+        NCS_TEST_EQUAL(ncs_vm_run_program(&vm, &program), NCS_VM_OK);
+        if (run == 0) {
+            firstRun = vm.strings.size();
+        }
+    }
+    NCS_TEST_EQUAL(vm.strings.size(), firstRun);
+    NCS_TEST_EQUAL(printed.size(), 1000);
+    NCS_TEST_CHECK(printed.back() == "abab");
+
+    // Strings the host pushed before a run survive the reclaim
+    NCS_TEST_EQUAL(ncs_vm_push_string(&vm, "kept"), NCS_VM_OK);
+    NCS_TEST_EQUAL(ncs_vm_run_program(&vm, &program), NCS_VM_OK);
+    std::string text;
+    NCS_TEST_EQUAL(ncs_vm_pop_string(&vm, &text), NCS_VM_OK);
+    NCS_TEST_CHECK(text == "kept");
+}
+
+/**
+ * @brief A program reloaded at the same address must not reuse the old literals
+ */
+static void ncs_test_literals_follow_the_load()
+{
+    NcsVm vm;
+    ncs_vm_init(&vm, 0);
+    std::vector<std::string> printed;
+    ncs_vm_register_action(&vm, NCS_TEST_ROUTINE_PRINT_STRING, ncs_test_print_string, &printed);
+
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_load(ncs_test_print_program("a"), &program), NCS_VM_OK);
+    NCS_TEST_EQUAL(ncs_vm_run_program(&vm, &program), NCS_VM_OK);
+    NCS_TEST_EQUAL(ncs_test_load(ncs_test_print_program("b"), &program), NCS_VM_OK);
+    NCS_TEST_EQUAL(ncs_vm_run_program(&vm, &program), NCS_VM_OK);
+
+    NCS_TEST_EQUAL(printed.size(), 2);
+    NCS_TEST_CHECK(printed.size() == 2 && printed[0] == "aa" && printed[1] == "bb");
+}
+
+/**
+ * @brief A continuation with string globals and locals runs after the pool was reclaimed, and on another machine
+ */
+static void ncs_test_state_owns_its_strings()
+{
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_load(ncs_test_deferred_program(), &program), NCS_VM_OK);
+    NcsVmProgram other;
+    NCS_TEST_EQUAL(ncs_test_load(ncs_test_print_program("x"), &other), NCS_VM_OK);
+
+    NcsVm vm;
+    ncs_vm_init(&vm, 0);
+    std::vector<std::string> printed;
+    std::vector<NcsVmSavedState> states;
+    ncs_vm_register_action(&vm, NCS_TEST_ROUTINE_PRINT_STRING, ncs_test_print_string, &printed);
+    ncs_vm_register_action(&vm, NCS_TEST_ROUTINE_TAKE_STATE, ncs_test_take_state, &states);
+    NCS_TEST_EQUAL(ncs_vm_run_program(&vm, &program), NCS_VM_OK);
+    NCS_TEST_EQUAL(states.size(), 1);
+    if (states.empty()) {
+        return;
+    }
+
+    // Reclaim the pool with unrelated runs
+    for (int run = 0; run < 10; run++) {
+        NCS_TEST_EQUAL(ncs_vm_run_program(&vm, &other), NCS_VM_OK);
+    }
+    printed.clear();
+    NCS_TEST_EQUAL(ncs_vm_run_state(&vm, &program, &states[0]), NCS_VM_OK);
+    NCS_TEST_EQUAL(printed.size(), 1);
+    NCS_TEST_CHECK(!printed.empty() && printed[0] == "hello world");
+
+    NcsVm fresh;
+    ncs_vm_init(&fresh, 0);
+    std::vector<std::string> freshPrinted;
+    ncs_vm_register_action(&fresh, NCS_TEST_ROUTINE_PRINT_STRING, ncs_test_print_string, &freshPrinted);
+    NCS_TEST_EQUAL(ncs_vm_run_state(&fresh, &program, &states[0]), NCS_VM_OK);
+    NCS_TEST_CHECK(freshPrinted.size() == 1 && freshPrinted[0] == "hello world");
+}
+
+int main()
+{
+    ncs_test_pool_is_reclaimed();
+    ncs_test_literals_follow_the_load();
+    ncs_test_state_owns_its_strings();
+    return ncs_test_finish("ncs_vm_strings_test");
+}
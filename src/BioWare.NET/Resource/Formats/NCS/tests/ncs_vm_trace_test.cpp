@@ -0,0 +1,117 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - TRACE ROUND-TRIP TESTS
+// ============================================================================
+// Records runs whose path depends on an engine call, replays them without
+// the engine, and checks that a changed script is caught as divergence.
+// ============================================================================
+
+#include "ncs_test.h"
+#include "ncs_vm_trace.h"
+
+#define NCS_TEST_SCRIPT_ID  7
+
+/**
+ * @brief void main() { int x = Random(10); if (x) PrintInteger(x); else PrintInteger(-1); }
+ *
+ * @param branch NCS_OP_JZ for the script as recorded, NCS_OP_JNZ for a changed one
+ */
+static std::vector<NcsInstruction> ncs_test_random_branch_program(uint8_t branch)
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_const_int(10));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_RANDOM, 1));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));
+    code.push_back(ncs_test_jump(branch, 7));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code.push_back(ncs_test_jump(NCS_OP_JMP, 9));
+    code.push_back(ncs_test_const_int(-1));                                   // 7
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));                // 9
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    return code;
+}
+
+static const NcsVmProgram* ncs_test_resolve(uint32_t scriptId, void* userData)
+{
+    return scriptId == NCS_TEST_SCRIPT_ID ? (const NcsVmProgram*)userData : NULL;
+}
+
+/**
+ * @brief Read back everything written to a temporary file
+ */
+static std::vector<uint8_t> ncs_test_read_all(FILE* file)
+{
+    std::vector<uint8_t> bytes;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size > 0) {
+        bytes.resize((size_t)size);
+        if (fread(bytes.data(), 1, bytes.size(), file) != bytes.size()) {
+            bytes.clear();
+        }
+    }
+    return bytes;
+}
+
+int main()
+{
+    const uint32_t runs = 20;
+
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_load(ncs_test_random_branch_program(NCS_OP_JZ), &program), NCS_VM_OK);
+
+    FILE* file = tmpfile();
+    NCS_TEST_CHECK(file != NULL);
+    if (file == NULL) {
+        return ncs_test_finish("ncs_vm_trace_test");
+    }
+
+    // Record
+    std::vector<NcsVmActionSignature> signatures = ncs_test_signatures();
+    NcsVmTraceRecorder recorder;
+    NCS_TEST_EQUAL(ncs_vm_trace_begin(&recorder, file, 0, signatures.data(), signatures.size()), 1);
+    ncs_vm_trace_set_script_id(&recorder, &program, NCS_TEST_SCRIPT_ID);
+
+    NcsVm vm;
+    ncs_vm_init(&vm, 0);
+    std::vector<int32_t> printed;
+    uint32_t counter = 12345;
+    ncs_vm_register_action(&vm, NCS_TEST_ROUTINE_PRINT_INTEGER, ncs_test_print_integer, &printed);
+    ncs_vm_register_action(&vm, NCS_TEST_ROUTINE_RANDOM, ncs_test_random, &counter);
+    vm.recorder = &recorder;
+    for (uint32_t r = 0; r < runs; r++) {
+        ncs_vm_trace_seed(&recorder, r);
+        NCS_TEST_EQUAL(ncs_vm_run_program(&vm, &program), NCS_VM_OK);
+    }
+    vm.recorder = NULL;
+    ncs_vm_trace_end(&recorder);
+    NCS_TEST_EQUAL(printed.size(), runs);
+    NCS_TEST_EQUAL(recorder.events, runs * 5);
+
+    std::vector<uint8_t> trace = ncs_test_read_all(file);
+    fclose(file);
+    NCS_TEST_CHECK(trace.size() > 4);
+    NCS_TEST_CHECK(trace.size() >= 4 && memcmp(trace.data(), NCS_VM_TRACE_MAGIC, 4) == 0);
+
+    // Replay against the same script: no engine, same paths
+    NcsVmTraceReplayStats stats;
+    NCS_TEST_EQUAL(ncs_vm_trace_replay(trace.data(), trace.size(), ncs_test_resolve, &program, 0, &stats),
+                   NCS_VM_OK);
+    NCS_TEST_EQUAL(stats.runs, runs);
+    NCS_TEST_EQUAL(stats.actions, runs * 2);
+    NCS_TEST_EQUAL(stats.seeds, runs);
+
+    // Replay against a script whose branch was inverted: the first run diverges
+    NcsVmProgram changed;
+    NCS_TEST_EQUAL(ncs_test_load(ncs_test_random_branch_program(NCS_OP_JNZ), &changed), NCS_VM_OK);
+    NCS_TEST_EQUAL(ncs_vm_trace_replay(trace.data(), trace.size(), ncs_test_resolve, &changed, 0, &stats),
+                   NCS_VM_ERROR_TRACE_MISMATCH);
+
+    // A truncated trace is malformed, not a mismatch
+    NCS_TEST_EQUAL(ncs_vm_trace_replay(trace.data(), 3, ncs_test_resolve, &program, 0, NULL),
+                   NCS_VM_ERROR_BAD_PROGRAM);
+
+    return ncs_test_finish("ncs_vm_trace_test");
+}
@@ -0,0 +1,271 @@
+// ============================================================================
+// NCS VIRTUAL MACHINE - VERIFIER ACCEPT/REJECT TESTS
+// ============================================================================
+
+#include "ncs_test.h"
+
+/**
+ * @brief Load and verify against ncs_test_signatures()
+ *
+ * @return NcsVmResult of ncs_vm_verify (or of the load, if that failed)
+ */
+static int ncs_test_verify(const std::vector<NcsInstruction>& code, NcsVmProgram* program)
+{
+    int result = ncs_test_load(code, program);
+    if (result != NCS_VM_OK) {
+        return result;
+    }
+    std::vector<NcsVmActionSignature> signatures = ncs_test_signatures();
+    return ncs_vm_verify(program, signatures.data(), signatures.size());
+}
+
+/**
+ * @brief void main() { int x = Random(10); if (x) Print(x); else Print(-1); }
+ */
+static void ncs_test_accepts_branches()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 2));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_const_int(10));                                   // 2
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_RANDOM, 1));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));
+    code.push_back(ncs_test_jump(NCS_OP_JZ, 9));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code.push_back(ncs_test_jump(NCS_OP_JMP, 11));
+    code.push_back(ncs_test_const_int(-1));                                   // 9
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));                // 11
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_verify(code, &program), NCS_VM_OK);
+    NCS_TEST_EQUAL(program.verified, 1);
+    NCS_TEST_CHECK(program.maxStackCells >= 2);
+
+    // The verified program runs unchecked and behaves the same
+    NcsVm vm;
+    ncs_vm_init(&vm, 0);
+    std::vector<int32_t> printed;
+    uint32_t counter = 1;
+    ncs_vm_register_action(&vm, NCS_TEST_ROUTINE_PRINT_INTEGER, ncs_test_print_integer, &printed);
+    ncs_vm_register_action(&vm, NCS_TEST_ROUTINE_RANDOM, ncs_test_random, &counter);
+    NCS_TEST_EQUAL(ncs_vm_run_program(&vm, &program), NCS_VM_OK);
+    NCS_TEST_EQUAL(printed.size(), 1);
+    NCS_TEST_EQUAL(vm.sp, 0);
+}
+
+/**
+ * @brief int g = 7; int twice(int a) { return a * 2; } void main() { g = g + 1; Print(twice(g)); }
+ *
+ * The globals routine executes SAVEBP below main, so BP-relative accesses
+ * in main are only provable with the absolute depth passed through the JSRs
+ */
+static void ncs_test_accepts_globals()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 2));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_op(NCS_OP_RSADD, NCS_Q_INT));                     // 2: int g = 7
+    code.push_back(ncs_test_const_int(7));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -8, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_SAVEBP));
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 11));
+    code.push_back(ncs_test_op(NCS_OP_RESTOREBP));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPBP, NCS_Q_STACK, -4, 4));          // 11: main, g = g + 1
+    code.push_back(ncs_test_const_int(1));
+    code.push_back(ncs_test_op(NCS_OP_ADD, NCS_Q_INT_INT));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNBP, NCS_Q_STACK, -4, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RSADD, NCS_Q_INT));                     // 16: return slot
+    code.push_back(ncs_test_op(NCS_OP_CPTOPBP, NCS_Q_STACK, -4, 4));          // argument g
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 21));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));          // 21: twice
+    code.push_back(ncs_test_const_int(2));
+    code.push_back(ncs_test_op(NCS_OP_MUL, NCS_Q_INT_INT));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -12, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_verify(code, &program), NCS_VM_OK);
+    NCS_TEST_EQUAL(program.verified, 1);
+
+    NcsVm vm;
+    ncs_vm_init(&vm, 0);
+    std::vector<int32_t> printed;
+    ncs_vm_register_action(&vm, NCS_TEST_ROUTINE_PRINT_INTEGER, ncs_test_print_integer, &printed);
+    NCS_TEST_EQUAL(ncs_vm_run_program(&vm, &program), NCS_VM_OK);
+    NCS_TEST_CHECK(printed.size() == 1 && printed[0] == 16);
+    NCS_TEST_EQUAL(vm.sp, 0);
+
+    // Reading below the globals is still an underflow
+    code[11] = ncs_test_op(NCS_OP_CPTOPBP, NCS_Q_STACK, -12, 4);
+    NCS_TEST_EQUAL(ncs_test_verify(code, &program), NCS_VM_ERROR_STACK_UNDERFLOW);
+}
+
+/**
+ * @brief int isFive(int a) { return a == 5; } void main() { Print(isFive(5)); }
+ *
+ * @param constantFirst Compare as 5 == a instead of a == 5
+ */
+static void ncs_test_accepts_param_equality(bool constantFirst)
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_op(NCS_OP_RSADD, NCS_Q_INT));                     // 0: return slot
+    code.push_back(ncs_test_const_int(5));                                    // argument
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 5));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    if (constantFirst) {
+        code.push_back(ncs_test_const_int(5));                                // 5: isFive
+        code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -8, 4));
+    } else {
+        code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -4, 4));      // 5: isFive
+        code.push_back(ncs_test_const_int(5));
+    }
+    code.push_back(ncs_test_op(NCS_OP_EQUAL, NCS_Q_INT_INT));
+    code.push_back(ncs_test_op(NCS_OP_CPDOWNSP, NCS_Q_STACK, -12, 4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_verify(code, &program), NCS_VM_OK);
+    NCS_TEST_EQUAL(program.verified, 1);
+
+    NcsVm vm;
+    ncs_vm_init(&vm, 0);
+    std::vector<int32_t> printed;
+    ncs_vm_register_action(&vm, NCS_TEST_ROUTINE_PRINT_INTEGER, ncs_test_print_integer, &printed);
+    NCS_TEST_EQUAL(ncs_vm_run_program(&vm, &program), NCS_VM_OK);
+    NCS_TEST_CHECK(printed.size() == 1 && printed[0] == 1);
+
+    // A parameter matches any known type; two known, different types do not
+    code[constantFirst ? 5 : 6] = ncs_test_const_string("5");
+    NCS_TEST_EQUAL(ncs_test_verify(code, &program), NCS_VM_OK);
+    code[constantFirst ? 6 : 5] = ncs_test_const_int(5);
+    NCS_TEST_EQUAL(ncs_test_verify(code, &program), NCS_VM_ERROR_TYPE_MISMATCH);
+}
+
+/**
+ * @brief int g = 7; void main() { Print(g == 7); }
+ */
+static void ncs_test_accepts_global_equality()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 2));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_const_int(7));                                    // 2: global g
+    code.push_back(ncs_test_op(NCS_OP_SAVEBP));
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 8));
+    code.push_back(ncs_test_op(NCS_OP_RESTOREBP));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPBP, NCS_Q_STACK, -4, 4));          // 8: main
+    code.push_back(ncs_test_const_int(7));
+    code.push_back(ncs_test_op(NCS_OP_EQUAL, NCS_Q_INT_INT));
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, NCS_TEST_ROUTINE_PRINT_INTEGER, 1));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_verify(code, &program), NCS_VM_OK);
+    NCS_TEST_EQUAL(program.verified, 1);
+
+    NcsVm vm;
+    ncs_vm_init(&vm, 0);
+    std::vector<int32_t> printed;
+    ncs_vm_register_action(&vm, NCS_TEST_ROUTINE_PRINT_INTEGER, ncs_test_print_integer, &printed);
+    NCS_TEST_EQUAL(ncs_vm_run_program(&vm, &program), NCS_VM_OK);
+    NCS_TEST_CHECK(printed.size() == 1 && printed[0] == 1);
+}
+
+/**
+ * @brief One branch leaves an extra cell where the paths merge
+ */
+static void ncs_test_rejects_unbalanced_merge()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_const_int(1));
+    code.push_back(ncs_test_jump(NCS_OP_JZ, 3));
+    code.push_back(ncs_test_const_int(2));
+    code.push_back(ncs_test_op(NCS_OP_RETN));                                 // 3: reached with depth 0 and 1
+
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_verify(code, &program), NCS_VM_ERROR_UNBALANCED);
+    NCS_TEST_EQUAL(program.verified, 0);
+}
+
+static void ncs_test_rejects_underflow()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_const_int(1));
+    code.push_back(ncs_test_op(NCS_OP_CPTOPSP, NCS_Q_STACK, -8, 4));          // Reads below the starting SP
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -8));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_verify(code, &program), NCS_VM_ERROR_STACK_UNDERFLOW);
+    NCS_TEST_EQUAL(program.errorOffset, NCS_HEADER_SIZE);
+}
+
+static void ncs_test_rejects_type_mismatch()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_const_string("a"));
+    code.push_back(ncs_test_const_int(1));
+    code.push_back(ncs_test_op(NCS_OP_ADD, NCS_Q_INT_INT));
+    code.push_back(ncs_test_op(NCS_OP_MOVSP, NCS_Q_NONE, -4));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_verify(code, &program), NCS_VM_ERROR_TYPE_MISMATCH);
+}
+
+static void ncs_test_rejects_unknown_action()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_op(NCS_OP_ACTION, NCS_Q_NONE, 7, 0));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_verify(code, &program), NCS_VM_ERROR_UNKNOWN_ACTION);
+}
+
+/**
+ * @brief A subroutine that calls itself is left to the checked interpreter
+ */
+static void ncs_test_rejects_recursion()
+{
+    std::vector<NcsInstruction> code;
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 2));
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+    code.push_back(ncs_test_jump(NCS_OP_JSR, 2));                             // 2
+    code.push_back(ncs_test_op(NCS_OP_RETN));
+
+    NcsVmProgram program;
+    NCS_TEST_EQUAL(ncs_test_verify(code, &program), NCS_VM_ERROR_UNSUPPORTED);
+    NCS_TEST_EQUAL(program.verified, 0);
+}
+
+int main()
+{
+    ncs_test_accepts_branches();
+    ncs_test_accepts_globals();
+    ncs_test_accepts_param_equality(false);
+    ncs_test_accepts_param_equality(true);
+    ncs_test_accepts_global_equality();
+    ncs_test_rejects_unbalanced_merge();
+    ncs_test_rejects_underflow();
+    ncs_test_rejects_type_mismatch();
+    ncs_test_rejects_unknown_action();
+    ncs_test_rejects_recursion();
+    return ncs_test_finish("ncs_vm_verifier_test");
+}
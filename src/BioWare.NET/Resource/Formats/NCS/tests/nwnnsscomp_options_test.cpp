@@ -0,0 +1,70 @@
+// ============================================================================
+// NWNNSSCOMP EXTENDED OPTIONS - PARSER TESTS
+// ============================================================================
+// Extended options are recognized only in their exact forms and are
+// removed from argv; anything else, including paths that start with '/'
+// or with an option letter, is left for the original parser.
+// ============================================================================
+
+#include "ncs_test.h"
+#include "nwnnsscomp_options.h"
+
+static void ncs_test_optimization_levels()
+{
+    NCS_TEST_EQUAL(g_optimizationLevel, 0);
+    NCS_TEST_EQUAL(nwnnsscomp_parse_extended_option("-O"), 1);
+    NCS_TEST_EQUAL(g_optimizationLevel, 2);
+    NCS_TEST_EQUAL(nwnnsscomp_parse_extended_option("-O3"), 1);
+    NCS_TEST_EQUAL(g_optimizationLevel, 3);
+    NCS_TEST_EQUAL(nwnnsscomp_parse_extended_option("-O4"), 0);
+    NCS_TEST_EQUAL(nwnnsscomp_parse_extended_option("/O1"), 0);
+    NCS_TEST_EQUAL(g_optimizationLevel, 3);
+    NCS_TEST_EQUAL(nwnnsscomp_effective_optimization_level(0), 3);
+    NCS_TEST_EQUAL(nwnnsscomp_effective_optimization_level(1), 0);
+    g_optimizationLevel = 0;
+}
+
+static void ncs_test_timing_and_memory_forms()
+{
+    NCS_TEST_EQUAL(nwnnsscomp_parse_extended_option("-Tools.nss"), 0);
+    NCS_TEST_EQUAL(nwnnsscomp_parse_extended_option("-Maps.nss"), 0);
+    NCS_TEST_EQUAL(nwnnsscomp_parse_extended_option("/T"), 0);
+    NCS_TEST_EQUAL(nwnnsscomp_parse_extended_option("-T="), 0);
+    NCS_TEST_EQUAL(g_phaseTimingEnabled, 0);
+    NCS_TEST_EQUAL(g_memoryAccountingEnabled, 0);
+
+    NCS_TEST_EQUAL(nwnnsscomp_parse_extended_option("-T"), 1);
+    NCS_TEST_EQUAL(g_phaseTimingEnabled, 1);
+    NCS_TEST_CHECK(g_phaseTimingPath == NULL);
+    NCS_TEST_EQUAL(nwnnsscomp_parse_extended_option("-T=phases.jsonl"), 1);
+    NCS_TEST_CHECK(g_phaseTimingPath != NULL && strcmp(g_phaseTimingPath, "phases.jsonl") == 0);
+    NCS_TEST_EQUAL(nwnnsscomp_parse_extended_option("-M=memory.jsonl"), 1);
+    NCS_TEST_EQUAL(g_memoryAccountingEnabled, 1);
+    NCS_TEST_CHECK(g_memoryAccountingPath != NULL && strcmp(g_memoryAccountingPath, "memory.jsonl") == 0);
+}
+
+static void ncs_test_consume_removes_options()
+{
+    char program[] = "nwnnsscomp";
+    char optimize[] = "-O1";
+    char input[] = "/Tools/x.nss";
+    char compile[] = "-c";
+    char roundtrip[] = "-Rcorpus";
+    char output[] = "-o";
+    char* argv[] = { program, optimize, input, compile, roundtrip, output, NULL };
+
+    int argc = nwnnsscomp_consume_extended_options(6, argv);
+    NCS_TEST_EQUAL(argc, 4);
+    NCS_TEST_CHECK(argv[0] == program && argv[1] == input && argv[2] == compile && argv[3] == output);
+    NCS_TEST_CHECK(argv[4] == NULL);
+    NCS_TEST_EQUAL(g_optimizationLevel, 1);
+    NCS_TEST_CHECK(g_roundtripCorpus != NULL && strcmp(g_roundtripCorpus, "corpus") == 0);
+}
+
+int main()
+{
+    ncs_test_optimization_levels();
+    ncs_test_timing_and_memory_forms();
+    ncs_test_consume_removes_options();
+    return ncs_test_finish("nwnnsscomp_options_test");
+}